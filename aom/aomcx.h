@@ -559,6 +559,33 @@ enum aome_enc_control_id {
    * Supported in codecs: AV1
    */
   AV1E_SET_RENDER_SIZE,
+
+  /*!\brief Codec control function to run the motion searches of the
+   * reference frames of a block in parallel.
+   *
+   * When enabled, the NEWMV searches of the single reference frames of a
+   * block are run on up to g_threads threads ahead of its mode search. It has
+   * no effect when the tile columns are already encoded in parallel.
+   *
+   * By default, the value is set as 0 (off).
+   *
+   * Supported in codecs: AV1
+   */
+  AV1E_SET_REF_SEARCH_MT,
+
+  /*!\brief Codec control function to estimate the camera motion of each
+   * frame relative to its reference frames.
+   *
+   * When enabled, a translation or affine model is fitted once per frame
+   * pair to a coarse block motion search. It seeds the motion search of the
+   * blocks, and narrows the search range of the blocks following it. It is
+   * not coded in the bitstream.
+   *
+   * By default, the value is set as 0 (off).
+   *
+   * Supported in codecs: AV1
+   */
+  AV1E_SET_GLOBAL_ME,
 };
 
 /*!\brief aom 1-D scaling mode
@@ -758,6 +785,12 @@ AOM_CTRL_USE_TYPE(AV1E_SET_COLOR_RANGE, int)
 AOM_CTRL_USE_TYPE(AV1E_SET_RENDER_SIZE, int *)
 #define AOM_CTRL_AV1E_SET_RENDER_SIZE
 
+AOM_CTRL_USE_TYPE(AV1E_SET_REF_SEARCH_MT, unsigned int)
+#define AOM_CTRL_AV1E_SET_REF_SEARCH_MT
+
+AOM_CTRL_USE_TYPE(AV1E_SET_GLOBAL_ME, unsigned int)
+#define AOM_CTRL_AV1E_SET_GLOBAL_ME
+
 /*!\endcond */
 /*! @} - end defgroup aom_encoder */
 #ifdef __cplusplus
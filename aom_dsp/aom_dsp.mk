@@ -199,6 +199,7 @@ endif  # CONFIG_AOM_HIGHBITDEPTH
 
 DSP_SRCS-yes            += txfm_common.h
 DSP_SRCS-$(HAVE_SSE2)   += x86/txfm_common_sse2.h
+DSP_SRCS-$(HAVE_AVX2)   += x86/txfm_common_avx2.h
 DSP_SRCS-$(HAVE_MSA)    += mips/txfm_macros_msa.h
 # forward transform
 ifneq ($(filter yes,$(CONFIG_AV1_ENCODER)),)
@@ -283,6 +284,13 @@ DSP_SRCS-$(HAVE_SSE2)   += x86/quantize_sse2.c
 ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 DSP_SRCS-$(HAVE_SSE2)   += x86/highbd_quantize_intrin_sse2.c
 endif
+ifeq ($(CONFIG_AOM_QM),yes)
+DSP_SRCS-$(HAVE_SSE4_1) += x86/quantize_qm_impl.h
+DSP_SRCS-$(HAVE_SSE4_1) += x86/quantize_qm_sse4.h
+DSP_SRCS-$(HAVE_SSE4_1) += x86/quantize_qm_sse4.c
+DSP_SRCS-$(HAVE_AVX2)   += x86/quantize_qm_avx2.h
+DSP_SRCS-$(HAVE_AVX2)   += x86/quantize_qm_avx2.c
+endif
 ifeq ($(ARCH_X86_64),yes)
 ifeq ($(CONFIG_USE_X86INC),yes)
 DSP_SRCS-$(HAVE_SSSE3)  += x86/quantize_ssse3_x86_64.asm
@@ -319,8 +327,13 @@ DSP_SRCS-$(HAVE_SSE3)   += x86/sad_sse3.asm
 DSP_SRCS-$(HAVE_SSSE3)  += x86/sad_ssse3.asm
 DSP_SRCS-$(HAVE_SSE4_1) += x86/sad_sse4.asm
 DSP_SRCS-$(HAVE_AVX2)   += x86/sad4d_avx2.c
+DSP_SRCS-$(HAVE_AVX2)   += x86/sad8_avx2.c
 DSP_SRCS-$(HAVE_AVX2)   += x86/sad_avx2.c
 
+ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
+DSP_SRCS-$(HAVE_SSE4_1) += x86/highbd_sad_sse4.c
+endif  # CONFIG_AOM_HIGHBITDEPTH
+
 ifeq ($(CONFIG_USE_X86INC),yes)
 DSP_SRCS-$(HAVE_SSE)    += x86/sad4d_sse2.asm
 DSP_SRCS-$(HAVE_SSE)    += x86/sad_sse2.asm
@@ -379,6 +392,9 @@ endif  # CONFIG_AOM_HIGHBITDEPTH
 ifeq ($(CONFIG_MOTION_VAR),yes)
 DSP_SRCS-$(HAVE_SSE4_1) += x86/obmc_sad_sse4.c
 DSP_SRCS-$(HAVE_SSE4_1) += x86/obmc_variance_sse4.c
+DSP_SRCS-$(HAVE_AVX2)   += x86/obmc_intrinsic_avx2.h
+DSP_SRCS-$(HAVE_AVX2)   += x86/obmc_sad_avx2.c
+DSP_SRCS-$(HAVE_AVX2)   += x86/obmc_variance_avx2.c
 endif  #CONFIG_MOTION_VAR
 endif  # CONFIG_ENCODERS
 
@@ -696,10 +696,10 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   specialize qw/aom_fdct16x16_1 sse2/;
 
   add_proto qw/void aom_fdct32x32/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/aom_fdct32x32 sse2/;
+  specialize qw/aom_fdct32x32 sse2 avx2/;
 
   add_proto qw/void aom_fdct32x32_rd/, "const int16_t *input, tran_low_t *output, int stride";
-  specialize qw/aom_fdct32x32_rd sse2/;
+  specialize qw/aom_fdct32x32_rd sse2 avx2/;
 
   add_proto qw/void aom_fdct32x32_1/, "const int16_t *input, tran_low_t *output, int stride";
   specialize qw/aom_fdct32x32_1 sse2/;
@@ -1002,13 +1002,17 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
 if (aom_config("CONFIG_AOM_QM") eq "yes") {
   if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
     add_proto qw/void aom_quantize_b/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, const qm_val_t * qm_ptr, const qm_val_t * iqm_ptr";
+    specialize qw/aom_quantize_b sse4_1 avx2/;
 
     add_proto qw/void aom_quantize_b_32x32/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, const qm_val_t * qm_ptr, const qm_val_t * iqm_ptr";
+    specialize qw/aom_quantize_b_32x32 sse4_1 avx2/;
 
     if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
       add_proto qw/void aom_highbd_quantize_b/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, const qm_val_t * qm_ptr, const qm_val_t * iqm_ptr";
+      specialize qw/aom_highbd_quantize_b sse4_1 avx2/;
 
       add_proto qw/void aom_highbd_quantize_b_32x32/, "const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan, const qm_val_t * qm_ptr, const qm_val_t * iqm_ptr";
+      specialize qw/aom_highbd_quantize_b_32x32 sse4_1 avx2/;
     }  # CONFIG_AOM_HIGHBITDEPTH
   }  # CONFIG_AV1_ENCODER
 } else {
@@ -1074,13 +1078,13 @@ add_proto qw/unsigned int aom_sad32x16/, "const uint8_t *src_ptr, int src_stride
 specialize qw/aom_sad32x16 avx2 msa/, "$sse2_x86inc";
 
 add_proto qw/unsigned int aom_sad16x32/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-specialize qw/aom_sad16x32 msa/, "$sse2_x86inc";
+specialize qw/aom_sad16x32 avx2 msa/, "$sse2_x86inc";
 
 add_proto qw/unsigned int aom_sad16x16/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-specialize qw/aom_sad16x16 media neon msa/, "$sse2_x86inc";
+specialize qw/aom_sad16x16 avx2 media neon msa/, "$sse2_x86inc";
 
 add_proto qw/unsigned int aom_sad16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-specialize qw/aom_sad16x8 neon msa/, "$sse2_x86inc";
+specialize qw/aom_sad16x8 avx2 neon msa/, "$sse2_x86inc";
 
 add_proto qw/unsigned int aom_sad8x16/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
 specialize qw/aom_sad8x16 neon msa/, "$sse2_x86inc";
@@ -1104,14 +1108,14 @@ if (aom_config("CONFIG_MOTION_VAR") eq "yes") {
   foreach (@block_sizes) {
     ($w, $h) = @$_;
     add_proto qw/unsigned int/, "aom_obmc_sad${w}x${h}", "const uint8_t *pre, int pre_stride, const int32_t *wsrc, const int32_t *mask";
-    specialize "aom_obmc_sad${w}x${h}", qw/sse4_1/;
+    specialize "aom_obmc_sad${w}x${h}", qw/sse4_1 avx2/;
   }
 
   if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
     foreach (@block_sizes) {
       ($w, $h) = @$_;
       add_proto qw/unsigned int/, "aom_highbd_obmc_sad${w}x${h}", "const uint8_t *pre, int pre_stride, const int32_t *wsrc, const int32_t *mask";
-      specialize "aom_highbd_obmc_sad${w}x${h}", qw/sse4_1/;
+      specialize "aom_highbd_obmc_sad${w}x${h}", qw/sse4_1 avx2/;
     }
   }
 }
@@ -1124,8 +1128,8 @@ if (aom_config("CONFIG_MOTION_VAR") eq "yes") {
     ($w, $h) = @$_;
     add_proto qw/unsigned int/, "aom_obmc_variance${w}x${h}", "const uint8_t *pre, int pre_stride, const int32_t *wsrc, const int32_t *mask, unsigned int *sse";
     add_proto qw/unsigned int/, "aom_obmc_sub_pixel_variance${w}x${h}", "const uint8_t *pre, int pre_stride, int xoffset, int yoffset, const int32_t *wsrc, const int32_t *mask, unsigned int *sse";
-    specialize "aom_obmc_variance${w}x${h}", q/sse4_1/;
-    specialize "aom_obmc_sub_pixel_variance${w}x${h}";
+    specialize "aom_obmc_variance${w}x${h}", qw/sse4_1 avx2/;
+    specialize "aom_obmc_sub_pixel_variance${w}x${h}", qw/avx2/;
   }
 
   if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
@@ -1134,8 +1138,8 @@ if (aom_config("CONFIG_MOTION_VAR") eq "yes") {
         ($w, $h) = @$_;
         add_proto qw/unsigned int/, "aom_highbd${bd}obmc_variance${w}x${h}", "const uint8_t *pre, int pre_stride, const int32_t *wsrc, const int32_t *mask, unsigned int *sse";
         add_proto qw/unsigned int/, "aom_highbd${bd}obmc_sub_pixel_variance${w}x${h}", "const uint8_t *pre, int pre_stride, int xoffset, int yoffset, const int32_t *wsrc, const int32_t *mask, unsigned int *sse";
-        specialize "aom_highbd${bd}obmc_variance${w}x${h}", qw/sse4_1/;
-        specialize "aom_highbd${bd}obmc_sub_pixel_variance${w}x${h}";
+        specialize "aom_highbd${bd}obmc_variance${w}x${h}", qw/sse4_1 avx2/;
+        specialize "aom_highbd${bd}obmc_sub_pixel_variance${w}x${h}", qw/avx2/;
       }
     }
   }
@@ -1151,6 +1155,9 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
   add_proto qw/unsigned int aom_avg_4x4/, "const uint8_t *, int p";
   specialize qw/aom_avg_4x4 sse2 neon msa/;
 
+  add_proto qw/void aom_avg_8x8_quad/, "const uint8_t *s, int p, int x16_idx, int y16_idx, int *avg";
+  specialize qw/aom_avg_8x8_quad sse2/;
+
   add_proto qw/void aom_minmax_8x8/, "const uint8_t *s, int p, const uint8_t *d, int dp, int *min, int *max";
   specialize qw/aom_minmax_8x8 sse2/;
 
@@ -1239,31 +1246,43 @@ specialize qw/aom_sad4x4x3 sse3 msa/;
 
 # Blocks of 8
 add_proto qw/void aom_sad64x64x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad64x64x8 msa/;
+specialize qw/aom_sad64x64x8 avx2 msa/;
+
+add_proto qw/void aom_sad64x32x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+specialize qw/aom_sad64x32x8 avx2/;
+
+add_proto qw/void aom_sad32x64x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+specialize qw/aom_sad32x64x8 avx2/;
 
 add_proto qw/void aom_sad32x32x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad32x32x8 msa/;
+specialize qw/aom_sad32x32x8 avx2 msa/;
+
+add_proto qw/void aom_sad32x16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+specialize qw/aom_sad32x16x8 avx2/;
+
+add_proto qw/void aom_sad16x32x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+specialize qw/aom_sad16x32x8 avx2/;
 
 add_proto qw/void aom_sad16x16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad16x16x8 sse4_1 msa/;
+specialize qw/aom_sad16x16x8 sse4_1 avx2 msa/;
 
 add_proto qw/void aom_sad16x8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad16x8x8 sse4_1 msa/;
+specialize qw/aom_sad16x8x8 sse4_1 avx2 msa/;
 
 add_proto qw/void aom_sad8x16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad8x16x8 sse4_1 msa/;
+specialize qw/aom_sad8x16x8 sse4_1 avx2 msa/;
 
 add_proto qw/void aom_sad8x8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad8x8x8 sse4_1 msa/;
+specialize qw/aom_sad8x8x8 sse4_1 avx2 msa/;
 
 add_proto qw/void aom_sad8x4x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad8x4x8 msa/;
+specialize qw/aom_sad8x4x8 avx2 msa/;
 
 add_proto qw/void aom_sad4x8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad4x8x8 msa/;
+specialize qw/aom_sad4x8x8 avx2 msa/;
 
 add_proto qw/void aom_sad4x4x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad4x4x8 sse4_1 msa/;
+specialize qw/aom_sad4x4x8 sse4_1 avx2 msa/;
 
 #
 # Multi-block SAD, comparing a reference to N independent blocks
@@ -1272,25 +1291,25 @@ add_proto qw/void aom_sad64x64x4d/, "const uint8_t *src_ptr, int src_stride, con
 specialize qw/aom_sad64x64x4d avx2 neon msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad64x32x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad64x32x4d msa/, "$sse2_x86inc";
+specialize qw/aom_sad64x32x4d avx2 msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad32x64x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad32x64x4d msa/, "$sse2_x86inc";
+specialize qw/aom_sad32x64x4d avx2 msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad32x32x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
 specialize qw/aom_sad32x32x4d avx2 neon msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad32x16x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad32x16x4d msa/, "$sse2_x86inc";
+specialize qw/aom_sad32x16x4d avx2 msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad16x32x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad16x32x4d msa/, "$sse2_x86inc";
+specialize qw/aom_sad16x32x4d avx2 msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad16x16x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad16x16x4d neon msa/, "$sse2_x86inc";
+specialize qw/aom_sad16x16x4d avx2 neon msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad16x8x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
-specialize qw/aom_sad16x8x4d msa/, "$sse2_x86inc";
+specialize qw/aom_sad16x8x4d avx2 msa/, "$sse2_x86inc";
 
 add_proto qw/void aom_sad8x16x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t * const ref_ptr[], int ref_stride, uint32_t *sad_array";
 specialize qw/aom_sad8x16x4d msa/, "$sse2_x86inc";
@@ -1329,51 +1348,51 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
   # Single block SAD
   #
   add_proto qw/unsigned int aom_highbd_sad64x64/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad64x64/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad64x64 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad64x32/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad64x32/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad64x32 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad32x64/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad32x64/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad32x64 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad32x32/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad32x32/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad32x32 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad32x16/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad32x16/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad32x16 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad16x32/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad16x32/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad16x32 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad16x16/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad16x16/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad16x16 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad16x8/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad16x8 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad8x16/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad8x16/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad8x16 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad8x8/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad8x8 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad8x4/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad8x4/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad8x4 sse4_1/, "$sse2_x86inc";
 
   add_proto qw/unsigned int aom_highbd_sad4x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad4x8/;
+  specialize qw/aom_highbd_sad4x8 sse4_1/;
 
   add_proto qw/unsigned int aom_highbd_sad4x4/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride";
-  specialize qw/aom_highbd_sad4x4/;
+  specialize qw/aom_highbd_sad4x4 sse4_1/;
 
   #
   # Avg
   #
   add_proto qw/unsigned int aom_highbd_avg_8x8/, "const uint8_t *, int p";
-  specialize qw/aom_highbd_avg_8x8/;
+  specialize qw/aom_highbd_avg_8x8 sse2/;
   add_proto qw/unsigned int aom_highbd_avg_4x4/, "const uint8_t *, int p";
-  specialize qw/aom_highbd_avg_4x4/;
+  specialize qw/aom_highbd_avg_4x4 sse2/;
   add_proto qw/void aom_highbd_minmax_8x8/, "const uint8_t *s, int p, const uint8_t *d, int dp, int *min, int *max";
   specialize qw/aom_highbd_minmax_8x8/;
 
@@ -1443,73 +1462,85 @@ if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
 
   # Blocks of 8
   add_proto qw/void aom_highbd_sad64x64x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad64x64x8/;
+  specialize qw/aom_highbd_sad64x64x8 sse4_1/;
+
+  add_proto qw/void aom_highbd_sad64x32x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+  specialize qw/aom_highbd_sad64x32x8 sse4_1/;
+
+  add_proto qw/void aom_highbd_sad32x64x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+  specialize qw/aom_highbd_sad32x64x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad32x32x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad32x32x8/;
+  specialize qw/aom_highbd_sad32x32x8 sse4_1/;
+
+  add_proto qw/void aom_highbd_sad32x16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+  specialize qw/aom_highbd_sad32x16x8 sse4_1/;
+
+  add_proto qw/void aom_highbd_sad16x32x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
+  specialize qw/aom_highbd_sad16x32x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad16x16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad16x16x8/;
+  specialize qw/aom_highbd_sad16x16x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad16x8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad16x8x8/;
+  specialize qw/aom_highbd_sad16x8x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad8x16x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad8x16x8/;
+  specialize qw/aom_highbd_sad8x16x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad8x8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad8x8x8/;
+  specialize qw/aom_highbd_sad8x8x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad8x4x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad8x4x8/;
+  specialize qw/aom_highbd_sad8x4x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad4x8x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad4x8x8/;
+  specialize qw/aom_highbd_sad4x8x8 sse4_1/;
 
   add_proto qw/void aom_highbd_sad4x4x8/, "const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr, int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad4x4x8/;
+  specialize qw/aom_highbd_sad4x4x8 sse4_1/;
 
   #
   # Multi-block SAD, comparing a reference to N independent blocks
   #
   add_proto qw/void aom_highbd_sad64x64x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad64x64x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad64x64x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad64x32x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad64x32x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad64x32x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad32x64x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad32x64x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad32x64x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad32x32x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad32x32x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad32x32x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad32x16x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad32x16x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad32x16x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad16x32x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad16x32x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad16x32x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad16x16x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad16x16x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad16x16x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad16x8x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad16x8x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad16x8x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad8x16x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad8x16x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad8x16x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad8x8x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad8x8x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad8x8x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad8x4x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad8x4x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad8x4x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad4x8x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad4x8x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad4x8x4d sse4_1/, "$sse2_x86inc";
 
   add_proto qw/void aom_highbd_sad4x4x4d/, "const uint8_t *src_ptr, int src_stride, const uint8_t* const ref_ptr[], int ref_stride, uint32_t *sad_array";
-  specialize qw/aom_highbd_sad4x4x4d/, "$sse2_x86inc";
+  specialize qw/aom_highbd_sad4x4x4d sse4_1/, "$sse2_x86inc";
 
   #
   # Structured Similarity (SSIM)
@@ -1594,18 +1625,6 @@ add_proto qw/unsigned int aom_get4x4sse_cs/, "const unsigned char *src_ptr, int
 
 add_proto qw/void aom_comp_avg_pred/, "uint8_t *comp_pred, const uint8_t *pred, int width, int height, const uint8_t *ref, int ref_stride";
 
-add_proto qw/void aom_upsampled_pred/, "uint8_t *pred, int width, int height, const uint8_t *ref, const int ref_stride";
-specialize qw/aom_upsampled_pred sse2/;
-add_proto qw/void aom_comp_avg_upsampled_pred/, "uint8_t *comp_pred, const uint8_t *pred, int width, int height, const uint8_t *ref, const int ref_stride";
-specialize qw/aom_comp_avg_upsampled_pred sse2/;
-
-if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
-  add_proto qw/void aom_highbd_upsampled_pred/, "uint16_t *pred, int width, int height, const uint8_t *ref8, const int ref_stride";
-  specialize qw/aom_highbd_upsampled_pred sse2/;
-  add_proto qw/void aom_highbd_comp_avg_upsampled_pred/, "uint16_t *comp_pred, const uint8_t *pred8, int width, int height, const uint8_t *ref8, const int ref_stride";
-  specialize qw/aom_highbd_comp_avg_upsampled_pred sse2/;
-}
-
 #
 # Subpixel Variance
 #
@@ -118,10 +118,12 @@ sadMxNx4D(64, 64)
 
 // 64x32
 sadMxN(64, 32)
+sadMxNxK(64, 32, 8)
 sadMxNx4D(64, 32)
 
 // 32x64
 sadMxN(32, 64)
+sadMxNxK(32, 64, 8)
 sadMxNx4D(32, 64)
 
 // 32x32
@@ -132,10 +134,12 @@ sadMxNx4D(32, 32)
 
 // 32x16
 sadMxN(32, 16)
+sadMxNxK(32, 16, 8)
 sadMxNx4D(32, 16)
 
 // 16x32
 sadMxN(16, 32)
+sadMxNxK(16, 32, 8)
 sadMxNx4D(16, 32)
 
 // 16x16
@@ -256,10 +260,12 @@ highbd_sadMxNx4D(64, 64)
 
 // 64x32
 highbd_sadMxN(64, 32)
+highbd_sadMxNxK(64, 32, 8)
 highbd_sadMxNx4D(64, 32)
 
 // 32x64
 highbd_sadMxN(32, 64)
+highbd_sadMxNxK(32, 64, 8)
 highbd_sadMxNx4D(32, 64)
 
 // 32x32
@@ -270,10 +276,12 @@ highbd_sadMxNx4D(32, 32)
 
 // 32x16
 highbd_sadMxN(32, 16)
+highbd_sadMxNxK(32, 16, 8)
 highbd_sadMxNx4D(32, 16)
 
 // 16x32
 highbd_sadMxN(16, 32)
+highbd_sadMxNxK(16, 32, 8)
 highbd_sadMxNx4D(16, 32)
 
 // 16x16
@@ -137,6 +137,59 @@ unsigned int aom_avg_4x4_sse2(const uint8_t *s, int p) {
   return (avg + 8) >> 4;
 }
 
+void aom_avg_8x8_quad_sse2(const uint8_t *s, int p, int x16_idx, int y16_idx,
+                           int *avg) {
+  const __m128i u0 = _mm_setzero_si128();
+  __m128i sum[2];
+  int i, r;
+  s += y16_idx * p + x16_idx;
+  for (i = 0; i < 2; ++i) {
+    // Each row gives the sums of its left and right 8 pixels in the low
+    // 16 bits of the two 64-bit lanes.
+    sum[i] = u0;
+    for (r = 0; r < 8; ++r, s += p) {
+      const __m128i s0 = _mm_loadu_si128((const __m128i *)s);
+      sum[i] = _mm_add_epi16(sum[i], _mm_sad_epu8(s0, u0));
+    }
+  }
+  avg[0] = (_mm_extract_epi16(sum[0], 0) + 32) >> 6;
+  avg[1] = (_mm_extract_epi16(sum[0], 4) + 32) >> 6;
+  avg[2] = (_mm_extract_epi16(sum[1], 0) + 32) >> 6;
+  avg[3] = (_mm_extract_epi16(sum[1], 4) + 32) >> 6;
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+static INLINE unsigned int highbd_hsum_epi32(__m128i sum) {
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return (unsigned int)_mm_cvtsi128_si32(sum);
+}
+
+unsigned int aom_highbd_avg_8x8_sse2(const uint8_t *s8, int p) {
+  const uint16_t *s = CONVERT_TO_SHORTPTR(s8);
+  const __m128i one = _mm_set1_epi16(1);
+  __m128i sum = _mm_setzero_si128();
+  int i;
+  for (i = 0; i < 8; ++i, s += p) {
+    const __m128i s0 = _mm_loadu_si128((const __m128i *)s);
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(s0, one));
+  }
+  return (highbd_hsum_epi32(sum) + 32) >> 6;
+}
+
+unsigned int aom_highbd_avg_4x4_sse2(const uint8_t *s8, int p) {
+  const uint16_t *s = CONVERT_TO_SHORTPTR(s8);
+  const __m128i one = _mm_set1_epi16(1);
+  __m128i sum = _mm_setzero_si128();
+  int i;
+  for (i = 0; i < 4; ++i, s += p) {
+    const __m128i s0 = _mm_loadl_epi64((const __m128i *)s);
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(s0, one));
+  }
+  return (highbd_hsum_epi32(sum) + 8) >> 4;
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
 static void hadamard_col8_sse2(__m128i *in, int iter) {
   __m128i a0 = in[0];
   __m128i a1 = in[1];
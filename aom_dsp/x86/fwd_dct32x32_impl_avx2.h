@@ -12,16 +12,7 @@
 #include <immintrin.h>  // AVX2
 
 #include "aom_dsp/txfm_common.h"
-
-#define pair256_set_epi16(a, b)                                            \
-  _mm256_set_epi16((int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
-                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
-                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
-                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a))
-
-#define pair256_set_epi32(a, b)                                                \
-  _mm256_set_epi32((int)(b), (int)(a), (int)(b), (int)(a), (int)(b), (int)(a), \
-                   (int)(b), (int)(a))
+#include "aom_dsp/x86/txfm_common_avx2.h"
 
 #if FDCT32x32_HIGH_PRECISION
 static INLINE __m256i k_madd_epi32_avx2(__m256i a, __m256i b) {
@@ -40,13 +31,21 @@ static INLINE __m256i k_packs_epi64_avx2(__m256i a, __m256i b) {
 }
 #endif
 
-void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
+void FDCT32x32_2D_AVX2(const int16_t *input, tran_low_t *output_org,
+                       int stride) {
   // Calculate pre-multiplied strides
   const int str1 = stride;
   const int str2 = 2 * stride;
   const int str3 = 2 * stride + str1;
   // We need an intermediate buffer between passes.
   DECLARE_ALIGNED(32, int16_t, intermediate[32 * 32]);
+#if CONFIG_AOM_HIGHBITDEPTH
+  // The second pass also works in 16 bits, its output is widened to
+  // tran_low_t at the end.
+  DECLARE_ALIGNED(32, int16_t, output16[32 * 32]);
+#else
+  int16_t *const output16 = output_org;
+#endif
   // Constants
   //    When we use them, in one case, they are all the same. In all others
   //    it's a pair of them that we need to repeat four times. This is done
@@ -2855,8 +2854,8 @@ void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
           output_currStep = &intermediate[column_start * 32];
           output_nextStep = &intermediate[(column_start + 8) * 32];
         } else {
-          output_currStep = &output_org[column_start * 32];
-          output_nextStep = &output_org[(column_start + 8) * 32];
+          output_currStep = &output16[column_start * 32];
+          output_nextStep = &output16[(column_start + 8) * 32];
         }
         for (transpose_block = 0; transpose_block < 4; ++transpose_block) {
           __m256i *this_out = &out[8 * transpose_block];
@@ -2999,4 +2998,18 @@ void FDCT32x32_2D_AVX2(const int16_t *input, int16_t *output_org, int stride) {
       }
     }
   }
+#if CONFIG_AOM_HIGHBITDEPTH
+  {
+    int i;
+    for (i = 0; i < 32 * 32; i += 16) {
+      const __m256i x = _mm256_load_si256((const __m256i *)(output16 + i));
+      const __m128i lo = _mm256_castsi256_si128(x);
+      const __m128i hi = _mm256_extractf128_si256(x, 1);
+      _mm256_storeu_si256((__m256i *)(output_org + i),
+                          _mm256_cvtepi16_epi32(lo));
+      _mm256_storeu_si256((__m256i *)(output_org + i + 8),
+                          _mm256_cvtepi16_epi32(hi));
+    }
+  }
+#endif  // CONFIG_AOM_HIGHBITDEPTH
 }  // NOLINT
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "aom/aom_integer.h"
+#include "aom_ports/mem.h"
+
+// Pixels are at most 12 bits, so the differences fit in 16 bits and pairs of
+// absolute differences are summed into 32 bits by _mm_madd_epi16.
+
+static INLINE __m128i sad_8x1(__m128i s, const uint16_t *ref, int ref_stride,
+                              int width) {
+  __m128i r;
+  if (width == 4)
+    r = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)ref),
+        _mm_loadl_epi64((const __m128i *)(ref + ref_stride)));
+  else
+    r = _mm_loadu_si128((const __m128i *)ref);
+  return _mm_madd_epi16(_mm_abs_epi16(_mm_sub_epi16(s, r)),
+                        _mm_set1_epi16(1));
+}
+
+// Loads 8 pixels, or 4 pixels of 2 rows for 4 wide blocks.
+static INLINE __m128i load_src(const uint16_t *src, int src_stride,
+                               int width) {
+  if (width == 4)
+    return _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)src),
+        _mm_loadl_epi64((const __m128i *)(src + src_stride)));
+  return _mm_loadu_si128((const __m128i *)src);
+}
+
+static INLINE uint32_t hsum_epi32(__m128i v) {
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+  return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+// Stores the horizontal sums of a, b, c and d.
+static INLINE void store_hsum4(__m128i a, __m128i b, __m128i c, __m128i d,
+                               uint32_t *res) {
+  _mm_storeu_si128((__m128i *)res,
+                   _mm_hadd_epi32(_mm_hadd_epi32(a, b), _mm_hadd_epi32(c, d)));
+}
+
+static INLINE unsigned int highbd_sad(const uint8_t *src8, int src_stride,
+                                      const uint8_t *ref8, int ref_stride,
+                                      int width, int height) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref = CONVERT_TO_SHORTPTR(ref8);
+  const int rows = width == 4 ? 2 : 1;
+  __m128i sum = _mm_setzero_si128();
+  int i, j;
+
+  for (i = 0; i < height; i += rows) {
+    for (j = 0; j < width; j += 8) {
+      const __m128i s = load_src(src + j, src_stride, width);
+      sum = _mm_add_epi32(sum, sad_8x1(s, ref + j, ref_stride, width));
+    }
+    src += rows * src_stride;
+    ref += rows * ref_stride;
+  }
+  return hsum_epi32(sum);
+}
+
+static INLINE void highbd_sad_x4d(const uint8_t *src8, int src_stride,
+                                  const uint8_t *const ref_array[],
+                                  int ref_stride, int width, int height,
+                                  uint32_t *sad_array) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref0 = CONVERT_TO_SHORTPTR(ref_array[0]);
+  const uint16_t *ref1 = CONVERT_TO_SHORTPTR(ref_array[1]);
+  const uint16_t *ref2 = CONVERT_TO_SHORTPTR(ref_array[2]);
+  const uint16_t *ref3 = CONVERT_TO_SHORTPTR(ref_array[3]);
+  const int rows = width == 4 ? 2 : 1;
+  __m128i sum0 = _mm_setzero_si128();
+  __m128i sum1 = _mm_setzero_si128();
+  __m128i sum2 = _mm_setzero_si128();
+  __m128i sum3 = _mm_setzero_si128();
+  int i, j, offset = 0;
+
+  for (i = 0; i < height; i += rows) {
+    for (j = 0; j < width; j += 8) {
+      const __m128i s = load_src(src + j, src_stride, width);
+      const int k = offset + j;
+      sum0 = _mm_add_epi32(sum0, sad_8x1(s, ref0 + k, ref_stride, width));
+      sum1 = _mm_add_epi32(sum1, sad_8x1(s, ref1 + k, ref_stride, width));
+      sum2 = _mm_add_epi32(sum2, sad_8x1(s, ref2 + k, ref_stride, width));
+      sum3 = _mm_add_epi32(sum3, sad_8x1(s, ref3 + k, ref_stride, width));
+    }
+    src += rows * src_stride;
+    offset += rows * ref_stride;
+  }
+  store_hsum4(sum0, sum1, sum2, sum3, sad_array);
+}
+
+// SADs against the 8 reference blocks starting at ref, ref + 1, ..., ref + 7.
+// Each source vector is loaded once for the 8 positions.
+static INLINE void highbd_sad_x8(const uint8_t *src8, int src_stride,
+                                 const uint8_t *ref8, int ref_stride,
+                                 int width, int height, uint32_t *sad_array) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref = CONVERT_TO_SHORTPTR(ref8);
+  const int rows = width == 4 ? 2 : 1;
+  __m128i sum[8];
+  int i, j, k;
+
+  for (k = 0; k < 8; ++k) sum[k] = _mm_setzero_si128();
+  for (i = 0; i < height; i += rows) {
+    for (j = 0; j < width; j += 8) {
+      const __m128i s = load_src(src + j, src_stride, width);
+      for (k = 0; k < 8; ++k)
+        sum[k] = _mm_add_epi32(sum[k],
+                               sad_8x1(s, ref + j + k, ref_stride, width));
+    }
+    src += rows * src_stride;
+    ref += rows * ref_stride;
+  }
+  store_hsum4(sum[0], sum[1], sum[2], sum[3], sad_array);
+  store_hsum4(sum[4], sum[5], sum[6], sum[7], sad_array + 4);
+}
+
+#define HIGHBD_SADMXN_SSE4(m, n)                                            \
+  unsigned int aom_highbd_sad##m##x##n##_sse4_1(                            \
+      const uint8_t *src, int src_stride, const uint8_t *ref,               \
+      int ref_stride) {                                                     \
+    return highbd_sad(src, src_stride, ref, ref_stride, m, n);              \
+  }                                                                         \
+  void aom_highbd_sad##m##x##n##x4d_sse4_1(                                 \
+      const uint8_t *src, int src_stride, const uint8_t *const ref_array[], \
+      int ref_stride, uint32_t *sad_array) {                                \
+    highbd_sad_x4d(src, src_stride, ref_array, ref_stride, m, n,            \
+                   sad_array);                                              \
+  }                                                                         \
+  void aom_highbd_sad##m##x##n##x8_sse4_1(                                  \
+      const uint8_t *src, int src_stride, const uint8_t *ref,               \
+      int ref_stride, uint32_t *sad_array) {                                \
+    highbd_sad_x8(src, src_stride, ref, ref_stride, m, n, sad_array);       \
+  }
+
+/* clang-format off */
+HIGHBD_SADMXN_SSE4(64, 64)
+HIGHBD_SADMXN_SSE4(64, 32)
+HIGHBD_SADMXN_SSE4(32, 64)
+HIGHBD_SADMXN_SSE4(32, 32)
+HIGHBD_SADMXN_SSE4(32, 16)
+HIGHBD_SADMXN_SSE4(16, 32)
+HIGHBD_SADMXN_SSE4(16, 16)
+HIGHBD_SADMXN_SSE4(16, 8)
+HIGHBD_SADMXN_SSE4(8, 16)
+HIGHBD_SADMXN_SSE4(8, 8)
+HIGHBD_SADMXN_SSE4(8, 4)
+HIGHBD_SADMXN_SSE4(4, 8)
+HIGHBD_SADMXN_SSE4(4, 4)
+/* clang-format on */
+
+#undef HIGHBD_SADMXN_SSE4
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_DSP_X86_OBMC_INTRINSIC_AVX2_H_
+#define AOM_DSP_X86_OBMC_INTRINSIC_AVX2_H_
+
+#include <immintrin.h>
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/x86/synonyms.h"
+
+// The wsrc and mask of an OBMC block are stored without padding, so the
+// kernels walk them 8 entries at a time. Entry n of a block w wide is the
+// pixel at row n / w, column n % w of pre. For 4 wide blocks the 8 entries
+// span two rows.
+
+// Loads the 8 pixels of entries n to n + 7, widened to 32 bits.
+static INLINE __m256i obmc_load_pre_8(const uint8_t *pre, int pre_stride,
+                                      int w, int n) {
+  const uint8_t *const p = pre + (n / w) * pre_stride + (n % w);
+  if (w == 4)
+    return _mm256_cvtepu8_epi32(
+        _mm_unpacklo_epi32(xx_loadl_32(p), xx_loadl_32(p + pre_stride)));
+  return _mm256_cvtepu8_epi32(xx_loadl_64(p));
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+static INLINE __m256i hbd_obmc_load_pre_8(const uint16_t *pre, int pre_stride,
+                                          int w, int n) {
+  const uint16_t *const p = pre + (n / w) * pre_stride + (n % w);
+  if (w == 4)
+    return _mm256_cvtepu16_epi32(
+        _mm_unpacklo_epi64(xx_loadl_64(p), xx_loadl_64(p + pre_stride)));
+  return _mm256_cvtepu16_epi32(xx_loadu_128(p));
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+#endif  // AOM_DSP_X86_OBMC_INTRINSIC_AVX2_H_
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
+#include "aom_ports/mem.h"
+#include "aom/aom_integer.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/x86/obmc_intrinsic_avx2.h"
+
+// Rounded absolute differences of 8 pixels, widened to 32 bits, against
+// wsrc and mask.
+static INLINE __m256i obmc_sad_8(const __m256i v_p_d, const int32_t *wsrc,
+                                 const int32_t *mask) {
+  const __m256i v_m_d = yy_loadu_256(mask);
+  const __m256i v_w_d = yy_loadu_256(wsrc);
+
+  // Values in both pre and mask fit in 15 bits, and are packed at 32 bit
+  // boundaries, so pmaddwd gives the same result as pmulld.
+  const __m256i v_pm_d = _mm256_madd_epi16(v_p_d, v_m_d);
+  const __m256i v_diff_d = _mm256_sub_epi32(v_w_d, v_pm_d);
+
+  return yy_roundn_epu32(_mm256_abs_epi32(v_diff_d), 12);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 8 bit
+////////////////////////////////////////////////////////////////////////////////
+
+static INLINE unsigned int obmc_sad(const uint8_t *pre, int pre_stride,
+                                    const int32_t *wsrc, const int32_t *mask,
+                                    int w, int h) {
+  __m256i v_sad_d = _mm256_setzero_si256();
+  int n;
+
+  assert(IS_POWER_OF_TWO(w));
+
+  for (n = 0; n < w * h; n += 8) {
+    const __m256i v_p_d = obmc_load_pre_8(pre, pre_stride, w, n);
+    v_sad_d = _mm256_add_epi32(v_sad_d, obmc_sad_8(v_p_d, wsrc + n, mask + n));
+  }
+
+  return yy_hsum_epi32_si32(v_sad_d);
+}
+
+#define OBMCSADWXH(w, h)                                       \
+  unsigned int aom_obmc_sad##w##x##h##_avx2(                   \
+      const uint8_t *pre, int pre_stride, const int32_t *wsrc, \
+      const int32_t *mask) {                                   \
+    return obmc_sad(pre, pre_stride, wsrc, mask, w, h);        \
+  }
+
+OBMCSADWXH(64, 64)
+OBMCSADWXH(64, 32)
+OBMCSADWXH(32, 64)
+OBMCSADWXH(32, 32)
+OBMCSADWXH(32, 16)
+OBMCSADWXH(16, 32)
+OBMCSADWXH(16, 16)
+OBMCSADWXH(16, 8)
+OBMCSADWXH(8, 16)
+OBMCSADWXH(8, 8)
+OBMCSADWXH(8, 4)
+OBMCSADWXH(4, 8)
+OBMCSADWXH(4, 4)
+
+////////////////////////////////////////////////////////////////////////////////
+// High bit-depth
+////////////////////////////////////////////////////////////////////////////////
+
+#if CONFIG_AOM_HIGHBITDEPTH
+static INLINE unsigned int hbd_obmc_sad(const uint8_t *pre8, int pre_stride,
+                                        const int32_t *wsrc,
+                                        const int32_t *mask, int w, int h) {
+  const uint16_t *pre = CONVERT_TO_SHORTPTR(pre8);
+  __m256i v_sad_d = _mm256_setzero_si256();
+  int n;
+
+  assert(IS_POWER_OF_TWO(w));
+
+  for (n = 0; n < w * h; n += 8) {
+    const __m256i v_p_d = hbd_obmc_load_pre_8(pre, pre_stride, w, n);
+    v_sad_d = _mm256_add_epi32(v_sad_d, obmc_sad_8(v_p_d, wsrc + n, mask + n));
+  }
+
+  return yy_hsum_epi32_si32(v_sad_d);
+}
+
+#define HBD_OBMCSADWXH(w, h)                                   \
+  unsigned int aom_highbd_obmc_sad##w##x##h##_avx2(            \
+      const uint8_t *pre, int pre_stride, const int32_t *wsrc, \
+      const int32_t *mask) {                                   \
+    return hbd_obmc_sad(pre, pre_stride, wsrc, mask, w, h);    \
+  }
+
+HBD_OBMCSADWXH(64, 64)
+HBD_OBMCSADWXH(64, 32)
+HBD_OBMCSADWXH(32, 64)
+HBD_OBMCSADWXH(32, 32)
+HBD_OBMCSADWXH(32, 16)
+HBD_OBMCSADWXH(16, 32)
+HBD_OBMCSADWXH(16, 16)
+HBD_OBMCSADWXH(16, 8)
+HBD_OBMCSADWXH(8, 16)
+HBD_OBMCSADWXH(8, 8)
+HBD_OBMCSADWXH(8, 4)
+HBD_OBMCSADWXH(4, 8)
+HBD_OBMCSADWXH(4, 4)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
+#include "aom_ports/mem.h"
+#include "aom/aom_integer.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/aom_filter.h"
+#include "aom_dsp/x86/obmc_intrinsic_avx2.h"
+
+// Same taps as the bilinear filters of the C sub-pixel variance.
+static const uint8_t obmc_bilinear_filters[8][2] = {
+  { 128, 0 }, { 112, 16 }, { 96, 32 }, { 80, 48 },
+  { 64, 64 }, { 48, 80 },  { 32, 96 }, { 16, 112 },
+};
+
+static INLINE __m256i load_pre_8(const uint8_t *pre8, int pre_stride, int w,
+                                 int n, int hbd) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (hbd)
+    return hbd_obmc_load_pre_8(CONVERT_TO_SHORTPTR(pre8), pre_stride, w, n);
+#else
+  (void)hbd;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  return obmc_load_pre_8(pre8, pre_stride, w, n);
+}
+
+// Rounded differences of 8 pixels against wsrc and mask.
+static INLINE __m256i obmc_rdiff_8(const __m256i v_p_d, const int32_t *wsrc,
+                                   const int32_t *mask) {
+  const __m256i v_m_d = yy_loadu_256(mask);
+  const __m256i v_w_d = yy_loadu_256(wsrc);
+
+  // Values in both pre and mask fit in 15 bits, and are packed at 32 bit
+  // boundaries, so pmaddwd gives the same result as pmulld.
+  const __m256i v_pm_d = _mm256_madd_epi16(v_p_d, v_m_d);
+  const __m256i v_diff_d = _mm256_sub_epi32(v_w_d, v_pm_d);
+
+  return yy_roundn_epi32(v_diff_d, 12);
+}
+
+// Adds the differences of the 16 pixels in p0 and p1 to sum, and their
+// squares to sse. The squares of high bit-depth input are added to 64 bit
+// lanes, as 32 bits may overflow with 12 bit input.
+static INLINE void obmc_accumulate_16(const __m256i v_p0_d,
+                                      const __m256i v_p1_d,
+                                      const int32_t *wsrc0,
+                                      const int32_t *mask0,
+                                      const int32_t *wsrc1,
+                                      const int32_t *mask1, int hbd,
+                                      __m256i *v_sum_d, __m256i *v_sse) {
+  const __m256i v_rdiff0_d = obmc_rdiff_8(v_p0_d, wsrc0, mask0);
+  const __m256i v_rdiff1_d = obmc_rdiff_8(v_p1_d, wsrc1, mask1);
+  const __m256i v_rdiff01_w = _mm256_packs_epi32(v_rdiff0_d, v_rdiff1_d);
+  const __m256i v_sqrdiff_d = _mm256_madd_epi16(v_rdiff01_w, v_rdiff01_w);
+
+  *v_sum_d = _mm256_add_epi32(*v_sum_d, v_rdiff0_d);
+  *v_sum_d = _mm256_add_epi32(*v_sum_d, v_rdiff1_d);
+  if (hbd) {
+    const __m256i v_zero = _mm256_setzero_si256();
+    const __m256i v_sqrdiff0_q = _mm256_unpacklo_epi32(v_sqrdiff_d, v_zero);
+    const __m256i v_sqrdiff1_q = _mm256_unpackhi_epi32(v_sqrdiff_d, v_zero);
+    *v_sse = _mm256_add_epi64(*v_sse, v_sqrdiff0_q);
+    *v_sse = _mm256_add_epi64(*v_sse, v_sqrdiff1_q);
+  } else {
+    *v_sse = _mm256_add_epi32(*v_sse, v_sqrdiff_d);
+  }
+}
+
+static INLINE void obmc_sums(const __m256i v_sum_d, const __m256i v_sse,
+                             int hbd, uint64_t *sse, int64_t *sum) {
+  *sum = yy_hsum_epi32_si32(v_sum_d);
+  *sse = hbd ? (uint64_t)yy_hsum_epi64_si64(v_sse)
+             : (uint32_t)yy_hsum_epi32_si32(v_sse);
+}
+
+static INLINE void obmc_variance(const uint8_t *pre8, int pre_stride,
+                                 const int32_t *wsrc, const int32_t *mask,
+                                 int w, int h, int hbd, uint64_t *sse,
+                                 int64_t *sum) {
+  __m256i v_sum_d = _mm256_setzero_si256();
+  __m256i v_sse = _mm256_setzero_si256();
+  int n;
+
+  assert(IS_POWER_OF_TWO(w));
+  assert(IS_POWER_OF_TWO(h));
+
+  for (n = 0; n < w * h; n += 16) {
+    const __m256i v_p0_d = load_pre_8(pre8, pre_stride, w, n, hbd);
+    const __m256i v_p1_d = load_pre_8(pre8, pre_stride, w, n + 8, hbd);
+    obmc_accumulate_16(v_p0_d, v_p1_d, wsrc + n, mask + n, wsrc + n + 8,
+                       mask + n + 8, hbd, &v_sum_d, &v_sse);
+  }
+
+  obmc_sums(v_sum_d, v_sse, hbd, sse, sum);
+}
+
+// Applies the 2-tap filter f to the 8 pixel pairs in a and b. f holds the
+// taps as a pair of 16 bit values in each 32 bit lane.
+static INLINE __m256i bil_filter_8(const __m256i v_a_d, const __m256i v_b_d,
+                                   const __m256i v_f_d) {
+  const __m256i v_ab_w = _mm256_or_si256(v_a_d, _mm256_slli_epi32(v_b_d, 16));
+  return yy_roundn_epu32(_mm256_madd_epi16(v_ab_w, v_f_d), FILTER_BITS);
+}
+
+static INLINE __m256i bil_filter_taps(int offset) {
+  const uint8_t *const f = obmc_bilinear_filters[offset];
+  return _mm256_set1_epi32(f[0] | (f[1] << 16));
+}
+
+// Horizontally filtered entries n to n + 7 of pre.
+static INLINE __m256i hfilter_8(const uint8_t *pre8, int pre_stride, int w,
+                                int n, const __m256i v_f_d, int hbd) {
+  const __m256i v_a_d = load_pre_8(pre8, pre_stride, w, n, hbd);
+  const __m256i v_b_d = load_pre_8(pre8, pre_stride, w, n + 1, hbd);
+  return bil_filter_8(v_a_d, v_b_d, v_f_d);
+}
+
+// The variance of the bilinear filtered pre, computed without storing the
+// filtered block. Wider blocks are filtered in 8 pixel columns, so that each
+// row is filtered horizontally once and kept for the vertical pass of the
+// next row.
+static INLINE void obmc_sub_pixel_variance(const uint8_t *pre8, int pre_stride,
+                                           int xoffset, int yoffset,
+                                           const int32_t *wsrc,
+                                           const int32_t *mask, int w, int h,
+                                           int hbd, uint64_t *sse,
+                                           int64_t *sum) {
+  const __m256i v_fx_d = bil_filter_taps(xoffset);
+  const __m256i v_fy_d = bil_filter_taps(yoffset);
+  __m256i v_sum_d = _mm256_setzero_si256();
+  __m256i v_sse = _mm256_setzero_si256();
+  int n, r, c;
+
+  assert(IS_POWER_OF_TWO(w));
+  assert(IS_POWER_OF_TWO(h));
+
+  if (w == 4) {
+    // The 8 entries span two rows, and entry n + 4 is one row below n.
+    for (n = 0; n < 4 * h; n += 16) {
+      const __m256i v_h0_d = hfilter_8(pre8, pre_stride, 4, n, v_fx_d, hbd);
+      const __m256i v_h1_d =
+          hfilter_8(pre8, pre_stride, 4, n + 4, v_fx_d, hbd);
+      const __m256i v_h2_d =
+          hfilter_8(pre8, pre_stride, 4, n + 8, v_fx_d, hbd);
+      const __m256i v_h3_d =
+          hfilter_8(pre8, pre_stride, 4, n + 12, v_fx_d, hbd);
+      obmc_accumulate_16(bil_filter_8(v_h0_d, v_h1_d, v_fy_d),
+                         bil_filter_8(v_h2_d, v_h3_d, v_fy_d), wsrc + n,
+                         mask + n, wsrc + n + 8, mask + n + 8, hbd, &v_sum_d,
+                         &v_sse);
+    }
+  } else {
+    for (c = 0; c < w; c += 8) {
+      __m256i v_h0_d = hfilter_8(pre8, pre_stride, w, c, v_fx_d, hbd);
+      for (r = 0; r < h; r += 2) {
+        const int i = r * w + c;
+        const __m256i v_h1_d =
+            hfilter_8(pre8, pre_stride, w, i + w, v_fx_d, hbd);
+        const __m256i v_h2_d =
+            hfilter_8(pre8, pre_stride, w, i + 2 * w, v_fx_d, hbd);
+        obmc_accumulate_16(bil_filter_8(v_h0_d, v_h1_d, v_fy_d),
+                           bil_filter_8(v_h1_d, v_h2_d, v_fy_d), wsrc + i,
+                           mask + i, wsrc + i + w, mask + i + w, hbd, &v_sum_d,
+                           &v_sse);
+        v_h0_d = v_h2_d;
+      }
+    }
+  }
+
+  obmc_sums(v_sum_d, v_sse, hbd, sse, sum);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 8 bit
+////////////////////////////////////////////////////////////////////////////////
+
+#define OBMCVARWXH(W, H)                                                   \
+  unsigned int aom_obmc_variance##W##x##H##_avx2(                          \
+      const uint8_t *pre, int pre_stride, const int32_t *wsrc,             \
+      const int32_t *mask, unsigned int *sse) {                            \
+    int64_t sum;                                                           \
+    uint64_t sse64;                                                        \
+    obmc_variance(pre, pre_stride, wsrc, mask, W, H, 0, &sse64, &sum);     \
+    *sse = (unsigned int)sse64;                                            \
+    return *sse - ((sum * sum) / (W * H));                                 \
+  }                                                                        \
+                                                                           \
+  unsigned int aom_obmc_sub_pixel_variance##W##x##H##_avx2(                \
+      const uint8_t *pre, int pre_stride, int xoffset, int yoffset,        \
+      const int32_t *wsrc, const int32_t *mask, unsigned int *sse) {       \
+    int64_t sum;                                                           \
+    uint64_t sse64;                                                        \
+    obmc_sub_pixel_variance(pre, pre_stride, xoffset, yoffset, wsrc, mask, \
+                            W, H, 0, &sse64, &sum);                        \
+    *sse = (unsigned int)sse64;                                            \
+    return *sse - ((sum * sum) / (W * H));                                 \
+  }
+
+OBMCVARWXH(64, 64)
+OBMCVARWXH(64, 32)
+OBMCVARWXH(32, 64)
+OBMCVARWXH(32, 32)
+OBMCVARWXH(32, 16)
+OBMCVARWXH(16, 32)
+OBMCVARWXH(16, 16)
+OBMCVARWXH(16, 8)
+OBMCVARWXH(8, 16)
+OBMCVARWXH(8, 8)
+OBMCVARWXH(8, 4)
+OBMCVARWXH(4, 8)
+OBMCVARWXH(4, 4)
+
+////////////////////////////////////////////////////////////////////////////////
+// High bit-depth
+////////////////////////////////////////////////////////////////////////////////
+
+#if CONFIG_AOM_HIGHBITDEPTH
+// Scales the sums of a bd bit block down to 8 bits, as the C versions do,
+// and returns the variance.
+static INLINE unsigned int hbd_obmc_variance_result(int64_t sum64,
+                                                    uint64_t sse64, int bd,
+                                                    int w, int h,
+                                                    unsigned int *sse) {
+  int sum;
+  if (bd == 12) {
+    sum = (int)ROUND_POWER_OF_TWO(sum64, 4);
+    *sse = (unsigned int)ROUND_POWER_OF_TWO(sse64, 8);
+  } else if (bd == 10) {
+    sum = (int)ROUND_POWER_OF_TWO(sum64, 2);
+    *sse = (unsigned int)ROUND_POWER_OF_TWO(sse64, 4);
+  } else {
+    sum = (int)sum64;
+    *sse = (unsigned int)sse64;
+  }
+  return *sse - (((int64_t)sum * sum) / (w * h));
+}
+
+#define HBD_OBMCVARWXH_BD(W, H, bd_name, bd)                                 \
+  unsigned int aom_highbd##bd_name##obmc_variance##W##x##H##_avx2(           \
+      const uint8_t *pre, int pre_stride, const int32_t *wsrc,               \
+      const int32_t *mask, unsigned int *sse) {                              \
+    int64_t sum;                                                             \
+    uint64_t sse64;                                                          \
+    obmc_variance(pre, pre_stride, wsrc, mask, W, H, 1, &sse64, &sum);       \
+    return hbd_obmc_variance_result(sum, sse64, bd, W, H, sse);              \
+  }                                                                          \
+                                                                             \
+  unsigned int aom_highbd##bd_name##obmc_sub_pixel_variance##W##x##H##_avx2( \
+      const uint8_t *pre, int pre_stride, int xoffset, int yoffset,          \
+      const int32_t *wsrc, const int32_t *mask, unsigned int *sse) {         \
+    int64_t sum;                                                             \
+    uint64_t sse64;                                                          \
+    obmc_sub_pixel_variance(pre, pre_stride, xoffset, yoffset, wsrc, mask,   \
+                            W, H, 1, &sse64, &sum);                          \
+    return hbd_obmc_variance_result(sum, sse64, bd, W, H, sse);              \
+  }
+
+#define HBD_OBMCVARWXH(W, H)        \
+  HBD_OBMCVARWXH_BD(W, H, _, 8)     \
+  HBD_OBMCVARWXH_BD(W, H, _10_, 10) \
+  HBD_OBMCVARWXH_BD(W, H, _12_, 12)
+
+HBD_OBMCVARWXH(64, 64)
+HBD_OBMCVARWXH(64, 32)
+HBD_OBMCVARWXH(32, 64)
+HBD_OBMCVARWXH(32, 32)
+HBD_OBMCVARWXH(32, 16)
+HBD_OBMCVARWXH(16, 32)
+HBD_OBMCVARWXH(16, 16)
+HBD_OBMCVARWXH(16, 8)
+HBD_OBMCVARWXH(8, 16)
+HBD_OBMCVARWXH(8, 8)
+HBD_OBMCVARWXH(8, 4)
+HBD_OBMCVARWXH(4, 8)
+HBD_OBMCVARWXH(4, 4)
+#endif  // CONFIG_AOM_HIGHBITDEPTH
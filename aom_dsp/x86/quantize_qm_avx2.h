@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_DSP_X86_QUANTIZE_QM_AVX2_H_
+#define AOM_DSP_X86_QUANTIZE_QM_AVX2_H_
+
+#include <immintrin.h>  // AVX2
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+
+#define QM_LANES 8
+typedef __m256i qm_vec;
+
+static INLINE __m256i qm_add(__m256i a, __m256i b) {
+  return _mm256_add_epi32(a, b);
+}
+
+static INLINE __m256i qm_sub(__m256i a, __m256i b) {
+  return _mm256_sub_epi32(a, b);
+}
+
+static INLINE __m256i qm_mullo(__m256i a, __m256i b) {
+  return _mm256_mullo_epi32(a, b);
+}
+
+static INLINE __m256i qm_max(__m256i a, __m256i b) {
+  return _mm256_max_epi32(a, b);
+}
+
+static INLINE __m256i qm_abs(__m256i a) { return _mm256_abs_epi32(a); }
+
+static INLINE __m256i qm_and(__m256i a, __m256i b) {
+  return _mm256_and_si256(a, b);
+}
+
+static INLINE __m256i qm_andnot(__m256i a, __m256i b) {
+  return _mm256_andnot_si256(a, b);
+}
+
+static INLINE __m256i qm_xor(__m256i a, __m256i b) {
+  return _mm256_xor_si256(a, b);
+}
+
+static INLINE __m256i qm_cmpeq(__m256i a, __m256i b) {
+  return _mm256_cmpeq_epi32(a, b);
+}
+
+static INLINE __m256i qm_cmpgt(__m256i a, __m256i b) {
+  return _mm256_cmpgt_epi32(a, b);
+}
+
+static INLINE __m256i qm_slli(__m256i a, int bits) {
+  return _mm256_slli_epi32(a, bits);
+}
+
+static INLINE __m256i qm_srli(__m256i a, int bits) {
+  return _mm256_srli_epi32(a, bits);
+}
+
+static INLINE __m256i qm_srai(__m256i a, int bits) {
+  return _mm256_srai_epi32(a, bits);
+}
+
+static INLINE __m256i qm_set1(int a) { return _mm256_set1_epi32(a); }
+
+static INLINE __m256i qm_set_dc(__m256i dc, __m256i ac) {
+  return _mm256_blend_epi32(ac, dc, 0x01);
+}
+
+static INLINE __m256i qm_clamp_s16(__m256i a) {
+  return _mm256_max_epi32(_mm256_min_epi32(a, _mm256_set1_epi32(INT16_MAX)),
+                          _mm256_set1_epi32(INT16_MIN));
+}
+
+// Returns the low 32 bits of (a * b) >> bits, with 0 < bits <= 32.
+static INLINE __m256i qm_mul_shift(__m256i a, __m256i b, int bits) {
+  // Only the low 32 bits of the shifted products are kept, so a logical shift
+  // is as good as an arithmetic one.
+  const __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), bits);
+  const __m256i odd = _mm256_slli_epi64(
+      _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)),
+      32 - bits);
+  return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+static INLINE int qm_hmax(__m256i a) {
+  __m128i b = _mm_max_epi32(_mm256_castsi256_si128(a),
+                            _mm256_extracti128_si256(a, 1));
+  b = _mm_max_epi32(b, _mm_shuffle_epi32(b, 0x4e));
+  b = _mm_max_epi32(b, _mm_shuffle_epi32(b, 0xb1));
+  return _mm_cvtsi128_si32(b);
+}
+
+static INLINE __m256i qm_load_u16(const uint16_t *src) {
+  return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+static INLINE __m256i qm_load_s16(const int16_t *src) {
+  return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+static INLINE __m256i qm_load_coeff(const tran_low_t *src) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  return _mm256_loadu_si256((const __m256i *)src);
+#else
+  return qm_load_s16(src);
+#endif
+}
+
+static INLINE void qm_store_coeff(tran_low_t *dst, __m256i a) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  _mm256_storeu_si256((__m256i *)dst, a);
+#else
+  // Keeps the low 16 bits as a conversion to tran_low_t would.
+  a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+  a = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, a), 0x08);
+  _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(a));
+#endif
+}
+
+#include "aom_dsp/x86/quantize_qm_impl.h"
+
+#endif  // AOM_DSP_X86_QUANTIZE_QM_AVX2_H_
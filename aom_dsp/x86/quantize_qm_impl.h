@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_DSP_X86_QUANTIZE_QM_IMPL_H_
+#define AOM_DSP_X86_QUANTIZE_QM_IMPL_H_
+
+#include <string.h>
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+
+// Quantizers weighted by the quantization matrices, written once against the
+// qm_vec operations of the including header. Each lane holds one coefficient
+// in 32 bits, so the weighted products are exact as long as the coefficient
+// magnitudes stay below 2^22 and the weights below 2^9, which is the case for
+// 12-bit input and the tables of av1/common/quant_common.c.
+
+typedef enum {
+  QM_QUANTIZE_B,
+  QM_QUANTIZE_FP,
+  QM_HIGHBD_QUANTIZE_B,
+  QM_HIGHBD_QUANTIZE_FP
+} QM_QUANTIZER;
+
+static INLINE qm_vec qm_sign_apply(qm_vec a, qm_vec sign) {
+  return qm_sub(qm_xor(a, sign), sign);
+}
+
+static INLINE void qm_quantize(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *zbin_ptr,
+                               const int16_t *round_ptr,
+                               const int16_t *quant_ptr,
+                               const int16_t *quant_shift_ptr,
+                               tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                               const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                               const int16_t *iscan, const qm_val_t *qm_ptr,
+                               const qm_val_t *iqm_ptr, QM_QUANTIZER type,
+                               int log_scale) {
+  const int is_fp = type == QM_QUANTIZE_FP || type == QM_HIGHBD_QUANTIZE_FP;
+  const int is_highbd =
+      type == QM_HIGHBD_QUANTIZE_B || type == QM_HIGHBD_QUANTIZE_FP;
+  // Only the _fp quantizer of the smaller transforms has no dead zone.
+  const int has_zbin = !is_fp || log_scale;
+  const int shift = 16 + AOM_QM_BITS - log_scale;
+  const qm_vec iqm_round = qm_set1(1 << (AOM_QM_BITS - 1));
+  qm_vec zbin[2], round[2], quant[2], quant_shift[2], dequant[2];
+  qm_vec eob = qm_set1(0);
+  intptr_t i;
+
+  if (skip_block) {
+    memset(qcoeff_ptr, 0, n_coeffs * sizeof(*qcoeff_ptr));
+    memset(dqcoeff_ptr, 0, n_coeffs * sizeof(*dqcoeff_ptr));
+    *eob_ptr = 0;
+    return;
+  }
+
+  for (i = 0; i < 2; ++i) {
+    // The weighted coefficients are compared with zbin << AOM_QM_BITS, or
+    // with dequant << (AOM_QM_BITS - 2) by the _fp quantizer.
+    const int zbin_i = log_scale ? ROUND_POWER_OF_TWO(zbin_ptr[i], 1)
+                                 : zbin_ptr[i];
+    const int thresh = is_fp ? dequant_ptr[i] * (1 << (AOM_QM_BITS - 2))
+                             : zbin_i * (1 << AOM_QM_BITS);
+    zbin[i] = qm_set1(thresh - 1);
+    round[i] = qm_set1(log_scale ? ROUND_POWER_OF_TWO(round_ptr[i], 1)
+                                 : round_ptr[i]);
+    quant[i] = qm_set1(quant_ptr[i]);
+    quant_shift[i] = qm_set1(quant_shift_ptr[i]);
+    dequant[i] = qm_set1(dequant_ptr[i]);
+  }
+  // The first vector holds the DC coefficient in its first lane.
+  zbin[0] = qm_set_dc(zbin[0], zbin[1]);
+  round[0] = qm_set_dc(round[0], round[1]);
+  quant[0] = qm_set_dc(quant[0], quant[1]);
+  quant_shift[0] = qm_set_dc(quant_shift[0], quant_shift[1]);
+  dequant[0] = qm_set_dc(dequant[0], dequant[1]);
+
+  for (i = 0; i < n_coeffs; i += QM_LANES) {
+    const int k = i != 0;
+    const qm_vec coeff = qm_load_coeff(coeff_ptr + i);
+    const qm_vec sign = qm_srai(coeff, 31);
+    const qm_vec abs_coeff = qm_abs(coeff);
+    const qm_vec wt = qm_load_u16(qm_ptr + i);
+    const qm_vec iwt = qm_load_u16(iqm_ptr + i);
+    qm_vec tmp = qm_add(abs_coeff, round[k]);
+    qm_vec abs_q, q, dq, dqv;
+
+    if (!is_highbd) tmp = qm_clamp_s16(tmp);
+    tmp = qm_mullo(tmp, wt);
+    if (!is_fp) {
+      tmp = qm_add(qm_mul_shift(tmp, quant[k], 16), tmp);
+      abs_q = qm_mul_shift(tmp, quant_shift[k], shift);
+    } else if (!is_highbd && log_scale) {
+      // av1_quantize_fp_32x32_c() truncates the product to 32 bits before
+      // shifting it.
+      abs_q = qm_srai(qm_mullo(tmp, quant[k]), shift);
+    } else {
+      abs_q = qm_mul_shift(tmp, quant[k], shift);
+    }
+    if (has_zbin)
+      abs_q = qm_and(abs_q, qm_cmpgt(qm_mullo(abs_coeff, wt), zbin[k]));
+
+    q = qm_sign_apply(abs_q, sign);
+#if !CONFIG_AOM_HIGHBITDEPTH
+    // The dequantized value is computed from the stored 16-bit qcoeff.
+    q = qm_srai(qm_slli(q, 16), 16);
+#endif
+    dqv = qm_srai(qm_add(qm_mullo(dequant[k], iwt), iqm_round), AOM_QM_BITS);
+    dq = qm_mullo(q, dqv);
+    // Divides by 2, rounding towards zero.
+    if (log_scale) dq = qm_srai(qm_add(dq, qm_srli(dq, 31)), 1);
+    qm_store_coeff(qcoeff_ptr + i, q);
+    qm_store_coeff(dqcoeff_ptr + i, dq);
+
+    // Keeps iscan + 1 of the nonzero coefficients.
+    eob = qm_max(eob, qm_andnot(qm_cmpeq(abs_q, qm_set1(0)),
+                                qm_sub(qm_load_s16(iscan + i), qm_set1(-1))));
+  }
+  *eob_ptr = (uint16_t)qm_hmax(eob);
+}
+
+#endif  // AOM_DSP_X86_QUANTIZE_QM_IMPL_H_
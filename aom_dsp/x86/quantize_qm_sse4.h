@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AOM_DSP_X86_QUANTIZE_QM_SSE4_H_
+#define AOM_DSP_X86_QUANTIZE_QM_SSE4_H_
+
+#include <smmintrin.h>  // SSE4.1
+
+#include "./aom_config.h"
+#include "aom_dsp/aom_dsp_common.h"
+
+#define QM_LANES 4
+typedef __m128i qm_vec;
+
+static INLINE __m128i qm_add(__m128i a, __m128i b) {
+  return _mm_add_epi32(a, b);
+}
+
+static INLINE __m128i qm_sub(__m128i a, __m128i b) {
+  return _mm_sub_epi32(a, b);
+}
+
+static INLINE __m128i qm_mullo(__m128i a, __m128i b) {
+  return _mm_mullo_epi32(a, b);
+}
+
+static INLINE __m128i qm_max(__m128i a, __m128i b) {
+  return _mm_max_epi32(a, b);
+}
+
+static INLINE __m128i qm_abs(__m128i a) { return _mm_abs_epi32(a); }
+
+static INLINE __m128i qm_and(__m128i a, __m128i b) {
+  return _mm_and_si128(a, b);
+}
+
+static INLINE __m128i qm_andnot(__m128i a, __m128i b) {
+  return _mm_andnot_si128(a, b);
+}
+
+static INLINE __m128i qm_xor(__m128i a, __m128i b) {
+  return _mm_xor_si128(a, b);
+}
+
+static INLINE __m128i qm_cmpeq(__m128i a, __m128i b) {
+  return _mm_cmpeq_epi32(a, b);
+}
+
+static INLINE __m128i qm_cmpgt(__m128i a, __m128i b) {
+  return _mm_cmpgt_epi32(a, b);
+}
+
+static INLINE __m128i qm_slli(__m128i a, int bits) {
+  return _mm_slli_epi32(a, bits);
+}
+
+static INLINE __m128i qm_srli(__m128i a, int bits) {
+  return _mm_srli_epi32(a, bits);
+}
+
+static INLINE __m128i qm_srai(__m128i a, int bits) {
+  return _mm_srai_epi32(a, bits);
+}
+
+static INLINE __m128i qm_set1(int a) { return _mm_set1_epi32(a); }
+
+static INLINE __m128i qm_set_dc(__m128i dc, __m128i ac) {
+  return _mm_blend_epi16(ac, dc, 0x03);
+}
+
+static INLINE __m128i qm_clamp_s16(__m128i a) {
+  return _mm_max_epi32(_mm_min_epi32(a, _mm_set1_epi32(INT16_MAX)),
+                       _mm_set1_epi32(INT16_MIN));
+}
+
+// Returns the low 32 bits of (a * b) >> bits, with 0 < bits <= 32.
+static INLINE __m128i qm_mul_shift(__m128i a, __m128i b, int bits) {
+  // Only the low 32 bits of the shifted products are kept, so a logical shift
+  // is as good as an arithmetic one.
+  const __m128i even = _mm_srli_epi64(_mm_mul_epi32(a, b), bits);
+  const __m128i odd = _mm_slli_epi64(
+      _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), 32 - bits);
+  return _mm_blend_epi16(even, odd, 0xcc);
+}
+
+static INLINE int qm_hmax(__m128i a) {
+  a = _mm_max_epi32(a, _mm_shuffle_epi32(a, 0x4e));
+  a = _mm_max_epi32(a, _mm_shuffle_epi32(a, 0xb1));
+  return _mm_cvtsi128_si32(a);
+}
+
+static INLINE __m128i qm_load_u16(const uint16_t *src) {
+  return _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE __m128i qm_load_s16(const int16_t *src) {
+  return _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE __m128i qm_load_coeff(const tran_low_t *src) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  return _mm_loadu_si128((const __m128i *)src);
+#else
+  return qm_load_s16(src);
+#endif
+}
+
+static INLINE void qm_store_coeff(tran_low_t *dst, __m128i a) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  _mm_storeu_si128((__m128i *)dst, a);
+#else
+  // Keeps the low 16 bits as a conversion to tran_low_t would.
+  a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+  _mm_storel_epi64((__m128i *)dst, _mm_packs_epi32(a, a));
+#endif
+}
+
+#include "aom_dsp/x86/quantize_qm_impl.h"
+
+#endif  // AOM_DSP_X86_QUANTIZE_QM_SSE4_H_
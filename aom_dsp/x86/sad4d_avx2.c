@@ -163,3 +163,121 @@ void aom_sad64x64x4d_avx2(const uint8_t *src, int src_stride,
     _mm_storeu_si128((__m128i *)(res), sum);
   }
 }
+
+// Reduces the 4 accumulators of _mm256_sad_epu8 results to the 4 SADs.
+static INLINE void store_sad4(__m256i sum_ref0, __m256i sum_ref1,
+                              __m256i sum_ref2, __m256i sum_ref3,
+                              uint32_t res[4]) {
+  __m256i sum_mlow, sum_mhigh;
+  __m128i sum;
+
+  sum_ref1 = _mm256_slli_si256(sum_ref1, 4);
+  sum_ref3 = _mm256_slli_si256(sum_ref3, 4);
+  sum_ref0 = _mm256_or_si256(sum_ref0, sum_ref1);
+  sum_ref2 = _mm256_or_si256(sum_ref2, sum_ref3);
+  sum_mlow = _mm256_unpacklo_epi64(sum_ref0, sum_ref2);
+  sum_mhigh = _mm256_unpackhi_epi64(sum_ref0, sum_ref2);
+  sum_mlow = _mm256_add_epi32(sum_mlow, sum_mhigh);
+  sum = _mm_add_epi32(_mm256_castsi256_si128(sum_mlow),
+                      _mm256_extractf128_si256(sum_mlow, 1));
+  _mm_storeu_si128((__m128i *)(res), sum);
+}
+
+// Blocks whose width is a multiple of 32.
+static INLINE void sad32n_x4d(const uint8_t *src, int src_stride,
+                              const uint8_t *const ref[4], int ref_stride,
+                              int width, int height, uint32_t res[4]) {
+  __m256i sum_ref0 = _mm256_setzero_si256();
+  __m256i sum_ref1 = _mm256_setzero_si256();
+  __m256i sum_ref2 = _mm256_setzero_si256();
+  __m256i sum_ref3 = _mm256_setzero_si256();
+  int i, j, offset = 0;
+
+  for (i = 0; i < height; i++) {
+    for (j = 0; j < width; j += 32) {
+      const __m256i src_reg = _mm256_loadu_si256((const __m256i *)(src + j));
+      const int k = offset + j;
+      sum_ref0 = _mm256_add_epi32(
+          sum_ref0, _mm256_sad_epu8(
+                        _mm256_loadu_si256((const __m256i *)(ref[0] + k)),
+                        src_reg));
+      sum_ref1 = _mm256_add_epi32(
+          sum_ref1, _mm256_sad_epu8(
+                        _mm256_loadu_si256((const __m256i *)(ref[1] + k)),
+                        src_reg));
+      sum_ref2 = _mm256_add_epi32(
+          sum_ref2, _mm256_sad_epu8(
+                        _mm256_loadu_si256((const __m256i *)(ref[2] + k)),
+                        src_reg));
+      sum_ref3 = _mm256_add_epi32(
+          sum_ref3, _mm256_sad_epu8(
+                        _mm256_loadu_si256((const __m256i *)(ref[3] + k)),
+                        src_reg));
+    }
+    src += src_stride;
+    offset += ref_stride;
+  }
+  store_sad4(sum_ref0, sum_ref1, sum_ref2, sum_ref3, res);
+}
+
+static INLINE __m256i load_16x2(const uint8_t *p, int stride) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+      _mm_loadu_si128((const __m128i *)(p + stride)), 1);
+}
+
+// 16 wide blocks, two rows at a time.
+static INLINE void sad16_x4d(const uint8_t *src, int src_stride,
+                             const uint8_t *const ref[4], int ref_stride,
+                             int height, uint32_t res[4]) {
+  __m256i sum_ref0 = _mm256_setzero_si256();
+  __m256i sum_ref1 = _mm256_setzero_si256();
+  __m256i sum_ref2 = _mm256_setzero_si256();
+  __m256i sum_ref3 = _mm256_setzero_si256();
+  int i, offset = 0;
+
+  for (i = 0; i < height; i += 2) {
+    const __m256i src_reg = load_16x2(src, src_stride);
+    sum_ref0 = _mm256_add_epi32(
+        sum_ref0,
+        _mm256_sad_epu8(load_16x2(ref[0] + offset, ref_stride), src_reg));
+    sum_ref1 = _mm256_add_epi32(
+        sum_ref1,
+        _mm256_sad_epu8(load_16x2(ref[1] + offset, ref_stride), src_reg));
+    sum_ref2 = _mm256_add_epi32(
+        sum_ref2,
+        _mm256_sad_epu8(load_16x2(ref[2] + offset, ref_stride), src_reg));
+    sum_ref3 = _mm256_add_epi32(
+        sum_ref3,
+        _mm256_sad_epu8(load_16x2(ref[3] + offset, ref_stride), src_reg));
+    src += 2 * src_stride;
+    offset += 2 * ref_stride;
+  }
+  store_sad4(sum_ref0, sum_ref1, sum_ref2, sum_ref3, res);
+}
+
+#define SAD32N_X4D(w, h)                                              \
+  void aom_sad##w##x##h##x4d_avx2(const uint8_t *src, int src_stride, \
+                                  const uint8_t *const ref[4],        \
+                                  int ref_stride, uint32_t res[4]) {  \
+    sad32n_x4d(src, src_stride, ref, ref_stride, w, h, res);          \
+  }
+
+#define SAD16_X4D(h)                                                        \
+  void aom_sad16x##h##x4d_avx2(const uint8_t *src, int src_stride,          \
+                               const uint8_t *const ref[4], int ref_stride, \
+                               uint32_t res[4]) {                           \
+    sad16_x4d(src, src_stride, ref, ref_stride, h, res);                    \
+  }
+
+/* clang-format off */
+SAD32N_X4D(64, 32)
+SAD32N_X4D(32, 64)
+SAD32N_X4D(32, 16)
+SAD16_X4D(32)
+SAD16_X4D(16)
+SAD16_X4D(8)
+/* clang-format on */
+
+#undef SAD32N_X4D
+#undef SAD16_X4D
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "aom/aom_integer.h"
+#include "aom_ports/mem.h"
+
+// SADs of a block against the 8 reference blocks starting at ref, ref + 1,
+// ..., ref + 7, using _mm256_mpsadbw_epu8. Each 128-bit lane of mpsadbw
+// compares one 4 pixel group of the source with 8 consecutive 4 pixel groups
+// of the reference, so every source pixel is used once per row for all 8
+// positions.
+
+static INLINE __m256i load_2x128(const uint8_t *lo, const uint8_t *hi) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)lo)),
+      _mm_loadu_si128((const __m128i *)hi), 1);
+}
+
+// 16 pixels of one row. The low lane compares source pixels 0-3 and 4-7 with
+// ref, the high lane pixels 8-11 and 12-15 with ref + 8.
+static INLINE __m256i sad16_x8(const uint8_t *src, const uint8_t *ref) {
+  const __m256i s = load_2x128(src, src);
+  const __m256i r = load_2x128(ref, ref + 8);
+  return _mm256_add_epi16(_mm256_mpsadbw_epu8(r, s, 0x10),
+                          _mm256_mpsadbw_epu8(r, s, 0x3D));
+}
+
+// Widens the 16-bit sums of both lanes and adds them to sum_lo (positions
+// 0-3) and sum_hi (positions 4-7).
+static INLINE void accumulate_x8(__m256i acc, __m128i *sum_lo,
+                                 __m128i *sum_hi) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i lo = _mm256_unpacklo_epi16(acc, zero);
+  const __m256i hi = _mm256_unpackhi_epi16(acc, zero);
+  *sum_lo = _mm_add_epi32(*sum_lo, _mm256_castsi256_si128(lo));
+  *sum_lo = _mm_add_epi32(*sum_lo, _mm256_extracti128_si256(lo, 1));
+  *sum_hi = _mm_add_epi32(*sum_hi, _mm256_castsi256_si128(hi));
+  *sum_hi = _mm_add_epi32(*sum_hi, _mm256_extracti128_si256(hi, 1));
+}
+
+// Blocks whose width is a multiple of 16. The 16-bit sums are widened every
+// 8 rows: 8 rows of 4 pairs of 1020 at most stay below 65536 per lane.
+static INLINE void sad16n_x8(const uint8_t *src, int src_stride,
+                             const uint8_t *ref, int ref_stride, int width,
+                             int height, uint32_t *sad_array) {
+  __m128i sum_lo = _mm_setzero_si128();
+  __m128i sum_hi = _mm_setzero_si128();
+  int i, j, k;
+
+  for (i = 0; i < height; i += 8) {
+    __m256i acc = _mm256_setzero_si256();
+    for (k = 0; k < 8; ++k) {
+      for (j = 0; j < width; j += 16)
+        acc = _mm256_add_epi16(acc, sad16_x8(src + j, ref + j));
+      src += src_stride;
+      ref += ref_stride;
+    }
+    accumulate_x8(acc, &sum_lo, &sum_hi);
+  }
+  _mm_storeu_si128((__m128i *)sad_array, sum_lo);
+  _mm_storeu_si128((__m128i *)(sad_array + 4), sum_hi);
+}
+
+// 8 and 4 wide blocks, two rows at a time: the low lane holds the even row
+// and the high lane the odd one.
+static INLINE void sad8_4_x8(const uint8_t *src, int src_stride,
+                             const uint8_t *ref, int ref_stride, int width,
+                             int height, uint32_t *sad_array) {
+  __m128i sum_lo = _mm_setzero_si128();
+  __m128i sum_hi = _mm_setzero_si128();
+  __m256i acc = _mm256_setzero_si256();
+  int i;
+
+  for (i = 0; i < height; i += 2) {
+    const __m256i r = load_2x128(ref, ref + ref_stride);
+    __m256i s;
+    if (width == 8) {
+      s = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)src)),
+          _mm_loadl_epi64((const __m128i *)(src + src_stride)), 1);
+      acc = _mm256_add_epi16(acc, _mm256_mpsadbw_epu8(r, s, 0x00));
+      acc = _mm256_add_epi16(acc, _mm256_mpsadbw_epu8(r, s, 0x2D));
+    } else {
+      s = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_cvtsi32_si128(*(const int *)src)),
+          _mm_cvtsi32_si128(*(const int *)(src + src_stride)), 1);
+      acc = _mm256_add_epi16(acc, _mm256_mpsadbw_epu8(r, s, 0x00));
+    }
+    src += 2 * src_stride;
+    ref += 2 * ref_stride;
+  }
+  accumulate_x8(acc, &sum_lo, &sum_hi);
+  _mm_storeu_si128((__m128i *)sad_array, sum_lo);
+  _mm_storeu_si128((__m128i *)(sad_array + 4), sum_hi);
+}
+
+#define SAD16N_X8(w, h)                                              \
+  void aom_sad##w##x##h##x8_avx2(const uint8_t *src, int src_stride, \
+                                 const uint8_t *ref, int ref_stride, \
+                                 uint32_t *sad_array) {              \
+    sad16n_x8(src, src_stride, ref, ref_stride, w, h, sad_array);    \
+  }
+
+#define SAD8_4_X8(w, h)                                              \
+  void aom_sad##w##x##h##x8_avx2(const uint8_t *src, int src_stride, \
+                                 const uint8_t *ref, int ref_stride, \
+                                 uint32_t *sad_array) {              \
+    sad8_4_x8(src, src_stride, ref, ref_stride, w, h, sad_array);    \
+  }
+
+/* clang-format off */
+SAD16N_X8(64, 64)
+SAD16N_X8(64, 32)
+SAD16N_X8(32, 64)
+SAD16N_X8(32, 32)
+SAD16N_X8(32, 16)
+SAD16N_X8(16, 32)
+SAD16N_X8(16, 16)
+SAD16N_X8(16, 8)
+SAD8_4_X8(8, 16)
+SAD8_4_X8(8, 8)
+SAD8_4_X8(8, 4)
+SAD8_4_X8(4, 8)
+SAD8_4_X8(4, 4)
+/* clang-format on */
+
+#undef SAD16N_X8
+#undef SAD8_4_X8
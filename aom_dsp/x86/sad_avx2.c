@@ -72,6 +72,37 @@
     return res;                                                               \
   }
 
+#define FSAD16_H(h)                                                           \
+  unsigned int aom_sad16x##h##_avx2(const uint8_t *src_ptr, int src_stride,   \
+                                    const uint8_t *ref_ptr, int ref_stride) { \
+    int i, res;                                                               \
+    __m256i sad_reg, ref_reg, src_reg;                                        \
+    __m256i sum_sad = _mm256_setzero_si256();                                 \
+    __m256i sum_sad_h;                                                        \
+    __m128i sum_sad128;                                                       \
+    int ref2_stride = ref_stride << 1;                                        \
+    int src2_stride = src_stride << 1;                                        \
+    int max = h >> 1;                                                         \
+    for (i = 0; i < max; i++) {                                               \
+      ref_reg = _mm256_inserti128_si256(                                      \
+          _mm256_castsi128_si256(_mm_loadu_si128((__m128i const *)ref_ptr)),  \
+          _mm_loadu_si128((__m128i const *)(ref_ptr + ref_stride)), 1);       \
+      src_reg = _mm256_inserti128_si256(                                      \
+          _mm256_castsi128_si256(_mm_loadu_si128((__m128i const *)src_ptr)),  \
+          _mm_loadu_si128((__m128i const *)(src_ptr + src_stride)), 1);       \
+      sad_reg = _mm256_sad_epu8(ref_reg, src_reg);                            \
+      sum_sad = _mm256_add_epi32(sum_sad, sad_reg);                           \
+      ref_ptr += ref2_stride;                                                 \
+      src_ptr += src2_stride;                                                 \
+    }                                                                         \
+    sum_sad_h = _mm256_srli_si256(sum_sad, 8);                                \
+    sum_sad = _mm256_add_epi32(sum_sad, sum_sad_h);                           \
+    sum_sad128 = _mm256_extracti128_si256(sum_sad, 1);                        \
+    sum_sad128 = _mm_add_epi32(_mm256_castsi256_si128(sum_sad), sum_sad128);  \
+    res = _mm_cvtsi128_si32(sum_sad128);                                      \
+    return res;                                                               \
+  }
+
 #define FSAD64  \
   FSAD64_H(64); \
   FSAD64_H(32);
@@ -81,15 +112,23 @@
   FSAD32_H(32); \
   FSAD32_H(16);
 
+#define FSAD16  \
+  FSAD16_H(32); \
+  FSAD16_H(16); \
+  FSAD16_H(8);
+
 /* clang-format off */
 FSAD64
 FSAD32
+FSAD16
 /* clang-format on */
 
 #undef FSAD64
 #undef FSAD32
+#undef FSAD16
 #undef FSAD64_H
 #undef FSAD32_H
+#undef FSAD16_H
 
 #define FSADAVG64_H(h)                                                        \
   unsigned int aom_sad64x##h##_avg_avx2(                                      \
@@ -109,4 +109,38 @@ static INLINE int64_t xx_hsum_epi32_si64(__m128i v_d) {
 }
 #endif  // __SSSE3__
 
+#ifdef __AVX2__
+static INLINE __m256i yy_loadu_256(const void *a) {
+  return _mm256_loadu_si256((const __m256i *)a);
+}
+
+static INLINE void yy_storeu_256(void *const a, const __m256i v) {
+  _mm256_storeu_si256((__m256i *)a, v);
+}
+
+static INLINE __m256i yy_roundn_epu32(__m256i v_val_d, int bits) {
+  const __m256i v_bias_d = _mm256_set1_epi32(1 << (bits - 1));
+  const __m256i v_tmp_d = _mm256_add_epi32(v_val_d, v_bias_d);
+  return _mm256_srli_epi32(v_tmp_d, bits);
+}
+
+static INLINE __m256i yy_roundn_epi32(__m256i v_val_d, int bits) {
+  const __m256i v_bias_d = _mm256_set1_epi32(1 << (bits - 1));
+  const __m256i v_sign_d = _mm256_srai_epi32(v_val_d, 31);
+  const __m256i v_tmp_d =
+      _mm256_add_epi32(_mm256_add_epi32(v_val_d, v_bias_d), v_sign_d);
+  return _mm256_srai_epi32(v_tmp_d, bits);
+}
+
+static INLINE int32_t yy_hsum_epi32_si32(__m256i v_d) {
+  return xx_hsum_epi32_si32(_mm_add_epi32(_mm256_castsi256_si128(v_d),
+                                          _mm256_extracti128_si256(v_d, 1)));
+}
+
+static INLINE int64_t yy_hsum_epi64_si64(__m256i v_q) {
+  return xx_hsum_epi64_si64(_mm_add_epi64(_mm256_castsi256_si128(v_q),
+                                          _mm256_extracti128_si256(v_q, 1)));
+}
+#endif  // __AVX2__
+
 #endif  // AOM_DSP_X86_SYNONYMS_H_
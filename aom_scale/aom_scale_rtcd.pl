@@ -1,5 +1,7 @@
 sub aom_scale_forward_decls() {
 print <<EOF
+#include "aom/aom_integer.h"
+
 struct yv12_buffer_config;
 EOF
 }
@@ -16,6 +18,14 @@ if (aom_config("CONFIG_SPATIAL_RESAMPLING") eq "yes") {
     add_proto qw/void aom_vertical_band_2_1_scale_i/, "unsigned char *source, unsigned int src_pitch, unsigned char *dest, unsigned int dest_pitch, unsigned int dest_width";
 }
 
+add_proto qw/void aom_extend_plane_lr/, "uint8_t *src, int src_stride, int width, int height, int extend_left, int extend_right";
+specialize qw/aom_extend_plane_lr avx2/;
+
+if (aom_config("CONFIG_AOM_HIGHBITDEPTH") eq "yes") {
+    add_proto qw/void aom_highbd_extend_plane_lr/, "uint16_t *src, int src_stride, int width, int height, int extend_left, int extend_right";
+    specialize qw/aom_highbd_extend_plane_lr avx2/;
+}
+
 add_proto qw/void aom_yv12_extend_frame_borders/, "struct yv12_buffer_config *ybf";
 
 add_proto qw/void aom_yv12_copy_frame/, "const struct yv12_buffer_config *src_ybc, struct yv12_buffer_config *dst_ybc";
@@ -31,5 +41,7 @@ if (aom_config("CONFIG_AV1") eq "yes") {
 
     add_proto qw/void aom_extend_frame_borders_y/, "struct yv12_buffer_config *ybf";
     specialize qw/aom_extend_frame_borders_y/;
+
+    add_proto qw/void aom_extend_frame_borders_plane_rows/, "struct yv12_buffer_config *ybf, int plane, int ext_size, int start_row, int end_row";
 }
 1;
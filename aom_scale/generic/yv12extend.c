@@ -14,32 +14,40 @@
 #include "./aom_scale_rtcd.h"
 #include "aom/aom_integer.h"
 #include "aom_mem/aom_mem.h"
+#include "aom_dsp/aom_dsp_common.h"
 #include "aom_ports/mem.h"
 #include "aom_scale/yv12config.h"
 #if CONFIG_AOM_HIGHBITDEPTH
 #include "av1/common/common.h"
 #endif
 
-static void extend_plane(uint8_t *const src, int src_stride, int width,
-                         int height, int extend_top, int extend_left,
-                         int extend_bottom, int extend_right) {
+void aom_extend_plane_lr_c(uint8_t *src, int src_stride, int width, int height,
+                           int extend_left, int extend_right) {
   int i;
-  const int linesize = extend_left + extend_right + width;
-
-  /* copy the left and right most columns out */
-  uint8_t *src_ptr1 = src;
-  uint8_t *src_ptr2 = src + width - 1;
-  uint8_t *dst_ptr1 = src - extend_left;
-  uint8_t *dst_ptr2 = src + width;
 
   for (i = 0; i < height; ++i) {
-    memset(dst_ptr1, src_ptr1[0], extend_left);
-    memset(dst_ptr2, src_ptr2[0], extend_right);
-    src_ptr1 += src_stride;
-    src_ptr2 += src_stride;
-    dst_ptr1 += src_stride;
-    dst_ptr2 += src_stride;
+    memset(src - extend_left, src[0], extend_left);
+    memset(src + width, src[width - 1], extend_right);
+    src += src_stride;
   }
+}
+
+// Extends the left and right borders of the rows [start_row, end_row) of the
+// plane, then the top border when the range covers the first row and the
+// bottom border when it covers the last one.
+static void extend_plane_rows(uint8_t *const src, int src_stride, int width,
+                              int height, int extend_top, int extend_left,
+                              int extend_bottom, int extend_right,
+                              int start_row, int end_row) {
+  int i;
+  const int linesize = extend_left + extend_right + width;
+  uint8_t *src_ptr1, *src_ptr2, *dst_ptr1, *dst_ptr2;
+
+  if (end_row <= start_row) return;
+
+  /* copy the left and right most columns out */
+  aom_extend_plane_lr(src + start_row * src_stride, src_stride, width,
+                      end_row - start_row, extend_left, extend_right);
 
   /* Now copy the top and bottom lines into each line of the respective
    * borders
@@ -49,39 +57,56 @@ static void extend_plane(uint8_t *const src, int src_stride, int width,
   dst_ptr1 = src + src_stride * -extend_top - extend_left;
   dst_ptr2 = src + src_stride * height - extend_left;
 
-  for (i = 0; i < extend_top; ++i) {
-    memcpy(dst_ptr1, src_ptr1, linesize);
-    dst_ptr1 += src_stride;
+  if (start_row == 0) {
+    for (i = 0; i < extend_top; ++i) {
+      memcpy(dst_ptr1, src_ptr1, linesize);
+      dst_ptr1 += src_stride;
+    }
   }
 
-  for (i = 0; i < extend_bottom; ++i) {
-    memcpy(dst_ptr2, src_ptr2, linesize);
-    dst_ptr2 += src_stride;
+  if (end_row == height) {
+    for (i = 0; i < extend_bottom; ++i) {
+      memcpy(dst_ptr2, src_ptr2, linesize);
+      dst_ptr2 += src_stride;
+    }
   }
 }
 
+static void extend_plane(uint8_t *const src, int src_stride, int width,
+                         int height, int extend_top, int extend_left,
+                         int extend_bottom, int extend_right) {
+  extend_plane_rows(src, src_stride, width, height, extend_top, extend_left,
+                    extend_bottom, extend_right, 0, height);
+}
+
 #if CONFIG_AOM_HIGHBITDEPTH
-static void extend_plane_high(uint8_t *const src8, int src_stride, int width,
-                              int height, int extend_top, int extend_left,
-                              int extend_bottom, int extend_right) {
+void aom_highbd_extend_plane_lr_c(uint16_t *src, int src_stride, int width,
+                                  int height, int extend_left,
+                                  int extend_right) {
+  int i;
+
+  for (i = 0; i < height; ++i) {
+    aom_memset16(src - extend_left, src[0], extend_left);
+    aom_memset16(src + width, src[width - 1], extend_right);
+    src += src_stride;
+  }
+}
+
+static void extend_plane_rows_high(uint8_t *const src8, int src_stride,
+                                   int width, int height, int extend_top,
+                                   int extend_left, int extend_bottom,
+                                   int extend_right, int start_row,
+                                   int end_row) {
   int i;
   const int linesize = extend_left + extend_right + width;
   uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  uint16_t *src_ptr1, *src_ptr2, *dst_ptr1, *dst_ptr2;
 
-  /* copy the left and right most columns out */
-  uint16_t *src_ptr1 = src;
-  uint16_t *src_ptr2 = src + width - 1;
-  uint16_t *dst_ptr1 = src - extend_left;
-  uint16_t *dst_ptr2 = src + width;
+  if (end_row <= start_row) return;
 
-  for (i = 0; i < height; ++i) {
-    aom_memset16(dst_ptr1, src_ptr1[0], extend_left);
-    aom_memset16(dst_ptr2, src_ptr2[0], extend_right);
-    src_ptr1 += src_stride;
-    src_ptr2 += src_stride;
-    dst_ptr1 += src_stride;
-    dst_ptr2 += src_stride;
-  }
+  /* copy the left and right most columns out */
+  aom_highbd_extend_plane_lr(src + start_row * src_stride, src_stride, width,
+                             end_row - start_row, extend_left, extend_right);
 
   /* Now copy the top and bottom lines into each line of the respective
    * borders
@@ -91,16 +116,27 @@ static void extend_plane_high(uint8_t *const src8, int src_stride, int width,
   dst_ptr1 = src + src_stride * -extend_top - extend_left;
   dst_ptr2 = src + src_stride * height - extend_left;
 
-  for (i = 0; i < extend_top; ++i) {
-    memcpy(dst_ptr1, src_ptr1, linesize * sizeof(uint16_t));
-    dst_ptr1 += src_stride;
+  if (start_row == 0) {
+    for (i = 0; i < extend_top; ++i) {
+      memcpy(dst_ptr1, src_ptr1, linesize * sizeof(uint16_t));
+      dst_ptr1 += src_stride;
+    }
   }
 
-  for (i = 0; i < extend_bottom; ++i) {
-    memcpy(dst_ptr2, src_ptr2, linesize * sizeof(uint16_t));
-    dst_ptr2 += src_stride;
+  if (end_row == height) {
+    for (i = 0; i < extend_bottom; ++i) {
+      memcpy(dst_ptr2, src_ptr2, linesize * sizeof(uint16_t));
+      dst_ptr2 += src_stride;
+    }
   }
 }
+
+static void extend_plane_high(uint8_t *const src8, int src_stride, int width,
+                              int height, int extend_top, int extend_left,
+                              int extend_bottom, int extend_right) {
+  extend_plane_rows_high(src8, src_stride, width, height, extend_top,
+                         extend_left, extend_bottom, extend_right, 0, height);
+}
 #endif
 
 void aom_yv12_extend_frame_borders_c(YV12_BUFFER_CONFIG *ybf) {
@@ -197,6 +233,39 @@ void aom_extend_frame_inner_borders_c(YV12_BUFFER_CONFIG *ybf) {
   extend_frame(ybf, inner_bw);
 }
 
+void aom_extend_frame_borders_plane_rows_c(YV12_BUFFER_CONFIG *ybf, int plane,
+                                           int ext_size, int start_row,
+                                           int end_row) {
+  const int ss_x = plane ? ybf->uv_width < ybf->y_width : 0;
+  const int ss_y = plane ? ybf->uv_height < ybf->y_height : 0;
+  const int width = plane ? ybf->uv_crop_width : ybf->y_crop_width;
+  const int height = plane ? ybf->uv_crop_height : ybf->y_crop_height;
+  const int stride = plane ? ybf->uv_stride : ybf->y_stride;
+  const int ext_top = ext_size >> ss_y;
+  const int ext_left = ext_size >> ss_x;
+  const int ext_bottom =
+      ext_top + (plane ? ybf->uv_height : ybf->y_height) - height;
+  const int ext_right = ext_left + (plane ? ybf->uv_width : ybf->y_width) - width;
+  uint8_t *const buf =
+      plane == 0 ? ybf->y_buffer : plane == 1 ? ybf->u_buffer : ybf->v_buffer;
+
+  assert(plane >= 0 && plane < 3);
+  assert(ext_size <= ybf->border);
+
+  start_row = AOMMAX(start_row, 0);
+  end_row = AOMMIN(end_row, height);
+
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (ybf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    extend_plane_rows_high(buf, stride, width, height, ext_top, ext_left,
+                           ext_bottom, ext_right, start_row, end_row);
+    return;
+  }
+#endif
+  extend_plane_rows(buf, stride, width, height, ext_top, ext_left, ext_bottom,
+                    ext_right, start_row, end_row);
+}
+
 void aom_extend_frame_borders_y_c(YV12_BUFFER_CONFIG *ybf) {
   const int ext_size = ybf->border;
   assert(ybf->y_height - ybf->y_crop_height < 16);
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./aom_scale_rtcd.h"
+#include "aom/aom_integer.h"
+#include "aom_mem/aom_mem.h"
+
+// Sets n bytes at dst to val. The last store overlaps the previous one instead
+// of falling back to a scalar tail.
+static INLINE void fill_bytes_avx2(uint8_t *dst, uint8_t val, int n) {
+  const __m256i v = _mm256_set1_epi8((char)val);
+  int i;
+
+  if (n < 32) {
+    memset(dst, val, n);
+    return;
+  }
+
+  for (i = 0; i < n - 32; i += 32) _mm256_storeu_si256((__m256i *)(dst + i), v);
+  _mm256_storeu_si256((__m256i *)(dst + n - 32), v);
+}
+
+void aom_extend_plane_lr_avx2(uint8_t *src, int src_stride, int width,
+                              int height, int extend_left, int extend_right) {
+  int i;
+
+  for (i = 0; i < height; ++i) {
+    fill_bytes_avx2(src - extend_left, src[0], extend_left);
+    fill_bytes_avx2(src + width, src[width - 1], extend_right);
+    src += src_stride;
+  }
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+// Sets n 16-bit values at dst to val.
+static INLINE void fill_words_avx2(uint16_t *dst, uint16_t val, int n) {
+  const __m256i v = _mm256_set1_epi16((int16_t)val);
+  int i;
+
+  if (n < 16) {
+    aom_memset16(dst, val, n);
+    return;
+  }
+
+  for (i = 0; i < n - 16; i += 16) _mm256_storeu_si256((__m256i *)(dst + i), v);
+  _mm256_storeu_si256((__m256i *)(dst + n - 16), v);
+}
+
+void aom_highbd_extend_plane_lr_avx2(uint16_t *src, int src_stride, int width,
+                                     int height, int extend_left,
+                                     int extend_right) {
+  int i;
+
+  for (i = 0; i < height; ++i) {
+    fill_words_avx2(src - extend_left, src[0], extend_left);
+    fill_words_avx2(src + width, src[width - 1], extend_right);
+    src += src_stride;
+  }
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
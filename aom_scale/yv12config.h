@@ -30,6 +30,11 @@ extern "C" {
 // to improve the decoder performance.
 #define AOM_BORDER_IN_PIXELS 160
 
+// The decoder does not extend the borders of its reference frames; inter
+// prediction emulates the frame edge for blocks that reach outside of the
+// frame, so only a small border is allocated.
+#define AOM_DEC_BORDER_IN_PIXELS 32
+
 typedef struct yv12_buffer_config {
   int y_width;
   int y_height;
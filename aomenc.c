@@ -371,7 +371,7 @@ static const arg_def_t max_intra_rate_pct =
 
 #if CONFIG_AV1_ENCODER
 static const arg_def_t cpu_used_av1 =
-    ARG_DEF(NULL, "cpu-used", 1, "CPU Used (-8..8)");
+    ARG_DEF(NULL, "cpu-used", 1, "CPU Used (-9..9)");
 static const arg_def_t tile_cols =
     ARG_DEF(NULL, "tile-columns", 1, "Number of tile columns to use, log2");
 static const arg_def_t tile_rows =
@@ -433,6 +433,16 @@ static const struct arg_enum_list tune_content_enum[] = {
 
 static const arg_def_t tune_content = ARG_DEF_ENUM(
     NULL, "tune-content", 1, "Tune content type", tune_content_enum);
+
+static const arg_def_t ref_search_mt =
+    ARG_DEF(NULL, "ref-search-mt", 1,
+            "Search the reference frames of a block in parallel "
+            "(0: off (default), 1: on)");
+
+static const arg_def_t global_me =
+    ARG_DEF(NULL, "global-me", 1,
+            "Seed the motion search with the estimated camera motion "
+            "(0: off (default), 1: on)");
 #endif
 
 #if CONFIG_AV1_ENCODER
@@ -448,7 +458,8 @@ static const arg_def_t *av1_args[] = {
 #endif
   &frame_parallel_decoding, &aq_mode,          &frame_periodic_boost,
   &noise_sens,              &tune_content,     &input_color_space,
-  &min_gf_interval,         &max_gf_interval,  NULL
+  &min_gf_interval,         &max_gf_interval,  &ref_search_mt,
+  &global_me,               NULL
 };
 static const int av1_arg_ctrl_map[] = {
   AOME_SET_CPUUSED,                 AOME_SET_ENABLEAUTOALTREF,
@@ -467,6 +478,7 @@ static const int av1_arg_ctrl_map[] = {
   AV1E_SET_FRAME_PERIODIC_BOOST,    AV1E_SET_NOISE_SENSITIVITY,
   AV1E_SET_TUNE_CONTENT,            AV1E_SET_COLOR_SPACE,
   AV1E_SET_MIN_GF_INTERVAL,         AV1E_SET_MAX_GF_INTERVAL,
+  AV1E_SET_REF_SEARCH_MT,           AV1E_SET_GLOBAL_ME,
   0
 };
 /* clang-format on */
@@ -53,12 +53,22 @@ AV1_CX_SRCS-yes += encoder/tokenize.h
 AV1_CX_SRCS-yes += encoder/treewriter.h
 AV1_CX_SRCS-yes += encoder/mcomp.c
 AV1_CX_SRCS-yes += encoder/encoder.c
+AV1_CX_SRCS-yes += encoder/global_me.c
+AV1_CX_SRCS-yes += encoder/global_me.h
+AV1_CX_SRCS-yes += encoder/motion_field.c
+AV1_CX_SRCS-yes += encoder/motion_field.h
 ifeq ($(CONFIG_PALETTE),yes)
 AV1_CX_SRCS-yes += encoder/palette.h
 AV1_CX_SRCS-yes += encoder/palette.c
 endif
+AV1_CX_SRCS-yes += encoder/partition_model.c
+AV1_CX_SRCS-yes += encoder/partition_model.h
 AV1_CX_SRCS-yes += encoder/picklpf.c
 AV1_CX_SRCS-yes += encoder/picklpf.h
+AV1_CX_SRCS-yes += encoder/pickmode.c
+AV1_CX_SRCS-yes += encoder/pickmode.h
+AV1_CX_SRCS-yes += encoder/pyramid.c
+AV1_CX_SRCS-yes += encoder/pyramid.h
 AV1_CX_SRCS-yes += encoder/quantize.c
 AV1_CX_SRCS-yes += encoder/ratectrl.c
 AV1_CX_SRCS-yes += encoder/rd.c
@@ -98,8 +108,15 @@ endif
 
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/temporal_filter_apply_sse2.asm
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/quantize_sse2.c
+ifeq ($(CONFIG_AOM_QM),yes)
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/quantize_qm_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/quantize_qm_avx2.c
+endif
 ifeq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/highbd_block_error_intrin_sse2.c
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/highbd_dct_intrin_impl.h
+AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/highbd_dct_intrin_sse4.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/highbd_dct_intrin_avx2.c
 endif
 
 ifeq ($(CONFIG_USE_X86INC),yes)
@@ -116,6 +133,7 @@ endif
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/dct_intrin_sse2.c
 AV1_CX_SRCS-$(HAVE_SSSE3) += encoder/x86/dct_ssse3.c
 
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/dct_intrin_avx2.c
 AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/error_intrin_avx2.c
 
 ifneq ($(CONFIG_AOM_HIGHBITDEPTH),yes)
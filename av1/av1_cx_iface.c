@@ -54,6 +54,8 @@ struct av1_extracfg {
   int color_range;
   int render_width;
   int render_height;
+  unsigned int ref_search_mt;
+  unsigned int global_me;
 };
 
 static struct av1_extracfg default_extra_cfg = {
@@ -88,6 +90,8 @@ static struct av1_extracfg default_extra_cfg = {
   0,                    // color range
   0,                    // render width
   0,                    // render height
+  0,                    // ref_search_mt
+  0,                    // global_me
 };
 
 struct aom_codec_alg_priv {
@@ -177,6 +181,8 @@ static aom_codec_err_t validate_config(aom_codec_alg_priv_t *ctx,
   RANGE_CHECK_BOOL(extra_cfg, lossless);
   RANGE_CHECK(extra_cfg, aq_mode, 0, AQ_MODE_COUNT - 1);
   RANGE_CHECK(extra_cfg, frame_periodic_boost, 0, 1);
+  RANGE_CHECK_BOOL(extra_cfg, ref_search_mt);
+  RANGE_CHECK_BOOL(extra_cfg, global_me);
   RANGE_CHECK_HI(cfg, g_threads, 64);
   RANGE_CHECK_HI(cfg, g_lag_in_frames, MAX_LAG_BUFFERS);
   RANGE_CHECK(cfg, rc_end_usage, AOM_VBR, AOM_Q);
@@ -213,7 +219,7 @@ static aom_codec_err_t validate_config(aom_codec_alg_priv_t *ctx,
         "or kf_max_dist instead.");
 
   RANGE_CHECK(extra_cfg, enable_auto_alt_ref, 0, 2);
-  RANGE_CHECK(extra_cfg, cpu_used, -8, 8);
+  RANGE_CHECK(extra_cfg, cpu_used, -9, 9);
   RANGE_CHECK_HI(extra_cfg, noise_sensitivity, 6);
   RANGE_CHECK(extra_cfg, tile_columns, 0, 6);
   RANGE_CHECK(extra_cfg, tile_rows, 0, 2);
@@ -331,6 +337,8 @@ static aom_codec_err_t set_encoder_config(
   const int is_vbr = cfg->rc_end_usage == AOM_VBR;
   oxcf->profile = cfg->g_profile;
   oxcf->max_threads = (int)cfg->g_threads;
+  oxcf->ref_search_mt = extra_cfg->ref_search_mt;
+  oxcf->global_me = extra_cfg->global_me;
   oxcf->width = cfg->g_w;
   oxcf->height = cfg->g_h;
   oxcf->bit_depth = cfg->g_bit_depth;
@@ -1234,6 +1242,20 @@ static aom_codec_err_t ctrl_set_render_size(aom_codec_alg_priv_t *ctx,
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static aom_codec_err_t ctrl_set_ref_search_mt(aom_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.ref_search_mt = CAST(AV1E_SET_REF_SEARCH_MT, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static aom_codec_err_t ctrl_set_global_me(aom_codec_alg_priv_t *ctx,
+                                          va_list args) {
+  struct av1_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.global_me = CAST(AV1E_SET_GLOBAL_ME, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
 static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AOM_COPY_REFERENCE, ctrl_copy_reference },
 
@@ -1274,6 +1296,8 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1E_SET_MIN_GF_INTERVAL, ctrl_set_min_gf_interval },
   { AV1E_SET_MAX_GF_INTERVAL, ctrl_set_max_gf_interval },
   { AV1E_SET_RENDER_SIZE, ctrl_set_render_size },
+  { AV1E_SET_REF_SEARCH_MT, ctrl_set_ref_search_mt },
+  { AV1E_SET_GLOBAL_ME, ctrl_set_global_me },
 
   // Getters
   { AOME_GET_LAST_QUANTIZER, ctrl_get_quantizer },
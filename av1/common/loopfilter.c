@@ -1697,6 +1697,7 @@ void av1_loop_filter_data_reset(
   lf_data->start = 0;
   lf_data->stop = 0;
   lf_data->y_only = 0;
+  lf_data->extend_borders = 0;
   memcpy(lf_data->planes, planes, sizeof(lf_data->planes));
 }
 
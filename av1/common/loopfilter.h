@@ -151,6 +151,9 @@ typedef struct LoopFilterWorkerData {
   int start;
   int stop;
   int y_only;
+  // Extend the frame borders of each superblock row as soon as the loop
+  // filter is done with it.
+  int extend_borders;
 } LFWorkerData;
 
 void av1_loop_filter_data_reset(
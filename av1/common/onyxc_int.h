@@ -220,16 +220,12 @@ typedef struct AV1Common {
   int16_t uv_dequant[MAX_SEGMENTS][2];
 
 #if CONFIG_AOM_QM
-  // Global quant matrix tables
-  qm_val_t *giqmatrix[NUM_QM_LEVELS][2][2][TX_SIZES];
-  qm_val_t *gqmatrix[NUM_QM_LEVELS][2][2][TX_SIZES];
-
   // Local quant matrix tables for each frame
-  qm_val_t *y_iqmatrix[MAX_SEGMENTS][2][TX_SIZES];
-  qm_val_t *uv_iqmatrix[MAX_SEGMENTS][2][TX_SIZES];
+  const qm_val_t *y_iqmatrix[MAX_SEGMENTS][2][TX_SIZES];
+  const qm_val_t *uv_iqmatrix[MAX_SEGMENTS][2][TX_SIZES];
   // Encoder
-  qm_val_t *y_qmatrix[MAX_SEGMENTS][2][TX_SIZES];
-  qm_val_t *uv_qmatrix[MAX_SEGMENTS][2][TX_SIZES];
+  const qm_val_t *y_qmatrix[MAX_SEGMENTS][2][TX_SIZES];
+  const qm_val_t *uv_qmatrix[MAX_SEGMENTS][2][TX_SIZES];
 
   int using_qmatrix;
   int min_qmlevel;
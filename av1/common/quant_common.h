@@ -50,11 +50,11 @@ static inline int aom_get_qmlevel(int qindex, int first, int last) {
   qmlevel = AOMMIN(qmlevel + first, NUM_QM_LEVELS - 1);
   return qmlevel;
 }
-void aom_qm_init(struct AV1Common *cm);
-qm_val_t *aom_iqmatrix(struct AV1Common *cm, int qindex, int comp,
-                       int log2sizem2, int is_intra);
-qm_val_t *aom_qmatrix(struct AV1Common *cm, int qindex, int comp,
-                      int log2sizem2, int is_intra);
+// The matrices are shared by all the codec instances of the process.
+const qm_val_t *aom_iqmatrix(int qmlevel, int is_chroma, int log2sizem2,
+                             int is_intra);
+const qm_val_t *aom_qmatrix(int qmlevel, int is_chroma, int log2sizem2,
+                            int is_intra);
 #endif
 
 #ifdef __cplusplus
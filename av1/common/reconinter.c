@@ -16,6 +16,7 @@
 #include "./aom_dsp_rtcd.h"
 
 #include "aom/aom_integer.h"
+#include "aom_mem/aom_mem.h"
 
 #include "av1/common/blockd.h"
 #include "av1/common/reconinter.h"
@@ -60,6 +61,200 @@ void av1_build_inter_predictor(const uint8_t *src, int src_stride, uint8_t *dst,
                   h, ref, interp_filter, sf->x_step_q4, sf->y_step_q4);
 }
 
+// Size of the temporary buffer holding an edge-emulated reference block: a
+// block up to MAX_SB_SIZE wide, read with a 2:1 scaling and padded for the
+// interpolation filter taps.
+#define MC_BORDER_BUF_SIZE ((MAX_SB_SIZE * 2 + 16) * (MAX_SB_SIZE * 2 + 16))
+
+// Copies the b_w x b_h block at (x, y) of a w x h frame into dst, replicating
+// the frame edge for every pixel that lies outside of the frame.
+static void build_mc_border(const uint8_t *src, int src_stride, uint8_t *dst,
+                            int dst_stride, int x, int y, int b_w, int b_h,
+                            int w, int h) {
+  // Get a pointer to the start of the real data for this row.
+  const uint8_t *ref_row = src - x - y * src_stride;
+
+  if (y >= h)
+    ref_row += (h - 1) * src_stride;
+  else if (y > 0)
+    ref_row += y * src_stride;
+
+  do {
+    int right = 0, copy;
+    int left = x < 0 ? -x : 0;
+
+    if (left > b_w) left = b_w;
+
+    if (x + b_w > w) right = x + b_w - w;
+
+    if (right > b_w) right = b_w;
+
+    copy = b_w - left - right;
+
+    if (left) memset(dst, ref_row[0], left);
+
+    if (copy) memcpy(dst + left, ref_row + x + left, copy);
+
+    if (right) memset(dst + left + copy, ref_row[w - 1], right);
+
+    dst += dst_stride;
+    ++y;
+
+    if (y > 0 && y < h) ref_row += src_stride;
+  } while (--b_h);
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+static void build_mc_border_highbd(const uint8_t *src8, int src_stride,
+                                   uint16_t *dst, int dst_stride, int x, int y,
+                                   int b_w, int b_h, int w, int h) {
+  // Get a pointer to the start of the real data for this row.
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref_row = src - x - y * src_stride;
+
+  if (y >= h)
+    ref_row += (h - 1) * src_stride;
+  else if (y > 0)
+    ref_row += y * src_stride;
+
+  do {
+    int right = 0, copy;
+    int left = x < 0 ? -x : 0;
+
+    if (left > b_w) left = b_w;
+
+    if (x + b_w > w) right = x + b_w - w;
+
+    if (right > b_w) right = b_w;
+
+    copy = b_w - left - right;
+
+    if (left) aom_memset16(dst, ref_row[0], left);
+
+    if (copy) memcpy(dst + left, ref_row + x + left, copy * sizeof(uint16_t));
+
+    if (right) aom_memset16(dst + left + copy, ref_row[w - 1], right);
+
+    dst += dst_stride;
+    ++y;
+
+    if (y > 0 && y < h) ref_row += src_stride;
+  } while (--b_h);
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+static INLINE void mc_predict(const MACROBLOCKD *xd, const uint8_t *pre,
+                              int pre_stride, uint8_t *dst, int dst_stride,
+                              int subpel_x, int subpel_y,
+                              const struct scale_factors *sf, int w, int h,
+                              int ref, const InterpFilter *interp_filter,
+                              int xs, int ys) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    high_inter_predictor(pre, pre_stride, dst, dst_stride, subpel_x, subpel_y,
+                         sf, w, h, ref, interp_filter, xs, ys, xd->bd);
+  } else {
+    inter_predictor(pre, pre_stride, dst, dst_stride, subpel_x, subpel_y, sf,
+                    w, h, ref, interp_filter, xs, ys);
+  }
+#else
+  (void)xd;
+  inter_predictor(pre, pre_stride, dst, dst_stride, subpel_x, subpel_y, sf, w,
+                  h, ref, interp_filter, xs, ys);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+static void extend_and_predict(const MACROBLOCKD *xd, const uint8_t *buf_ptr,
+                               int pre_stride, int x0, int y0, int b_w, int b_h,
+                               int frame_width, int frame_height,
+                               int border_offset, uint8_t *dst, int dst_stride,
+                               int subpel_x, int subpel_y,
+                               const struct scale_factors *sf, int w, int h,
+                               int ref, const InterpFilter *interp_filter,
+                               int xs, int ys) {
+  assert(b_w * b_h <= MC_BORDER_BUF_SIZE);
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    DECLARE_ALIGNED(16, uint16_t, mc_buf_high[MC_BORDER_BUF_SIZE]);
+    build_mc_border_highbd(buf_ptr, pre_stride, mc_buf_high, b_w, x0, y0, b_w,
+                           b_h, frame_width, frame_height);
+    mc_predict(xd, CONVERT_TO_BYTEPTR(mc_buf_high) + border_offset, b_w, dst,
+               dst_stride, subpel_x, subpel_y, sf, w, h, ref, interp_filter,
+               xs, ys);
+    return;
+  }
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  {
+    DECLARE_ALIGNED(16, uint8_t, mc_buf[MC_BORDER_BUF_SIZE]);
+    build_mc_border(buf_ptr, pre_stride, mc_buf, b_w, x0, y0, b_w, b_h,
+                    frame_width, frame_height);
+    mc_predict(xd, mc_buf + border_offset, b_w, dst, dst_stride, subpel_x,
+               subpel_y, sf, w, h, ref, interp_filter, xs, ys);
+  }
+}
+
+// Builds the w x h prediction from reference |ref|. |pre| points at the
+// reference block with the integer part of |mv| already applied, and
+// (pos_x, pos_y) is the position of the block in the reference plane before
+// the motion vector is applied. When the reference borders are not extended,
+// blocks that read outside of the frame are predicted from a copy of the
+// reference region with the frame edge replicated.
+static void build_mc_predictor(const MACROBLOCKD *xd, int plane, int ref,
+                               const uint8_t *pre, int pre_stride,
+                               uint8_t *dst, int dst_stride, int pos_x,
+                               int pos_y, const MV32 *mv, int w, int h, int xs,
+                               int ys, const InterpFilter *interp_filter) {
+  const struct scale_factors *const sf = &xd->block_refs[ref]->sf;
+  const int subpel_x = mv->col & SUBPEL_MASK;
+  const int subpel_y = mv->row & SUBPEL_MASK;
+
+  if (xd->lazy_border_extension) {
+    const YV12_BUFFER_CONFIG *const ref_buf = xd->block_refs[ref]->buf;
+    const int frame_width =
+        plane == 0 ? ref_buf->y_crop_width : ref_buf->uv_crop_width;
+    const int frame_height =
+        plane == 0 ? ref_buf->y_crop_height : ref_buf->uv_crop_height;
+    const int filter_extend = get_interp_filter_params(*interp_filter).taps / 2;
+    const int x0_16 = (pos_x << SUBPEL_BITS) + mv->col;
+    const int y0_16 = (pos_y << SUBPEL_BITS) + mv->row;
+    int x0 = x0_16 >> SUBPEL_BITS;
+    int y0 = y0_16 >> SUBPEL_BITS;
+    // Bottom right corner of the reference block.
+    int x1 = ((x0_16 + (w - 1) * xs) >> SUBPEL_BITS) + 1;
+    int y1 = ((y0_16 + (h - 1) * ys) >> SUBPEL_BITS) + 1;
+    int x_pad = 0, y_pad = 0;
+
+    if (subpel_x || xs != SUBPEL_SHIFTS) {
+      x0 -= filter_extend - 1;
+      x1 += filter_extend;
+      x_pad = 1;
+    }
+
+    if (subpel_y || ys != SUBPEL_SHIFTS) {
+      y0 -= filter_extend - 1;
+      y1 += filter_extend;
+      y_pad = 1;
+    }
+
+    // Skip border extension if the block is inside the frame.
+    if (x0 < 0 || x1 > frame_width - 1 || y0 < 0 || y1 > frame_height - 1) {
+      const int left = x_pad * (filter_extend - 1);
+      const int top = y_pad * (filter_extend - 1);
+      const int b_w = x1 - x0 + 1;
+      const int b_h = y1 - y0 + 1;
+
+      extend_and_predict(xd, pre - top * pre_stride - left, pre_stride, x0, y0,
+                         b_w, b_h, frame_width, frame_height, top * b_w + left,
+                         dst, dst_stride, subpel_x, subpel_y, sf, w, h, ref,
+                         interp_filter, xs, ys);
+      return;
+    }
+  }
+
+  mc_predict(xd, pre, pre_stride, dst, dst_stride, subpel_x, subpel_y, sf, w, h,
+             ref, interp_filter, xs, ys);
+}
+
 void build_inter_predictors(MACROBLOCKD *xd, int plane,
 #if CONFIG_MOTION_VAR
                             int mi_col_offset, int mi_row_offset,
@@ -108,7 +303,7 @@ void build_inter_predictors(MACROBLOCKD *xd, int plane,
               xd, &mv, bw, bh, pd->subsampling_x, pd->subsampling_y);
           uint8_t *pre;
           MV32 scaled_mv;
-          int xs, ys, subpel_x, subpel_y;
+          int xs, ys, pos_x, pos_y;
           const int is_scaled = av1_is_scaled(sf);
 
           x = x_base + idx * x_step;
@@ -122,33 +317,25 @@ void build_inter_predictors(MACROBLOCKD *xd, int plane,
             scaled_mv = av1_scale_mv(&mv_q4, mi_x + x, mi_y + y, sf);
             xs = sf->x_step_q4;
             ys = sf->y_step_q4;
+            pos_x = sf->scale_value_x(mi_x >> pd->subsampling_x, sf) +
+                    sf->scale_value_x(x, sf);
+            pos_y = sf->scale_value_y(mi_y >> pd->subsampling_y, sf) +
+                    sf->scale_value_y(y, sf);
           } else {
             pre = pre_buf->buf + y * pre_buf->stride + x;
             scaled_mv.row = mv_q4.row;
             scaled_mv.col = mv_q4.col;
             xs = ys = 16;
+            pos_x = (mi_x >> pd->subsampling_x) + x;
+            pos_y = (mi_y >> pd->subsampling_y) + y;
           }
 
-          subpel_x = scaled_mv.col & SUBPEL_MASK;
-          subpel_y = scaled_mv.row & SUBPEL_MASK;
           pre += (scaled_mv.row >> SUBPEL_BITS) * pre_buf->stride +
                  (scaled_mv.col >> SUBPEL_BITS);
 
-#if CONFIG_AOM_HIGHBITDEPTH
-          if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
-            high_inter_predictor(pre, pre_buf->stride, dst, dst_buf->stride,
-                                 subpel_x, subpel_y, sf, x_step, y_step, ref,
-                                 &mi->mbmi.interp_filter, xs, ys, xd->bd);
-          } else {
-            inter_predictor(pre, pre_buf->stride, dst, dst_buf->stride,
-                            subpel_x, subpel_y, sf, x_step, y_step, ref,
-                            &mi->mbmi.interp_filter, xs, ys);
-          }
-#else
-          inter_predictor(pre, pre_buf->stride, dst, dst_buf->stride, subpel_x,
-                          subpel_y, sf, x_step, y_step, ref,
-                          &mi->mbmi.interp_filter, xs, ys);
-#endif
+          build_mc_predictor(xd, plane, ref, pre, pre_buf->stride, dst,
+                             dst_buf->stride, pos_x, pos_y, &scaled_mv, x_step,
+                             y_step, xs, ys, &mi->mbmi.interp_filter);
         }
       }
     }
@@ -175,7 +362,7 @@ void build_inter_predictors(MACROBLOCKD *xd, int plane,
 
     uint8_t *pre;
     MV32 scaled_mv;
-    int xs, ys, subpel_x, subpel_y;
+    int xs, ys, pos_x, pos_y;
     const int is_scaled = av1_is_scaled(sf);
 
     if (is_scaled) {
@@ -183,30 +370,24 @@ void build_inter_predictors(MACROBLOCKD *xd, int plane,
       scaled_mv = av1_scale_mv(&mv_q4, mi_x + x, mi_y + y, sf);
       xs = sf->x_step_q4;
       ys = sf->y_step_q4;
+      pos_x = sf->scale_value_x(mi_x >> pd->subsampling_x, sf) +
+              sf->scale_value_x(x, sf);
+      pos_y = sf->scale_value_y(mi_y >> pd->subsampling_y, sf) +
+              sf->scale_value_y(y, sf);
     } else {
       pre = pre_buf->buf + (y * pre_buf->stride + x);
       scaled_mv.row = mv_q4.row;
       scaled_mv.col = mv_q4.col;
       xs = ys = 16;
+      pos_x = (mi_x >> pd->subsampling_x) + x;
+      pos_y = (mi_y >> pd->subsampling_y) + y;
     }
-    subpel_x = scaled_mv.col & SUBPEL_MASK;
-    subpel_y = scaled_mv.row & SUBPEL_MASK;
     pre += (scaled_mv.row >> SUBPEL_BITS) * pre_buf->stride +
            (scaled_mv.col >> SUBPEL_BITS);
 
-#if CONFIG_AOM_HIGHBITDEPTH
-    if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
-      high_inter_predictor(pre, pre_buf->stride, dst, dst_buf->stride, subpel_x,
-                           subpel_y, sf, w, h, ref, &mi->mbmi.interp_filter, xs,
-                           ys, xd->bd);
-    } else {
-      inter_predictor(pre, pre_buf->stride, dst, dst_buf->stride, subpel_x,
-                      subpel_y, sf, w, h, ref, &mi->mbmi.interp_filter, xs, ys);
-    }
-#else
-    inter_predictor(pre, pre_buf->stride, dst, dst_buf->stride, subpel_x,
-                    subpel_y, sf, w, h, ref, &mi->mbmi.interp_filter, xs, ys);
-#endif  // CONFIG_AOM_HIGHBITDEPTH
+    build_mc_predictor(xd, plane, ref, pre, pre_buf->stride, dst,
+                       dst_buf->stride, pos_x, pos_y, &scaled_mv, w, h, xs, ys,
+                       &mi->mbmi.interp_filter);
   }
 }
 
@@ -9,7 +9,11 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <assert.h>
+#include <limits.h>
+
 #include "./aom_config.h"
+#include "./aom_scale_rtcd.h"
 #include "aom_dsp/aom_dsp_common.h"
 #include "aom_mem/aom_mem.h"
 #include "av1/common/entropymode.h"
@@ -139,6 +143,34 @@ static INLINE void loop_filter_block_plane_hor(
   }
 }
 
+// Number of lines above the top edge of a superblock row that its loop
+// filtering may still modify.
+#define LF_ROW_OVERLAP 8
+
+// Extends the frame borders of the pixel rows that are final once superblock
+// row mi_row has been filtered: the rows of mi_row, except for the bottom
+// LF_ROW_OVERLAP lines that the next superblock row still filters, and the
+// bottom lines of the previous superblock row.
+static void extend_filtered_sb_row(const LFWorkerData *const lf_data,
+                                   int mi_row) {
+  YV12_BUFFER_CONFIG *const frame = lf_data->frame_buffer;
+  const int ext_size = AOMMIN(frame->border, AOMINNERBORDERINPIXELS);
+  const int last_row = mi_row + MAX_MIB_SIZE >= lf_data->cm->mi_rows;
+  int plane;
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    const int ss_y = lf_data->planes[plane].subsampling_y;
+    const int start_row =
+        mi_row ? ((mi_row * MI_SIZE) >> ss_y) - LF_ROW_OVERLAP : 0;
+    const int end_row =
+        last_row ? INT_MAX
+                 : (((mi_row + MAX_MIB_SIZE) * MI_SIZE) >> ss_y) -
+                       LF_ROW_OVERLAP;
+    aom_extend_frame_borders_plane_rows(frame, plane, ext_size, start_row,
+                                        end_row);
+  }
+}
+
 // Row-based multi-threaded loopfilter hook
 #if CONFIG_PARALLEL_DEBLOCKING
 static int loop_filter_ver_row_worker(AV1LfSync *const lf_sync,
@@ -203,6 +235,8 @@ static int loop_filter_hor_row_worker(AV1LfSync *const lf_sync,
 
       sync_write(lf_sync, r, c, sb_cols);
     }
+
+    if (lf_data->extend_borders) extend_filtered_sb_row(lf_data, mi_row);
   }
   return 1;
 }
@@ -242,6 +276,8 @@ static int loop_filter_row_worker(AV1LfSync *const lf_sync,
 
       sync_write(lf_sync, r, c, sb_cols);
     }
+
+    if (lf_data->extend_borders) extend_filtered_sb_row(lf_data, mi_row);
   }
   return 1;
 }
@@ -250,8 +286,8 @@ static int loop_filter_row_worker(AV1LfSync *const lf_sync,
 static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                                 struct macroblockd_plane planes[MAX_MB_PLANE],
                                 int start, int stop, int y_only,
-                                AVxWorker *workers, int nworkers,
-                                AV1LfSync *lf_sync) {
+                                int extend_borders, AVxWorker *workers,
+                                int nworkers, AV1LfSync *lf_sync) {
   const AVxWorkerInterface *const winterface = aom_get_worker_interface();
   // Number of superblock rows and cols
   const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MAX_MIB_SIZE_LOG2;
@@ -323,6 +359,7 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
     lf_data->start = start + i * MAX_MIB_SIZE;
     lf_data->stop = stop;
     lf_data->y_only = y_only;
+    lf_data->extend_borders = extend_borders;
 
     // Start loopfiltering
     if (i == num_workers - 1) {
@@ -353,6 +390,7 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
     lf_data->start = start + i * MAX_MIB_SIZE;
     lf_data->stop = stop;
     lf_data->y_only = y_only;
+    lf_data->extend_borders = extend_borders;
 
     // Start loopfiltering
     if (i == num_workers - 1) {
@@ -372,12 +410,17 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
 void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                               struct macroblockd_plane planes[MAX_MB_PLANE],
                               int frame_filter_level, int y_only,
-                              int partial_frame, AVxWorker *workers,
-                              int num_workers, AV1LfSync *lf_sync) {
+                              int partial_frame, int extend_borders,
+                              AVxWorker *workers, int num_workers,
+                              AV1LfSync *lf_sync) {
   int start_mi_row, end_mi_row, mi_rows_to_filter;
 
   if (!frame_filter_level) return;
 
+  // Borders can only be extended along with the loop filter when every row
+  // of every plane is filtered.
+  assert(!extend_borders || (!y_only && !partial_frame));
+
   start_mi_row = 0;
   mi_rows_to_filter = cm->mi_rows;
   if (partial_frame && cm->mi_rows > 8) {
@@ -389,7 +432,7 @@ void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
   av1_loop_filter_frame_init(cm, frame_filter_level);
 
   loop_filter_rows_mt(frame, cm, planes, start_mi_row, end_mi_row, y_only,
-                      workers, num_workers, lf_sync);
+                      extend_borders, workers, num_workers, lf_sync);
 }
 
 // Set up nsync by width.
@@ -47,12 +47,15 @@ void av1_loop_filter_alloc(AV1LfSync *lf_sync, struct AV1Common *cm, int rows,
 // Deallocate loopfilter synchronization related mutex and data.
 void av1_loop_filter_dealloc(AV1LfSync *lf_sync);
 
-// Multi-threaded loopfilter that uses the tile threads.
+// Multi-threaded loopfilter that uses the tile threads. When extend_borders is
+// set, the inner frame borders of each superblock row are extended by the
+// worker that filtered it, which requires y_only and partial_frame to be 0.
 void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, struct AV1Common *cm,
                               struct macroblockd_plane planes[MAX_MB_PLANE],
                               int frame_filter_level, int y_only,
-                              int partial_frame, AVxWorker *workers,
-                              int num_workers, AV1LfSync *lf_sync);
+                              int partial_frame, int extend_borders,
+                              AVxWorker *workers, int num_workers,
+                              AV1LfSync *lf_sync);
 
 void av1_accumulate_frame_counts(struct AV1Common *cm,
                                  struct FRAME_COUNTS *counts, int is_dec);
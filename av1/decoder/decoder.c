@@ -116,9 +116,10 @@ AV1Decoder *av1_decoder_create(BufferPool *const pool) {
 
   av1_loop_filter_init(cm);
 
-#if CONFIG_AOM_QM
-  aom_qm_init(cm);
-#endif
+  // Reference frame borders are never extended by the decoder; inter
+  // prediction emulates the frame edge for the blocks that need it.
+  pbi->mb.lazy_border_extension = 1;
+
 #if CONFIG_ACCOUNTING
   aom_accounting_init(&pbi->accounting);
 #endif
@@ -416,8 +417,6 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
 
   swap_frame_buffers(pbi);
 
-  aom_extend_frame_inner_borders(cm->frame_to_show);
-
   aom_clear_system_state();
 
   if (!cm->show_existing_frame) {
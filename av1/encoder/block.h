@@ -67,6 +67,68 @@ typedef struct {
 } PALETTE_BUFFER;
 #endif  // CONFIG_PALETTE
 
+// Number of subpel refinements of a block kept by its mode search.
+#define SUBPEL_MEMO_SIZE 8
+
+// The inputs of a subpel refinement that vary within the mode search of a
+// block.
+typedef struct {
+  MV_REFERENCE_FRAME ref;
+  // The other prediction of a compound search, NONE for a single search.
+  MV_REFERENCE_FRAME second_ref;
+  MV second_mv;
+  InterpFilter second_filter;
+  BLOCK_SIZE bsize;
+  int block;
+  MV start_mv;
+  MV ref_mv;
+  int forced_stop;
+  int cost_list[5];
+  int **mvcost;
+} SUBPEL_MEMO_KEY;
+
+typedef struct {
+  SUBPEL_MEMO_KEY key;
+  MV best_mv;
+  int besterr;
+  int distortion;
+  unsigned int sse;
+} SUBPEL_MEMO;
+
+// Number of transform block RD results kept by the RD search of a tile, a
+// power of 2.
+#define TX_RD_CACHE_SIZE 4096
+
+typedef struct {
+  // Hash of the residual of the block and of the parameters of its transform,
+  // quantization and coefficient coding, 0 for an empty entry.
+  uint64_t key;
+  int rate;
+  int eob;
+  int64_t dist;
+  int64_t sse;
+} TX_RD_CACHE_ENTRY;
+
+// The outcome of the RD search of an inter block, kept from one encode of a
+// frame in the recode loop to the next.
+typedef struct {
+  // Frame the entry was written in, see AV1_COMP.rd_decision_frame, and the
+  // reference frames available to the block then. An entry of an earlier
+  // frame is empty.
+  unsigned int frame;
+  int ref_frame_flags;
+  // Hash of the coding context of the block: its entropy and partition
+  // contexts and the modes of its above and left neighbors.
+  uint32_t ctx_hash;
+  int qindex;
+  PREDICTION_MODE mode;
+  MV_REFERENCE_FRAME ref_frame[2];
+  int_mv mv[2];
+  // The reference frames whose best mode came close to the best one, intra
+  // included.
+  int ref_mask;
+} RD_DECISION;
+
 typedef struct macroblock MACROBLOCK;
 struct macroblock {
   struct macroblock_plane plane[MAX_MB_PLANE];
@@ -142,6 +204,8 @@ struct macroblock {
   av1_coeff_cost token_costs[TX_SIZES];
 
   int optimize;
+  // Use optimize_b_fast() instead of optimize_b() for the trellis.
+  int fast_trellis;
 
   // indicate if it is in the rd search loop or encoding process
   int use_lp32x32fdct;
@@ -159,6 +223,28 @@ struct macroblock {
 
   // Used to store sub partition's choices.
   MV pred_mv[MAX_REF_FRAMES];
+
+  // Subpel refinements run by the mode search of the current block, reset
+  // at the start of the search.
+  SUBPEL_MEMO subpel_memo[SUBPEL_MEMO_SIZE];
+  int subpel_memo_count;
+
+  // RD results of the inter transform blocks coded in the current tile. The
+  // partition search codes the same residuals again and again.
+  TX_RD_CACHE_ENTRY tx_rd_cache[TX_RD_CACHE_SIZE];
+
+  // Decision of the previous encode of the frame for the current block to
+  // seed its mode search with, NULL if none, and whether it was made in the
+  // same coding context at the same q index.
+  const RD_DECISION *rd_seed;
+  int rd_seed_exact;
+  // The reference frames whose best mode came close to the best one in the
+  // last inter mode search, for the next RD_DECISION.
+  int rd_ref_mask;
+
+  // Luma transform type picked by the last transform type search, a hint for
+  // the ranking of the types of the next one.
+  TX_TYPE last_tx_type;
 };
 
 #ifdef __cplusplus
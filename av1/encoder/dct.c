@@ -1462,6 +1462,72 @@ void av1_fht16x16_c(const int16_t *input, tran_low_t *output, int stride,
   }
 }
 
+#if !CONFIG_AOM_QM
+// The fused transform, quantization and error kernels. The C versions run the
+// separate kernels in turn, so that targets without a fused kernel keep their
+// optimized ones.
+static int64_t fht_quant(void (*fht)(const int16_t *, tran_low_t *, int, int),
+                         int n_coeffs, const int16_t *input, int stride,
+                         int tx_type, tran_low_t *coeff_ptr, int skip_block,
+                         const int16_t *zbin_ptr, const int16_t *round_ptr,
+                         const int16_t *quant_ptr,
+                         const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+                         tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr,
+                         uint16_t *eob_ptr, const int16_t *scan,
+                         const int16_t *iscan, int64_t *ssz) {
+  fht(input, coeff_ptr, stride, tx_type);
+  aom_quantize_b(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                 quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                 dequant_ptr, eob_ptr, scan, iscan);
+  return av1_block_error(coeff_ptr, dqcoeff_ptr, n_coeffs, ssz);
+}
+
+int64_t av1_fht4x4_quant_c(const int16_t *input, int stride, int tx_type,
+                           tran_low_t *coeff_ptr, int skip_block,
+                           const int16_t *zbin_ptr, const int16_t *round_ptr,
+                           const int16_t *quant_ptr,
+                           const int16_t *quant_shift_ptr,
+                           tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                           const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                           const int16_t *scan, const int16_t *iscan,
+                           int64_t *ssz) {
+  return fht_quant(av1_fht4x4, 16, input, stride, tx_type, coeff_ptr,
+                   skip_block, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+                   qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan,
+                   ssz);
+}
+
+int64_t av1_fht8x8_quant_c(const int16_t *input, int stride, int tx_type,
+                           tran_low_t *coeff_ptr, int skip_block,
+                           const int16_t *zbin_ptr, const int16_t *round_ptr,
+                           const int16_t *quant_ptr,
+                           const int16_t *quant_shift_ptr,
+                           tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                           const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                           const int16_t *scan, const int16_t *iscan,
+                           int64_t *ssz) {
+  return fht_quant(av1_fht8x8, 64, input, stride, tx_type, coeff_ptr,
+                   skip_block, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+                   qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan,
+                   ssz);
+}
+
+int64_t av1_fht16x16_quant_c(const int16_t *input, int stride, int tx_type,
+                             tran_low_t *coeff_ptr, int skip_block,
+                             const int16_t *zbin_ptr, const int16_t *round_ptr,
+                             const int16_t *quant_ptr,
+                             const int16_t *quant_shift_ptr,
+                             tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                             const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                             const int16_t *scan, const int16_t *iscan,
+                             int64_t *ssz) {
+  return fht_quant(av1_fht16x16, 256, input, stride, tx_type, coeff_ptr,
+                   skip_block, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+                   qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan,
+                   ssz);
+}
+#endif  // !CONFIG_AOM_QM
+
 #if CONFIG_AOM_HIGHBITDEPTH
 void av1_highbd_fht4x4_c(const int16_t *input, tran_low_t *output, int stride,
                          int tx_type) {
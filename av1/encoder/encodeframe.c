@@ -42,6 +42,8 @@
 #include "av1/encoder/encodemv.h"
 #include "av1/encoder/ethread.h"
 #include "av1/encoder/extend.h"
+#include "av1/encoder/partition_model.h"
+#include "av1/encoder/pickmode.h"
 #include "av1/encoder/rd.h"
 #include "av1/encoder/rdopt.h"
 #include "av1/encoder/segmentation.h"
@@ -449,6 +451,17 @@ static int set_vt_partitioning(AV1_COMP *cpi, MACROBLOCK *const x,
   return 0;
 }
 
+// Extra left shift applied to the variance partition thresholds so that
+// high bitdepth sources split like 8-bit ones.
+static int get_vbp_bd_shift(const AV1_COMMON *cm) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (cm->use_highbitdepth) return cm->bit_depth - 8;
+#else
+  (void)cm;
+#endif
+  return 0;
+}
+
 // Set the variance split thresholds for following the block sizes:
 // 0 - threshold_64x64, 1 - threshold_32x32, 2 - threshold_16x16,
 // 3 - vbp_threshold_8x8. vbp_threshold_8x8 (to split to 4x4 partition) is
@@ -456,6 +469,7 @@ static int set_vt_partitioning(AV1_COMP *cpi, MACROBLOCK *const x,
 static void set_vbp_thresholds(AV1_COMP *cpi, int64_t thresholds[], int q) {
   AV1_COMMON *const cm = &cpi->common;
   const int is_key_frame = (cm->frame_type == KEY_FRAME);
+  const int bd_shift = get_vbp_bd_shift(cm);
   const int threshold_multiplier = is_key_frame ? 20 : 1;
   const int64_t threshold_base =
       (int64_t)(threshold_multiplier * cpi->y_dequant[q][1]);
@@ -477,14 +491,22 @@ static void set_vbp_thresholds(AV1_COMP *cpi, int64_t thresholds[], int q) {
       thresholds[2] = threshold_base << cpi->oxcf.speed;
     }
   }
+  // The dequantizer scales linearly with the sample range, the variances of
+  // the averages with its square.
+  if (bd_shift) {
+    int i;
+    for (i = 0; i < 4; i++) thresholds[i] <<= bd_shift;
+  }
 }
 
 void av1_set_variance_partition_thresholds(AV1_COMP *cpi, int q) {
   AV1_COMMON *const cm = &cpi->common;
   SPEED_FEATURES *const sf = &cpi->sf;
   const int is_key_frame = (cm->frame_type == KEY_FRAME);
+  const int bd_shift = get_vbp_bd_shift(cm);
   if (sf->partition_search_type != VAR_BASED_PARTITION &&
-      sf->partition_search_type != REFERENCE_PARTITION) {
+      sf->partition_search_type != REFERENCE_PARTITION &&
+      sf->auto_min_max_partition_size != VAR_BASED_MIN_MAX) {
     return;
   } else {
     set_vbp_thresholds(cpi, cpi->vbp_thresholds, q);
@@ -494,14 +516,13 @@ void av1_set_variance_partition_thresholds(AV1_COMP *cpi, int q) {
       cpi->vbp_bsize_min = BLOCK_8X8;
     } else {
       if (cm->width <= 352 && cm->height <= 288)
-        cpi->vbp_threshold_sad = 100;
+        cpi->vbp_threshold_sad = 100 << bd_shift;
       else
-        cpi->vbp_threshold_sad = (cpi->y_dequant[q][1] << 1) > 1000
-                                     ? (cpi->y_dequant[q][1] << 1)
-                                     : 1000;
+        cpi->vbp_threshold_sad =
+            AOMMAX(cpi->y_dequant[q][1] << 1, 1000 << bd_shift);
       cpi->vbp_bsize_min = BLOCK_16X16;
     }
-    cpi->vbp_threshold_minmax = 15 + (q >> 3);
+    cpi->vbp_threshold_minmax = (15 + (q >> 3)) << bd_shift;
   }
 }
 
@@ -514,7 +535,7 @@ static int compute_minmax_8x8(const uint8_t *s, int sp, const uint8_t *d,
                               int pixels_wide, int pixels_high) {
   int k;
   int minmax_max = 0;
-  int minmax_min = 255;
+  int minmax_min = INT_MAX;
   // Loop over the 4 8x8 subblocks.
   for (k = 0; k < 4; k++) {
     int x8_idx = x16_idx + ((k & 1) << 3);
@@ -585,6 +606,23 @@ static void fill_variance_8x8avg(const uint8_t *s, int sp, const uint8_t *d,
                                  int pixels_wide, int pixels_high,
                                  int is_key_frame) {
   int k;
+  if (x16_idx + 16 <= pixels_wide && y16_idx + 16 <= pixels_high
+#if CONFIG_AOM_HIGHBITDEPTH
+      && !(highbd_flag & YV12_FLAG_HIGHBITDEPTH)
+#endif
+      ) {
+    // The whole 16x16 block is inside the frame: average its four 8x8
+    // blocks in one go.
+    int s_avg[4];
+    int d_avg[4] = { 128, 128, 128, 128 };
+    aom_avg_8x8_quad(s, sp, x16_idx, y16_idx, s_avg);
+    if (!is_key_frame) aom_avg_8x8_quad(d, dp, x16_idx, y16_idx, d_avg);
+    for (k = 0; k < 4; k++) {
+      const int sum = s_avg[k] - d_avg[k];
+      fill_variance(sum * sum, sum, 0, &vst->split[k].part_variances.none);
+    }
+    return;
+  }
   for (k = 0; k < 4; k++) {
     int x8_idx = x16_idx + ((k & 1) << 3);
     int y8_idx = y16_idx + ((k >> 1) << 3);
@@ -992,6 +1030,126 @@ static int set_segment_rdmult(const AV1_COMP *const cpi, MACROBLOCK *const x,
   return av1_compute_rd_mult(cpi, segment_qindex + cm->y_dc_delta_q);
 }
 
+// Returns the index in a superblock's entries of the RD decision cache of the
+// first entry of the blocks of bsize, or the number of entries of a superblock
+// for BLOCK_SIZES. There is one entry for each block of 8x8 and above.
+static int rd_decision_offset(BLOCK_SIZE bsize) {
+  int offset = 0;
+  BLOCK_SIZE b;
+  for (b = BLOCK_8X8; b < bsize; ++b) {
+    offset += (MAX_MIB_SIZE / num_8x8_blocks_wide_lookup[b]) *
+              (MAX_MIB_SIZE / num_8x8_blocks_high_lookup[b]);
+  }
+  return offset;
+}
+
+// Returns the entry of the bsize block at mi_row, mi_col in the RD decision
+// cache. The blocks of a superblock are coded by one thread.
+static RD_DECISION *get_rd_decision(const AV1_COMP *const cpi, int mi_row,
+                                    int mi_col, BLOCK_SIZE bsize) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MAX_MIB_SIZE_LOG2;
+  const int sb_index =
+      (mi_row >> MAX_MIB_SIZE_LOG2) * sb_cols + (mi_col >> MAX_MIB_SIZE_LOG2);
+  const int mi_width = num_8x8_blocks_wide_lookup[bsize];
+  const int mi_height = num_8x8_blocks_high_lookup[bsize];
+  const int block_index =
+      (mi_row & MAX_MIB_MASK) / mi_height * (MAX_MIB_SIZE / mi_width) +
+      (mi_col & MAX_MIB_MASK) / mi_width;
+  return &cpi->rd_decisions[sb_index * rd_decision_offset(BLOCK_SIZES) +
+                            rd_decision_offset(bsize) + block_index];
+}
+
+static uint32_t hash_bytes(uint32_t hash, const void *data, size_t size) {
+  const uint8_t *const bytes = (const uint8_t *)data;
+  size_t i;
+  for (i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * 16777619u;
+  return hash;
+}
+
+static uint32_t hash_neighbor(uint32_t hash, const MODE_INFO *mi) {
+  if (mi == NULL) return hash * 16777619u;
+  hash = hash_bytes(hash, &mi->mbmi.sb_type, sizeof(mi->mbmi.sb_type));
+  hash = hash_bytes(hash, &mi->mbmi.mode, sizeof(mi->mbmi.mode));
+  hash = hash_bytes(hash, mi->mbmi.ref_frame, sizeof(mi->mbmi.ref_frame));
+  hash = hash_bytes(hash, mi->mbmi.mv, sizeof(mi->mbmi.mv));
+  hash = hash_bytes(hash, &mi->mbmi.interp_filter,
+                    sizeof(mi->mbmi.interp_filter));
+  hash = hash_bytes(hash, &mi->mbmi.tx_size, sizeof(mi->mbmi.tx_size));
+  return hash_bytes(hash, &mi->mbmi.skip, sizeof(mi->mbmi.skip));
+}
+
+// Returns a hash of what the mode search of the block depends on besides its
+// source and the q index: its entropy and partition contexts, its segment and
+// the modes of its above and left neighbors.
+static uint32_t rd_decision_ctx_hash(const MACROBLOCK *const x, int mi_row,
+                                     int mi_col, BLOCK_SIZE bsize) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const int num_4x4_blocks_wide = num_4x4_blocks_wide_lookup[bsize];
+  const int num_4x4_blocks_high = num_4x4_blocks_high_lookup[bsize];
+  uint32_t hash = 2166136261u;
+  int p;
+
+  for (p = 0; p < MAX_MB_PLANE; ++p) {
+    hash = hash_bytes(
+        hash, xd->above_context[p] + (mi_col * 2 >> xd->plane[p].subsampling_x),
+        (sizeof(ENTROPY_CONTEXT) * num_4x4_blocks_wide) >>
+            xd->plane[p].subsampling_x);
+    hash = hash_bytes(
+        hash,
+        xd->left_context[p] +
+            ((mi_row & MAX_MIB_MASK) * 2 >> xd->plane[p].subsampling_y),
+        (sizeof(ENTROPY_CONTEXT) * num_4x4_blocks_high) >>
+            xd->plane[p].subsampling_y);
+  }
+  hash = hash_bytes(hash, xd->above_seg_context + mi_col,
+                    sizeof(*xd->above_seg_context) *
+                        num_8x8_blocks_wide_lookup[bsize]);
+  hash = hash_bytes(hash, xd->left_seg_context + (mi_row & MAX_MIB_MASK),
+                    sizeof(xd->left_seg_context[0]) *
+                        num_8x8_blocks_high_lookup[bsize]);
+  hash = hash_bytes(hash, &xd->mi[0]->mbmi.segment_id,
+                    sizeof(xd->mi[0]->mbmi.segment_id));
+  hash = hash_neighbor(hash, xd->above_mi);
+  return hash_neighbor(hash, xd->left_mi);
+}
+
+// Runs the RD mode search of an inter block of 8x8 and above, seeded with the
+// decision of the previous encode of the frame for it, and keeps its decision
+// for the next one.
+static void rd_pick_inter_mode_cached(const AV1_COMP *const cpi,
+                                      TileDataEnc *tile_data,
+                                      MACROBLOCK *const x, int mi_row,
+                                      int mi_col, RD_COST *rd_cost,
+                                      BLOCK_SIZE bsize, PICK_MODE_CONTEXT *ctx,
+                                      int64_t best_rd) {
+  const MB_MODE_INFO *const mbmi = &x->e_mbd.mi[0]->mbmi;
+  RD_DECISION *const decision = get_rd_decision(cpi, mi_row, mi_col, bsize);
+  const uint32_t ctx_hash = rd_decision_ctx_hash(x, mi_row, mi_col, bsize);
+
+  if (decision->frame == cpi->rd_decision_frame &&
+      decision->ref_frame_flags == cpi->ref_frame_flags) {
+    x->rd_seed = decision;
+    x->rd_seed_exact =
+        decision->qindex == x->q_index && decision->ctx_hash == ctx_hash;
+  }
+  av1_rd_pick_inter_mode_sb(cpi, tile_data, x, mi_row, mi_col, rd_cost, bsize,
+                            ctx, best_rd);
+  x->rd_seed = NULL;
+
+  if (rd_cost->rate == INT_MAX) return;
+  decision->frame = cpi->rd_decision_frame;
+  decision->ref_frame_flags = cpi->ref_frame_flags;
+  decision->ctx_hash = ctx_hash;
+  decision->qindex = x->q_index;
+  decision->mode = mbmi->mode;
+  decision->ref_frame[0] = mbmi->ref_frame[0];
+  decision->ref_frame[1] = mbmi->ref_frame[1];
+  decision->mv[0] = mbmi->mv[0];
+  decision->mv[1] = mbmi->mv[1];
+  decision->ref_mask = x->rd_ref_mask;
+}
+
 static void rd_pick_sb_modes(const AV1_COMP *const cpi, TileDataEnc *tile_data,
                              MACROBLOCK *const x, int mi_row, int mi_col,
                              RD_COST *rd_cost, BLOCK_SIZE bsize,
@@ -1079,6 +1237,12 @@ static void rd_pick_sb_modes(const AV1_COMP *const cpi, TileDataEnc *tile_data,
       if (segfeature_active(&cm->seg, mbmi->segment_id, SEG_LVL_SKIP))
         av1_rd_pick_inter_mode_sb_seg_skip(cpi, tile_data, x, rd_cost, bsize,
                                            ctx, best_rd);
+      else if (cpi->sf.use_nonrd_pick_mode)
+        av1_pick_inter_mode(cpi, tile_data, x, mi_row, mi_col, rd_cost, bsize,
+                            ctx, best_rd);
+      else if (cpi->sf.use_rd_decision_cache)
+        rd_pick_inter_mode_cached(cpi, tile_data, x, mi_row, mi_col, rd_cost,
+                                  bsize, ctx, best_rd);
       else
         av1_rd_pick_inter_mode_sb(cpi, tile_data, x, mi_row, mi_col, rd_cost,
                                   bsize, ctx, best_rd);
@@ -1908,6 +2072,27 @@ static void get_sb_partition_size_range(MACROBLOCKD *xd, MODE_INFO **mi_8x8,
   }
 }
 
+// Find the min and max sb_type of the blocks choose_partitioning() laid out
+// in the SB64 at mi_8x8. Only the top-left entry of each block is set there.
+static void get_sb_var_based_size_range(const AV1_COMMON *cm,
+                                        MODE_INFO **mi_8x8, int mi_row,
+                                        int mi_col, BLOCK_SIZE *min_block_size,
+                                        BLOCK_SIZE *max_block_size) {
+  const int rows = AOMMIN(MAX_MIB_SIZE, cm->mi_rows - mi_row);
+  const int cols = AOMMIN(MAX_MIB_SIZE, cm->mi_cols - mi_col);
+  int i, j;
+
+  for (i = 0; i < rows; ++i) {
+    for (j = 0; j < cols; ++j) {
+      const MODE_INFO *const mi = mi_8x8[i * cm->mi_stride + j];
+      if (mi) {
+        *min_block_size = AOMMIN(*min_block_size, mi->mbmi.sb_type);
+        *max_block_size = AOMMAX(*max_block_size, mi->mbmi.sb_type);
+      }
+    }
+  }
+}
+
 // Next square block size less or equal than current block size.
 static const BLOCK_SIZE next_square_size[BLOCK_SIZES] = {
   BLOCK_4X4,   BLOCK_4X4,   BLOCK_4X4,   BLOCK_8X8,   BLOCK_8X8,
@@ -1916,7 +2101,9 @@ static const BLOCK_SIZE next_square_size[BLOCK_SIZES] = {
 };
 
 // Look at neighboring blocks and set a min and max partition size based on
-// what they chose.
+// what they chose. With VAR_BASED_MIN_MAX on inter frames, the range is taken
+// from the variance based partitioning of this SB64 instead, which must have
+// been computed by choose_partitioning() beforehand.
 static void rd_auto_partition_range(AV1_COMP *cpi, const TileInfo *const tile,
                                     MACROBLOCKD *const xd, int mi_row,
                                     int mi_col, BLOCK_SIZE *min_block_size,
@@ -1932,8 +2119,17 @@ static void rd_auto_partition_range(AV1_COMP *cpi, const TileInfo *const tile,
   BLOCK_SIZE max_size = BLOCK_64X64;
   int bs_hist[BLOCK_SIZES] = { 0 };
 
-  // Trap case where we do not have a prediction.
-  if (left_in_image || above_in_image || cm->frame_type != KEY_FRAME) {
+  if (cpi->sf.auto_min_max_partition_size == VAR_BASED_MIN_MAX &&
+      !frame_is_intra_only(cm)) {
+    min_size = BLOCK_64X64;
+    max_size = BLOCK_4X4;
+    get_sb_var_based_size_range(cm, mi, mi_row, mi_col, &min_size, &max_size);
+    // Let the RD search try one size either side of the variance decision.
+    min_size = min_partition_size[min_size];
+    max_size = max_partition_size[max_size];
+  } else if (left_in_image || above_in_image ||
+             cm->frame_type != KEY_FRAME) {
+    // Trap case where we do not have a prediction.
     // Default "min to max" and "max to min"
     min_size = BLOCK_64X64;
     max_size = BLOCK_4X4;
@@ -1960,7 +2156,7 @@ static void rd_auto_partition_range(AV1_COMP *cpi, const TileInfo *const tile,
     }
 
     // Adjust observed min and max for "relaxed" auto partition case.
-    if (cpi->sf.auto_min_max_partition_size == RELAXED_NEIGHBORING_MIN_MAX) {
+    if (cpi->sf.auto_min_max_partition_size != STRICT_NEIGHBORING_MIN_MAX) {
       min_size = min_partition_size[min_size];
       max_size = max_partition_size[max_size];
     }
@@ -2052,6 +2248,45 @@ static INLINE void load_pred_mv(MACROBLOCK *x, PICK_MODE_CONTEXT *ctx) {
   memcpy(x->pred_mv, ctx->pred_mv, sizeof(x->pred_mv));
 }
 
+// Compute the features of the partition pruning models for a bsize block whose
+// PARTITION_NONE search gave none_rdc.
+static void get_partition_model_features(const AV1_COMP *const cpi,
+                                         const MACROBLOCK *const x, int mi_row,
+                                         int mi_col, BLOCK_SIZE bsize,
+                                         const RD_COST *none_rdc,
+                                         int none_skippable, float *features) {
+  const int ctx = partition_plane_context(&x->e_mbd, mi_row, mi_col, bsize) %
+                  PARTITION_PLOFFSET;
+  const double num_pels = (double)(1 << num_pels_log2_lookup[bsize]);
+
+  aom_clear_system_state();
+  features[0] = (float)log(1.0 + none_rdc->dist / num_pels);
+  features[1] = (float)log(1.0 + none_rdc->rate / num_pels);
+  // Set by rd_pick_sb_modes() for the PARTITION_NONE search.
+  features[2] = (float)log(1.0 + x->source_variance);
+  features[3] = cpi->common.base_qindex / 255.0f;
+  features[4] = (float)(ctx & 1);
+  features[5] = (float)(ctx >> 1);
+  features[6] = (float)none_skippable;
+  features[7] =
+      cpi->oxcf.pass == 2 ? (float)cpi->twopass.mb_av_energy : 0.0f;
+}
+
+#if COLLECT_PARTITION_STATS
+static void write_partition_stats(BLOCK_SIZE bsize, const float *features,
+                                  int split_searched, int rect_searched,
+                                  PARTITION_TYPE partition) {
+  FILE *f = fopen("partition_stats.stt", "a");
+  int i;
+  if (!f) return;
+  fprintf(f, "%d %d %d %d", bsize, split_searched, rect_searched, partition);
+  for (i = 0; i < PARTITION_MODEL_FEATURES; ++i)
+    fprintf(f, " %f", features[i]);
+  fprintf(f, "\n");
+  fclose(f);
+}
+#endif  // COLLECT_PARTITION_STATS
+
 #if CONFIG_FP_MB_STATS
 const int num_16x16_blocks_wide_lookup[BLOCK_SIZES] = { 1, 1, 1, 1, 1, 1, 1,
                                                         1, 2, 2, 2, 4, 4 };
@@ -2122,6 +2357,11 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   const int bsize_at_least_8x8 = (bsize >= BLOCK_8X8);
   int do_square_split = bsize_at_least_8x8;
   int do_rectangular_split = 1;
+  float model_features[PARTITION_MODEL_FEATURES];
+  int have_model_features = 0;
+#if COLLECT_PARTITION_STATS
+  int rect_searched = 0;
+#endif
 
   // Override skipping rectangular partition operations for edge blocks
   const int force_horz_split = (mi_row + mi_step >= cm->mi_rows);
@@ -2327,6 +2567,25 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
         }
 #endif
       }
+
+      if (bsize >= BLOCK_16X16 &&
+          (cpi->sf.partition_model_prune || COLLECT_PARTITION_STATS)) {
+        get_partition_model_features(cpi, x, mi_row, mi_col, bsize, &this_rdc,
+                                     ctx_none->skippable, model_features);
+        have_model_features = 1;
+#if !COLLECT_PARTITION_STATS
+        if (do_square_split &&
+            av1_partition_model_prune(bsize, PARTITION_MODEL_SPLIT,
+                                      model_features,
+                                      cpi->sf.partition_model_prune))
+          do_square_split = 0;
+        if (do_rectangular_split &&
+            av1_partition_model_prune(bsize, PARTITION_MODEL_RECT,
+                                      model_features,
+                                      cpi->sf.partition_model_prune))
+          do_rectangular_split = 0;
+#endif  // !COLLECT_PARTITION_STATS
+      }
     }
     restore_context(x, mi_row, mi_col, a, l, sa, sl, bsize);
   }
@@ -2394,6 +2653,11 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
     restore_context(x, mi_row, mi_col, a, l, sa, sl, bsize);
   }
 
+#if COLLECT_PARTITION_STATS
+  rect_searched = (partition_horz_allowed || partition_vert_allowed) &&
+                  do_rectangular_split;
+#endif
+
   // PARTITION_HORZ
   if (partition_horz_allowed &&
       (do_rectangular_split || av1_active_h_edge(cpi, mi_row, mi_step))) {
@@ -2496,6 +2760,14 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   (void)best_rd;
   *rd_cost = best_rdc;
 
+#if COLLECT_PARTITION_STATS
+  if (have_model_features && best_rdc.rate < INT_MAX)
+    write_partition_stats(bsize, model_features, do_square_split,
+                          rect_searched, pc_tree->partitioning);
+#else
+  (void)have_model_features;
+#endif  // COLLECT_PARTITION_STATS
+
   if (best_rdc.rate < INT_MAX && best_rdc.dist < INT64_MAX &&
       pc_tree->index != 3) {
     int output_enabled = (bsize == BLOCK_64X64);
@@ -2583,6 +2855,9 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
     } else {
       // If required set upper and lower partition size limits
       if (sf->auto_min_max_partition_size) {
+        if (sf->auto_min_max_partition_size == VAR_BASED_MIN_MAX &&
+            !frame_is_intra_only(cm))
+          choose_partitioning(cpi, tile_info, x, mi_row, mi_col);
         set_offsets(cpi, tile_info, x, mi_row, mi_col, BLOCK_64X64);
         rd_auto_partition_range(cpi, tile_info, xd, mi_row, mi_col,
                                 &x->min_partition_size, &x->max_partition_size);
@@ -2690,6 +2965,19 @@ void av1_init_tile_data(AV1_COMP *cpi) {
       }
   }
 
+  if (cpi->sf.use_rd_decision_cache) {
+    const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MAX_MIB_SIZE_LOG2;
+    const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MAX_MIB_SIZE_LOG2;
+    const int size = sb_rows * sb_cols * rd_decision_offset(BLOCK_SIZES);
+    if (cpi->allocated_rd_decisions < size) {
+      aom_free(cpi->rd_decisions);
+      // Zeroed, the entries are of frame 0, before the first one.
+      CHECK_MEM_ERROR(cm, cpi->rd_decisions,
+                      aom_calloc(size, sizeof(*cpi->rd_decisions)));
+      cpi->allocated_rd_decisions = size;
+    }
+  }
+
   for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
     for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
       TileInfo *tile_info =
@@ -2716,6 +3004,9 @@ void av1_encode_tile(AV1_COMP *cpi, ThreadData *td, int tile_row,
   td->mb.m_search_count_ptr = &td->rd_counts.m_search_count;
   td->mb.ex_search_count_ptr = &td->rd_counts.ex_search_count;
 
+  // The cached transform block rates depend on the token costs of the frame.
+  memset(td->mb.tx_rd_cache, 0, sizeof(td->mb.tx_rd_cache));
+
   for (mi_row = tile_info->mi_row_start; mi_row < tile_info->mi_row_end;
        mi_row += MAX_MIB_SIZE) {
     encode_rd_sb_row(cpi, td, this_tile, mi_row, &tok);
@@ -2753,6 +3044,105 @@ static int input_fpmb_stats(FIRSTPASS_MB_STATS *firstpass_mb_stats,
 }
 #endif
 
+static void setup_motion_fields(AV1_COMP *cpi) {
+  const AV1_COMMON *const cm = &cpi->common;
+  MOTION_FIELD_CACHE *const cache = &cpi->motion_field_cache;
+  int buf_idx;
+  MV_REFERENCE_FRAME ref;
+
+  av1_zero(cpi->motion_field);
+  cpi->arf_motion_field = NULL;
+  if (!cpi->sf.mv.use_motion_field_cache || frame_is_intra_only(cm)) return;
+
+  // Look up the temporal filter field first, as getting the fields of this
+  // frame may recycle it.
+  buf_idx = get_ref_frame_buf_idx(cpi, ALTREF_FRAME);
+  if (buf_idx != INVALID_IDX && cpi->recon_id[buf_idx]) {
+    const MOTION_FIELD *const mf = av1_motion_field_lookup(
+        cache, cpi->recon_time_stamp[buf_idx],
+        av1_motion_field_source_ref_id(cpi->source_time_stamp));
+    if (mf && mf->mb_rows == cm->mb_rows && mf->mb_cols == cm->mb_cols)
+      cpi->arf_motion_field = mf;
+  }
+
+  for (ref = LAST_FRAME; ref <= ALTREF_FRAME; ++ref) {
+    buf_idx = get_ref_frame_buf_idx(cpi, ref);
+    if (buf_idx == INVALID_IDX || !cpi->recon_id[buf_idx]) continue;
+    cpi->motion_field[ref] =
+        av1_motion_field_get(cache, cpi->source_time_stamp,
+                             cpi->recon_id[buf_idx], cm->width, cm->height);
+  }
+}
+
+#if CONFIG_INTERNAL_STATS
+static void write_global_me_stats(const AV1_COMP *cpi, MV_REFERENCE_FRAME ref,
+                                  const GLOBAL_ME_MODEL *model) {
+  FILE *f = fopen("global_me.stt", "a");
+  if (!f) return;
+  // Frame, reference, model type and parameters, textured blocks, inliers,
+  // mean inlier distance and search range.
+  fprintf(f, "%4d %d %d %8.3f %8.5f %8.5f %8.3f %8.5f %8.5f",
+          cpi->common.current_video_frame, ref, model->type, model->par[0],
+          model->par[1], model->par[2], model->par[3], model->par[4],
+          model->par[5]);
+  fprintf(f, " %4d %4d %6.3f %2d\n", model->num_blocks, model->num_inliers,
+          model->residual, model->search_range);
+  fclose(f);
+}
+#endif  // CONFIG_INTERNAL_STATS
+
+static void setup_global_me(AV1_COMP *cpi) {
+  const AV1_COMMON *const cm = &cpi->common;
+  MV_REFERENCE_FRAME ref, prev;
+
+  if (!cpi->oxcf.global_me || frame_is_intra_only(cm) ||
+      !av1_me_pyramid_valid(&cpi->source_pyramid, cm->width, cm->height)) {
+    for (ref = LAST_FRAME; ref <= ALTREF_FRAME; ++ref)
+      av1_invalidate_global_me(&cpi->global_me[ref]);
+    return;
+  }
+
+  for (ref = LAST_FRAME; ref <= ALTREF_FRAME; ++ref) {
+    GLOBAL_ME_MODEL *const model = &cpi->global_me[ref];
+    const ME_PYRAMID *const ref_pyramid = get_ref_me_pyramid(cpi, ref);
+    const int buf_idx = get_ref_frame_buf_idx(cpi, ref);
+    MV start = { 0, 0 };
+
+    if (!ref_pyramid || !cpi->recon_id[buf_idx]) {
+      av1_invalidate_global_me(model);
+      continue;
+    }
+    // The model is kept over the recodes of the frame, and shared by the
+    // references to the same buffer.
+    if (model->src_id == cpi->source_time_stamp &&
+        model->ref_id == cpi->recon_id[buf_idx])
+      continue;
+    for (prev = LAST_FRAME; prev < ref; ++prev) {
+      if (cpi->global_me[prev].src_id == cpi->source_time_stamp &&
+          cpi->global_me[prev].ref_id == cpi->recon_id[buf_idx])
+        break;
+    }
+    if (prev < ref) {
+      *model = cpi->global_me[prev];
+      continue;
+    }
+
+    // Start from the translation of the previous frame relative to the same
+    // reference.
+    aom_clear_system_state();
+    if (model->type != GLOBAL_ME_NONE) {
+      start.row = (int16_t)floor(model->par[3] + 0.5);
+      start.col = (int16_t)floor(model->par[0] + 0.5);
+    }
+    av1_estimate_global_me(&cpi->source_pyramid, ref_pyramid, &start, model);
+    model->src_id = cpi->source_time_stamp;
+    model->ref_id = cpi->recon_id[buf_idx];
+#if CONFIG_INTERNAL_STATS
+    write_global_me_stats(cpi, ref, model);
+#endif  // CONFIG_INTERNAL_STATS
+  }
+}
+
 static void encode_frame_internal(AV1_COMP *cpi) {
   ThreadData *const td = &cpi->td;
   MACROBLOCK *const x = &td->mb;
@@ -2814,8 +3204,21 @@ static void encode_frame_internal(AV1_COMP *cpi) {
   cm->prev_mi =
       cm->use_prev_frame_mvs ? cm->prev_mip + cm->mi_stride + 1 : NULL;
 
+  if ((cpi->sf.mv.pyramid_search || cpi->oxcf.global_me) &&
+      !frame_is_intra_only(cm)) {
+    if (av1_build_me_pyramid(&cpi->source_pyramid, cpi->Source,
+                             cm->bit_depth))
+      aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                         "Failed to allocate source pyramid");
+  } else {
+    av1_invalidate_me_pyramid(&cpi->source_pyramid);
+  }
+  setup_motion_fields(cpi);
+  setup_global_me(cpi);
+
   x->quant_fp = cpi->sf.use_quant_fp;
   av1_zero(x->skip_txfm);
+  av1_setup_ref_search_workers(cpi);
 
   {
     struct aom_usec_timer emr_timer;
@@ -2827,6 +3230,7 @@ static void encode_frame_internal(AV1_COMP *cpi) {
                        &cpi->twopass.this_frame_mb_stats);
     }
 #endif
+    av1_setup_search_range_map(cpi);
 
     // If allowed, encoding tiles in parallel with one thread handling one tile.
     if (AOMMIN(cpi->oxcf.max_threads, 1 << cm->log2_tile_cols) > 1)
@@ -333,6 +333,236 @@ static int optimize_b(MACROBLOCK *mb, int plane, int block, TX_SIZE tx_size,
   return final_eob;
 }
 
+// Rate, in the units of the token costs, that rounding a coefficient above 1
+// down is assumed to save at most besides its extra bits, through its token
+// and the context of the next one.
+#define TRELLIS_MAX_TOKEN_GAIN (3 << AV1_PROB_COST_SHIFT)
+
+// Same trellis as optimize_b(), with less work per coefficient. The
+// distortions of both roundings of all the coefficients are computed up
+// front, the states of the coefficients that cannot be rounded down are
+// copied instead of evaluated twice, and the block is left as is when none
+// can. The rounding down of a coefficient above 1 is not evaluated when its
+// extra distortion costs more than the rate it could save, so the result may
+// differ from that of optimize_b().
+static int optimize_b_fast(MACROBLOCK *mb, int plane, int block,
+                           TX_SIZE tx_size, int ctx) {
+  MACROBLOCKD *const xd = &mb->e_mbd;
+  struct macroblock_plane *const p = &mb->plane[plane];
+  struct macroblockd_plane *const pd = &xd->plane[plane];
+  const int ref = is_inter_block(&xd->mi[0]->mbmi);
+  av1_token_state tokens[1025][2];
+  unsigned best_index[1025][2];
+  uint8_t token_cache[1024];
+  // Coefficients in scan order, then their distortions with and without
+  // rounding down, and whether they can be.
+  int coeff_s[1024], dqcoeff_s[1024], qcoeff_s[1024], dequant_s[1024];
+  int error_s[1024][2];
+  uint8_t lower_s[1024];
+#if CONFIG_AOM_QM
+  int iwt_s[1024];
+#endif
+  const tran_low_t *const coeff = BLOCK_OFFSET(mb->plane[plane].coeff, block);
+  tran_low_t *const qcoeff = BLOCK_OFFSET(p->qcoeff, block);
+  tran_low_t *const dqcoeff = BLOCK_OFFSET(pd->dqcoeff, block);
+  const int eob = p->eobs[block];
+  const PLANE_TYPE type = pd->plane_type;
+  const int default_eob = 1 << (tx_size_1d_log2[tx_size] * 2);
+  const int mul = 1 + (tx_size == TX_32X32);
+#if CONFIG_AOM_QM
+  int seg_id = xd->mi[0]->mbmi.segment_id;
+  int is_intra = !is_inter_block(&xd->mi[0]->mbmi);
+  const qm_val_t *iqmatrix = pd->seg_iqmatrix[seg_id][is_intra][tx_size];
+#endif
+  const int16_t *dequant_ptr = pd->dequant;
+  const uint8_t *const band_translate = get_band_translate(tx_size);
+  TX_TYPE tx_type = get_tx_type(type, xd, block);
+  const SCAN_ORDER *const scan_order = get_scan(tx_size, tx_type);
+  const int16_t *const scan = scan_order->scan;
+  const int16_t *const nb = scan_order->neighbors;
+  unsigned int(*const token_costs)[2][COEFF_CONTEXTS][ENTROPY_TOKENS] =
+      mb->token_costs[tx_size][type][ref];
+  int next = eob, num_lower = 0;
+  int64_t rdmult = mb->rdmult * plane_rd_mult[type], rddiv = mb->rddiv;
+  int64_t rd_cost0, rd_cost1;
+  int rate0, rate1, error0, error1;
+  int16_t t0, t1;
+  int best, band, pt, i, final_eob;
+#if CONFIG_AOM_HIGHBITDEPTH
+  const int *cat6_high_cost = av1_get_high_cost_table(xd->bd);
+  const int shift =
+      (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) ? xd->bd - 8 : 0;
+#else
+  const int *cat6_high_cost = av1_get_high_cost_table(8);
+  const int shift = 0;
+#endif
+
+  assert((!type && !plane) || (type && plane));
+  assert(eob <= default_eob);
+
+  if (!eob) return 0;
+
+  for (i = 0; i < eob; i++) {
+    const int rc = scan[i];
+    coeff_s[i] = coeff[rc];
+    dqcoeff_s[i] = dqcoeff[rc];
+    qcoeff_s[i] = qcoeff[rc];
+    dequant_s[i] = dequant_ptr[rc != 0];
+#if CONFIG_AOM_QM
+    iwt_s[i] = iqmatrix[rc];
+#endif
+    token_cache[rc] = av1_pt_energy_class[av1_get_token(qcoeff[rc])];
+  }
+
+  // No branches nor table lookups, so that the compiler vectorizes this.
+  for (i = 0; i < eob; i++) {
+    const int x = qcoeff_s[i];
+    const int sz = x >> 31;
+    const int ax = (x ^ sz) - sz;
+    const int ac = abs(coeff_s[i]) * mul;
+    const int dx = (mul * (dqcoeff_s[i] - coeff_s[i])) >> shift;
+    const int dq = dequant_s[i];
+#if CONFIG_AOM_QM
+    const int lower = (ax * dq * iwt_s[i] > (ac << AOM_QM_BITS)) &
+                      (ax * dq * iwt_s[i] < ((ac + dq) << AOM_QM_BITS));
+#else
+    const int lower = (ax * dq > ac) & (ax * dq < ac + dq);
+#endif
+    const int dx1 = dx - (((dq >> shift) + sz) ^ sz);
+    error_s[i][0] = dx * dx;
+    error_s[i][1] = dx1 * dx1;
+    lower_s[i] = lower & (x != 0);
+    num_lower += lower_s[i];
+  }
+
+  // No rounding to choose: the trellis would return the block as is.
+  if (!num_lower) return eob;
+
+  if (!ref) rdmult = (rdmult * 9) >> 4;
+
+  tokens[eob][0].rate = 0;
+  tokens[eob][0].error = 0;
+  tokens[eob][0].next = default_eob;
+  tokens[eob][0].token = EOB_TOKEN;
+  tokens[eob][0].qc = 0;
+  tokens[eob][1] = tokens[eob][0];
+
+  for (i = eob; i-- > 0;) {
+    const int x = qcoeff_s[i];
+    if (x) {
+      const int base_bits = av1_get_token_cost(x, &t0, cat6_high_cost);
+      error0 = tokens[next][0].error;
+      error1 = tokens[next][1].error;
+      rate0 = tokens[next][0].rate;
+      rate1 = tokens[next][1].rate;
+      // token_cache holds the energy of t0 at scan[i], and the contexts of
+      // the coefficients before i do not depend on it.
+      if (next < default_eob) {
+        band = band_translate[i + 1];
+        pt = get_coef_context(nb, token_cache, i + 1);
+        rate0 += token_costs[band][0][pt][tokens[next][0].token];
+        rate1 += token_costs[band][0][pt][tokens[next][1].token];
+      }
+      UPDATE_RD_COST();
+      best = rd_cost1 < rd_cost0;
+      tokens[i][0].rate = base_bits + (best ? rate1 : rate0);
+      tokens[i][0].error = error_s[i][0] + (best ? error1 : error0);
+      tokens[i][0].next = next;
+      tokens[i][0].token = t0;
+      tokens[i][0].qc = x;
+      best_index[i][0] = best;
+
+      if (lower_s[i]) {
+        const int x1 = x - (x < 0 ? -1 : 1);
+        const int lower_bits =
+            x1 ? av1_get_token_cost(x1, &t0, cat6_high_cost) : 0;
+        const int64_t gain = RDCOST(
+            rdmult, rddiv, base_bits - lower_bits + TRELLIS_MAX_TOKEN_GAIN, 0);
+        if (x1 && (int64_t)(error_s[i][1] - error_s[i][0]) << rddiv > gain) {
+          tokens[i][1] = tokens[i][0];
+          best_index[i][1] = best;
+        } else {
+          rate0 = tokens[next][0].rate;
+          rate1 = tokens[next][1].rate;
+          if (!x1) {
+            t0 = tokens[next][0].token == EOB_TOKEN ? EOB_TOKEN : ZERO_TOKEN;
+            t1 = tokens[next][1].token == EOB_TOKEN ? EOB_TOKEN : ZERO_TOKEN;
+          } else {
+            t1 = t0;
+          }
+          if (next < default_eob) {
+            band = band_translate[i + 1];
+            token_cache[scan[i]] =
+                av1_pt_energy_class[t0 != EOB_TOKEN ? t0 : t1];
+            pt = get_coef_context(nb, token_cache, i + 1);
+            if (t0 != EOB_TOKEN)
+              rate0 += token_costs[band][!x1][pt][tokens[next][0].token];
+            if (t1 != EOB_TOKEN)
+              rate1 += token_costs[band][!x1][pt][tokens[next][1].token];
+          }
+          UPDATE_RD_COST();
+          best = rd_cost1 < rd_cost0;
+          tokens[i][1].rate = lower_bits + (best ? rate1 : rate0);
+          tokens[i][1].error = error_s[i][1] + (best ? error1 : error0);
+          tokens[i][1].next = next;
+          tokens[i][1].token = best ? t1 : t0;
+          tokens[i][1].qc = x1;
+          best_index[i][1] = best;
+        }
+      } else {
+        tokens[i][1] = tokens[i][0];
+        best_index[i][1] = best;
+      }
+      next = i;
+    } else {
+      band = band_translate[i + 1];
+      t0 = tokens[next][0].token;
+      t1 = tokens[next][1].token;
+      if (t0 != EOB_TOKEN) {
+        tokens[next][0].rate += token_costs[band][1][0][t0];
+        tokens[next][0].token = ZERO_TOKEN;
+      }
+      if (t1 != EOB_TOKEN) {
+        tokens[next][1].rate += token_costs[band][1][0][t1];
+        tokens[next][1].token = ZERO_TOKEN;
+      }
+      best_index[i][0] = best_index[i][1] = 0;
+    }
+  }
+
+  band = band_translate[i + 1];
+  rate0 = tokens[next][0].rate;
+  rate1 = tokens[next][1].rate;
+  error0 = tokens[next][0].error;
+  error1 = tokens[next][1].error;
+  t0 = tokens[next][0].token;
+  t1 = tokens[next][1].token;
+  rate0 += token_costs[band][0][ctx][t0];
+  rate1 += token_costs[band][0][ctx][t1];
+  UPDATE_RD_COST();
+  best = rd_cost1 < rd_cost0;
+  final_eob = -1;
+  for (i = next; i < eob; i = next) {
+    const int x = tokens[i][best].qc;
+    const int rc = scan[i];
+#if CONFIG_AOM_QM
+    const int dequant =
+        (dequant_s[i] * iwt_s[i] + (1 << (AOM_QM_BITS - 1))) >> AOM_QM_BITS;
+#else
+    const int dequant = dequant_s[i];
+#endif
+    if (x) final_eob = i;
+    qcoeff[rc] = x;
+    dqcoeff[rc] = (x * dequant) / mul;
+    next = tokens[i][best].next;
+    best = best_index[i][best];
+  }
+  final_eob++;
+
+  mb->plane[plane].eobs[block] = final_eob;
+  return final_eob;
+}
+
 // TODO(sarahparker) refactor fwd quant functions to use fwd_txfm fns in
 // hybrid_fwd_txfm.c
 void av1_xform_quant_fp(MACROBLOCK *x, int plane, int block, int blk_row,
@@ -718,6 +948,68 @@ void av1_xform_quant(MACROBLOCK *x, int plane, int block, int blk_row,
   }
 }
 
+// Codes the tx_size block as av1_xform_quant() does, with a kernel that also
+// returns the distortion and sse of its coefficients, so that they are read
+// once. Returns 0 without coding the block when there is no such kernel for
+// it.
+int av1_xform_quant_dist(MACROBLOCK *x, int plane, int block, int blk_row,
+                         int blk_col, BLOCK_SIZE plane_bsize, TX_SIZE tx_size,
+                         int64_t *dist, int64_t *sse) {
+#if CONFIG_AOM_QM
+  (void)x;
+  (void)plane;
+  (void)block;
+  (void)blk_row;
+  (void)blk_col;
+  (void)plane_bsize;
+  (void)tx_size;
+  (void)dist;
+  (void)sse;
+  return 0;
+#else
+  MACROBLOCKD *const xd = &x->e_mbd;
+  const struct macroblock_plane *const p = &x->plane[plane];
+  const struct macroblockd_plane *const pd = &xd->plane[plane];
+  PLANE_TYPE plane_type = (plane == 0) ? PLANE_TYPE_Y : PLANE_TYPE_UV;
+  TX_TYPE tx_type = get_tx_type(plane_type, xd, block);
+  const SCAN_ORDER *const scan_order = get_scan(tx_size, tx_type);
+  tran_low_t *const coeff = BLOCK_OFFSET(p->coeff, block);
+  tran_low_t *const qcoeff = BLOCK_OFFSET(p->qcoeff, block);
+  tran_low_t *const dqcoeff = BLOCK_OFFSET(pd->dqcoeff, block);
+  uint16_t *const eob = &p->eobs[block];
+  const int diff_stride = 4 * num_4x4_blocks_wide_lookup[plane_bsize];
+  const int16_t *const src_diff =
+      &p->src_diff[4 * (blk_row * diff_stride + blk_col)];
+
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) return 0;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  if (xd->lossless[xd->mi[0]->mbmi.segment_id]) return 0;
+
+  switch (tx_size) {
+    case TX_16X16:
+      *dist = av1_fht16x16_quant(src_diff, diff_stride, tx_type, coeff,
+                                 x->skip_block, p->zbin, p->round, p->quant,
+                                 p->quant_shift, qcoeff, dqcoeff, pd->dequant,
+                                 eob, scan_order->scan, scan_order->iscan, sse);
+      return 1;
+    case TX_8X8:
+      *dist = av1_fht8x8_quant(src_diff, diff_stride, tx_type, coeff,
+                               x->skip_block, p->zbin, p->round, p->quant,
+                               p->quant_shift, qcoeff, dqcoeff, pd->dequant,
+                               eob, scan_order->scan, scan_order->iscan, sse);
+      return 1;
+    case TX_4X4:
+      *dist = av1_fht4x4_quant(src_diff, diff_stride, tx_type, coeff,
+                               x->skip_block, p->zbin, p->round, p->quant,
+                               p->quant_shift, qcoeff, dqcoeff, pd->dequant,
+                               eob, scan_order->scan, scan_order->iscan, sse);
+      return 1;
+    default: return 0;
+  }
+#endif  // CONFIG_AOM_QM
+}
+
 static void encode_block(int plane, int block, int blk_row, int blk_col,
                          BLOCK_SIZE plane_bsize, TX_SIZE tx_size, void *arg) {
   struct encode_b_args *const args = arg;
@@ -770,7 +1062,10 @@ static void encode_block(int plane, int block, int blk_row, int blk_col,
 
   if (x->optimize) {
     const int combined_ctx = combine_entropy_contexts(*a, *l);
-    *a = *l = optimize_b(x, plane, block, tx_size, combined_ctx) > 0;
+    if (x->fast_trellis)
+      *a = *l = optimize_b_fast(x, plane, block, tx_size, combined_ctx) > 0;
+    else
+      *a = *l = optimize_b(x, plane, block, tx_size, combined_ctx) > 0;
   } else {
     *a = *l = p->eobs[block] > 0;
   }
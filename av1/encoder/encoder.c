@@ -372,20 +372,23 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free(cpi->tile_data);
   cpi->tile_data = NULL;
 
+  aom_free(cpi->rd_decisions);
+  cpi->rd_decisions = NULL;
+  cpi->allocated_rd_decisions = 0;
+
   // Delete sementation map
   aom_free(cpi->segmentation_map);
   cpi->segmentation_map = NULL;
 
+  aom_free(cpi->search_range_map);
+  cpi->search_range_map = NULL;
+
   av1_cyclic_refresh_free(cpi->cyclic_refresh);
   cpi->cyclic_refresh = NULL;
 
   aom_free(cpi->active_map.map);
   cpi->active_map.map = NULL;
 
-  // Free up-sampled reference buffers.
-  for (i = 0; i < MAX_UPSAMPLED_BUFS; i++)
-    aom_free_frame_buffer(&cpi->upsampled_ref_bufs[i].buf);
-
   av1_free_ref_frame_buffers(cm->buffer_pool);
   av1_free_context_buffers(cm);
 
@@ -393,6 +396,9 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free_frame_buffer(&cpi->scaled_source);
   aom_free_frame_buffer(&cpi->scaled_last_source);
   aom_free_frame_buffer(&cpi->alt_ref_buffer);
+  av1_free_me_pyramid(&cpi->source_pyramid);
+  for (i = 0; i < FRAME_BUFFERS; ++i) av1_free_me_pyramid(&cpi->ref_pyramid[i]);
+  av1_free_motion_field_cache(&cpi->motion_field_cache);
   av1_lookahead_destroy(cpi->lookahead);
 
   aom_free(cpi->tile_tok[0][0]);
@@ -708,6 +714,15 @@ void av1_alloc_compressor_data(AV1_COMP *cpi) {
 #endif  // CONFIG_ANS
   }
 
+  {
+    const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MAX_MIB_SIZE_LOG2;
+    const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MAX_MIB_SIZE_LOG2;
+    aom_free(cpi->search_range_map);
+    CHECK_MEM_ERROR(cm, cpi->search_range_map,
+                    aom_calloc(sb_rows * sb_cols,
+                               sizeof(*cpi->search_range_map)));
+  }
+
   av1_setup_pc_tree(&cpi->common, &cpi->td);
 }
 
@@ -911,15 +926,19 @@ static void set_rc_buffer_sizes(RATE_CONTROL *rc,
 /* clang-format off */
 MAKE_BFP_SAD_WRAPPER(aom_highbd_sad32x16)
 MAKE_BFP_SADAVG_WRAPPER(aom_highbd_sad32x16_avg)
+MAKE_BFP_SAD8_WRAPPER(aom_highbd_sad32x16x8)
 MAKE_BFP_SAD4D_WRAPPER(aom_highbd_sad32x16x4d)
 MAKE_BFP_SAD_WRAPPER(aom_highbd_sad16x32)
 MAKE_BFP_SADAVG_WRAPPER(aom_highbd_sad16x32_avg)
+MAKE_BFP_SAD8_WRAPPER(aom_highbd_sad16x32x8)
 MAKE_BFP_SAD4D_WRAPPER(aom_highbd_sad16x32x4d)
 MAKE_BFP_SAD_WRAPPER(aom_highbd_sad64x32)
 MAKE_BFP_SADAVG_WRAPPER(aom_highbd_sad64x32_avg)
+MAKE_BFP_SAD8_WRAPPER(aom_highbd_sad64x32x8)
 MAKE_BFP_SAD4D_WRAPPER(aom_highbd_sad64x32x4d)
 MAKE_BFP_SAD_WRAPPER(aom_highbd_sad32x64)
 MAKE_BFP_SADAVG_WRAPPER(aom_highbd_sad32x64_avg)
+MAKE_BFP_SAD8_WRAPPER(aom_highbd_sad32x64x8)
 MAKE_BFP_SAD4D_WRAPPER(aom_highbd_sad32x64x4d)
 MAKE_BFP_SAD_WRAPPER(aom_highbd_sad32x32)
 MAKE_BFP_SADAVG_WRAPPER(aom_highbd_sad32x32_avg)
@@ -1012,26 +1031,26 @@ static void highbd_set_var_fns(AV1_COMP *const cpi) {
         HIGHBD_BFP(BLOCK_32X16, aom_highbd_sad32x16_bits8,
                    aom_highbd_sad32x16_avg_bits8, aom_highbd_8_variance32x16,
                    aom_highbd_8_sub_pixel_variance32x16,
-                   aom_highbd_8_sub_pixel_avg_variance32x16, NULL, NULL,
-                   aom_highbd_sad32x16x4d_bits8)
+                   aom_highbd_8_sub_pixel_avg_variance32x16, NULL,
+                   aom_highbd_sad32x16x8_bits8, aom_highbd_sad32x16x4d_bits8)
 
         HIGHBD_BFP(BLOCK_16X32, aom_highbd_sad16x32_bits8,
                    aom_highbd_sad16x32_avg_bits8, aom_highbd_8_variance16x32,
                    aom_highbd_8_sub_pixel_variance16x32,
-                   aom_highbd_8_sub_pixel_avg_variance16x32, NULL, NULL,
-                   aom_highbd_sad16x32x4d_bits8)
+                   aom_highbd_8_sub_pixel_avg_variance16x32, NULL,
+                   aom_highbd_sad16x32x8_bits8, aom_highbd_sad16x32x4d_bits8)
 
         HIGHBD_BFP(BLOCK_64X32, aom_highbd_sad64x32_bits8,
                    aom_highbd_sad64x32_avg_bits8, aom_highbd_8_variance64x32,
                    aom_highbd_8_sub_pixel_variance64x32,
-                   aom_highbd_8_sub_pixel_avg_variance64x32, NULL, NULL,
-                   aom_highbd_sad64x32x4d_bits8)
+                   aom_highbd_8_sub_pixel_avg_variance64x32, NULL,
+                   aom_highbd_sad64x32x8_bits8, aom_highbd_sad64x32x4d_bits8)
 
         HIGHBD_BFP(BLOCK_32X64, aom_highbd_sad32x64_bits8,
                    aom_highbd_sad32x64_avg_bits8, aom_highbd_8_variance32x64,
                    aom_highbd_8_sub_pixel_variance32x64,
-                   aom_highbd_8_sub_pixel_avg_variance32x64, NULL, NULL,
-                   aom_highbd_sad32x64x4d_bits8)
+                   aom_highbd_8_sub_pixel_avg_variance32x64, NULL,
+                   aom_highbd_sad32x64x8_bits8, aom_highbd_sad32x64x4d_bits8)
 
         HIGHBD_BFP(BLOCK_32X32, aom_highbd_sad32x32_bits8,
                    aom_highbd_sad32x32_avg_bits8, aom_highbd_8_variance32x32,
@@ -1137,26 +1156,26 @@ static void highbd_set_var_fns(AV1_COMP *const cpi) {
         HIGHBD_BFP(BLOCK_32X16, aom_highbd_sad32x16_bits10,
                    aom_highbd_sad32x16_avg_bits10, aom_highbd_10_variance32x16,
                    aom_highbd_10_sub_pixel_variance32x16,
-                   aom_highbd_10_sub_pixel_avg_variance32x16, NULL, NULL,
-                   aom_highbd_sad32x16x4d_bits10)
+                   aom_highbd_10_sub_pixel_avg_variance32x16, NULL,
+                   aom_highbd_sad32x16x8_bits10, aom_highbd_sad32x16x4d_bits10)
 
         HIGHBD_BFP(BLOCK_16X32, aom_highbd_sad16x32_bits10,
                    aom_highbd_sad16x32_avg_bits10, aom_highbd_10_variance16x32,
                    aom_highbd_10_sub_pixel_variance16x32,
-                   aom_highbd_10_sub_pixel_avg_variance16x32, NULL, NULL,
-                   aom_highbd_sad16x32x4d_bits10)
+                   aom_highbd_10_sub_pixel_avg_variance16x32, NULL,
+                   aom_highbd_sad16x32x8_bits10, aom_highbd_sad16x32x4d_bits10)
 
         HIGHBD_BFP(BLOCK_64X32, aom_highbd_sad64x32_bits10,
                    aom_highbd_sad64x32_avg_bits10, aom_highbd_10_variance64x32,
                    aom_highbd_10_sub_pixel_variance64x32,
-                   aom_highbd_10_sub_pixel_avg_variance64x32, NULL, NULL,
-                   aom_highbd_sad64x32x4d_bits10)
+                   aom_highbd_10_sub_pixel_avg_variance64x32, NULL,
+                   aom_highbd_sad64x32x8_bits10, aom_highbd_sad64x32x4d_bits10)
 
         HIGHBD_BFP(BLOCK_32X64, aom_highbd_sad32x64_bits10,
                    aom_highbd_sad32x64_avg_bits10, aom_highbd_10_variance32x64,
                    aom_highbd_10_sub_pixel_variance32x64,
-                   aom_highbd_10_sub_pixel_avg_variance32x64, NULL, NULL,
-                   aom_highbd_sad32x64x4d_bits10)
+                   aom_highbd_10_sub_pixel_avg_variance32x64, NULL,
+                   aom_highbd_sad32x64x8_bits10, aom_highbd_sad32x64x4d_bits10)
 
         HIGHBD_BFP(BLOCK_32X32, aom_highbd_sad32x32_bits10,
                    aom_highbd_sad32x32_avg_bits10, aom_highbd_10_variance32x32,
@@ -1264,26 +1283,26 @@ static void highbd_set_var_fns(AV1_COMP *const cpi) {
         HIGHBD_BFP(BLOCK_32X16, aom_highbd_sad32x16_bits12,
                    aom_highbd_sad32x16_avg_bits12, aom_highbd_12_variance32x16,
                    aom_highbd_12_sub_pixel_variance32x16,
-                   aom_highbd_12_sub_pixel_avg_variance32x16, NULL, NULL,
-                   aom_highbd_sad32x16x4d_bits12)
+                   aom_highbd_12_sub_pixel_avg_variance32x16, NULL,
+                   aom_highbd_sad32x16x8_bits12, aom_highbd_sad32x16x4d_bits12)
 
         HIGHBD_BFP(BLOCK_16X32, aom_highbd_sad16x32_bits12,
                    aom_highbd_sad16x32_avg_bits12, aom_highbd_12_variance16x32,
                    aom_highbd_12_sub_pixel_variance16x32,
-                   aom_highbd_12_sub_pixel_avg_variance16x32, NULL, NULL,
-                   aom_highbd_sad16x32x4d_bits12)
+                   aom_highbd_12_sub_pixel_avg_variance16x32, NULL,
+                   aom_highbd_sad16x32x8_bits12, aom_highbd_sad16x32x4d_bits12)
 
         HIGHBD_BFP(BLOCK_64X32, aom_highbd_sad64x32_bits12,
                    aom_highbd_sad64x32_avg_bits12, aom_highbd_12_variance64x32,
                    aom_highbd_12_sub_pixel_variance64x32,
-                   aom_highbd_12_sub_pixel_avg_variance64x32, NULL, NULL,
-                   aom_highbd_sad64x32x4d_bits12)
+                   aom_highbd_12_sub_pixel_avg_variance64x32, NULL,
+                   aom_highbd_sad64x32x8_bits12, aom_highbd_sad64x32x4d_bits12)
 
         HIGHBD_BFP(BLOCK_32X64, aom_highbd_sad32x64_bits12,
                    aom_highbd_sad32x64_avg_bits12, aom_highbd_12_variance32x64,
                    aom_highbd_12_sub_pixel_variance32x64,
-                   aom_highbd_12_sub_pixel_avg_variance32x64, NULL, NULL,
-                   aom_highbd_sad32x64x4d_bits12)
+                   aom_highbd_12_sub_pixel_avg_variance32x64, NULL,
+                   aom_highbd_sad32x64x8_bits12, aom_highbd_sad32x64x4d_bits12)
 
         HIGHBD_BFP(BLOCK_32X32, aom_highbd_sad32x32_bits12,
                    aom_highbd_sad32x32_avg_bits12, aom_highbd_12_variance32x32,
@@ -1575,15 +1594,6 @@ static void cal_nmvsadcosts_hp(int *mvsadcost[2]) {
   } while (++i <= MV_MAX);
 }
 
-static INLINE void init_upsampled_ref_frame_bufs(AV1_COMP *cpi) {
-  int i;
-
-  for (i = 0; i < MAX_UPSAMPLED_BUFS; ++i) {
-    cpi->upsampled_ref_bufs[i].ref_count = 0;
-    cpi->upsampled_ref_idx[i] = INVALID_IDX;
-  }
-}
-
 AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
                                 BufferPool *const pool) {
   unsigned int i;
@@ -1754,8 +1764,6 @@ AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
     av1_init_second_pass(cpi);
   }
 
-  init_upsampled_ref_frame_bufs(cpi);
-
   av1_set_speed_features_framesize_independent(cpi);
   av1_set_speed_features_framesize_dependent(cpi);
 
@@ -1776,20 +1784,20 @@ AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
   cpi->fn_ptr[BT].sdx4df = SDX4DF;
 
   BFP(BLOCK_32X16, aom_sad32x16, aom_sad32x16_avg, aom_variance32x16,
-      aom_sub_pixel_variance32x16, aom_sub_pixel_avg_variance32x16, NULL, NULL,
-      aom_sad32x16x4d)
+      aom_sub_pixel_variance32x16, aom_sub_pixel_avg_variance32x16, NULL,
+      aom_sad32x16x8, aom_sad32x16x4d)
 
   BFP(BLOCK_16X32, aom_sad16x32, aom_sad16x32_avg, aom_variance16x32,
-      aom_sub_pixel_variance16x32, aom_sub_pixel_avg_variance16x32, NULL, NULL,
-      aom_sad16x32x4d)
+      aom_sub_pixel_variance16x32, aom_sub_pixel_avg_variance16x32, NULL,
+      aom_sad16x32x8, aom_sad16x32x4d)
 
   BFP(BLOCK_64X32, aom_sad64x32, aom_sad64x32_avg, aom_variance64x32,
-      aom_sub_pixel_variance64x32, aom_sub_pixel_avg_variance64x32, NULL, NULL,
-      aom_sad64x32x4d)
+      aom_sub_pixel_variance64x32, aom_sub_pixel_avg_variance64x32, NULL,
+      aom_sad64x32x8, aom_sad64x32x4d)
 
   BFP(BLOCK_32X64, aom_sad32x64, aom_sad32x64_avg, aom_variance32x64,
-      aom_sub_pixel_variance32x64, aom_sub_pixel_avg_variance32x64, NULL, NULL,
-      aom_sad32x64x4d)
+      aom_sub_pixel_variance32x64, aom_sub_pixel_avg_variance32x64, NULL,
+      aom_sad32x64x8, aom_sad32x64x4d)
 
   BFP(BLOCK_32X32, aom_sad32x32, aom_sad32x32_avg, aom_variance32x32,
       aom_sub_pixel_variance32x32, aom_sub_pixel_avg_variance32x32,
@@ -1871,9 +1879,6 @@ AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
    * av1_init_quantizer() for every frame.
    */
   av1_init_quantizer(cpi);
-#if CONFIG_AOM_QM
-  aom_qm_init(cm);
-#endif
 
   av1_loop_filter_init(cm);
 
@@ -1989,6 +1994,11 @@ void av1_remove_compressor(AV1_COMP *cpi) {
   aom_free(cpi->tile_thr_data);
   aom_free(cpi->workers);
 
+  for (t = 0; t < cpi->num_ref_search_workers; ++t)
+    aom_get_worker_interface()->end(&cpi->ref_search_workers[t]);
+  aom_free(cpi->ref_search_thr_data);
+  aom_free(cpi->ref_search_workers);
+
   if (cpi->num_workers > 1) av1_loop_filter_dealloc(&cpi->lf_row_sync);
 
   dealloc_compressor_data(cpi);
@@ -2334,75 +2344,9 @@ static int recode_loop_test(AV1_COMP *cpi, int high_limit, int low_limit, int q,
   return force_recode;
 }
 
-static INLINE int get_free_upsampled_ref_buf(EncRefCntBuffer *ubufs) {
-  int i;
-
-  for (i = 0; i < MAX_UPSAMPLED_BUFS; i++) {
-    if (!ubufs[i].ref_count) {
-      return i;
-    }
-  }
-  return INVALID_IDX;
-}
-
-// Up-sample 1 reference frame.
-static INLINE int upsample_ref_frame(AV1_COMP *cpi,
-                                     const YV12_BUFFER_CONFIG *const ref) {
-  AV1_COMMON *const cm = &cpi->common;
-  EncRefCntBuffer *ubufs = cpi->upsampled_ref_bufs;
-  int new_uidx = get_free_upsampled_ref_buf(ubufs);
-
-  if (new_uidx == INVALID_IDX) {
-    return INVALID_IDX;
-  } else {
-    YV12_BUFFER_CONFIG *upsampled_ref = &ubufs[new_uidx].buf;
-
-    // Can allocate buffer for Y plane only.
-    if (upsampled_ref->buffer_alloc_sz < (ref->buffer_alloc_sz << 6))
-      if (aom_realloc_frame_buffer(upsampled_ref, (cm->width << 3),
-                                   (cm->height << 3), cm->subsampling_x,
-                                   cm->subsampling_y,
-#if CONFIG_AOM_HIGHBITDEPTH
-                                   cm->use_highbitdepth,
-#endif
-                                   (AOM_BORDER_IN_PIXELS << 3),
-                                   cm->byte_alignment, NULL, NULL, NULL))
-        aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
-                           "Failed to allocate up-sampled frame buffer");
-
-// Currently, only Y plane is up-sampled, U, V are not used.
-#if CONFIG_AOM_HIGHBITDEPTH
-    scale_and_extend_frame(ref, upsampled_ref, 1, (int)cm->bit_depth);
-#else
-    scale_and_extend_frame(ref, upsampled_ref, 1);
-#endif
-    return new_uidx;
-  }
-}
-
 void av1_update_reference_frames(AV1_COMP *cpi) {
   AV1_COMMON *const cm = &cpi->common;
   BufferPool *const pool = cm->buffer_pool;
-  const int use_upsampled_ref = cpi->sf.use_upsampled_references;
-  int new_uidx = 0;
-
-  if (use_upsampled_ref) {
-#if CONFIG_EXT_REFS
-    if (cm->show_existing_frame) {
-      new_uidx = cpi->upsampled_ref_idx[cpi->existing_fb_idx_to_show];
-      assert(cpi->upsampled_ref_bufs[new_uidx].ref_count > 0);
-    } else {
-#endif  // CONFIG_EXT_REFS
-      // Up-sample the current encoded frame.
-      RefCntBuffer *bufs = pool->frame_bufs;
-      const YV12_BUFFER_CONFIG *const ref = &bufs[cm->new_fb_idx].buf;
-
-      new_uidx = upsample_ref_frame(cpi, ref);
-#if CONFIG_EXT_REFS
-    }
-#endif  // CONFIG_EXT_REFS
-  }
-  assert(new_uidx != -1);
 
   // At this point the new frame has been encoded.
   // If any buffer copy / swapping is signaled it should be done here.
@@ -2415,16 +2359,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
 #endif  // CONFIG_EXT_REFS
     ref_cnt_fb(pool->frame_bufs, &cm->ref_frame_map[cpi->alt_fb_idx],
                cm->new_fb_idx);
-    if (use_upsampled_ref) {
-      uref_cnt_fb(cpi->upsampled_ref_bufs,
-                  &cpi->upsampled_ref_idx[cpi->gld_fb_idx], new_uidx);
-#if CONFIG_EXT_REFS
-      uref_cnt_fb(cpi->upsampled_ref_bufs,
-                  &cpi->upsampled_ref_idx[cpi->bwd_fb_idx], new_uidx);
-#endif  // CONFIG_EXT_REFS
-      uref_cnt_fb(cpi->upsampled_ref_bufs,
-                  &cpi->upsampled_ref_idx[cpi->alt_fb_idx], new_uidx);
-    }
   } else if (av1_preserve_existing_gf(cpi)) {
     // We have decided to preserve the previously existing golden frame as our
     // new ARF frame. However, in the short term in function
@@ -2438,9 +2372,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
 
     ref_cnt_fb(pool->frame_bufs, &cm->ref_frame_map[cpi->alt_fb_idx],
                cm->new_fb_idx);
-    if (use_upsampled_ref)
-      uref_cnt_fb(cpi->upsampled_ref_bufs,
-                  &cpi->upsampled_ref_idx[cpi->alt_fb_idx], new_uidx);
 
     tmp = cpi->alt_fb_idx;
     cpi->alt_fb_idx = cpi->gld_fb_idx;
@@ -2454,9 +2385,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
       }
 
       ref_cnt_fb(pool->frame_bufs, &cm->ref_frame_map[arf_idx], cm->new_fb_idx);
-      if (use_upsampled_ref)
-        uref_cnt_fb(cpi->upsampled_ref_bufs, &cpi->upsampled_ref_idx[arf_idx],
-                    new_uidx);
 
       memcpy(cpi->interp_filter_selected[ALTREF_FRAME],
              cpi->interp_filter_selected[0],
@@ -2466,9 +2394,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
     if (cpi->refresh_golden_frame) {
       ref_cnt_fb(pool->frame_bufs, &cm->ref_frame_map[cpi->gld_fb_idx],
                  cm->new_fb_idx);
-      if (use_upsampled_ref)
-        uref_cnt_fb(cpi->upsampled_ref_bufs,
-                    &cpi->upsampled_ref_idx[cpi->gld_fb_idx], new_uidx);
 
       if (!cpi->rc.is_src_frame_alt_ref)
         memcpy(cpi->interp_filter_selected[GOLDEN_FRAME],
@@ -2484,9 +2409,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
     if (cpi->refresh_bwd_ref_frame) {
       ref_cnt_fb(pool->frame_bufs, &cm->ref_frame_map[cpi->bwd_fb_idx],
                  cm->new_fb_idx);
-      if (use_upsampled_ref)
-        uref_cnt_fb(cpi->upsampled_ref_bufs,
-                    &cpi->upsampled_ref_idx[cpi->bwd_fb_idx], new_uidx);
 
       memcpy(cpi->interp_filter_selected[BWDREF_FRAME],
              cpi->interp_filter_selected[0],
@@ -2534,11 +2456,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
         ref_cnt_fb(pool->frame_bufs,
                    &cm->ref_frame_map[cpi->lst_fb_idxes[ref_frame]],
                    cm->new_fb_idx);
-
-        if (use_upsampled_ref)
-          uref_cnt_fb(cpi->upsampled_ref_bufs,
-                      &cpi->upsampled_ref_idx[cpi->lst_fb_idxes[ref_frame]],
-                      new_uidx);
       }
     } else {
       int tmp;
@@ -2547,12 +2464,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
                  &cm->ref_frame_map[cpi->lst_fb_idxes[LAST_REF_FRAMES - 1]],
                  cm->new_fb_idx);
 
-      if (use_upsampled_ref)
-        uref_cnt_fb(
-            cpi->upsampled_ref_bufs,
-            &cpi->upsampled_ref_idx[cpi->lst_fb_idxes[LAST_REF_FRAMES - 1]],
-            new_uidx);
-
       tmp = cpi->lst_fb_idxes[LAST_REF_FRAMES - 1];
       for (ref_frame = LAST_REF_FRAMES - 1; ref_frame > 0; --ref_frame) {
         cpi->lst_fb_idxes[ref_frame] = cpi->lst_fb_idxes[ref_frame - 1];
@@ -2580,9 +2491,6 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
 #else
     ref_cnt_fb(pool->frame_bufs, &cm->ref_frame_map[cpi->lst_fb_idx],
                cm->new_fb_idx);
-    if (use_upsampled_ref)
-      uref_cnt_fb(cpi->upsampled_ref_bufs,
-                  &cpi->upsampled_ref_idx[cpi->lst_fb_idx], new_uidx);
 
     if (!cpi->rc.is_src_frame_alt_ref)
       memcpy(cpi->interp_filter_selected[LAST_FRAME],
@@ -2595,6 +2503,7 @@ void av1_update_reference_frames(AV1_COMP *cpi) {
 static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
   MACROBLOCKD *xd = &cpi->td.mb.e_mbd;
   struct loopfilter *lf = &cm->lf;
+  int borders_extended = 0;
   if (is_lossless_requested(&cpi->oxcf)) {
     lf->filter_level = 0;
   } else {
@@ -2611,12 +2520,22 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
   }
 
   if (lf->filter_level > 0) {
-    if (cpi->num_workers > 1)
+    if (cpi->num_workers > 1) {
+#if CONFIG_CLPF || CONFIG_DERING
+      // CLPF and deringing filter the frame after the loop filter, so the
+      // borders can only be extended once they are done.
+      const int extend_borders = 0;
+#else
+      const int extend_borders = 1;
+#endif  // CONFIG_CLPF || CONFIG_DERING
       av1_loop_filter_frame_mt(cm->frame_to_show, cm, xd->plane,
-                               lf->filter_level, 0, 0, cpi->workers,
-                               cpi->num_workers, &cpi->lf_row_sync);
-    else
+                               lf->filter_level, 0, 0, extend_borders,
+                               cpi->workers, cpi->num_workers,
+                               &cpi->lf_row_sync);
+      borders_extended = extend_borders;
+    } else {
       av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level, 0, 0);
+    }
   }
 
 #if CONFIG_CLPF
@@ -2657,7 +2576,7 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
   }
 #endif  // CONFIG_DERING
 
-  aom_extend_frame_inner_borders(cm->frame_to_show);
+  if (!borders_extended) aom_extend_frame_inner_borders(cm->frame_to_show);
 }
 
 static INLINE void alloc_frame_mvs(const AV1_COMMON *cm, int buffer_idx) {
@@ -2744,31 +2663,6 @@ void av1_scale_references(AV1_COMP *cpi) {
           alloc_frame_mvs(cm, new_fb);
         }
 #endif  // CONFIG_AOM_HIGHBITDEPTH
-
-        if (cpi->sf.use_upsampled_references &&
-            (force_scaling || new_fb_ptr->buf.y_crop_width != cm->width ||
-             new_fb_ptr->buf.y_crop_height != cm->height)) {
-          const int map_idx = get_ref_frame_map_idx(cpi, ref_frame);
-          EncRefCntBuffer *ubuf =
-              &cpi->upsampled_ref_bufs[cpi->upsampled_ref_idx[map_idx]];
-
-          if (aom_realloc_frame_buffer(&ubuf->buf, (cm->width << 3),
-                                       (cm->height << 3), cm->subsampling_x,
-                                       cm->subsampling_y,
-#if CONFIG_AOM_HIGHBITDEPTH
-                                       cm->use_highbitdepth,
-#endif
-                                       (AOM_BORDER_IN_PIXELS << 3),
-                                       cm->byte_alignment, NULL, NULL, NULL))
-            aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
-                               "Failed to allocate up-sampled frame buffer");
-#if CONFIG_AOM_HIGHBITDEPTH
-          scale_and_extend_frame(&new_fb_ptr->buf, &ubuf->buf, 1,
-                                 (int)cm->bit_depth);
-#else
-          scale_and_extend_frame(&new_fb_ptr->buf, &ubuf->buf, 1);
-#endif
-        }
       } else {
         const int buf_idx = get_ref_frame_buf_idx(cpi, ref_frame);
         RefCntBuffer *const buf = &pool->frame_bufs[buf_idx];
@@ -3067,26 +2961,9 @@ static void set_frame_size(AV1_COMP *cpi) {
   set_ref_ptrs(cm, xd, LAST_FRAME, LAST_FRAME);
 }
 
-static void reset_use_upsampled_references(AV1_COMP *cpi) {
-  MV_REFERENCE_FRAME ref_frame;
-
-  // reset up-sampled reference buffer structure.
-  init_upsampled_ref_frame_bufs(cpi);
-
-  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
-    const YV12_BUFFER_CONFIG *const ref = get_ref_frame_buffer(cpi, ref_frame);
-    int new_uidx = upsample_ref_frame(cpi, ref);
-
-    // Update the up-sampled reference index.
-    cpi->upsampled_ref_idx[get_ref_frame_map_idx(cpi, ref_frame)] = new_uidx;
-    cpi->upsampled_ref_bufs[new_uidx].ref_count++;
-  }
-}
-
 static void encode_without_recode_loop(AV1_COMP *cpi) {
   AV1_COMMON *const cm = &cpi->common;
   int q = 0, bottom_index = 0, top_index = 0;  // Dummy variables.
-  const int use_upsampled_ref = cpi->sf.use_upsampled_references;
 
   aom_clear_system_state();
 
@@ -3118,12 +2995,6 @@ static void encode_without_recode_loop(AV1_COMP *cpi) {
   set_size_independent_vars(cpi);
   set_size_dependent_vars(cpi, &q, &bottom_index, &top_index);
 
-  // cpi->sf.use_upsampled_references can be different from frame to frame.
-  // Every time when cpi->sf.use_upsampled_references is changed from 0 to 1.
-  // The reference frames for this frame have to be up-sampled before encoding.
-  if (!use_upsampled_ref && cpi->sf.use_upsampled_references)
-    reset_use_upsampled_references(cpi);
-
   av1_set_quantizer(cm, q);
   av1_set_variance_partition_thresholds(cpi, q);
 
@@ -3141,6 +3012,8 @@ static void encode_without_recode_loop(AV1_COMP *cpi) {
   }
   apply_active_map(cpi);
 
+  ++cpi->rd_decision_frame;
+
   // transform / motion compensation build reconstruction frame
   av1_encode_frame(cpi);
 
@@ -3169,16 +3042,9 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
   int frame_over_shoot_limit;
   int frame_under_shoot_limit;
   int q = 0, q_low = 0, q_high = 0;
-  const int use_upsampled_ref = cpi->sf.use_upsampled_references;
 
   set_size_independent_vars(cpi);
 
-  // cpi->sf.use_upsampled_references can be different from frame to frame.
-  // Every time when cpi->sf.use_upsampled_references is changed from 0 to 1.
-  // The reference frames for this frame have to be up-sampled before encoding.
-  if (!use_upsampled_ref && cpi->sf.use_upsampled_references)
-    reset_use_upsampled_references(cpi);
-
   do {
     aom_clear_system_state();
 
@@ -3197,6 +3063,9 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
       // Reconfiguration for change in frame size has concluded.
       cpi->resize_pending = 0;
 
+      // The decisions of another frame or size do not seed the searches.
+      ++cpi->rd_decision_frame;
+
       q_low = bottom_index;
       q_high = top_index;
 
@@ -3796,6 +3665,16 @@ static void encode_frame_to_data_rate(AV1_COMP *cpi, size_t *size,
   if (frame_is_intra_only(cm) == 0) {
     release_scaled_references(cpi);
   }
+  if (cpi->sf.mv.pyramid_search || cpi->oxcf.global_me) {
+    if (av1_build_me_pyramid(&cpi->ref_pyramid[cm->new_fb_idx],
+                             cm->frame_to_show, cm->bit_depth))
+      aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                         "Failed to allocate reference pyramid");
+  } else {
+    av1_invalidate_me_pyramid(&cpi->ref_pyramid[cm->new_fb_idx]);
+  }
+  cpi->recon_id[cm->new_fb_idx] = ++cpi->recon_count;
+  cpi->recon_time_stamp[cm->new_fb_idx] = cpi->source_time_stamp;
   av1_update_reference_frames(cpi);
 
   for (t = TX_4X4; t <= TX_32X32; t++)
@@ -4376,6 +4255,7 @@ int av1_get_compressed_data(AV1_COMP *cpi, unsigned int *frame_flags,
 
     cpi->unscaled_last_source = last_source != NULL ? &last_source->img : NULL;
 
+    cpi->source_time_stamp = source->ts_start;
     *time_stamp = source->ts_start;
     *time_end = source->ts_end;
     *frame_flags = (source->flags & AOM_EFLAG_FORCE_KF) ? FRAMEFLAGS_KEY : 0;
@@ -29,6 +29,9 @@
 #include "av1/encoder/lookahead.h"
 #include "av1/encoder/mbgraph.h"
 #include "av1/encoder/mcomp.h"
+#include "av1/encoder/global_me.h"
+#include "av1/encoder/motion_field.h"
+#include "av1/encoder/pyramid.h"
 #include "av1/encoder/quantize.h"
 #include "av1/encoder/ratectrl.h"
 #include "av1/encoder/rd.h"
@@ -49,12 +52,6 @@
 extern "C" {
 #endif
 
-// av1_update_reference_frames relies on there being 1 more buffer available
-// than the number of used references so a new buffer can always be allocated.
-// Therefore when multi arf mode is enabled, 1 more buffer is required then
-// MAX_REF_FRAMES.
-#define MAX_UPSAMPLED_BUFS (MAX_REF_FRAMES + 1)
-
 typedef struct {
   int nmvjointcost[MV_JOINTS];
   int nmvcosts[2][MV_VALS];
@@ -238,6 +235,10 @@ typedef struct AV1EncoderConfig {
   int tile_rows;
 
   int max_threads;
+  // Run the NEWMV searches of the reference frames of a block in parallel.
+  int ref_search_mt;
+  // Seed the motion search with the estimated camera motion.
+  int global_me;
 
   aom_fixed_buf_t two_pass_stats_in;
   struct aom_codec_pkt_list *output_pkt_list;
@@ -300,11 +301,6 @@ typedef struct IMAGE_STAT {
   double worst;
 } ImageStat;
 
-typedef struct {
-  int ref_count;
-  YV12_BUFFER_CONFIG buf;
-} EncRefCntBuffer;
-
 typedef struct AV1_COMP {
   QUANTS quants;
   ThreadData td;
@@ -323,13 +319,40 @@ typedef struct AV1_COMP {
   YV12_BUFFER_CONFIG *unscaled_last_source;
   YV12_BUFFER_CONFIG scaled_last_source;
 
-  // Up-sampled reference buffers
-  EncRefCntBuffer upsampled_ref_bufs[MAX_UPSAMPLED_BUFS];
-  int upsampled_ref_idx[MAX_UPSAMPLED_BUFS];
+  // Down-scaled luma of the source and of the reconstructed frame buffers,
+  // for sf.mv.pyramid_search and oxcf.global_me.
+  ME_PYRAMID source_pyramid;
+  ME_PYRAMID ref_pyramid[FRAME_BUFFERS];
+
+  // Motion fields shared by the motion searches on the same frame pairs, for
+  // sf.mv.use_motion_field_cache. source_time_stamp identifies the source
+  // being coded, and recon_id and recon_time_stamp the frame in each buffer
+  // and its source.
+  MOTION_FIELD_CACHE motion_field_cache;
+  MOTION_FIELD *motion_field[MAX_REF_FRAMES];
+  // Field of the source of the ALTREF_FRAME relative to the current source,
+  // left by the temporal filter.
+  const MOTION_FIELD *arf_motion_field;
+  int64_t source_time_stamp;
+  int64_t recon_id[FRAME_BUFFERS];
+  int64_t recon_time_stamp[FRAME_BUFFERS];
+  int64_t recon_count;
+
+  // Camera motion of the source relative to each reference frame, for
+  // oxcf.global_me. The ids of a model are the source_time_stamp and recon_id
+  // of its frame pair.
+  GLOBAL_ME_MODEL global_me[MAX_REF_FRAMES];
 
   TileDataEnc *tile_data;
   int allocated_tiles;  // Keep track of memory allocated for tiles.
 
+  // Decisions of the RD searches of the inter blocks of 8x8 and above, one
+  // entry per block of each superblock, and the number of entries allocated.
+  RD_DECISION *rd_decisions;
+  int allocated_rd_decisions;
+  // Counts the frames, but not the encodes of a frame in the recode loop.
+  unsigned int rd_decision_frame;
+
   // For a still frame, this flag is set to 1 to skip partition search.
   int partition_search_skippable_frame;
 
@@ -403,6 +426,15 @@ typedef struct AV1_COMP {
   unsigned int max_mv_magnitude;
   int mv_step_param;
 
+  // Full pixel search ranges for sf.mv.adaptive_search_range, used for the
+  // frame if use_search_range_map is set, 0 where unknown: the range of each
+  // reference frame, and of each superblock per frame of distance to the
+  // reference, whichever is smaller.
+  int ref_search_range[MAX_REF_FRAMES];
+  int ref_frame_distance[MAX_REF_FRAMES];
+  uint16_t *search_range_map;
+  int use_search_range_map;
+
   int allow_comp_inter_inter;
 
   unsigned char *segmentation_map;
@@ -535,6 +567,12 @@ typedef struct AV1_COMP {
   AVxWorker *workers;
   struct EncWorkerData *tile_thr_data;
   AV1LfSync lf_row_sync;
+  // Threads running the reference frame searches of a block, used for the
+  // frame if use_ref_search_mt is set.
+  int num_ref_search_workers;
+  AVxWorker *ref_search_workers;
+  struct RefSearchWorkerData *ref_search_thr_data;
+  int use_ref_search_mt;
 #if CONFIG_ANS
   struct BufAnsCoder buf_ans;
 #endif  // CONFIG_ANS
@@ -621,12 +659,16 @@ static INLINE YV12_BUFFER_CONFIG *get_ref_frame_buffer(
                                 : NULL;
 }
 
-static INLINE const YV12_BUFFER_CONFIG *get_upsampled_ref(
-    const AV1_COMP *cpi, const MV_REFERENCE_FRAME ref_frame) {
-  // Use up-sampled reference frames.
-  const int buf_idx =
-      cpi->upsampled_ref_idx[get_ref_frame_map_idx(cpi, ref_frame)];
-  return &cpi->upsampled_ref_bufs[buf_idx].buf;
+// Returns the pyramid of ref_frame, or NULL if it has not been built at the
+// current frame size.
+static INLINE const ME_PYRAMID *get_ref_me_pyramid(
+    const AV1_COMP *cpi, MV_REFERENCE_FRAME ref_frame) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const int buf_idx = get_ref_frame_buf_idx(cpi, ref_frame);
+  if (buf_idx == INVALID_IDX ||
+      !av1_me_pyramid_valid(&cpi->ref_pyramid[buf_idx], cm->width, cm->height))
+    return NULL;
+  return &cpi->ref_pyramid[buf_idx];
 }
 
 #if CONFIG_EXT_REFS
@@ -702,18 +744,6 @@ void av1_new_framerate(AV1_COMP *cpi, double framerate);
 
 #define LAYER_IDS_TO_IDX(sl, tl, num_tl) ((sl) * (num_tl) + (tl))
 
-// Update up-sampled reference frame index.
-static INLINE void uref_cnt_fb(EncRefCntBuffer *ubufs, int *uidx,
-                               int new_uidx) {
-  const int ref_index = *uidx;
-
-  if (ref_index >= 0 && ubufs[ref_index].ref_count > 0)
-    ubufs[ref_index].ref_count--;
-
-  *uidx = new_uidx;
-  ubufs[new_uidx].ref_count++;
-}
-
 #ifdef __cplusplus
 }  // extern "C"
 #endif
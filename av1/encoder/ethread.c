@@ -171,3 +171,53 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
     }
   }
 }
+
+void av1_setup_ref_search_workers(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  const int num_workers =
+      AOMMIN(cpi->oxcf.max_threads, MAX_REF_SEARCH_WORKERS);
+  int i;
+
+  // The tile threads already use the cores when the tile columns are encoded
+  // in parallel.
+  cpi->use_ref_search_mt =
+      cpi->oxcf.ref_search_mt && num_workers > 1 &&
+      AOMMIN(cpi->oxcf.max_threads, 1 << cm->log2_tile_cols) <= 1;
+  if (!cpi->use_ref_search_mt) return;
+
+  // Only run once to create threads and allocate thread data.
+  if (cpi->num_ref_search_workers == 0) {
+    CHECK_MEM_ERROR(
+        cm, cpi->ref_search_workers,
+        aom_malloc(num_workers * sizeof(*cpi->ref_search_workers)));
+    CHECK_MEM_ERROR(
+        cm, cpi->ref_search_thr_data,
+        aom_memalign(32, num_workers * sizeof(*cpi->ref_search_thr_data)));
+    memset(cpi->ref_search_thr_data, 0,
+           num_workers * sizeof(*cpi->ref_search_thr_data));
+
+    for (i = 0; i < num_workers; i++) {
+      AVxWorker *const worker = &cpi->ref_search_workers[i];
+
+      ++cpi->num_ref_search_workers;
+      winterface->init(worker);
+      cpi->ref_search_thr_data[i].cpi = cpi;
+
+      // The main thread runs the last worker.
+      if (i < num_workers - 1 && !winterface->reset(worker))
+        aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                           "Reference search thread creation failed");
+      winterface->sync(worker);
+    }
+  }
+
+  // Before encoding a frame, copy the MACROBLOCK from cpi.
+  for (i = 0; i < cpi->num_ref_search_workers; i++) {
+    RefSearchWorkerData *const thread_data = &cpi->ref_search_thr_data[i];
+    thread_data->x = cpi->td.mb;
+    thread_data->x.m_search_count_ptr = &thread_data->m_search_count;
+    thread_data->x.ex_search_count_ptr = &thread_data->ex_search_count;
+    cpi->ref_search_workers[i].data1 = thread_data;
+  }
+}
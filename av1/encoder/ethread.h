@@ -12,6 +12,9 @@
 #ifndef AV1_ENCODER_ETHREAD_H_
 #define AV1_ENCODER_ETHREAD_H_
 
+#include "av1/encoder/block.h"
+#include "av1/encoder/motion_field.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,8 +28,46 @@ typedef struct EncWorkerData {
   int start;
 } EncWorkerData;
 
+// The NEWMV search of one single reference frame of a block, run ahead of
+// the mode search of the block.
+typedef struct {
+  int valid;
+  MV_REFERENCE_FRAME ref;
+  int_mv mv;
+  int rate_mv;
+  // The MACROBLOCK state that the search updates, copied back when the
+  // result is used.
+  MV pred_mv;
+  unsigned int pred_sse;
+  // The motion field entry of the search, stored when the result is used.
+  MOTION_FIELD_BLOCK field_result;
+  int m_search_count;
+  int ex_search_count;
+} REF_SEARCH_JOB;
+
+typedef struct RefSearchWorkerData {
+  struct AV1_COMP *cpi;
+  // Private copy of the MACROBLOCK of the frame, with its own mode info, so
+  // that the searches of several references can run at the same time.
+  MACROBLOCK x;
+  MODE_INFO mi;
+  MODE_INFO *mi_ptr;
+  MB_MODE_INFO_EXT mbmi_ext;
+  int m_search_count;
+  int ex_search_count;
+  int start;
+} RefSearchWorkerData;
+
+// Maximum number of threads used for the reference frame searches of a
+// block: one per single reference frame.
+#define MAX_REF_SEARCH_WORKERS (ALTREF_FRAME - LAST_FRAME + 1)
+
 void av1_encode_tiles_mt(struct AV1_COMP *cpi);
 
+// Sets cpi->use_ref_search_mt for the frame, creating the reference search
+// threads on first use and copying the MACROBLOCK of the frame to them.
+void av1_setup_ref_search_workers(struct AV1_COMP *cpi);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -2630,6 +2630,109 @@ void av1_rc_get_second_pass_params(AV1_COMP *cpi) {
   subtract_stats(&twopass->total_left_stats, &this_frame);
 }
 
+// Margin in full pixels between the first pass motion of a frame and its
+// search range, and range of the superblocks that did not move in the first
+// pass, per frame of distance to the reference.
+#define SEARCH_RANGE_MARGIN 8
+#define STATIC_SEARCH_RANGE 4
+
+// Below this share of blocks coded inter in the first pass, its vectors miss
+// too much of the motion to limit the search.
+#define SEARCH_RANGE_MIN_PCNT_INTER 0.5
+
+// Returns the search range in full pixels that covers the first pass motion
+// of a frame relative to the previous one, or 0 if that is unreliable.
+static int get_frame_search_range(const FIRSTPASS_STATS *stats) {
+  double row, col;
+  if (stats->pcnt_inter < SEARCH_RANGE_MIN_PCNT_INTER) return 0;
+  // Mean and three standard deviations of the moving blocks, in 1/8 pixels.
+  row = stats->mvr_abs + 3 * sqrt(AOMMAX(stats->MVrv, 0));
+  col = stats->mvc_abs + 3 * sqrt(AOMMAX(stats->MVcv, 0));
+  return (int)ceil(AOMMAX(row, col) / 8) + SEARCH_RANGE_MARGIN;
+}
+
+#if CONFIG_FP_MB_STATS
+// Returns 1 if all the macroblocks of the superblock at sb_row, sb_col did
+// not move in the first pass.
+static int is_static_sb(const AV1_COMP *cpi, int sb_row, int sb_col) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const int mbs = MAX_MIB_SIZE / 2;
+  const int row_end = AOMMIN((sb_row + 1) * mbs, cm->mb_rows);
+  const int col_end = AOMMIN((sb_col + 1) * mbs, cm->mb_cols);
+  int r, c;
+  for (r = sb_row * mbs; r < row_end; ++r) {
+    for (c = sb_col * mbs; c < col_end; ++c) {
+      const uint8_t fp_byte =
+          cpi->twopass.this_frame_mb_stats[r * cm->mb_cols + c];
+      if (!(fp_byte & FPMB_MOTION_ZERO_MASK) || (fp_byte & FPMB_DCINTRA_MASK))
+        return 0;
+    }
+  }
+  return 1;
+}
+#endif  // CONFIG_FP_MB_STATS
+
+void av1_setup_search_range_map(AV1_COMP *cpi) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const TWO_PASS *const twopass = &cpi->twopass;
+  const int sb_rows = (cm->mi_rows + MAX_MIB_SIZE - 1) >> MAX_MIB_SIZE_LOG2;
+  const int sb_cols = (cm->mi_cols + MAX_MIB_SIZE - 1) >> MAX_MIB_SIZE_LOG2;
+  const int num_stats = (int)(twopass->stats_in_end - twopass->stats_in_start);
+  int index, sb_row, sb_col;
+  MV_REFERENCE_FRAME ref;
+
+  cpi->use_search_range_map = 0;
+  if (!cpi->sf.mv.adaptive_search_range || cpi->oxcf.pass != 2 ||
+      frame_is_intra_only(cm) || !twopass->stats_in_start || num_stats <= 0)
+    return;
+
+  aom_clear_system_state();
+  index = (int)floor((double)(cpi->source_time_stamp -
+                              cpi->first_time_stamp_ever) *
+                         cpi->framerate / 10000000.0 +
+                     0.5);
+  for (ref = LAST_FRAME; ref <= ALTREF_FRAME; ++ref) {
+    const int buf_idx = get_ref_frame_buf_idx(cpi, ref);
+    int64_t delta;
+    int dist, first, i, range = 0;
+
+    cpi->ref_frame_distance[ref] = 0;
+    cpi->ref_search_range[ref] = 0;
+    if (buf_idx == INVALID_IDX || !cpi->recon_id[buf_idx]) continue;
+    // Distance in frames from the source time stamps.
+    delta = cpi->source_time_stamp - cpi->recon_time_stamp[buf_idx];
+    dist = (int)floor(fabs((double)delta) * cpi->framerate / 10000000.0 + 0.5);
+    dist = AOMMAX(dist, 1);
+    cpi->ref_frame_distance[ref] = dist;
+
+    // The first pass motion of frame i is relative to frame i - 1, so the
+    // motion to the reference is covered by the dist frames after the first
+    // of the two.
+    first = delta >= 0 ? index - dist + 1 : index + 1;
+    for (i = AOMMAX(first, 1); i < first + dist; ++i) {
+      const int frame_range =
+          i < num_stats ? get_frame_search_range(&twopass->stats_in_start[i])
+                        : 0;
+      if (!frame_range) break;
+      range = AOMMAX(range, frame_range);
+    }
+    if (i == first + dist)
+      cpi->ref_search_range[ref] = AOMMIN(range * dist, MAX_FULL_PEL_VAL);
+  }
+
+  for (sb_row = 0; sb_row < sb_rows; ++sb_row) {
+    for (sb_col = 0; sb_col < sb_cols; ++sb_col) {
+      uint16_t range = 0;
+#if CONFIG_FP_MB_STATS
+      if (cpi->use_fp_mb_stats && is_static_sb(cpi, sb_row, sb_col))
+        range = STATIC_SEARCH_RANGE;
+#endif  // CONFIG_FP_MB_STATS
+      cpi->search_range_map[sb_row * sb_cols + sb_col] = range;
+    }
+  }
+  cpi->use_search_range_map = 1;
+}
+
 #define MINQ_ADJ_LIMIT 48
 #define MINQ_ADJ_LIMIT_CQ 20
 #define HIGH_UNDERSHOOT_RATIO 2
@@ -174,6 +174,12 @@ void av1_twopass_postencode_update(struct AV1_COMP *cpi);
 
 void av1_init_subsampling(struct AV1_COMP *cpi);
 
+// Sets the motion search range of each reference frame from the first pass
+// motion of the frames between the frame and the reference, and the range of
+// each superblock per frame of distance to the reference from the first pass
+// macroblock stats, for sf.mv.adaptive_search_range.
+void av1_setup_search_range_map(struct AV1_COMP *cpi);
+
 void av1_calculate_coded_size(struct AV1_COMP *cpi, int *scaled_frame_width,
                               int *scaled_frame_height);
 
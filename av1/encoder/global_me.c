@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_dsp/variance.h"
+#include "aom_mem/aom_mem.h"
+#include "aom_ports/system_state.h"
+#include "av1/common/common_data.h"
+#include "av1/encoder/global_me.h"
+
+// The blocks are 16x16 at 1/4 resolution, that is 64x64 in the frame. Their
+// vectors are searched exhaustively within GLOBAL_ME_RANGE of the start
+// vector and of zero at 1/4 resolution, and refined by one pixel at 1/2
+// resolution.
+#define GLOBAL_ME_BLOCK 16
+#define GLOBAL_ME_RANGE 8
+
+// Largest vector at 1/4 resolution whose refinement stays within the border
+// of the 1/2 resolution level.
+#define GLOBAL_ME_MAX_MV ((ME_PYRAMID_BORDER - 1) / 2)
+
+// Blocks whose sum of horizontal and vertical absolute gradients is below
+// this are too flat to give a reliable vector.
+#define GLOBAL_ME_MIN_GRADIENT (2 * 2 * GLOBAL_ME_BLOCK * GLOBAL_ME_BLOCK)
+
+// A block matches a model if neither vector component is further than this
+// many pixels from it.
+#define GLOBAL_ME_INLIER_DIST 4
+
+#define GLOBAL_ME_MIN_BLOCKS 6
+#define GLOBAL_ME_FIT_ITERATIONS 3
+
+typedef struct {
+  // Center of the block, relative to the center of the frame.
+  int x;
+  int y;
+  // Vector in full pixels.
+  int col;
+  int row;
+} GLOBAL_ME_BLOCK_MV;
+
+static void block_search(const ME_PYRAMID_LEVEL *s, const ME_PYRAMID_LEVEL *r,
+                         aom_sad_fn_t sdf, int row, int col, const MV *center,
+                         int range, int max_mv, MV *best,
+                         unsigned int *bestsad) {
+  const uint8_t *const src_buf = s->buf + row * s->stride + col;
+  const uint8_t *const ref_buf = r->buf + row * r->stride + col;
+  const int row_min = AOMMAX(center->row - range, -max_mv);
+  const int row_max = AOMMIN(center->row + range, max_mv);
+  const int col_min = AOMMAX(center->col - range, -max_mv);
+  const int col_max = AOMMIN(center->col + range, max_mv);
+  int i, j;
+
+  for (i = row_min; i <= row_max; ++i) {
+    for (j = col_min; j <= col_max; ++j) {
+      const unsigned int sad =
+          sdf(src_buf, s->stride, ref_buf + i * r->stride + j, r->stride);
+      if (sad < *bestsad) {
+        *bestsad = sad;
+        best->row = i;
+        best->col = j;
+      }
+    }
+  }
+}
+
+// Searches the vector of the block at (row, col) of the 1/4 resolution level.
+// Returns 0 if the block is too flat.
+static int search_block(const ME_PYRAMID *src, const ME_PYRAMID *ref, int row,
+                        int col, const MV *start, MV *mv) {
+  const ME_PYRAMID_LEVEL *const s = &src->level[1];
+  const uint8_t *const src_buf = s->buf + row * s->stride + col;
+  const MV zero_mv = { 0, 0 };
+  unsigned int bestsad = UINT_MAX;
+  MV best = { 0, 0 }, half;
+
+  if (aom_sad16x16(src_buf, s->stride, src_buf + 1, s->stride) +
+          aom_sad16x16(src_buf, s->stride, src_buf + s->stride, s->stride) <
+      GLOBAL_ME_MIN_GRADIENT)
+    return 0;
+
+  block_search(s, &ref->level[1], aom_sad16x16, row, col, &zero_mv,
+               GLOBAL_ME_RANGE, GLOBAL_ME_MAX_MV, &best, &bestsad);
+  if (abs(start->row) > GLOBAL_ME_RANGE || abs(start->col) > GLOBAL_ME_RANGE)
+    block_search(s, &ref->level[1], aom_sad16x16, row, col, start,
+                 GLOBAL_ME_RANGE, GLOBAL_ME_MAX_MV, &best, &bestsad);
+
+  half.row = best.row * 2;
+  half.col = best.col * 2;
+  bestsad = UINT_MAX;
+  block_search(&src->level[0], &ref->level[0], aom_sad32x32, row * 2, col * 2,
+               &half, 1, 2 * GLOBAL_ME_MAX_MV + 1, &best, &bestsad);
+  mv->row = best.row * 2;
+  mv->col = best.col * 2;
+  return 1;
+}
+
+static int block_dist(const GLOBAL_ME_BLOCK_MV *b, const double *par) {
+  const double col = par[0] + par[1] * b->x + par[2] * b->y;
+  const double row = par[3] + par[4] * b->x + par[5] * b->y;
+  return (int)ceil(AOMMAX(fabs(b->col - col), fabs(b->row - row)));
+}
+
+// Marks the blocks within GLOBAL_ME_INLIER_DIST of the model. Returns their
+// number, and their mean distance in residual.
+static int find_inliers(const GLOBAL_ME_BLOCK_MV *blocks, int n,
+                        const double *par, uint8_t *inlier, double *residual) {
+  int i, num_inliers = 0, dist_sum = 0;
+  for (i = 0; i < n; ++i) {
+    const int dist = block_dist(&blocks[i], par);
+    inlier[i] = dist <= GLOBAL_ME_INLIER_DIST;
+    if (inlier[i]) {
+      ++num_inliers;
+      dist_sum += dist;
+    }
+  }
+  *residual = num_inliers ? (double)dist_sum / num_inliers : 0;
+  return num_inliers;
+}
+
+static int compare_ints(const void *a, const void *b) {
+  return *(const int *)a - *(const int *)b;
+}
+
+// Median of the vectors, which tolerates up to half of the blocks moving
+// differently.
+static void fit_translation(const GLOBAL_ME_BLOCK_MV *blocks, int n,
+                            int *tmp, double *par) {
+  int i;
+  for (i = 0; i < n; ++i) tmp[i] = blocks[i].col;
+  qsort(tmp, n, sizeof(*tmp), compare_ints);
+  par[0] = tmp[n / 2];
+  for (i = 0; i < n; ++i) tmp[i] = blocks[i].row;
+  qsort(tmp, n, sizeof(*tmp), compare_ints);
+  par[3] = tmp[n / 2];
+  par[1] = par[2] = par[4] = par[5] = 0;
+}
+
+// Solves a x = b by Cramer's rule. Returns 0 if a is singular.
+static int solve_3x3(double a[3][3], const double *b, double *x) {
+  const double det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+                     a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+                     a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+  int i, j;
+
+  if (fabs(det) < 1e-6) return 0;
+  for (i = 0; i < 3; ++i) {
+    double m[3][3];
+    memcpy(m, a, sizeof(m));
+    for (j = 0; j < 3; ++j) m[j][i] = b[j];
+    x[i] = (m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+            m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+            m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) /
+           det;
+  }
+  return 1;
+}
+
+// Least squares fit of an affine model to the inliers. Returns 0 if they are
+// degenerate, for example all on one row.
+static int fit_affine(const GLOBAL_ME_BLOCK_MV *blocks, int n,
+                      const uint8_t *inlier, double *par) {
+  double a[3][3] = { { 0 } };
+  double bc[3] = { 0 }, br[3] = { 0 };
+  int i, j, k;
+
+  for (i = 0; i < n; ++i) {
+    double v[3];
+    if (!inlier[i]) continue;
+    v[0] = 1;
+    v[1] = blocks[i].x;
+    v[2] = blocks[i].y;
+    for (j = 0; j < 3; ++j) {
+      for (k = 0; k < 3; ++k) a[j][k] += v[j] * v[k];
+      bc[j] += v[j] * blocks[i].col;
+      br[j] += v[j] * blocks[i].row;
+    }
+  }
+  return solve_3x3(a, bc, par) && solve_3x3(a, br, par + 3);
+}
+
+void av1_estimate_global_me(const ME_PYRAMID *src, const ME_PYRAMID *ref,
+                            const MV *start, GLOBAL_ME_MODEL *model) {
+  const ME_PYRAMID_LEVEL *const s = &src->level[1];
+  const int rows = s->height / GLOBAL_ME_BLOCK;
+  const int cols = s->width / GLOBAL_ME_BLOCK;
+  const MV start_q = { start->row / 4, start->col / 4 };
+  GLOBAL_ME_BLOCK_MV *blocks;
+  uint8_t *inlier;
+  int *tmp;
+  double affine[6], affine_residual, residual;
+  int i, j, n = 0, num_inliers;
+
+  model->type = GLOBAL_ME_NONE;
+  model->num_blocks = 0;
+  model->num_inliers = 0;
+  model->residual = 0;
+  model->search_range = 0;
+  model->center_x = src->width / 2;
+  model->center_y = src->height / 2;
+  if (rows * cols < GLOBAL_ME_MIN_BLOCKS) return;
+
+  blocks = (GLOBAL_ME_BLOCK_MV *)aom_malloc(rows * cols * sizeof(*blocks));
+  inlier = (uint8_t *)aom_malloc(rows * cols * sizeof(*inlier));
+  tmp = (int *)aom_malloc(rows * cols * sizeof(*tmp));
+  if (!blocks || !inlier || !tmp) goto done;
+
+  for (i = 0; i < rows; ++i) {
+    for (j = 0; j < cols; ++j) {
+      const int row = i * GLOBAL_ME_BLOCK;
+      const int col = j * GLOBAL_ME_BLOCK;
+      MV mv;
+      if (!search_block(src, ref, row, col, &start_q, &mv)) continue;
+      blocks[n].x = (col + GLOBAL_ME_BLOCK / 2) * 4 - model->center_x;
+      blocks[n].y = (row + GLOBAL_ME_BLOCK / 2) * 4 - model->center_y;
+      blocks[n].col = mv.col;
+      blocks[n].row = mv.row;
+      ++n;
+    }
+  }
+  model->num_blocks = n;
+  if (n < GLOBAL_ME_MIN_BLOCKS) goto done;
+
+  aom_clear_system_state();
+  fit_translation(blocks, n, tmp, model->par);
+  num_inliers = find_inliers(blocks, n, model->par, inlier, &residual);
+
+  // Refit an affine model to the inliers, which then include the blocks that
+  // the translation misses at the edges of a zoom or a rotation. It replaces
+  // the translation if it matches clearly more blocks.
+  if (num_inliers >= 3) {
+    int affine_inliers = num_inliers;
+    for (i = 0; i < GLOBAL_ME_FIT_ITERATIONS; ++i) {
+      if (!fit_affine(blocks, n, inlier, affine)) break;
+      affine_inliers =
+          find_inliers(blocks, n, affine, inlier, &affine_residual);
+      if (affine_inliers < 3) break;
+    }
+    if (i == GLOBAL_ME_FIT_ITERATIONS &&
+        affine_inliers > num_inliers + AOMMAX(1, n / 16)) {
+      memcpy(model->par, affine, sizeof(affine));
+      num_inliers = affine_inliers;
+      residual = affine_residual;
+      model->type = GLOBAL_ME_AFFINE;
+    }
+  }
+  if (model->type == GLOBAL_ME_NONE) model->type = GLOBAL_ME_TRANSLATION;
+
+  model->num_inliers = num_inliers;
+  model->residual = residual;
+  if (num_inliers < AOMMAX(GLOBAL_ME_MIN_BLOCKS, n / 2)) {
+    model->type = GLOBAL_ME_NONE;
+  } else if (num_inliers * 4 >= n * 3) {
+    // The vectors are only accurate to 2 pixels, and the blocks of the
+    // frame are 64x64, so leave room for smaller blocks moving differently.
+    model->search_range = 16 + 4 * (int)ceil(residual);
+  }
+
+done:
+  aom_free(blocks);
+  aom_free(inlier);
+  aom_free(tmp);
+}
+
+void av1_global_me_block_mv(const GLOBAL_ME_MODEL *model, BLOCK_SIZE bsize,
+                            int mi_row, int mi_col, MV *mv) {
+  const int bw = num_4x4_blocks_wide_lookup[bsize] * 4;
+  const int bh = num_4x4_blocks_high_lookup[bsize] * 4;
+  const double x = mi_col * MI_SIZE + bw / 2 - model->center_x;
+  const double y = mi_row * MI_SIZE + bh / 2 - model->center_y;
+  const double *const par = model->par;
+  mv->col = (int16_t)floor(par[0] + par[1] * x + par[2] * y + 0.5);
+  mv->row = (int16_t)floor(par[3] + par[4] * x + par[5] * y + 0.5);
+}
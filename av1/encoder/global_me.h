@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_GLOBAL_ME_H_
+#define AV1_ENCODER_GLOBAL_ME_H_
+
+#include "av1/common/enums.h"
+#include "av1/common/mv.h"
+#include "av1/encoder/pyramid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  GLOBAL_ME_NONE,
+  GLOBAL_ME_TRANSLATION,
+  GLOBAL_ME_AFFINE,
+} GLOBAL_ME_TYPE;
+
+// Camera motion of a source frame relative to a reference frame, fitted to
+// the vectors of a block motion search on the 1/4 resolution pyramids. It is
+// only used to seed the motion search of the blocks, and is not coded.
+typedef struct {
+  // Frame pair of the model, with the ids of the motion field cache.
+  int64_t src_id;
+  int64_t ref_id;
+  GLOBAL_ME_TYPE type;
+  // Displacement in full pixels of the point at (x, y) pixels from the
+  // center of the frame:
+  //   col = par[0] + par[1] * x + par[2] * y
+  //   row = par[3] + par[4] * x + par[5] * y
+  // par[1], par[2], par[4] and par[5] are 0 for a translation.
+  double par[6];
+  int center_x;
+  int center_y;
+  // Number of textured blocks fitted, and of those the model matches.
+  int num_blocks;
+  int num_inliers;
+  // Mean distance in pixels between the vectors of the inliers and the
+  // model.
+  double residual;
+  // Range in full pixels around the model vector that the motion search of a
+  // block following the model is limited to, 0 if the model is not reliable
+  // enough for that.
+  int search_range;
+} GLOBAL_ME_MODEL;
+
+static INLINE void av1_invalidate_global_me(GLOBAL_ME_MODEL *model) {
+  model->type = GLOBAL_ME_NONE;
+  model->src_id = 0;
+  model->ref_id = 0;
+}
+
+// Estimates the model of the frame pair whose luma pyramids are src and ref.
+// start is a guess of the translation in full pixels, typically that of the
+// previous frame. On failure, model->type is GLOBAL_ME_NONE. The ids of the
+// model are left to the caller.
+void av1_estimate_global_me(const ME_PYRAMID *src, const ME_PYRAMID *ref,
+                            const MV *start, GLOBAL_ME_MODEL *model);
+
+// Full pixel vector of the model at the center of the bsize block at mi_row,
+// mi_col.
+void av1_global_me_block_mv(const GLOBAL_ME_MODEL *model, BLOCK_SIZE bsize,
+                            int mi_row, int mi_col, MV *mv);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_GLOBAL_ME_H_
@@ -9,6 +9,7 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <assert.h>
 #include <limits.h>
 #include <math.h>
 #include <stdio.h>
@@ -52,6 +53,13 @@ void av1_set_mv_search_range(MACROBLOCK *x, const MV *mv) {
   if (x->mv_row_max > row_max) x->mv_row_max = row_max;
 }
 
+void av1_limit_mv_search_range(MACROBLOCK *x, const MV *center, int range) {
+  x->mv_col_min = AOMMAX(x->mv_col_min, center->col - range);
+  x->mv_col_max = AOMMIN(x->mv_col_max, center->col + range);
+  x->mv_row_min = AOMMAX(x->mv_row_min, center->row - range);
+  x->mv_row_max = AOMMIN(x->mv_row_max, center->row + range);
+}
+
 int av1_init_search_range(int size) {
   int sr = 0;
   // Minimum search size no matter what the passed in value.
@@ -199,17 +207,11 @@ static INLINE const uint8_t *pre(const uint8_t *buf, int stride, int r, int c) {
 
 #define CHECK_BETTER0(v, r, c) CHECK_BETTER(v, r, c)
 
-static INLINE const uint8_t *upre(const uint8_t *buf, int stride, int r,
-                                  int c) {
-  return &buf[(r)*stride + (c)];
-}
-
 /* checks if (r, c) has better score than previous best */
 #define CHECK_BETTER1(v, r, c)                                                \
   if (c >= minc && c <= maxc && r >= minr && r <= maxr) {                     \
-    thismse =                                                                 \
-        upsampled_pref_error(xd, vfp, z, src_stride, upre(y, y_stride, r, c), \
-                             y_stride, second_pred, w, h, &sse);              \
+    thismse = upsampled_pref_error(xd, vfp, z, src_stride, y, y_stride, r, c, \
+                                   second_pred, w, h, &sse);                  \
     if ((v = MVC(r, c) + thismse) < besterr) {                                \
       besterr = v;                                                            \
       br = r;                                                                 \
@@ -614,33 +616,177 @@ static const MV search_step_table[12] = {
   { -2, 0 }, { 2, 0 }, { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 }
 };
 
+// Returns the pixel at the 1/8 pel offset (r, c) from ref, interpolated with
+// the EIGHTTAP filter.
+static int upsampled_pixel(const MACROBLOCKD *xd, const uint8_t *ref,
+                           int ref_stride, int r, int c) {
+  const InterpFilterParams filter_params = get_interp_filter_params(EIGHTTAP);
+  const int16_t *const filter_x =
+      get_interp_filter_subpel_kernel(filter_params, (c & 7) << 1);
+  const int16_t *const filter_y =
+      get_interp_filter_subpel_kernel(filter_params, (r & 7) << 1);
+  int temp[SUBPEL_TAPS];
+  int i, k, sum;
+
+  ref += ((r >> 3) - (SUBPEL_TAPS / 2 - 1)) * ref_stride + (c >> 3) -
+         (SUBPEL_TAPS / 2 - 1);
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    const uint16_t *const ref16 = CONVERT_TO_SHORTPTR(ref);
+    for (i = 0; i < SUBPEL_TAPS; ++i) {
+      for (k = 0, sum = 0; k < SUBPEL_TAPS; ++k)
+        sum += ref16[i * ref_stride + k] * filter_x[k];
+      temp[i] = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), xd->bd);
+    }
+    for (k = 0, sum = 0; k < SUBPEL_TAPS; ++k) sum += temp[k] * filter_y[k];
+    return clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), xd->bd);
+  }
+#else
+  (void)xd;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  for (i = 0; i < SUBPEL_TAPS; ++i) {
+    for (k = 0, sum = 0; k < SUBPEL_TAPS; ++k)
+      sum += ref[i * ref_stride + k] * filter_x[k];
+    temp[i] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+  }
+  for (k = 0, sum = 0; k < SUBPEL_TAPS; ++k) sum += temp[k] * filter_y[k];
+  return clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+}
+
+// Builds the w x h prediction at the 1/8 pel offset (r, c) from the block at
+// y, as it would be read from the reference up-sampled 8 times with the
+// EIGHTTAP filter. The borders of the up-sampled reference were extended from
+// its edges, so positions outside the frame take the value of the closest
+// position inside it. pred is a uint16_t buffer for high bitdepth frames.
+static void upsampled_pred(const MACROBLOCKD *xd, uint8_t *pred, int w, int h,
+                           const uint8_t *y, int y_stride, int r, int c) {
+  const InterpFilterParams filter_params = get_interp_filter_params(EIGHTTAP);
+  const int16_t *const filter_x =
+      get_interp_filter_subpel_kernel(filter_params, (c & 7) << 1);
+  const int16_t *const filter_y =
+      get_interp_filter_subpel_kernel(filter_params, (r & 7) << 1);
+  const uint8_t *const ref = y + (r >> 3) * y_stride + (c >> 3);
+  // Position of the prediction and of the last pixel of the frame, in 1/8
+  // pel units.
+  const int row0 = r - xd->mb_to_top_edge;
+  const int col0 = c - xd->mb_to_left_edge;
+  const int max_row = (xd->cur_buf->y_crop_height << 3) - 1;
+  const int max_col = (xd->cur_buf->y_crop_width << 3) - 1;
+  int i, j;
+
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    uint8_t *const pred8 = CONVERT_TO_BYTEPTR(pred);
+    if (r & 7) {
+      if (c & 7)
+        aom_highbd_convolve8(ref, y_stride, pred8, w, filter_x, 16, filter_y,
+                             16, w, h, xd->bd);
+      else
+        aom_highbd_convolve8_vert(ref, y_stride, pred8, w, filter_x, 16,
+                                  filter_y, 16, w, h, xd->bd);
+    } else {
+      if (c & 7)
+        aom_highbd_convolve8_horiz(ref, y_stride, pred8, w, filter_x, 16,
+                                   filter_y, 16, w, h, xd->bd);
+      else
+        aom_highbd_convolve_copy(ref, y_stride, pred8, w, NULL, -1, NULL, -1,
+                                 w, h, xd->bd);
+    }
+  } else {
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+    if (r & 7) {
+      if (c & 7)
+        aom_convolve8(ref, y_stride, pred, w, filter_x, 16, filter_y, 16, w,
+                      h);
+      else
+        aom_convolve8_vert(ref, y_stride, pred, w, filter_x, 16, filter_y, 16,
+                           w, h);
+    } else {
+      if (c & 7)
+        aom_convolve8_horiz(ref, y_stride, pred, w, filter_x, 16, filter_y, 16,
+                            w, h);
+      else
+        aom_convolve_copy(ref, y_stride, pred, w, NULL, -1, NULL, -1, w, h);
+    }
+#if CONFIG_AOM_HIGHBITDEPTH
+  }
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+  if (row0 >= 0 && col0 >= 0 && row0 + ((h - 1) << 3) <= max_row &&
+      col0 + ((w - 1) << 3) <= max_col)
+    return;
+
+  // Replace the pixels outside the frame. Clamped positions repeat along
+  // runs, so each distinct one is interpolated once.
+  for (i = 0; i < h; ++i) {
+    const int row = row0 + (i << 3);
+    const int clamped_row = clamp(row, 0, max_row);
+    const int ref_row = clamped_row + xd->mb_to_top_edge;
+    int last_clamped_col = -1;
+
+    if (row != clamped_row && i > 0 &&
+        clamp(row - 8, 0, max_row) == clamped_row) {
+#if CONFIG_AOM_HIGHBITDEPTH
+      if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
+        memcpy((uint16_t *)pred + i * w, (uint16_t *)pred + (i - 1) * w,
+               w * sizeof(uint16_t));
+      else
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+        memcpy(pred + i * w, pred + (i - 1) * w, w);
+      continue;
+    }
+
+    for (j = 0; j < w; ++j) {
+      const int col = col0 + (j << 3);
+      const int clamped_col = clamp(col, 0, max_col);
+      int v;
+      if (row == clamped_row && col == clamped_col) continue;
+      if (clamped_col == last_clamped_col) {
+#if CONFIG_AOM_HIGHBITDEPTH
+        if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
+          v = ((uint16_t *)pred)[i * w + j - 1];
+        else
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+          v = pred[i * w + j - 1];
+      } else {
+        v = upsampled_pixel(xd, y, y_stride, ref_row,
+                            clamped_col + xd->mb_to_left_edge);
+      }
+      last_clamped_col = clamped_col;
+#if CONFIG_AOM_HIGHBITDEPTH
+      if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
+        ((uint16_t *)pred)[i * w + j] = v;
+      else
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+        pred[i * w + j] = v;
+    }
+  }
+}
+
 static int upsampled_pref_error(const MACROBLOCKD *xd,
                                 const aom_variance_fn_ptr_t *vfp,
                                 const uint8_t *const src, const int src_stride,
-                                const uint8_t *const y, int y_stride,
-                                const uint8_t *second_pred, int w, int h,
+                                const uint8_t *const y, int y_stride, int r,
+                                int c, const uint8_t *second_pred, int w, int h,
                                 unsigned int *sse) {
   unsigned int besterr;
 #if CONFIG_AOM_HIGHBITDEPTH
   if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
     DECLARE_ALIGNED(16, uint16_t, pred16[64 * 64]);
+    upsampled_pred(xd, (uint8_t *)pred16, w, h, y, y_stride, r, c);
     if (second_pred != NULL)
-      aom_highbd_comp_avg_upsampled_pred(pred16, second_pred, w, h, y,
-                                         y_stride);
-    else
-      aom_highbd_upsampled_pred(pred16, w, h, y, y_stride);
+      aom_highbd_comp_avg_pred(pred16, second_pred, w, h,
+                               CONVERT_TO_BYTEPTR(pred16), w);
 
     besterr = vfp->vf(CONVERT_TO_BYTEPTR(pred16), w, src, src_stride, sse);
   } else {
     DECLARE_ALIGNED(16, uint8_t, pred[64 * 64]);
 #else
   DECLARE_ALIGNED(16, uint8_t, pred[64 * 64]);
-  (void)xd;
 #endif  // CONFIG_AOM_HIGHBITDEPTH
+    upsampled_pred(xd, pred, w, h, y, y_stride, r, c);
     if (second_pred != NULL)
-      aom_comp_avg_upsampled_pred(pred, second_pred, w, h, y, y_stride);
-    else
-      aom_upsampled_pred(pred, w, h, y, y_stride);
+      aom_comp_avg_pred(pred, second_pred, w, h, pred, w);
 
     besterr = vfp->vf(pred, w, src, src_stride, sse);
 #if CONFIG_AOM_HIGHBITDEPTH
@@ -653,10 +799,11 @@ static unsigned int upsampled_setup_center_error(
     const MACROBLOCKD *xd, const MV *bestmv, const MV *ref_mv,
     int error_per_bit, const aom_variance_fn_ptr_t *vfp,
     const uint8_t *const src, const int src_stride, const uint8_t *const y,
-    int y_stride, const uint8_t *second_pred, int w, int h, int offset,
-    int *mvjcost, int *mvcost[2], unsigned int *sse1, int *distortion) {
-  unsigned int besterr = upsampled_pref_error(
-      xd, vfp, src, src_stride, y + offset, y_stride, second_pred, w, h, sse1);
+    int y_stride, const uint8_t *second_pred, int w, int h, int *mvjcost,
+    int *mvcost[2], unsigned int *sse1, int *distortion) {
+  unsigned int besterr =
+      upsampled_pref_error(xd, vfp, src, src_stride, y, y_stride, bestmv->row,
+                           bestmv->col, second_pred, w, h, sse1);
   *distortion = besterr;
   besterr += mv_err_cost(bestmv, ref_mv, mvjcost, mvcost, error_per_bit);
   return besterr;
@@ -706,7 +853,7 @@ int av1_find_best_sub_pixel_tree(
   if (use_upsampled_ref)
     besterr = upsampled_setup_center_error(
         xd, bestmv, ref_mv, error_per_bit, vfp, z, src_stride, y, y_stride,
-        second_pred, w, h, offset * 8, mvjcost, mvcost, sse1, distortion);
+        second_pred, w, h, mvjcost, mvcost, sse1, distortion);
   else
     besterr = setup_center_error(xd, bestmv, ref_mv, error_per_bit, vfp, z,
                                  src_stride, y, y_stride, second_pred, w, h,
@@ -723,11 +870,9 @@ int av1_find_best_sub_pixel_tree(
         MV this_mv = { tr, tc };
 
         if (use_upsampled_ref) {
-          const uint8_t *const pre_address = y + tr * y_stride + tc;
-
-          thismse = upsampled_pref_error(xd, vfp, src_address, src_stride,
-                                         pre_address, y_stride, second_pred, w,
-                                         h, &sse);
+          thismse = upsampled_pref_error(xd, vfp, src_address, src_stride, y,
+                                         y_stride, tr, tc, second_pred, w, h,
+                                         &sse);
         } else {
           const uint8_t *const pre_address =
               y + (tr >> 3) * y_stride + (tc >> 3);
@@ -763,11 +908,9 @@ int av1_find_best_sub_pixel_tree(
       MV this_mv = { tr, tc };
 
       if (use_upsampled_ref) {
-        const uint8_t *const pre_address = y + tr * y_stride + tc;
-
-        thismse =
-            upsampled_pref_error(xd, vfp, src_address, src_stride, pre_address,
-                                 y_stride, second_pred, w, h, &sse);
+        thismse = upsampled_pref_error(xd, vfp, src_address, src_stride, y,
+                                       y_stride, tr, tc, second_pred, w, h,
+                                       &sse);
       } else {
         const uint8_t *const pre_address = y + (tr >> 3) * y_stride + (tc >> 3);
 
@@ -849,22 +992,119 @@ static INLINE int is_mv_in(const MACROBLOCK *x, const MV *mv) {
          (mv->row >= x->mv_row_min) && (mv->row <= x->mv_row_max);
 }
 
-#define CHECK_BETTER                                                      \
-  {                                                                       \
-    if (thissad < bestsad) {                                              \
-      if (use_mvcost)                                                     \
-        thissad += mvsad_err_cost(x, &this_mv, &fcenter_mv, sad_per_bit); \
-      if (thissad < bestsad) {                                            \
-        bestsad = thissad;                                                \
-        best_site = i;                                                    \
-      }                                                                   \
-    }                                                                     \
+// Maximum number of candidates scored by one check_candidates() call: the
+// largest search step of the diamond and pattern searches.
+#define MAX_STEP_CANDIDATES 8
+
+// Scores the n candidates of one search step together and returns the index
+// of the best one, updating *best_sad, or -1 if none beats *best_sad. The
+// SADs are computed 4 at a time with sdx4df, and the MV cost is only added to
+// those that beat the best so far, since it cannot make a candidate better.
+// Candidates outside the MV limits are skipped if check_mv is set. If sads is
+// not NULL it receives the raw SAD of each candidate, INT_MAX for the skipped
+// ones.
+static int check_candidates(const MACROBLOCK *x,
+                            const aom_variance_fn_ptr_t *fn_ptr,
+                            const MV *mvs, int n, int check_mv,
+                            const MV *fcenter_mv, int sad_per_bit,
+                            int use_mvcost, int *sads,
+                            unsigned int *best_sad) {
+  const struct buf_2d *const what = &x->plane[0].src;
+  const struct buf_2d *const in_what = &x->e_mbd.plane[0].pre[0];
+  const uint8_t *addrs[MAX_STEP_CANDIDATES];
+  uint32_t sad_array[MAX_STEP_CANDIDATES];
+  int idx[MAX_STEP_CANDIDATES];
+  int i, m = 0, best = -1;
+
+  assert(n <= MAX_STEP_CANDIDATES);
+  for (i = 0; i < n; ++i) {
+    if (sads) sads[i] = INT_MAX;
+    if (check_mv && !is_mv_in(x, &mvs[i])) continue;
+    idx[m] = i;
+    addrs[m++] = get_buf_from_mv(in_what, &mvs[i]);
+  }
+
+  for (i = 0; i + 4 <= m; i += 4)
+    fn_ptr->sdx4df(what->buf, what->stride, &addrs[i], in_what->stride,
+                   &sad_array[i]);
+  if (m - i == 3) {
+    // MAX_STEP_CANDIDATES is a multiple of 4, so there is room for a fourth
+    // position, a copy of the last one.
+    addrs[m] = addrs[m - 1];
+    fn_ptr->sdx4df(what->buf, what->stride, &addrs[i], in_what->stride,
+                   &sad_array[i]);
+  } else {
+    for (; i < m; ++i)
+      sad_array[i] =
+          fn_ptr->sdf(what->buf, what->stride, addrs[i], in_what->stride);
+  }
+
+  for (i = 0; i < m; ++i) {
+    unsigned int sad = sad_array[i];
+    if (sads) sads[idx[i]] = sad;
+    if (sad < *best_sad) {
+      if (use_mvcost)
+        sad += mvsad_err_cost(x, &mvs[idx[i]], fcenter_mv, sad_per_bit);
+      if (sad < *best_sad) {
+        *best_sad = sad;
+        best = idx[i];
+      }
+    }
   }
+  return best;
+}
 
 #define MAX_PATTERN_SCALES 11
 #define MAX_PATTERN_CANDIDATES 8  // max number of canddiates per scale
 #define PATTERN_CANDIDATES_REF 3  // number of refinement candidates
 
+// Checks the n candidates at the given offsets from (br, bc). The MV limits
+// are only checked if a candidate range pixels away may be outside them.
+static int check_pattern_candidates(const MACROBLOCK *x,
+                                    const aom_variance_fn_ptr_t *vfp, int br,
+                                    int bc, const MV *offsets, int n,
+                                    int range, const MV *fcenter_mv,
+                                    int sad_per_bit, int use_mvcost, int *sads,
+                                    unsigned int *best_sad) {
+  MV mvs[MAX_PATTERN_CANDIDATES];
+  int i;
+  for (i = 0; i < n; ++i) {
+    mvs[i].row = br + offsets[i].row;
+    mvs[i].col = bc + offsets[i].col;
+  }
+  return check_candidates(x, vfp, mvs, n, !check_bounds(x, br, bc, range),
+                          fcenter_mv, sad_per_bit, use_mvcost, sads, best_sad);
+}
+
+// Checks the candidate k of a scale and its two neighbors in the pattern.
+// Returns the index of the best one in candidates, or -1. If sads is not NULL
+// it receives the raw SADs at the same indices.
+static int check_pattern_refinement(const MACROBLOCK *x,
+                                    const aom_variance_fn_ptr_t *vfp, int br,
+                                    int bc, const MV *candidates,
+                                    int num_candidates, int k, int range,
+                                    const MV *fcenter_mv, int sad_per_bit,
+                                    int use_mvcost, int *sads,
+                                    unsigned int *best_sad) {
+  int indices[PATTERN_CANDIDATES_REF];
+  MV offsets[PATTERN_CANDIDATES_REF];
+  int ref_sads[PATTERN_CANDIDATES_REF];
+  int i, best;
+  indices[0] = (k == 0) ? num_candidates - 1 : k - 1;
+  indices[1] = k;
+  indices[2] = (k == num_candidates - 1) ? 0 : k + 1;
+  for (i = 0; i < PATTERN_CANDIDATES_REF; i++)
+    offsets[i] = candidates[indices[i]];
+  best = check_pattern_candidates(x, vfp, br, bc, offsets,
+                                  PATTERN_CANDIDATES_REF, range, fcenter_mv,
+                                  sad_per_bit, use_mvcost,
+                                  sads ? ref_sads : NULL, best_sad);
+  if (sads)
+    for (i = 0; i < PATTERN_CANDIDATES_REF; i++)
+      sads[indices[i]] = ref_sads[i];
+  return best == -1 ? -1 : indices[best];
+}
+
 // Calculate and return a sad+mvcost list around an integer best pel.
 static INLINE void calc_int_cost_list(const MACROBLOCK *x, const MV *ref_mv,
                                       int sadpb,
@@ -924,12 +1164,11 @@ static int av1_pattern_search(
   static const int search_param_to_steps[MAX_MVSEARCH_STEPS] = {
     10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
   };
-  int i, s, t;
+  int s, t;
   const struct buf_2d *const what = &x->plane[0].src;
   const struct buf_2d *const in_what = &xd->plane[0].pre[0];
   int br, bc;
-  int bestsad = INT_MAX;
-  int thissad;
+  unsigned int bestsad;
   int k = -1;
   const MV fcenter_mv = { center_mv->row >> 3, center_mv->col >> 3 };
   int best_init_s = search_param_to_steps[search_param];
@@ -950,30 +1189,10 @@ static int av1_pattern_search(
     s = best_init_s;
     best_init_s = -1;
     for (t = 0; t <= s; ++t) {
-      int best_site = -1;
-      if (check_bounds(x, br, bc, 1 << t)) {
-        for (i = 0; i < num_candidates[t]; i++) {
-          const MV this_mv = { br + candidates[t][i].row,
-                               bc + candidates[t][i].col };
-          thissad =
-              vfp->sdf(what->buf, what->stride,
-                       get_buf_from_mv(in_what, &this_mv), in_what->stride);
-          CHECK_BETTER
-        }
-      } else {
-        for (i = 0; i < num_candidates[t]; i++) {
-          const MV this_mv = { br + candidates[t][i].row,
-                               bc + candidates[t][i].col };
-          if (!is_mv_in(x, &this_mv)) continue;
-          thissad =
-              vfp->sdf(what->buf, what->stride,
-                       get_buf_from_mv(in_what, &this_mv), in_what->stride);
-          CHECK_BETTER
-        }
-      }
-      if (best_site == -1) {
-        continue;
-      } else {
+      const int best_site = check_pattern_candidates(
+          x, vfp, br, bc, candidates[t], num_candidates[t], 1 << t,
+          &fcenter_mv, sad_per_bit, use_mvcost, NULL, &bestsad);
+      if (best_site != -1) {
         best_init_s = t;
         k = best_site;
       }
@@ -993,27 +1212,9 @@ static int av1_pattern_search(
     do {
       // No need to search all 6 points the 1st time if initial search was used
       if (!do_init_search || s != best_init_s) {
-        if (check_bounds(x, br, bc, 1 << s)) {
-          for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        } else {
-          for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            if (!is_mv_in(x, &this_mv)) continue;
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        }
-
+        best_site = check_pattern_candidates(
+            x, vfp, br, bc, candidates[s], num_candidates[s], 1 << s,
+            &fcenter_mv, sad_per_bit, use_mvcost, NULL, &bestsad);
         if (best_site == -1) {
           continue;
         } else {
@@ -1024,39 +1225,11 @@ static int av1_pattern_search(
       }
 
       do {
-        int next_chkpts_indices[PATTERN_CANDIDATES_REF];
-        best_site = -1;
-        next_chkpts_indices[0] = (k == 0) ? num_candidates[s] - 1 : k - 1;
-        next_chkpts_indices[1] = k;
-        next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
-
-        if (check_bounds(x, br, bc, 1 << s)) {
-          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        } else {
-          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            if (!is_mv_in(x, &this_mv)) continue;
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        }
-
+        best_site = check_pattern_refinement(
+            x, vfp, br, bc, candidates[s], num_candidates[s], k, 1 << s,
+            &fcenter_mv, sad_per_bit, use_mvcost, NULL, &bestsad);
         if (best_site != -1) {
-          k = next_chkpts_indices[best_site];
+          k = best_site;
           br += candidates[s][k].row;
           bc += candidates[s][k].col;
         }
@@ -1098,8 +1271,7 @@ static int av1_pattern_search_sad(
   const struct buf_2d *const what = &x->plane[0].src;
   const struct buf_2d *const in_what = &xd->plane[0].pre[0];
   int br, bc;
-  int bestsad = INT_MAX;
-  int thissad;
+  unsigned int bestsad;
   int k = -1;
   const MV fcenter_mv = { center_mv->row >> 3, center_mv->col >> 3 };
   int best_init_s = search_param_to_steps[search_param];
@@ -1124,30 +1296,10 @@ static int av1_pattern_search_sad(
     s = best_init_s;
     best_init_s = -1;
     for (t = 0; t <= s; ++t) {
-      int best_site = -1;
-      if (check_bounds(x, br, bc, 1 << t)) {
-        for (i = 0; i < num_candidates[t]; i++) {
-          const MV this_mv = { br + candidates[t][i].row,
-                               bc + candidates[t][i].col };
-          thissad =
-              vfp->sdf(what->buf, what->stride,
-                       get_buf_from_mv(in_what, &this_mv), in_what->stride);
-          CHECK_BETTER
-        }
-      } else {
-        for (i = 0; i < num_candidates[t]; i++) {
-          const MV this_mv = { br + candidates[t][i].row,
-                               bc + candidates[t][i].col };
-          if (!is_mv_in(x, &this_mv)) continue;
-          thissad =
-              vfp->sdf(what->buf, what->stride,
-                       get_buf_from_mv(in_what, &this_mv), in_what->stride);
-          CHECK_BETTER
-        }
-      }
-      if (best_site == -1) {
-        continue;
-      } else {
+      const int best_site = check_pattern_candidates(
+          x, vfp, br, bc, candidates[t], num_candidates[t], 1 << t,
+          &fcenter_mv, sad_per_bit, use_mvcost, NULL, &bestsad);
+      if (best_site != -1) {
         best_init_s = t;
         k = best_site;
       }
@@ -1167,27 +1319,9 @@ static int av1_pattern_search_sad(
 
     for (; s >= do_sad; s--) {
       if (!do_init_search || s != best_init_s) {
-        if (check_bounds(x, br, bc, 1 << s)) {
-          for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        } else {
-          for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            if (!is_mv_in(x, &this_mv)) continue;
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        }
-
+        best_site = check_pattern_candidates(
+            x, vfp, br, bc, candidates[s], num_candidates[s], 1 << s,
+            &fcenter_mv, sad_per_bit, use_mvcost, NULL, &bestsad);
         if (best_site == -1) {
           continue;
         } else {
@@ -1198,39 +1332,11 @@ static int av1_pattern_search_sad(
       }
 
       do {
-        int next_chkpts_indices[PATTERN_CANDIDATES_REF];
-        best_site = -1;
-        next_chkpts_indices[0] = (k == 0) ? num_candidates[s] - 1 : k - 1;
-        next_chkpts_indices[1] = k;
-        next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
-
-        if (check_bounds(x, br, bc, 1 << s)) {
-          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        } else {
-          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            if (!is_mv_in(x, &this_mv)) continue;
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        }
-
+        best_site = check_pattern_refinement(
+            x, vfp, br, bc, candidates[s], num_candidates[s], k, 1 << s,
+            &fcenter_mv, sad_per_bit, use_mvcost, NULL, &bestsad);
         if (best_site != -1) {
-          k = next_chkpts_indices[best_site];
+          k = best_site;
           br += candidates[s][k].row;
           bc += candidates[s][k].col;
         }
@@ -1241,27 +1347,9 @@ static int av1_pattern_search_sad(
     if (s == 0) {
       cost_list[0] = bestsad;
       if (!do_init_search || s != best_init_s) {
-        if (check_bounds(x, br, bc, 1 << s)) {
-          for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            cost_list[i + 1] = thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        } else {
-          for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            if (!is_mv_in(x, &this_mv)) continue;
-            cost_list[i + 1] = thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        }
-
+        best_site = check_pattern_candidates(
+            x, vfp, br, bc, candidates[s], num_candidates[s], 1 << s,
+            &fcenter_mv, sad_per_bit, use_mvcost, cost_list + 1, &bestsad);
         if (best_site != -1) {
           br += candidates[s][best_site].row;
           bc += candidates[s][best_site].col;
@@ -1269,45 +1357,15 @@ static int av1_pattern_search_sad(
         }
       }
       while (best_site != -1) {
-        int next_chkpts_indices[PATTERN_CANDIDATES_REF];
-        best_site = -1;
-        next_chkpts_indices[0] = (k == 0) ? num_candidates[s] - 1 : k - 1;
-        next_chkpts_indices[1] = k;
-        next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
         cost_list[1] = cost_list[2] = cost_list[3] = cost_list[4] = INT_MAX;
         cost_list[((k + 2) % 4) + 1] = cost_list[0];
         cost_list[0] = bestsad;
 
-        if (check_bounds(x, br, bc, 1 << s)) {
-          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            cost_list[next_chkpts_indices[i] + 1] = thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        } else {
-          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            if (!is_mv_in(x, &this_mv)) {
-              cost_list[next_chkpts_indices[i] + 1] = INT_MAX;
-              continue;
-            }
-            cost_list[next_chkpts_indices[i] + 1] = thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
-            CHECK_BETTER
-          }
-        }
-
+        best_site = check_pattern_refinement(
+            x, vfp, br, bc, candidates[s], num_candidates[s], k, 1 << s,
+            &fcenter_mv, sad_per_bit, use_mvcost, cost_list + 1, &bestsad);
         if (best_site != -1) {
-          k = next_chkpts_indices[best_site];
+          k = best_site;
           br += candidates[s][k].row;
           bc += candidates[s][k].col;
         }
@@ -1679,10 +1737,28 @@ int av1_fast_dia_search(const MACROBLOCK *x, MV *ref_mv, int search_param,
       do_init_search, cost_list, vfp, use_mvcost, center_mv, best_mv);
 }
 
-#undef CHECK_BETTER
+// Updates best_sad and best_mv with the SADs of n positions that start at mv
+// and are col_step columns apart.
+static INLINE void update_mesh_best(const MACROBLOCK *x, const uint32_t *sads,
+                                    int n, MV mv, int col_step,
+                                    const MV *ref_mv, int sad_per_bit,
+                                    unsigned int *best_sad, MV *best_mv) {
+  int i;
+  for (i = 0; i < n; ++i, mv.col += col_step) {
+    if (sads[i] < *best_sad) {
+      const unsigned int sad =
+          sads[i] + mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
+      if (sad < *best_sad) {
+        *best_sad = sad;
+        *best_mv = mv;
+      }
+    }
+  }
+}
 
 // Exhuastive motion search around a given centre position with a given
-// step size.
+// step size. Every row is evaluated 8 positions at a time with sdx8f when
+// all locations are checked, and 4 at a time with sdx4df otherwise.
 static int exhuastive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
                                   int range, int step, int sad_per_bit,
                                   const aom_variance_fn_ptr_t *fn_ptr,
@@ -1694,7 +1770,6 @@ static int exhuastive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
   unsigned int best_sad = INT_MAX;
   int r, c, i;
   int start_col, end_col, start_row, end_row;
-  int col_step = (step > 1) ? step : 4;
 
   assert(step >= 1);
 
@@ -1711,59 +1786,35 @@ static int exhuastive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
   end_col = AOMMIN(range, x->mv_col_max - fcenter_mv.col);
 
   for (r = start_row; r <= end_row; r += step) {
-    for (c = start_col; c <= end_col; c += col_step) {
-      // Step > 1 means we are not checking every location in this pass.
-      if (step > 1) {
-        const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c };
-        unsigned int sad =
-            fn_ptr->sdf(what->buf, what->stride, get_buf_from_mv(in_what, &mv),
-                        in_what->stride);
-        if (sad < best_sad) {
-          sad += mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
-          if (sad < best_sad) {
-            best_sad = sad;
-            *best_mv = mv;
-          }
-        }
-      } else {
-        // 4 sads in a single call if we are checking every location
-        if (c + 3 <= end_col) {
-          unsigned int sads[4];
-          const uint8_t *addrs[4];
-          for (i = 0; i < 4; ++i) {
-            const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
-            addrs[i] = get_buf_from_mv(in_what, &mv);
-          }
-          fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride, sads);
-
-          for (i = 0; i < 4; ++i) {
-            if (sads[i] < best_sad) {
-              const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
-              const unsigned int sad =
-                  sads[i] + mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
-              if (sad < best_sad) {
-                best_sad = sad;
-                *best_mv = mv;
-              }
-            }
-          }
-        } else {
-          for (i = 0; i < end_col - c; ++i) {
-            const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
-            unsigned int sad =
-                fn_ptr->sdf(what->buf, what->stride,
-                            get_buf_from_mv(in_what, &mv), in_what->stride);
-            if (sad < best_sad) {
-              sad += mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
-              if (sad < best_sad) {
-                best_sad = sad;
-                *best_mv = mv;
-              }
-            }
-          }
-        }
+    const MV row_mv = { fcenter_mv.row + r, fcenter_mv.col };
+    const uint8_t *const row_buf = get_buf_from_mv(in_what, &row_mv);
+    c = start_col;
+    if (step == 1 && fn_ptr->sdx8f != NULL) {
+      for (; c + 7 <= end_col; c += 8) {
+        const MV mv = { row_mv.row, row_mv.col + c };
+        DECLARE_ALIGNED(16, uint32_t, sads[8]);
+        fn_ptr->sdx8f(what->buf, what->stride, row_buf + c, in_what->stride,
+                      sads);
+        update_mesh_best(x, sads, 8, mv, 1, ref_mv, sad_per_bit, &best_sad,
+                         best_mv);
       }
     }
+    for (; c + 3 * step <= end_col; c += 4 * step) {
+      const MV mv = { row_mv.row, row_mv.col + c };
+      uint32_t sads[4];
+      const uint8_t *addrs[4];
+      for (i = 0; i < 4; ++i) addrs[i] = row_buf + c + i * step;
+      fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride, sads);
+      update_mesh_best(x, sads, 4, mv, step, ref_mv, sad_per_bit, &best_sad,
+                       best_mv);
+    }
+    for (; c <= end_col; c += step) {
+      const MV mv = { row_mv.row, row_mv.col + c };
+      const uint32_t sad = fn_ptr->sdf(what->buf, what->stride, row_buf + c,
+                                       in_what->stride);
+      update_mesh_best(x, &sad, 1, mv, step, ref_mv, sad_per_bit, &best_sad,
+                       best_mv);
+    }
   }
 
   return best_sad;
@@ -1817,7 +1868,8 @@ int av1_diamond_search_sad_c(const MACROBLOCK *x, const search_site_config *cfg,
   i = 1;
 
   for (step = 0; step < tot_steps; step++) {
-    int all_in = 1, t;
+    MV mvs[MAX_STEP_CANDIDATES];
+    int all_in = 1, site;
 
     // All_in is true if every one of the points we are checking are within
     // the bounds of the image.
@@ -1827,55 +1879,16 @@ int av1_diamond_search_sad_c(const MACROBLOCK *x, const search_site_config *cfg,
     all_in &= ((best_mv->col + ss[i + 3].mv.col) < x->mv_col_max);
 
     // If all the pixels are within the bounds we don't check whether the
-    // search point is valid in this loop,  otherwise we check each point
-    // for validity..
-    if (all_in) {
-      unsigned int sad_array[4];
-
-      for (j = 0; j < cfg->searches_per_step; j += 4) {
-        unsigned char const *block_offset[4];
-
-        for (t = 0; t < 4; t++)
-          block_offset[t] = ss[i + t].offset + best_address;
-
-        fn_ptr->sdx4df(what, what_stride, block_offset, in_what_stride,
-                       sad_array);
-
-        for (t = 0; t < 4; t++, i++) {
-          if (sad_array[t] < bestsad) {
-            const MV this_mv = { best_mv->row + ss[i].mv.row,
-                                 best_mv->col + ss[i].mv.col };
-            sad_array[t] +=
-                mvsad_err_cost(x, &this_mv, &fcenter_mv, sad_per_bit);
-            if (sad_array[t] < bestsad) {
-              bestsad = sad_array[t];
-              best_site = i;
-            }
-          }
-        }
-      }
-    } else {
-      for (j = 0; j < cfg->searches_per_step; j++) {
-        // Trap illegal vectors
-        const MV this_mv = { best_mv->row + ss[i].mv.row,
-                             best_mv->col + ss[i].mv.col };
-
-        if (is_mv_in(x, &this_mv)) {
-          const uint8_t *const check_here = ss[i].offset + best_address;
-          unsigned int thissad =
-              fn_ptr->sdf(what, what_stride, check_here, in_what_stride);
-
-          if (thissad < bestsad) {
-            thissad += mvsad_err_cost(x, &this_mv, &fcenter_mv, sad_per_bit);
-            if (thissad < bestsad) {
-              bestsad = thissad;
-              best_site = i;
-            }
-          }
-        }
-        i++;
-      }
+    // search points are valid, otherwise we check each point for validity.
+    for (j = 0; j < cfg->searches_per_step; j++) {
+      mvs[j].row = best_mv->row + ss[i + j].mv.row;
+      mvs[j].col = best_mv->col + ss[i + j].mv.col;
     }
+    site = check_candidates(x, fn_ptr, mvs, cfg->searches_per_step, !all_in,
+                            &fcenter_mv, sad_per_bit, 1, NULL, &bestsad);
+    if (site != -1) best_site = i + site;
+    i += cfg->searches_per_step;
+
     if (best_site != last_site) {
       best_mv->row += ss[best_site].mv.row;
       best_mv->col += ss[best_site].mv.col;
@@ -2634,6 +2647,140 @@ int av1_full_pixel_search(const AV1_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
   return var;
 }
 
+int av1_pick_full_pixel_start(const AV1_COMP *cpi, const MACROBLOCK *x,
+                              BLOCK_SIZE bsize, const MV *cands, int num_cands,
+                              int sad_per_bit, const MV *ref_mv,
+                              MV *mvp_full) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const aom_variance_fn_ptr_t *const fn_ptr = &cpi->fn_ptr[bsize];
+  const struct buf_2d *const src = &x->plane[0].src;
+  const struct buf_2d *const pre = &xd->plane[0].pre[0];
+  const MV fcenter_mv = { ref_mv->row >> 3, ref_mv->col >> 3 };
+  unsigned int bestsad;
+  int i, picked = 0;
+
+  clamp_mv(mvp_full, x->mv_col_min, x->mv_col_max, x->mv_row_min,
+           x->mv_row_max);
+  bestsad = fn_ptr->sdf(src->buf, src->stride, get_buf_from_mv(pre, mvp_full),
+                        pre->stride) +
+            mvsad_err_cost(x, mvp_full, &fcenter_mv, sad_per_bit);
+  for (i = 0; i < num_cands; ++i) {
+    MV mv = cands[i];
+    unsigned int sad;
+    clamp_mv(&mv, x->mv_col_min, x->mv_col_max, x->mv_row_min,
+             x->mv_row_max);
+    if (mv.row == mvp_full->row && mv.col == mvp_full->col) continue;
+    sad = fn_ptr->sdf(src->buf, src->stride, get_buf_from_mv(pre, &mv),
+                      pre->stride) +
+          mvsad_err_cost(x, &mv, &fcenter_mv, sad_per_bit);
+    if (sad < bestsad) {
+      bestsad = sad;
+      *mvp_full = mv;
+      picked = 1;
+    }
+  }
+  return picked;
+}
+
+// Range of the exhaustive search around each start point at 1/4 resolution,
+// and of its refinement at 1/2 resolution.
+#define PYRAMID_COARSE_RANGE 6
+#define PYRAMID_REFINE_RANGE 1
+
+static aom_sad_fn_t pyramid_sad_fn(BLOCK_SIZE bsize) {
+  switch (bsize) {
+    case BLOCK_4X4: return aom_sad4x4;
+    case BLOCK_4X8: return aom_sad4x8;
+    case BLOCK_8X4: return aom_sad8x4;
+    case BLOCK_8X8: return aom_sad8x8;
+    case BLOCK_8X16: return aom_sad8x16;
+    case BLOCK_16X8: return aom_sad16x8;
+    case BLOCK_16X16: return aom_sad16x16;
+    case BLOCK_16X32: return aom_sad16x32;
+    case BLOCK_32X16: return aom_sad32x16;
+    case BLOCK_32X32: return aom_sad32x32;
+    default: assert(0 && "Invalid pyramid block size."); return NULL;
+  }
+}
+
+// Exhaustive SAD search of the block at (row, col) of the given pyramid level
+// within range of center, clamped to the motion vector limits scaled to the
+// level. Updates best and bestsad.
+static void pyramid_level_search(const MACROBLOCK *x, const ME_PYRAMID *src,
+                                 const ME_PYRAMID *ref, int level,
+                                 BLOCK_SIZE bsize, int row, int col,
+                                 const MV *center, int range, MV *best,
+                                 unsigned int *bestsad) {
+  const int shift = level + 1;
+  const ME_PYRAMID_LEVEL *const s = &src->level[level];
+  const ME_PYRAMID_LEVEL *const r = &ref->level[level];
+  const aom_sad_fn_t sdf = pyramid_sad_fn(bsize);
+  const uint8_t *const src_buf = s->buf + row * s->stride + col;
+  const uint8_t *const ref_buf = r->buf + row * r->stride + col;
+  const int row_min =
+      AOMMAX(center->row - range, (x->mv_row_min + (1 << shift) - 1) >> shift);
+  const int row_max = AOMMIN(center->row + range, x->mv_row_max >> shift);
+  const int col_min =
+      AOMMAX(center->col - range, (x->mv_col_min + (1 << shift) - 1) >> shift);
+  const int col_max = AOMMIN(center->col + range, x->mv_col_max >> shift);
+  int i, j;
+
+  for (i = row_min; i <= row_max; ++i) {
+    for (j = col_min; j <= col_max; ++j) {
+      const unsigned int sad =
+          sdf(src_buf, s->stride, ref_buf + i * r->stride + j, r->stride);
+      if (sad < *bestsad) {
+        *bestsad = sad;
+        best->row = i;
+        best->col = j;
+      }
+    }
+  }
+}
+
+int av1_pyramid_search(const AV1_COMP *cpi, const MACROBLOCK *x,
+                       BLOCK_SIZE bsize, int mi_row, int mi_col,
+                       const ME_PYRAMID *src_pyr, const ME_PYRAMID *ref_pyr,
+                       int sad_per_bit, const MV *ref_mv, MV *mvp_full) {
+  const BLOCK_SIZE bsize_half = ss_size_lookup[bsize][1][1];
+  const BLOCK_SIZE bsize_quarter = ss_size_lookup[bsize_half][1][1];
+  const int row = mi_row * MI_SIZE;
+  const int col = mi_col * MI_SIZE;
+  const MV zero_mv = { 0, 0 };
+  MV coarse_mv, mv;
+  unsigned int bestsad = UINT_MAX;
+
+  assert(num_4x4_blocks_wide_lookup[bsize] >= 4 &&
+         num_4x4_blocks_high_lookup[bsize] >= 4 &&
+         num_4x4_blocks_wide_lookup[bsize] <= 16 &&
+         num_4x4_blocks_high_lookup[bsize] <= 16);
+
+  // Start points at 1/4 resolution: the predicted vector and zero.
+  coarse_mv.row = mvp_full->row >> 2;
+  coarse_mv.col = mvp_full->col >> 2;
+  pyramid_level_search(x, src_pyr, ref_pyr, 1, bsize_quarter, row >> 2,
+                       col >> 2, &coarse_mv, PYRAMID_COARSE_RANGE, &mv,
+                       &bestsad);
+  if (abs(coarse_mv.row) > PYRAMID_COARSE_RANGE ||
+      abs(coarse_mv.col) > PYRAMID_COARSE_RANGE)
+    pyramid_level_search(x, src_pyr, ref_pyr, 1, bsize_quarter, row >> 2,
+                         col >> 2, &zero_mv, PYRAMID_COARSE_RANGE, &mv,
+                         &bestsad);
+  if (bestsad == UINT_MAX) return 0;
+
+  // Refine at 1/2 resolution.
+  coarse_mv.row = mv.row * 2;
+  coarse_mv.col = mv.col * 2;
+  bestsad = UINT_MAX;
+  pyramid_level_search(x, src_pyr, ref_pyr, 0, bsize_half, row >> 1, col >> 1,
+                       &coarse_mv, PYRAMID_REFINE_RANGE, &mv, &bestsad);
+  if (bestsad == UINT_MAX) return 0;
+  mv.row *= 2;
+  mv.col *= 2;
+  return av1_pick_full_pixel_start(cpi, x, bsize, &mv, 1, sad_per_bit, ref_mv,
+                                   mvp_full);
+}
+
 #if CONFIG_MOTION_VAR
 /* returns subpixel variance error function */
 #define DIST(r, c) \
@@ -2669,8 +2816,8 @@ int av1_full_pixel_search(const AV1_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
 #undef CHECK_BETTER1
 #define CHECK_BETTER1(v, r, c)                                            \
   if (c >= minc && c <= maxc && r >= minr && r <= maxr) {                 \
-    thismse = upsampled_obmc_pref_error(                                  \
-        xd, mask, vfp, z, upre(y, y_stride, r, c), y_stride, w, h, &sse); \
+    thismse = upsampled_obmc_pref_error(xd, mask, vfp, z, y, y_stride, r, \
+                                        c, w, h, &sse);                   \
     if ((v = MVC(r, c) + thismse) < besterr) {                            \
       besterr = v;                                                        \
       br = r;                                                             \
@@ -2698,21 +2845,21 @@ static int upsampled_obmc_pref_error(const MACROBLOCKD *xd, const int32_t *mask,
                                      const aom_variance_fn_ptr_t *vfp,
                                      const int32_t *const wsrc,
                                      const uint8_t *const y, int y_stride,
-                                     int w, int h, unsigned int *sse) {
+                                     int r, int c, int w, int h,
+                                     unsigned int *sse) {
   unsigned int besterr;
 #if CONFIG_AOM_HIGHBITDEPTH
   if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
     DECLARE_ALIGNED(16, uint16_t, pred16[MAX_SB_SQUARE]);
-    aom_highbd_upsampled_pred(pred16, w, h, y, y_stride);
+    upsampled_pred(xd, (uint8_t *)pred16, w, h, y, y_stride, r, c);
 
     besterr = vfp->ovf(CONVERT_TO_BYTEPTR(pred16), w, wsrc, mask, sse);
   } else {
     DECLARE_ALIGNED(16, uint8_t, pred[MAX_SB_SQUARE]);
 #else
   DECLARE_ALIGNED(16, uint8_t, pred[MAX_SB_SQUARE]);
-  (void)xd;
 #endif  // CONFIG_AOM_HIGHBITDEPTH
-    aom_upsampled_pred(pred, w, h, y, y_stride);
+    upsampled_pred(xd, pred, w, h, y, y_stride, r, c);
 
     besterr = vfp->ovf(pred, w, wsrc, mask, sse);
 #if CONFIG_AOM_HIGHBITDEPTH
@@ -2725,21 +2872,20 @@ static unsigned int upsampled_setup_obmc_center_error(
     const MACROBLOCKD *xd, const int32_t *mask, const MV *bestmv,
     const MV *ref_mv, int error_per_bit, const aom_variance_fn_ptr_t *vfp,
     const int32_t *const wsrc, const uint8_t *const y, int y_stride, int w,
-    int h, int offset, int *mvjcost, int *mvcost[2], unsigned int *sse1,
-    int *distortion) {
-  unsigned int besterr = upsampled_obmc_pref_error(
-      xd, mask, vfp, wsrc, y + offset, y_stride, w, h, sse1);
+    int h, int *mvjcost, int *mvcost[2], unsigned int *sse1, int *distortion) {
+  unsigned int besterr =
+      upsampled_obmc_pref_error(xd, mask, vfp, wsrc, y, y_stride, bestmv->row,
+                                bestmv->col, w, h, sse1);
   *distortion = besterr;
   besterr += mv_err_cost(bestmv, ref_mv, mvjcost, mvcost, error_per_bit);
   return besterr;
 }
 
 int av1_find_best_obmc_sub_pixel_tree_up(
-    const AV1_COMP *cpi, MACROBLOCK *x, int mi_row, int mi_col, MV *bestmv,
-    const MV *ref_mv, int allow_hp, int error_per_bit,
-    const aom_variance_fn_ptr_t *vfp, int forced_stop, int iters_per_step,
-    int *mvjcost, int *mvcost[2], int *distortion, unsigned int *sse1,
-    int is_second, int use_upsampled_ref) {
+    MACROBLOCK *x, MV *bestmv, const MV *ref_mv, int allow_hp,
+    int error_per_bit, const aom_variance_fn_ptr_t *vfp, int forced_stop,
+    int iters_per_step, int *mvjcost, int *mvcost[2], int *distortion,
+    unsigned int *sse1, int is_second, int use_upsampled_ref) {
   const int32_t *wsrc = x->wsrc_buf;
   const int32_t *mask = x->mask_buf;
   const int *const z = wsrc;
@@ -2770,21 +2916,9 @@ int av1_find_best_obmc_sub_pixel_tree_up(
   int kr, kc;
   const int w = 4 * num_4x4_blocks_wide_lookup[mbmi->sb_type];
   const int h = 4 * num_4x4_blocks_high_lookup[mbmi->sb_type];
-  int offset;
-  int y_stride;
-  const uint8_t *y;
-
-  const struct buf_2d backup_pred = pd->pre[is_second];
-  if (use_upsampled_ref) {
-    int ref = xd->mi[0]->mbmi.ref_frame[is_second];
-    const YV12_BUFFER_CONFIG *upsampled_ref = get_upsampled_ref(cpi, ref);
-    setup_pred_plane(&pd->pre[is_second], upsampled_ref->y_buffer,
-                     upsampled_ref->y_stride, (mi_row << 3), (mi_col << 3),
-                     NULL, pd->subsampling_x, pd->subsampling_y);
-  }
-  y = pd->pre[is_second].buf;
-  y_stride = pd->pre[is_second].stride;
-  offset = bestmv->row * y_stride + bestmv->col;
+  const uint8_t *const y = pd->pre[is_second].buf;
+  const int y_stride = pd->pre[is_second].stride;
+  const int offset = bestmv->row * y_stride + bestmv->col;
 
   if (!(allow_hp && av1_use_mv_hp(ref_mv)))
     if (round == 3) round = 2;
@@ -2795,7 +2929,7 @@ int av1_find_best_obmc_sub_pixel_tree_up(
   if (use_upsampled_ref)
     besterr = upsampled_setup_obmc_center_error(
         xd, mask, bestmv, ref_mv, error_per_bit, vfp, z, y, y_stride, w, h,
-        (offset << 3), mvjcost, mvcost, sse1, distortion);
+        mvjcost, mvcost, sse1, distortion);
   else
     besterr = setup_obmc_center_error(mask, bestmv, ref_mv, error_per_bit, vfp,
                                       z, y, y_stride, offset, mvjcost, mvcost,
@@ -2810,10 +2944,8 @@ int av1_find_best_obmc_sub_pixel_tree_up(
         MV this_mv = { tr, tc };
 
         if (use_upsampled_ref) {
-          const uint8_t *const pre_address = y + tr * y_stride + tc;
-
-          thismse = upsampled_obmc_pref_error(
-              xd, mask, vfp, src_address, pre_address, y_stride, w, h, &sse);
+          thismse = upsampled_obmc_pref_error(xd, mask, vfp, src_address, y,
+                                              y_stride, tr, tc, w, h, &sse);
         } else {
           const uint8_t *const pre_address =
               y + (tr >> 3) * y_stride + (tc >> 3);
@@ -2844,10 +2976,8 @@ int av1_find_best_obmc_sub_pixel_tree_up(
       MV this_mv = { tr, tc };
 
       if (use_upsampled_ref) {
-        const uint8_t *const pre_address = y + tr * y_stride + tc;
-
-        thismse = upsampled_obmc_pref_error(xd, mask, vfp, src_address,
-                                            pre_address, y_stride, w, h, &sse);
+        thismse = upsampled_obmc_pref_error(xd, mask, vfp, src_address, y,
+                                            y_stride, tr, tc, w, h, &sse);
       } else {
         const uint8_t *const pre_address = y + (tr >> 3) * y_stride + (tc >> 3);
 
@@ -2900,10 +3030,6 @@ int av1_find_best_obmc_sub_pixel_tree_up(
   bestmv->row = br;
   bestmv->col = bc;
 
-  if (use_upsampled_ref) {
-    pd->pre[is_second] = backup_pred;
-  }
-
   if ((abs(bestmv->col - ref_mv->col) > (MAX_FULL_PEL_VAL << 3)) ||
       (abs(bestmv->row - ref_mv->row) > (MAX_FULL_PEL_VAL << 3)))
     return INT_MAX;
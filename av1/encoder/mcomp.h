@@ -13,6 +13,7 @@
 #define AV1_ENCODER_MCOMP_H_
 
 #include "av1/encoder/block.h"
+#include "av1/encoder/pyramid.h"
 #include "aom_dsp/variance.h"
 
 #ifdef __cplusplus
@@ -47,6 +48,9 @@ void av1_init_dsmotion_compensation(search_site_config *cfg, int stride);
 void av1_init3smotion_compensation(search_site_config *cfg, int stride);
 
 void av1_set_mv_search_range(MACROBLOCK *x, const MV *mv);
+// Narrows the motion vector limits of x to range full pixels around the full
+// pixel center. The caller must make sure that the limits include center.
+void av1_limit_mv_search_range(MACROBLOCK *x, const MV *center, int range);
 int av1_mv_bit_cost(const MV *mv, const MV *ref, const int *mvjcost,
                     int *mvcost[2], int weight);
 
@@ -93,6 +97,9 @@ integer_mv_pattern_search_fn av1_square_search;
 integer_mv_pattern_search_fn av1_fast_hex_search;
 integer_mv_pattern_search_fn av1_fast_dia_search;
 
+// With use_upsampled_ref, the 1/8 pel predictions are interpolated with the
+// EIGHTTAP filter, as if read from a reference up-sampled 8 times, rather than
+// with the bilinear sub-pixel variance functions.
 typedef int(fractional_mv_step_fp)(
     const MACROBLOCK *x, MV *bestmv, const MV *ref_mv, int allow_hp,
     int error_per_bit, const aom_variance_fn_ptr_t *vfp,
@@ -133,6 +140,26 @@ int av1_full_pixel_search(const struct AV1_COMP *cpi, MACROBLOCK *x,
                           int error_per_bit, int *cost_list, const MV *ref_mv,
                           MV *tmp_mv, int var_max, int rd);
 
+// Replaces the full pixel start point mvp_full of a search with the first of
+// the num_cands candidates with the lowest SAD plus motion vector cost, if
+// that is lower than the one of mvp_full. The candidates and mvp_full are
+// clamped to the motion vector limits of x. Returns 1 if mvp_full was
+// replaced.
+int av1_pick_full_pixel_start(const struct AV1_COMP *cpi, const MACROBLOCK *x,
+                              BLOCK_SIZE bsize, const MV *cands, int num_cands,
+                              int sad_per_bit, const MV *ref_mv, MV *mvp_full);
+
+// Coarse-to-fine SAD search of a 16x16 to 64x64 block on the 1/4 and 1/2
+// resolution pyramids of the source and reference frames, around the full
+// pixel mvp_full and the zero vector. The motion vector limits of x must be
+// set. Replaces mvp_full with the result and returns 1 if that has a lower
+// full resolution SAD plus motion vector cost, which lets the caller start the
+// full pixel search with a smaller step.
+int av1_pyramid_search(const struct AV1_COMP *cpi, const MACROBLOCK *x,
+                       BLOCK_SIZE bsize, int mi_row, int mi_col,
+                       const ME_PYRAMID *src_pyr, const ME_PYRAMID *ref_pyr,
+                       int sad_per_bit, const MV *ref_mv, MV *mvp_full);
+
 #if CONFIG_MOTION_VAR
 int av1_obmc_full_pixel_diamond(const struct AV1_COMP *cpi, MACROBLOCK *x,
                                 MV *mvp_full, int step_param, int sadpb,
@@ -140,11 +167,10 @@ int av1_obmc_full_pixel_diamond(const struct AV1_COMP *cpi, MACROBLOCK *x,
                                 const aom_variance_fn_ptr_t *fn_ptr,
                                 const MV *ref_mv, MV *dst_mv, int is_second);
 int av1_find_best_obmc_sub_pixel_tree_up(
-    const struct AV1_COMP *cpi, MACROBLOCK *x, int mi_row, int mi_col,
-    MV *bestmv, const MV *ref_mv, int allow_hp, int error_per_bit,
-    const aom_variance_fn_ptr_t *vfp, int forced_stop, int iters_per_step,
-    int *mvjcost, int *mvcost[2], int *distortion, unsigned int *sse1,
-    int is_second, int use_upsampled_ref);
+    MACROBLOCK *x, MV *bestmv, const MV *ref_mv, int allow_hp,
+    int error_per_bit, const aom_variance_fn_ptr_t *vfp, int forced_stop,
+    int iters_per_step, int *mvjcost, int *mvcost[2], int *distortion,
+    unsigned int *sse1, int is_second, int use_upsampled_ref);
 #endif  // CONFIG_MOTION_VAR
 
 #ifdef __cplusplus
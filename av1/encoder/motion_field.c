@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <limits.h>
+#include <string.h>
+
+#include "aom_mem/aom_mem.h"
+#include "av1/encoder/motion_field.h"
+
+static void reset_field(MOTION_FIELD *mf) {
+  const int n16 = mf->mb_rows * mf->mb_cols;
+  int i;
+  for (i = 0; i < n16; ++i) mf->mv16[i].sad = UINT_MAX;
+  for (i = 0; i < 4 * n16; ++i) mf->mv8[i].sad = UINT_MAX;
+}
+
+MOTION_FIELD *av1_motion_field_lookup(MOTION_FIELD_CACHE *cache,
+                                      int64_t src_id, int64_t ref_id) {
+  int i;
+  for (i = 0; i < MOTION_FIELD_CACHE_SIZE; ++i) {
+    MOTION_FIELD *const mf = &cache->fields[i];
+    if (mf->mv16 && mf->src_id == src_id && mf->ref_id == ref_id) {
+      mf->last_use = ++cache->clock;
+      return mf;
+    }
+  }
+  return NULL;
+}
+
+MOTION_FIELD *av1_motion_field_get(MOTION_FIELD_CACHE *cache, int64_t src_id,
+                                   int64_t ref_id, int width, int height) {
+  const int mb_rows = (height + 15) >> 4;
+  const int mb_cols = (width + 15) >> 4;
+  MOTION_FIELD *mf = av1_motion_field_lookup(cache, src_id, ref_id);
+  int i;
+
+  if (mf && mf->mb_rows == mb_rows && mf->mb_cols == mb_cols) return mf;
+
+  if (!mf) {
+    mf = &cache->fields[0];
+    for (i = 1; i < MOTION_FIELD_CACHE_SIZE; ++i)
+      if (cache->fields[i].last_use < mf->last_use) mf = &cache->fields[i];
+  }
+  if (!mf->mv16 || mf->mb_rows != mb_rows || mf->mb_cols != mb_cols) {
+    aom_free(mf->mv16);
+    aom_free(mf->mv8);
+    mf->mv16 = (MOTION_FIELD_BLOCK *)aom_malloc(mb_rows * mb_cols *
+                                                sizeof(*mf->mv16));
+    mf->mv8 = (MOTION_FIELD_BLOCK *)aom_malloc(4 * mb_rows * mb_cols *
+                                               sizeof(*mf->mv8));
+    if (!mf->mv16 || !mf->mv8) {
+      aom_free(mf->mv16);
+      aom_free(mf->mv8);
+      mf->mv16 = NULL;
+      mf->mv8 = NULL;
+      return NULL;
+    }
+    mf->mb_rows = mb_rows;
+    mf->mb_cols = mb_cols;
+  }
+  mf->src_id = src_id;
+  mf->ref_id = ref_id;
+  mf->last_use = ++cache->clock;
+  reset_field(mf);
+  return mf;
+}
+
+MOTION_FIELD_BLOCK *av1_motion_field_block(const MOTION_FIELD *mf,
+                                           BLOCK_SIZE bsize, int mi_row,
+                                           int mi_col) {
+  if (bsize == BLOCK_16X16) {
+    const int mb_row = mi_row >> 1;
+    const int mb_col = mi_col >> 1;
+    if (mb_row >= mf->mb_rows || mb_col >= mf->mb_cols) return NULL;
+    return &mf->mv16[mb_row * mf->mb_cols + mb_col];
+  }
+  if (bsize == BLOCK_8X8) {
+    if (mi_row >= 2 * mf->mb_rows || mi_col >= 2 * mf->mb_cols) return NULL;
+    return &mf->mv8[mi_row * 2 * mf->mb_cols + mi_col];
+  }
+  return NULL;
+}
+
+void av1_motion_field_store(MOTION_FIELD *mf, BLOCK_SIZE bsize, int mi_row,
+                            int mi_col, const MV *mv, unsigned int sad) {
+  MOTION_FIELD_BLOCK *const b = av1_motion_field_block(mf, bsize, mi_row,
+                                                       mi_col);
+  if (b && sad < b->sad) {
+    b->mv = *mv;
+    b->sad = sad;
+  }
+}
+
+void av1_free_motion_field_cache(MOTION_FIELD_CACHE *cache) {
+  int i;
+  for (i = 0; i < MOTION_FIELD_CACHE_SIZE; ++i) {
+    aom_free(cache->fields[i].mv16);
+    aom_free(cache->fields[i].mv8);
+  }
+  memset(cache, 0, sizeof(*cache));
+}
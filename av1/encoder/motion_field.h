@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_MOTION_FIELD_H_
+#define AV1_ENCODER_MOTION_FIELD_H_
+
+#include "av1/common/enums.h"
+#include "av1/common/mv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of frame pairs whose motion fields are kept. The least recently
+// used field is recycled when a new pair is requested.
+#define MOTION_FIELD_CACHE_SIZE 16
+
+typedef struct {
+  MV mv;
+  // SAD of the block at the full pixel position of mv, UINT_MAX if the block
+  // has not been searched.
+  unsigned int sad;
+} MOTION_FIELD_BLOCK;
+
+// Luma block motion vectors of a source frame relative to a reference frame,
+// at 16x16 and 8x8 granularity.
+typedef struct {
+  int64_t src_id;
+  int64_t ref_id;
+  int mb_rows;
+  int mb_cols;
+  MOTION_FIELD_BLOCK *mv16;
+  MOTION_FIELD_BLOCK *mv8;
+  unsigned int last_use;
+} MOTION_FIELD;
+
+typedef struct {
+  MOTION_FIELD fields[MOTION_FIELD_CACHE_SIZE];
+  unsigned int clock;
+} MOTION_FIELD_CACHE;
+
+// Source frames are identified by their time stamp. A reference frame is
+// either a reconstructed frame, identified by a counter that the encoder
+// increments for every frame it codes, or a source frame, whose time stamp is
+// mapped to negative ids here so that the two never collide.
+static INLINE int64_t av1_motion_field_source_ref_id(int64_t ts_start) {
+  return -1 - ts_start;
+}
+
+// Returns the field of the (src_id, ref_id) pair, or NULL if it is not
+// cached.
+MOTION_FIELD *av1_motion_field_lookup(MOTION_FIELD_CACHE *cache,
+                                      int64_t src_id, int64_t ref_id);
+
+// Returns the field of the (src_id, ref_id) pair for a width x height frame,
+// recycling the least recently used field if the pair is not cached. Returns
+// NULL on allocation failure.
+MOTION_FIELD *av1_motion_field_get(MOTION_FIELD_CACHE *cache, int64_t src_id,
+                                   int64_t ref_id, int width, int height);
+
+// Returns the 16x16 or 8x8 block at mi_row, mi_col, or NULL if bsize is
+// neither or the position is outside the field.
+MOTION_FIELD_BLOCK *av1_motion_field_block(const MOTION_FIELD *mf,
+                                           BLOCK_SIZE bsize, int mi_row,
+                                           int mi_col);
+
+// Records the result of a search of the 16x16 or 8x8 block at mi_row, mi_col
+// if it has a lower SAD than the recorded one.
+void av1_motion_field_store(MOTION_FIELD *mf, BLOCK_SIZE bsize, int mi_row,
+                            int mi_col, const MV *mv, unsigned int sad);
+
+void av1_free_motion_field_cache(MOTION_FIELD_CACHE *cache);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_MOTION_FIELD_H_
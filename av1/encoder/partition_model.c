@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+
+#include "av1/encoder/partition_model.h"
+
+typedef struct {
+  float weights[PARTITION_MODEL_FEATURES];
+  float bias;
+  // The search is skipped when the model output is below the threshold of
+  // the prune level.
+  float thresholds[2];
+} PARTITION_LINEAR_MODEL;
+
+// Logistic regression models of the log-odds that the search wins, trained on
+// partition_stats.stt from two pass and one pass encodes at speeds 1 and 2.
+// The thresholds lose about 1% and 4% of the searches that would have won.
+static const PARTITION_LINEAR_MODEL
+    partition_models[3][PARTITION_MODEL_TYPES] = {
+      // 64x64
+      { { { 0.8719f, 0.1180f, 0.8568f, -8.1703f, 1.8170f, 2.0333f, -0.5465f,
+            -0.1860f },
+          -5.9914f,
+          { -1.46f, -0.80f } },
+        { { -10.2429f, -3.9870f, 2.3447f, 34.9758f, -5.8830f, 6.9603f, 0.0f,
+            0.9520f },
+          15.4050f,
+          { -6.14f, -6.14f } } },
+      // 32x32
+      { { { 1.0114f, 0.0811f, 0.2967f, -8.7698f, 1.9588f, 2.5068f, -0.0957f,
+            -0.1258f },
+          -2.7968f,
+          { -1.07f, -0.48f } },
+        { { -2.1732f, 2.7084f, -2.0812f, 29.9637f, -1.1494f, -0.2663f, 0.0f,
+            -0.0393f },
+          -6.6573f,
+          { -5.68f, -5.68f } } },
+      // 16x16
+      { { { 1.2550f, 0.3388f, 0.3749f, -10.2348f, 1.0965f, 0.9211f, 0.2154f,
+            -0.1480f },
+          -5.1848f,
+          { -2.78f, -1.43f } },
+        { { -0.6853f, -0.6432f, -1.0314f, 8.6838f, -0.1211f, -0.2287f, 0.0f,
+            0.1063f },
+          7.9653f,
+          { -4.34f, -3.90f } } },
+    };
+
+int av1_partition_model_prune(BLOCK_SIZE bsize, PARTITION_MODEL_TYPE type,
+                              const float *features, int level) {
+  const PARTITION_LINEAR_MODEL *model;
+  float score;
+  int i;
+
+  assert(level >= 1 && level <= 2);
+  switch (bsize) {
+    case BLOCK_64X64: model = &partition_models[0][type]; break;
+    case BLOCK_32X32: model = &partition_models[1][type]; break;
+    case BLOCK_16X16: model = &partition_models[2][type]; break;
+    default: return 0;
+  }
+
+  score = model->bias;
+  for (i = 0; i < PARTITION_MODEL_FEATURES; ++i)
+    score += model->weights[i] * features[i];
+  return score < model->thresholds[level - 1];
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_PARTITION_MODEL_H_
+#define AV1_ENCODER_PARTITION_MODEL_H_
+
+#include "av1/common/enums.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Set to 1 to append the features and the outcome of the partition search of
+// every 16x16 to 64x64 block to partition_stats.stt, to retrain the models
+// offline. Pruning is disabled while collecting so that the recorded outcomes
+// are those of the full search.
+#define COLLECT_PARTITION_STATS 0
+
+// Features of a block, computed after its PARTITION_NONE search:
+//  0: log(1 + distortion per pixel of PARTITION_NONE)
+//  1: log(1 + rate per pixel of PARTITION_NONE)
+//  2: log(1 + source variance per pixel)
+//  3: base qindex / 255
+//  4: 1 if the above neighbor is split below this block size
+//  5: 1 if the left neighbor is split below this block size
+//  6: 1 if PARTITION_NONE has no non-zero coefficients
+//  7: first pass intra energy of the frame (0 in one pass mode)
+#define PARTITION_MODEL_FEATURES 8
+
+typedef enum {
+  PARTITION_MODEL_SPLIT,
+  PARTITION_MODEL_RECT,
+  PARTITION_MODEL_TYPES
+} PARTITION_MODEL_TYPE;
+
+// Returns 1 if the model predicts that PARTITION_SPLIT (or PARTITION_HORZ and
+// PARTITION_VERT, for PARTITION_MODEL_RECT) will not win the search of a
+// bsize block with the given features, and the search can be skipped. level
+// is the aggressiveness, 1 or 2. Only 16x16 to 64x64 blocks have a model.
+int av1_partition_model_prune(BLOCK_SIZE bsize, PARTITION_MODEL_TYPE type,
+                              const float *features, int level);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_PARTITION_MODEL_H_
@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <limits.h>
+
+#include "./aom_dsp_rtcd.h"
+#include "./av1_rtcd.h"
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/mem.h"
+#include "aom_ports/system_state.h"
+
+#include "av1/common/common.h"
+#include "av1/common/mvref_common.h"
+#include "av1/common/pred_common.h"
+#include "av1/common/reconinter.h"
+#include "av1/common/reconintra.h"
+
+#include "av1/encoder/cost.h"
+#include "av1/encoder/encoder.h"
+#include "av1/encoder/mcomp.h"
+#include "av1/encoder/pickmode.h"
+#include "av1/encoder/rd.h"
+#include "av1/encoder/rdopt.h"
+
+static const int pick_flag_list[REFS_PER_FRAME + 1] = {
+  0,
+  AOM_LAST_FLAG,
+#if CONFIG_EXT_REFS
+  AOM_LAST2_FLAG,
+  AOM_LAST3_FLAG,
+#endif  // CONFIG_EXT_REFS
+  AOM_GOLD_FLAG,
+#if CONFIG_EXT_REFS
+  AOM_BWD_FLAG,
+#endif  // CONFIG_EXT_REFS
+  AOM_ALT_FLAG
+};
+
+// Reference frames searched by the non-RD picker, in search order.
+static const MV_REFERENCE_FRAME pick_ref_frames[] = { LAST_FRAME,
+                                                      GOLDEN_FRAME };
+
+// Inter modes searched for each reference, in search order.
+static const PREDICTION_MODE pick_inter_modes[] = { ZEROMV, NEARESTMV, NEARMV,
+                                                    NEWMV };
+
+// Intra modes checked when no inter mode gives a good enough prediction.
+static const PREDICTION_MODE pick_intra_modes[] = { DC_PRED, V_PRED, H_PRED,
+                                                    TM_PRED };
+
+// Returns the rd threshold index matching the given single reference mode.
+static THR_MODES get_thr_mode(MV_REFERENCE_FRAME ref_frame,
+                              PREDICTION_MODE mode) {
+  if (ref_frame == INTRA_FRAME) {
+    switch (mode) {
+      case V_PRED: return THR_V_PRED;
+      case H_PRED: return THR_H_PRED;
+      case TM_PRED: return THR_TM;
+      default: return THR_DC;
+    }
+  }
+  if (ref_frame == GOLDEN_FRAME) {
+    switch (mode) {
+      case NEARESTMV: return THR_NEARESTG;
+      case NEARMV: return THR_NEARG;
+      case ZEROMV: return THR_ZEROG;
+      default: return THR_NEWG;
+    }
+  }
+  switch (mode) {
+    case NEARESTMV: return THR_NEARESTMV;
+    case NEARMV: return THR_NEARMV;
+    case ZEROMV: return THR_ZEROMV;
+    default: return THR_NEWMV;
+  }
+}
+
+static INLINE int get_dequant_shift(const MACROBLOCKD *xd) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) return xd->bd - 5;
+#else
+  (void)xd;
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+  return 3;
+}
+
+// Picks the transform size from the ratio of the prediction error variance to
+// its energy: a residual dominated by its mean favors a large transform.
+static TX_SIZE pick_tx_size(const AV1_COMP *cpi, BLOCK_SIZE bsize,
+                            unsigned int var, unsigned int sse) {
+  const AV1_COMMON *const cm = &cpi->common;
+  TX_SIZE tx_size = AOMMIN(max_txsize_lookup[bsize],
+                           tx_mode_to_biggest_tx_size[cm->tx_mode]);
+
+  if (cm->tx_mode == TX_MODE_SELECT) {
+    if (sse <= (var << 2)) tx_size = AOMMIN(tx_size, TX_8X8);
+    if (cpi->sf.partition_search_type == VAR_BASED_PARTITION)
+      tx_size = AOMMIN(tx_size, TX_16X16);
+  }
+  return tx_size;
+}
+
+// Estimates the luma rate and distortion of the current prediction in dst
+// from the variance of the prediction error, and sets the transform size.
+// Returns 1 if all the luma coefficients are expected to quantize to zero.
+static int model_rd_for_sb_y(const AV1_COMP *const cpi, BLOCK_SIZE bsize,
+                             MACROBLOCK *x, MACROBLOCKD *xd, int *out_rate_sum,
+                             int64_t *out_dist_sum, unsigned int *var_y,
+                             unsigned int *sse_y) {
+  MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  const struct macroblock_plane *const p = &x->plane[0];
+  const struct macroblockd_plane *const pd = &xd->plane[0];
+  const int dequant_shift = get_dequant_shift(xd);
+  // Quantizer steps in the 8 bit pixel domain, for the skip thresholds.
+  const int64_t dc_quant = pd->dequant[0] >> (dequant_shift - 3);
+  const int64_t ac_quant = pd->dequant[1] >> (dequant_shift - 3);
+  const int64_t dc_thr = (dc_quant * dc_quant) >> 6;
+  const int64_t ac_thr = (ac_quant * ac_quant) >> 6;
+  unsigned int sse;
+  unsigned int var;
+  unsigned int num_blk_log2;
+  BLOCK_SIZE unit_size;
+  int rate;
+  int64_t dist;
+
+  var = cpi->fn_ptr[bsize].vf(p->src.buf, p->src.stride, pd->dst.buf,
+                              pd->dst.stride, &sse);
+  *var_y = var;
+  *sse_y = sse;
+
+  mbmi->tx_size = pick_tx_size(cpi, bsize, var, sse);
+
+  // Check whether the quantized coefficients of every transform block are
+  // expected to be zero.
+  unit_size = txsize_to_bsize[mbmi->tx_size];
+  num_blk_log2 =
+      (b_width_log2_lookup[bsize] - b_width_log2_lookup[unit_size]) +
+      (b_height_log2_lookup[bsize] - b_height_log2_lookup[unit_size]);
+  if ((var >> num_blk_log2) < ac_thr || var == 0) {
+    if (((sse - var) >> num_blk_log2) < dc_thr || sse == var) {
+      *out_rate_sum = 0;
+      *out_dist_sum = (int64_t)sse << 4;
+      return 1;
+    }
+  }
+
+  av1_model_rd_from_var_lapndz(sse - var, num_pels_log2_lookup[bsize],
+                               pd->dequant[0] >> dequant_shift, &rate, &dist);
+  *out_rate_sum = rate >> 1;
+  *out_dist_sum = dist << 3;
+
+  av1_model_rd_from_var_lapndz(var, num_pels_log2_lookup[bsize],
+                               pd->dequant[1] >> dequant_shift, &rate, &dist);
+  *out_rate_sum += rate;
+  *out_dist_sum += dist << 4;
+  return 0;
+}
+
+// Full pixel search around the best candidate followed by sub pixel
+// refinement. The sub pixel stage is skipped, and 0 returned, when the motion
+// vector alone already costs more than the best mode found so far.
+static int combined_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
+                                  BLOCK_SIZE bsize, int mi_row, int mi_col,
+                                  int_mv *tmp_mv, int *rate_mv,
+                                  int mode_rate, int64_t best_rd_sofar) {
+  const AV1_COMMON *const cm = &cpi->common;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  struct buf_2d backup_yv12[MAX_MB_PLANE] = { { 0, 0 } };
+  const int ref = mbmi->ref_frame[0];
+  const MV ref_mv = x->mbmi_ext->ref_mvs[ref][0].as_mv;
+  const int tmp_col_min = x->mv_col_min;
+  const int tmp_col_max = x->mv_col_max;
+  const int tmp_row_min = x->mv_row_min;
+  const int tmp_row_max = x->mv_row_max;
+  const YV12_BUFFER_CONFIG *scaled_ref_frame =
+      av1_get_scaled_ref_frame(cpi, ref);
+  MV mvp_full;
+  MV full_mv;
+  int cost_list[5];
+  int dis;
+  int rv = 0;
+
+  if (scaled_ref_frame) {
+    int i;
+    // Swap out the reference frame for a version that's been scaled to
+    // match the resolution of the current frame, allowing the existing
+    // motion search code to be used without additional modifications.
+    for (i = 0; i < MAX_MB_PLANE; i++) backup_yv12[i] = xd->plane[i].pre[0];
+    av1_setup_pre_planes(xd, 0, scaled_ref_frame, mi_row, mi_col, NULL);
+  }
+
+#if CONFIG_REF_MV
+  av1_set_mvcost(x, ref, 0, mbmi->ref_mv_idx);
+#endif
+
+  av1_set_mv_search_range(x, &ref_mv);
+
+  assert(x->mv_best_ref_index[ref] <= 2);
+  if (x->mv_best_ref_index[ref] < 2)
+    mvp_full = x->mbmi_ext->ref_mvs[ref][x->mv_best_ref_index[ref]].as_mv;
+  else
+    mvp_full = x->pred_mv[ref];
+  mvp_full.col >>= 3;
+  mvp_full.row >>= 3;
+
+  av1_full_pixel_search(cpi, x, bsize, &mvp_full,
+                        cpi->sf.mv.fullpel_search_step_param, x->sadperbit16,
+                        cond_cost_list(cpi, cost_list), &ref_mv, &tmp_mv->as_mv,
+                        INT_MAX, 0);
+
+  x->mv_col_min = tmp_col_min;
+  x->mv_col_max = tmp_col_max;
+  x->mv_row_min = tmp_row_min;
+  x->mv_row_max = tmp_row_max;
+
+  full_mv.row = tmp_mv->as_mv.row * 8;
+  full_mv.col = tmp_mv->as_mv.col * 8;
+  *rate_mv = av1_mv_bit_cost(&full_mv, &ref_mv, x->nmvjointcost, x->mvcost,
+                             MV_COST_WEIGHT);
+
+  rv = !(RDCOST(x->rdmult, x->rddiv, *rate_mv + mode_rate, 0) > best_rd_sofar);
+
+  if (rv) {
+    cpi->find_fractional_mv_step(
+        x, &tmp_mv->as_mv, &ref_mv, cm->allow_high_precision_mv,
+        x->errorperbit, &cpi->fn_ptr[bsize], cpi->sf.mv.subpel_force_stop,
+        cpi->sf.mv.subpel_iters_per_step, cond_cost_list(cpi, cost_list),
+        x->nmvjointcost, x->mvcost, &dis, &x->pred_sse[ref], NULL, 0, 0, 0);
+    *rate_mv = av1_mv_bit_cost(&tmp_mv->as_mv, &ref_mv, x->nmvjointcost,
+                               x->mvcost, MV_COST_WEIGHT);
+    x->pred_mv[ref] = tmp_mv->as_mv;
+  }
+
+  if (scaled_ref_frame) {
+    int i;
+    for (i = 0; i < MAX_MB_PLANE; i++) xd->plane[i].pre[0] = backup_yv12[i];
+  }
+  return rv;
+}
+
+static INLINE int mv_out_of_range(const MACROBLOCK *x, const MV *mv) {
+  return (mv->row >> 3) < x->mv_row_min || (mv->row >> 3) > x->mv_row_max ||
+         (mv->col >> 3) < x->mv_col_min || (mv->col >> 3) > x->mv_col_max;
+}
+
+struct estimate_block_intra_args {
+  const AV1_COMP *cpi;
+  MACROBLOCK *x;
+  PREDICTION_MODE mode;
+  int64_t sse;
+};
+
+// Predicts one transform block from its (predicted, not reconstructed)
+// neighbors and accumulates the prediction error energy.
+static void estimate_block_intra(int plane, int block, int blk_row, int blk_col,
+                                 BLOCK_SIZE plane_bsize, TX_SIZE tx_size,
+                                 void *arg) {
+  struct estimate_block_intra_args *const args = arg;
+  MACROBLOCK *const x = args->x;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  const struct macroblock_plane *const p = &x->plane[plane];
+  const struct macroblockd_plane *const pd = &xd->plane[plane];
+  const uint8_t *const src =
+      &p->src.buf[4 * (blk_row * p->src.stride + blk_col)];
+  uint8_t *const dst = &pd->dst.buf[4 * (blk_row * pd->dst.stride + blk_col)];
+  unsigned int sse;
+  (void)block;
+
+  av1_predict_intra_block(xd, b_width_log2_lookup[plane_bsize],
+                          b_height_log2_lookup[plane_bsize], tx_size,
+                          args->mode, dst, pd->dst.stride, dst, pd->dst.stride,
+                          blk_col, blk_row, plane);
+  args->cpi->fn_ptr[txsize_to_bsize[tx_size]].vf(src, p->src.stride, dst,
+                                                 pd->dst.stride, &sse);
+  args->sse += sse;
+}
+
+static void store_pick_context(const MACROBLOCK *x, PICK_MODE_CONTEXT *ctx,
+                               int mode_index) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+
+  ctx->skip = x->skip;
+  ctx->skippable = 0;
+  ctx->best_mode_index = mode_index;
+  ctx->mic = *xd->mi[0];
+  ctx->mbmi_ext = *x->mbmi_ext;
+  ctx->single_pred_diff = 0;
+  ctx->comp_pred_diff = 0;
+  ctx->hybrid_pred_diff = 0;
+}
+
+void av1_pick_inter_mode(const AV1_COMP *cpi, TileDataEnc *tile_data,
+                         MACROBLOCK *x, int mi_row, int mi_col,
+                         RD_COST *rd_cost, BLOCK_SIZE bsize,
+                         PICK_MODE_CONTEXT *ctx, int64_t best_rd_so_far) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const SPEED_FEATURES *const sf = &cpi->sf;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  MB_MODE_INFO_EXT *const mbmi_ext = x->mbmi_ext;
+  const struct segmentation *const seg = &cm->seg;
+  const int segment_id = mbmi->segment_id;
+  const aom_prob skip_prob = av1_get_skip_prob(cm, xd);
+  const int intra_cost_penalty = av1_get_intra_cost_penalty(
+      cm->base_qindex, cm->y_dc_delta_q, cm->bit_depth);
+  const int64_t inter_mode_thresh =
+      RDCOST(x->rdmult, x->rddiv, intra_cost_penalty, 0);
+  struct buf_2d yv12_mb[MAX_REF_FRAMES][MAX_MB_PLANE];
+  int_mv frame_mv[MB_MODE_COUNT][MAX_REF_FRAMES];
+  unsigned int ref_costs_single[MAX_REF_FRAMES], ref_costs_comp[MAX_REF_FRAMES];
+  aom_prob comp_mode_p;
+  MB_MODE_INFO best_mbmode;
+  int64_t best_rd = best_rd_so_far;
+  int best_rate = INT_MAX;
+  int64_t best_dist = 0;
+  int best_mode_index = -1;
+  int best_skip_y = 0;
+  unsigned int var_y = UINT_MAX, sse_y = UINT_MAX;
+  int ref_idx, mode_idx, i;
+
+  (void)tile_data;
+  aom_clear_system_state();
+
+  av1_estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single,
+                               ref_costs_comp, &comp_mode_p);
+
+#if CONFIG_PALETTE
+  mbmi->palette_mode_info.palette_size[0] = 0;
+  mbmi->palette_mode_info.palette_size[1] = 0;
+#endif  // CONFIG_PALETTE
+#if CONFIG_EXT_INTRA
+  mbmi->intra_angle_delta[0] = 0;
+  mbmi->intra_angle_delta[1] = 0;
+#endif  // CONFIG_EXT_INTRA
+#if CONFIG_MOTION_VAR
+  mbmi->motion_mode = SIMPLE_TRANSLATION;
+#endif  // CONFIG_MOTION_VAR
+#if CONFIG_REF_MV
+  mbmi->ref_mv_idx = 0;
+#endif
+  mbmi->tx_type = DCT_DCT;
+  mbmi->uv_mode = DC_PRED;
+  mbmi->ref_frame[1] = NONE;
+  av1_zero(best_mbmode);
+
+  for (i = 0; i < MAX_REF_FRAMES; ++i) x->pred_sse[i] = INT_MAX;
+
+  rd_cost->rate = INT_MAX;
+
+  for (i = LAST_FRAME; i <= ALTREF_FRAME; ++i) {
+    x->pred_mv_sad[i] = INT_MAX;
+    mbmi_ext->mode_context[i] = 0;
+    frame_mv[NEWMV][i].as_int = INVALID_MV;
+    frame_mv[ZEROMV][i].as_int = 0;
+  }
+
+  for (ref_idx = 0; ref_idx < (int)(sizeof(pick_ref_frames) /
+                                    sizeof(pick_ref_frames[0]));
+       ++ref_idx) {
+    const MV_REFERENCE_FRAME ref_frame = pick_ref_frames[ref_idx];
+    const YV12_BUFFER_CONFIG *yv12;
+    const struct scale_factors *ref_sf;
+
+    if (!(cpi->ref_frame_flags & pick_flag_list[ref_frame])) continue;
+    if (segfeature_active(seg, segment_id, SEG_LVL_REF_FRAME) &&
+        get_segdata(seg, segment_id, SEG_LVL_REF_FRAME) != (int)ref_frame)
+      continue;
+
+    yv12 = get_ref_frame_buffer(cpi, ref_frame);
+    assert(yv12 != NULL);
+    ref_sf = &cm->frame_refs[ref_frame - 1].sf;
+    av1_setup_pred_block(xd, yv12_mb[ref_frame], yv12, mi_row, mi_col, ref_sf,
+                         ref_sf);
+    av1_find_mv_refs(cm, xd, xd->mi[0], ref_frame,
+#if CONFIG_REF_MV
+                     &mbmi_ext->ref_mv_count[ref_frame],
+                     mbmi_ext->ref_mv_stack[ref_frame],
+#endif
+                     mbmi_ext->ref_mvs[ref_frame], mi_row, mi_col, NULL, NULL,
+                     mbmi_ext->mode_context);
+    av1_find_best_ref_mvs(cm->allow_high_precision_mv,
+                          mbmi_ext->ref_mvs[ref_frame],
+                          &frame_mv[NEARESTMV][ref_frame],
+                          &frame_mv[NEARMV][ref_frame]);
+    if (!av1_is_scaled(ref_sf))
+      av1_mv_pred(cpi, x, yv12_mb[ref_frame][0].buf, yv12->y_stride, ref_frame,
+                  bsize);
+    else
+      x->mv_best_ref_index[ref_frame] = 0;
+
+    mbmi->ref_frame[0] = ref_frame;
+    set_ref_ptrs(cm, xd, ref_frame, NONE);
+    for (i = 0; i < MAX_MB_PLANE; i++)
+      xd->plane[i].pre[0] = yv12_mb[ref_frame][i];
+
+    for (mode_idx = 0; mode_idx < (int)(sizeof(pick_inter_modes) /
+                                        sizeof(pick_inter_modes[0]));
+         ++mode_idx) {
+      const PREDICTION_MODE this_mode = pick_inter_modes[mode_idx];
+      const THR_MODES thr_mode = get_thr_mode(ref_frame, this_mode);
+      int16_t mode_ctx;
+      int mode_rate;
+      int rate_mv = 0;
+      int this_rate;
+      int64_t this_dist;
+      int64_t this_rd;
+      int skip_y;
+      unsigned int this_var, this_sse;
+
+      if (!(sf->inter_mode_mask[bsize] & (1 << this_mode))) continue;
+
+      mbmi->mode = this_mode;
+#if CONFIG_REF_MV
+      mode_ctx = av1_mode_context_analyzer(mbmi_ext->mode_context,
+                                           mbmi->ref_frame, bsize, -1);
+#else
+      mode_ctx = mbmi_ext->mode_context[ref_frame];
+#endif
+      mode_rate = av1_cost_mv_ref(cpi, this_mode, mode_ctx);
+
+      if (this_mode == NEWMV) {
+        int_mv tmp_mv;
+        if (best_mode_index >= 0 && best_skip_y &&
+            best_mbmode.ref_frame[0] == ref_frame)
+          continue;
+        if (!combined_motion_search(cpi, x, bsize, mi_row, mi_col, &tmp_mv,
+                                    &rate_mv, mode_rate, best_rd))
+          continue;
+        frame_mv[NEWMV][ref_frame].as_int = tmp_mv.as_int;
+        // A new motion vector matching a cheaper mode is left to that mode.
+        if (tmp_mv.as_int == 0 ||
+            tmp_mv.as_int == frame_mv[NEARESTMV][ref_frame].as_int ||
+            tmp_mv.as_int == frame_mv[NEARMV][ref_frame].as_int)
+          continue;
+      } else if (this_mode != ZEROMV) {
+        // Candidates equal to an already checked motion vector are skipped.
+        if (frame_mv[this_mode][ref_frame].as_int == 0) continue;
+        if (this_mode == NEARMV &&
+            frame_mv[NEARMV][ref_frame].as_int ==
+                frame_mv[NEARESTMV][ref_frame].as_int)
+          continue;
+        if (mv_out_of_range(x, &frame_mv[this_mode][ref_frame].as_mv))
+          continue;
+      }
+
+      mbmi->mv[0].as_int = frame_mv[this_mode][ref_frame].as_int;
+      mbmi->mv[1].as_int = 0;
+      xd->mi[0]->bmi[0].as_mv[0].as_int = mbmi->mv[0].as_int;
+      mbmi->interp_filter =
+          cm->interp_filter == SWITCHABLE ? EIGHTTAP : cm->interp_filter;
+
+      av1_build_inter_predictors_sby(xd, mi_row, mi_col, bsize);
+      skip_y = model_rd_for_sb_y(cpi, bsize, x, xd, &this_rate, &this_dist,
+                                 &this_var, &this_sse);
+
+      if (cm->interp_filter == SWITCHABLE) {
+        if (!is_interp_needed(xd)) {
+#if !CONFIG_EXT_INTERP
+          this_rate += av1_get_switchable_rate(cpi, xd);
+#endif  // !CONFIG_EXT_INTERP
+        } else if (x->source_variance <
+                   sf->disable_filter_search_var_thresh) {
+          this_rate += av1_get_switchable_rate(cpi, xd);
+        } else {
+          // Pick the sub-pixel filter from the modelled rd of each candidate.
+          InterpFilter filter, best_filter = EIGHTTAP;
+          int64_t best_filter_rd = INT64_MAX;
+          int best_filter_rate = 0, best_filter_skip = 0;
+          int64_t best_filter_dist = 0;
+          unsigned int best_filter_var = 0, best_filter_sse = 0;
+          TX_SIZE best_filter_tx = mbmi->tx_size;
+
+          for (filter = EIGHTTAP; filter <= EIGHTTAP_SHARP; ++filter) {
+            int64_t filter_rd;
+            mbmi->interp_filter = filter;
+            if (filter != EIGHTTAP) {
+              av1_build_inter_predictors_sby(xd, mi_row, mi_col, bsize);
+              skip_y = model_rd_for_sb_y(cpi, bsize, x, xd, &this_rate,
+                                         &this_dist, &this_var, &this_sse);
+            }
+            this_rate += av1_get_switchable_rate(cpi, xd);
+            filter_rd = RDCOST(x->rdmult, x->rddiv, this_rate, this_dist);
+            if (filter_rd < best_filter_rd) {
+              best_filter_rd = filter_rd;
+              best_filter = filter;
+              best_filter_rate = this_rate;
+              best_filter_dist = this_dist;
+              best_filter_skip = skip_y;
+              best_filter_var = this_var;
+              best_filter_sse = this_sse;
+              best_filter_tx = mbmi->tx_size;
+            }
+          }
+          mbmi->interp_filter = best_filter;
+          mbmi->tx_size = best_filter_tx;
+          this_rate = best_filter_rate;
+          this_dist = best_filter_dist;
+          skip_y = best_filter_skip;
+          this_var = best_filter_var;
+          this_sse = best_filter_sse;
+        }
+#if CONFIG_EXT_INTERP
+        if (!is_interp_needed(xd)) mbmi->interp_filter = EIGHTTAP;
+#endif  // CONFIG_EXT_INTERP
+      }
+
+      this_rate += av1_cost_bit(skip_prob, skip_y);
+      this_rate += rate_mv + mode_rate + ref_costs_single[ref_frame];
+      if (cm->reference_mode == REFERENCE_MODE_SELECT)
+        this_rate += av1_cost_bit(comp_mode_p, 0);
+      this_rd = RDCOST(x->rdmult, x->rddiv, this_rate, this_dist);
+
+      if (this_rd < best_rd) {
+        best_rd = this_rd;
+        best_rate = this_rate;
+        best_dist = this_dist;
+        best_mode_index = thr_mode;
+        best_mbmode = *mbmi;
+        best_skip_y = skip_y;
+        var_y = this_var;
+        sse_y = this_sse;
+      }
+    }
+  }
+
+  // Check a few intra modes if no inter mode is good enough.
+  if (best_mode_index < 0 ||
+      (!best_skip_y && best_rd > inter_mode_thresh &&
+       bsize <= sf->max_intra_bsize &&
+       !segfeature_active(seg, segment_id, SEG_LVL_REF_FRAME))) {
+    const int dequant_shift = get_dequant_shift(xd);
+    struct estimate_block_intra_args args = { cpi, x, DC_PRED, 0 };
+
+    mbmi->ref_frame[0] = INTRA_FRAME;
+    mbmi->mv[0].as_int = 0;
+    mbmi->interp_filter =
+        cm->interp_filter == SWITCHABLE ? EIGHTTAP : cm->interp_filter;
+    mbmi->tx_size =
+        best_mode_index >= 0
+            ? pick_tx_size(cpi, bsize, var_y, sse_y)
+            : AOMMIN(max_txsize_lookup[bsize],
+                     tx_mode_to_biggest_tx_size[cm->tx_mode]);
+
+    for (mode_idx = 0; mode_idx < (int)(sizeof(pick_intra_modes) /
+                                        sizeof(pick_intra_modes[0]));
+         ++mode_idx) {
+      const PREDICTION_MODE this_mode = pick_intra_modes[mode_idx];
+      int this_rate;
+      int64_t this_dist;
+      int64_t this_rd;
+
+      // DC_PRED is always checked so that a mode is found for every block.
+      if (this_mode != DC_PRED &&
+          !(sf->intra_y_mode_bsize_mask[bsize] & (1 << this_mode)))
+        continue;
+
+      mbmi->mode = this_mode;
+      args.mode = this_mode;
+      args.sse = 0;
+      av1_foreach_transformed_block_in_plane(xd, bsize, 0,
+                                             estimate_block_intra, &args);
+      av1_model_rd_from_var_lapndz(
+          (unsigned int)AOMMIN(args.sse, UINT_MAX),
+          num_pels_log2_lookup[bsize], xd->plane[0].dequant[1] >> dequant_shift,
+          &this_rate, &this_dist);
+      this_dist <<= 4;
+      this_rate += cpi->mbmode_cost[this_mode] +
+                   cpi->intra_uv_mode_cost[this_mode][DC_PRED] +
+                   ref_costs_single[INTRA_FRAME] + av1_cost_bit(skip_prob, 0);
+      if (this_mode != DC_PRED && this_mode != TM_PRED)
+        this_rate += intra_cost_penalty;
+      this_rd = RDCOST(x->rdmult, x->rddiv, this_rate, this_dist);
+
+      if (this_rd < best_rd) {
+        best_rd = this_rd;
+        best_rate = this_rate;
+        best_dist = this_dist;
+        best_mode_index = get_thr_mode(INTRA_FRAME, this_mode);
+        best_mbmode = *mbmi;
+        best_skip_y = 0;
+      }
+    }
+  }
+
+  if (best_mode_index < 0 || best_rd >= best_rd_so_far) {
+    rd_cost->rate = INT_MAX;
+    rd_cost->rdcost = INT64_MAX;
+    return;
+  }
+
+#if CONFIG_REF_MV
+  if (best_mbmode.ref_frame[0] > INTRA_FRAME &&
+      best_mbmode.mv[0].as_int == 0 &&
+      (mbmi_ext->mode_context[best_mbmode.ref_frame[0]] &
+       (1 << ALL_ZERO_FLAG_OFFSET)))
+    best_mbmode.mode = ZEROMV;
+#endif
+
+  *mbmi = best_mbmode;
+#if CONFIG_REF_MV
+  if (is_inter_block(mbmi)) {
+    if (mbmi->mode != NEWMV)
+      mbmi->pred_mv[0].as_int = mbmi->mv[0].as_int;
+    else
+      mbmi->pred_mv[0].as_int = mbmi_ext->ref_mvs[mbmi->ref_frame[0]][0].as_int;
+  }
+#endif
+  xd->mi[0]->bmi[0].as_mv[0].as_int = mbmi->mv[0].as_int;
+
+  // The residual is always coded; blocks whose coefficients all quantize to
+  // zero are flagged as skipped by the tokenizer.
+  x->skip = 0;
+
+  rd_cost->rate = best_rate;
+  rd_cost->dist = best_dist;
+  rd_cost->rdcost = best_rd;
+
+  store_pick_context(x, ctx, best_mode_index);
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_PICKMODE_H_
+#define AV1_ENCODER_PICKMODE_H_
+
+#include "av1/encoder/encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Non-RD mode decision for real-time encoding. Picks the inter (or intra)
+// mode of a block >= 8x8 in an inter frame from variance based rate and
+// distortion estimates of the prediction, without running the transform,
+// quantization and token costing for each candidate.
+void av1_pick_inter_mode(const AV1_COMP *cpi, TileDataEnc *tile_data,
+                         MACROBLOCK *x, int mi_row, int mi_col,
+                         RD_COST *rd_cost, BLOCK_SIZE bsize,
+                         PICK_MODE_CONTEXT *ctx, int64_t best_rd_so_far);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_PICKMODE_H_
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "aom_mem/aom_mem.h"
+#include "aom_ports/mem.h"
+#include "av1/encoder/pyramid.h"
+
+static int alloc_level(ME_PYRAMID_LEVEL *lvl, int width, int height) {
+  const int stride = (width + 2 * ME_PYRAMID_BORDER + 31) & ~31;
+  const int rows = height + 2 * ME_PYRAMID_BORDER;
+
+  if (lvl->buf_alloc && lvl->width == width && lvl->height == height)
+    return 0;
+  aom_free(lvl->buf_alloc);
+  lvl->buf_alloc = (uint8_t *)aom_memalign(32, (size_t)stride * rows);
+  if (!lvl->buf_alloc) {
+    lvl->buf = NULL;
+    lvl->width = lvl->height = 0;
+    return -1;
+  }
+  lvl->stride = stride;
+  lvl->width = width;
+  lvl->height = height;
+  lvl->buf = lvl->buf_alloc + ME_PYRAMID_BORDER * stride + ME_PYRAMID_BORDER;
+  return 0;
+}
+
+static void extend_level(ME_PYRAMID_LEVEL *lvl) {
+  const int b = ME_PYRAMID_BORDER;
+  const int stride = lvl->stride;
+  uint8_t *row = lvl->buf;
+  int i;
+
+  for (i = 0; i < lvl->height; ++i, row += stride) {
+    memset(row - b, row[0], b);
+    memset(row + lvl->width, row[lvl->width - 1], b);
+  }
+  for (i = 1; i <= b; ++i) {
+    memcpy(lvl->buf - i * stride - b, lvl->buf - b, lvl->width + 2 * b);
+    memcpy(lvl->buf + (lvl->height - 1 + i) * stride - b,
+           lvl->buf + (lvl->height - 1) * stride - b, lvl->width + 2 * b);
+  }
+}
+
+// Averages 2x2 blocks of src into dst. The last row and column are repeated
+// when the source dimensions are odd.
+static void downscale_2x2(const uint8_t *src, int src_stride, int src_w,
+                          int src_h, ME_PYRAMID_LEVEL *dst) {
+  int i, j;
+  for (i = 0; i < dst->height; ++i) {
+    const uint8_t *s0 = src + 2 * i * src_stride;
+    const uint8_t *s1 = 2 * i + 1 < src_h ? s0 + src_stride : s0;
+    uint8_t *d = dst->buf + i * dst->stride;
+    for (j = 0; j < dst->width; ++j) {
+      const int c0 = 2 * j;
+      const int c1 = c0 + 1 < src_w ? c0 + 1 : c0;
+      d[j] = (s0[c0] + s0[c1] + s1[c0] + s1[c1] + 2) >> 2;
+    }
+  }
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+static void highbd_downscale_2x2(const uint16_t *src, int src_stride,
+                                 int src_w, int src_h, int bit_depth,
+                                 ME_PYRAMID_LEVEL *dst) {
+  const int shift = bit_depth - 8 + 2;
+  const int round = 1 << (shift - 1);
+  int i, j;
+  for (i = 0; i < dst->height; ++i) {
+    const uint16_t *s0 = src + 2 * i * src_stride;
+    const uint16_t *s1 = 2 * i + 1 < src_h ? s0 + src_stride : s0;
+    uint8_t *d = dst->buf + i * dst->stride;
+    for (j = 0; j < dst->width; ++j) {
+      const int c0 = 2 * j;
+      const int c1 = c0 + 1 < src_w ? c0 + 1 : c0;
+      d[j] = (s0[c0] + s0[c1] + s1[c0] + s1[c1] + round) >> shift;
+    }
+  }
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+int av1_build_me_pyramid(ME_PYRAMID *pyr, const YV12_BUFFER_CONFIG *src,
+                         int bit_depth) {
+  const int width = src->y_crop_width;
+  const int height = src->y_crop_height;
+  ME_PYRAMID_LEVEL *const l1 = &pyr->level[0];
+  ME_PYRAMID_LEVEL *const l2 = &pyr->level[1];
+
+  av1_invalidate_me_pyramid(pyr);
+  if (alloc_level(l1, (width + 1) >> 1, (height + 1) >> 1) ||
+      alloc_level(l2, (l1->width + 1) >> 1, (l1->height + 1) >> 1))
+    return -1;
+
+#if CONFIG_AOM_HIGHBITDEPTH
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH)
+    highbd_downscale_2x2(CONVERT_TO_SHORTPTR(src->y_buffer), src->y_stride,
+                         width, height, bit_depth, l1);
+  else
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+    downscale_2x2(src->y_buffer, src->y_stride, width, height, l1);
+  (void)bit_depth;
+  downscale_2x2(l1->buf, l1->stride, l1->width, l1->height, l2);
+
+  extend_level(l1);
+  extend_level(l2);
+  pyr->width = width;
+  pyr->height = height;
+  return 0;
+}
+
+void av1_free_me_pyramid(ME_PYRAMID *pyr) {
+  int i;
+  for (i = 0; i < ME_PYRAMID_LEVELS; ++i) {
+    aom_free(pyr->level[i].buf_alloc);
+    memset(&pyr->level[i], 0, sizeof(pyr->level[i]));
+  }
+  av1_invalidate_me_pyramid(pyr);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_PYRAMID_H_
+#define AV1_ENCODER_PYRAMID_H_
+
+#include "./aom_config.h"
+#include "aom_scale/yv12config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of down-scaled levels: level 1 is 1/2 and level 2 is 1/4 of the
+// luma plane.
+#define ME_PYRAMID_LEVELS 2
+
+// Border of every level. It covers a 64x64 block lying just outside the
+// frame, which the motion vector limits allow, at 1/2 resolution.
+#define ME_PYRAMID_BORDER 48
+
+typedef struct {
+  uint8_t *buf;
+  uint8_t *buf_alloc;
+  int stride;
+  int width;
+  int height;
+} ME_PYRAMID_LEVEL;
+
+// 8-bit down-scaled copies of the luma plane of a frame, for the coarse
+// motion search. High bit-depth frames are scaled down to 8 bits.
+typedef struct {
+  ME_PYRAMID_LEVEL level[ME_PYRAMID_LEVELS];
+  // Dimensions of the full resolution frame, 0 while the pyramid is invalid.
+  int width;
+  int height;
+} ME_PYRAMID;
+
+// Builds the pyramid of the luma plane of src, (re)allocating the levels if
+// the frame size changed. Returns -1 on allocation failure.
+int av1_build_me_pyramid(ME_PYRAMID *pyr, const YV12_BUFFER_CONFIG *src,
+                         int bit_depth);
+
+static INLINE void av1_invalidate_me_pyramid(ME_PYRAMID *pyr) {
+  pyr->width = 0;
+  pyr->height = 0;
+}
+
+static INLINE int av1_me_pyramid_valid(const ME_PYRAMID *pyr, int width,
+                                       int height) {
+  return pyr->width == width && pyr->height == height && width > 0;
+}
+
+void av1_free_me_pyramid(ME_PYRAMID *pyr);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_PYRAMID_H_
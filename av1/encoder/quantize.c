@@ -377,6 +377,21 @@ void av1_init_quantizer(AV1_COMP *cpi) {
   }
 }
 
+#if CONFIG_AOM_QM
+static void set_plane_qmatrices(struct macroblockd_plane *pd, int segment_id,
+                                int qmlevel, int is_chroma) {
+  int is_intra, t;
+  for (is_intra = 0; is_intra < 2; ++is_intra) {
+    for (t = 0; t < TX_SIZES; ++t) {
+      pd->seg_qmatrix[segment_id][is_intra][t] =
+          aom_qmatrix(qmlevel, is_chroma, t, is_intra);
+      pd->seg_iqmatrix[segment_id][is_intra][t] =
+          aom_iqmatrix(qmlevel, is_chroma, t, is_intra);
+    }
+  }
+}
+#endif
+
 void av1_init_plane_quantizers(const AV1_COMP *cpi, MACROBLOCK *x) {
   const AV1_COMMON *const cm = &cpi->common;
   MACROBLOCKD *const xd = &x->e_mbd;
@@ -402,10 +417,7 @@ void av1_init_plane_quantizers(const AV1_COMP *cpi, MACROBLOCK *x) {
   x->plane[0].zbin = quants->y_zbin[qindex];
   x->plane[0].round = quants->y_round[qindex];
 #if CONFIG_AOM_QM
-  memcpy(&xd->plane[0].seg_qmatrix[segment_id], cm->gqmatrix[qmlevel][0],
-         sizeof(cm->gqmatrix[qmlevel][0]));
-  memcpy(&xd->plane[0].seg_iqmatrix[segment_id], cm->giqmatrix[qmlevel][0],
-         sizeof(cm->giqmatrix[qmlevel][0]));
+  set_plane_qmatrices(&xd->plane[0], segment_id, qmlevel, 0);
 #endif
   xd->plane[0].dequant = cpi->y_dequant[qindex];
 
@@ -421,10 +433,7 @@ void av1_init_plane_quantizers(const AV1_COMP *cpi, MACROBLOCK *x) {
     x->plane[i].zbin = quants->uv_zbin[qindex];
     x->plane[i].round = quants->uv_round[qindex];
 #if CONFIG_AOM_QM
-    memcpy(&xd->plane[i].seg_qmatrix[segment_id], cm->gqmatrix[qmlevel][1],
-           sizeof(cm->gqmatrix[qmlevel][1]));
-    memcpy(&xd->plane[i].seg_iqmatrix[segment_id], cm->giqmatrix[qmlevel][1],
-           sizeof(cm->giqmatrix[qmlevel][1]));
+    set_plane_qmatrices(&xd->plane[i], segment_id, qmlevel, 1);
 #endif
     xd->plane[i].dequant = cpi->uv_dequant[qindex];
 
@@ -38,6 +38,7 @@
 #include "av1/encoder/encodemb.h"
 #include "av1/encoder/encodemv.h"
 #include "av1/encoder/encoder.h"
+#include "av1/encoder/ethread.h"
 #include "av1/encoder/hybrid_fwd_txfm.h"
 #include "av1/encoder/mcomp.h"
 #if CONFIG_PALETTE
@@ -419,12 +420,9 @@ static int cost_coeffs(MACROBLOCK *x, int plane, int block, ENTROPY_CONTEXT *A,
     int band_left = *band_count++;
 
     // dc token
-    int v = qcoeff[0];
     int16_t prev_t;
-    EXTRABIT e;
-    av1_get_token_extra(v, &prev_t, &e);
-    cost =
-        (*token_costs)[0][pt][prev_t] + av1_get_cost(prev_t, e, cat6_high_cost);
+    cost = av1_get_token_cost(qcoeff[0], &prev_t, cat6_high_cost);
+    cost += (*token_costs)[0][pt][prev_t];
 
     token_cache[0] = av1_pt_energy_class[prev_t];
     ++token_costs;
@@ -434,15 +432,12 @@ static int cost_coeffs(MACROBLOCK *x, int plane, int block, ENTROPY_CONTEXT *A,
       const int rc = scan[c];
       int16_t t;
 
-      v = qcoeff[rc];
-      av1_get_token_extra(v, &t, &e);
+      cost += av1_get_token_cost(qcoeff[rc], &t, cat6_high_cost);
       if (use_fast_coef_costing) {
-        cost += (*token_costs)[!prev_t][!prev_t][t] +
-                av1_get_cost(t, e, cat6_high_cost);
+        cost += (*token_costs)[!prev_t][!prev_t][t];
       } else {
         pt = get_coef_context(nb, token_cache, c);
-        cost +=
-            (*token_costs)[!prev_t][pt][t] + av1_get_cost(t, e, cat6_high_cost);
+        cost += (*token_costs)[!prev_t][pt][t];
         token_cache[rc] = av1_pt_energy_class[t];
       }
       prev_t = t;
@@ -498,6 +493,81 @@ static int rate_block(int plane, int block, int blk_row, int blk_col,
                      args->scan_order->neighbors, args->use_fast_coef_costing);
 }
 
+// Returns the key in the transform block RD cache of the tx_size block at
+// blk_row, blk_col: a hash of its residual and of the parameters of its
+// transform, quantization and coefficient coding.
+static uint64_t tx_rd_cache_key(const struct rdcost_block_args *args,
+                                int plane, int block, int blk_row, int blk_col,
+                                BLOCK_SIZE plane_bsize, TX_SIZE tx_size) {
+  const MACROBLOCK *const x = args->x;
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const struct macroblock_plane *const p = &x->plane[plane];
+  const PLANE_TYPE plane_type = plane == 0 ? PLANE_TYPE_Y : PLANE_TYPE_UV;
+  const int diff_stride = 4 * num_4x4_blocks_wide_lookup[plane_bsize];
+  const int16_t *const diff =
+      &p->src_diff[4 * (blk_row * diff_stride + blk_col)];
+  const int size = tx_size_1d[tx_size];
+  const int pt =
+      combine_entropy_contexts(args->t_above[blk_col], args->t_left[blk_row]);
+  // The quantizer tables identify the plane and the q index.
+  uint64_t key = (uintptr_t)p->quant;
+  int r, c;
+
+  key = key << 32 ^ (get_tx_type(plane_type, xd, block) | tx_size << 4 |
+                     pt << 6 | args->use_fast_coef_costing << 8 |
+                     x->skip_block << 9 | x->use_lp32x32fdct << 10 |
+                     xd->mi[0]->mbmi.segment_id << 11);
+  for (r = 0; r < size; ++r) {
+    for (c = 0; c < size; c += 4) {
+      uint64_t v;
+      memcpy(&v, diff + r * diff_stride + c, sizeof(v));
+      key = (key ^ v) * 0x100000001b3ULL;
+      key ^= key >> 29;
+    }
+  }
+  return key ? key : 1;
+}
+
+// Codes the tx_size block of an inter block at blk_row, blk_col, and returns
+// its rate, distortion and sse. The results of blocks coded before in the
+// tile with the same residual and parameters are reused.
+static void inter_block_txfm_rd(struct rdcost_block_args *args, int plane,
+                                int block, int blk_row, int blk_col,
+                                BLOCK_SIZE plane_bsize, TX_SIZE tx_size,
+                                int *rate, int64_t *dist, int64_t *sse) {
+  MACROBLOCK *const x = args->x;
+  const uint64_t key = tx_rd_cache_key(args, plane, block, blk_row, blk_col,
+                                       plane_bsize, tx_size);
+  TX_RD_CACHE_ENTRY *const entry =
+      &x->tx_rd_cache[key & (TX_RD_CACHE_SIZE - 1)];
+
+  if (entry->key == key) {
+    x->plane[plane].eobs[block] = entry->eob;
+    args->t_above[blk_col] = args->t_left[blk_row] = entry->eob > 0;
+    *rate = entry->rate;
+    *dist = entry->dist;
+    *sse = entry->sse;
+    return;
+  }
+
+  if (av1_xform_quant_dist(x, plane, block, blk_row, blk_col, plane_bsize,
+                           tx_size, dist, sse)) {
+    // Scaled as in dist_block(), the fused kernels being below 32x32.
+    *dist >>= 2;
+    *sse >>= 2;
+  } else {
+    av1_xform_quant(x, plane, block, blk_row, blk_col, plane_bsize, tx_size);
+    dist_block(x, plane, block, tx_size, dist, sse);
+  }
+  *rate = rate_block(plane, block, blk_row, blk_col, tx_size, args);
+
+  entry->key = key;
+  entry->rate = *rate;
+  entry->eob = x->plane[plane].eobs[block];
+  entry->dist = *dist;
+  entry->sse = *sse;
+}
+
 static void block_rd_txfm(int plane, int block, int blk_row, int blk_col,
                           BLOCK_SIZE plane_bsize, TX_SIZE tx_size, void *arg) {
   struct rdcost_block_args *args = arg;
@@ -505,7 +575,7 @@ static void block_rd_txfm(int plane, int block, int blk_row, int blk_col,
   MACROBLOCKD *const xd = &x->e_mbd;
   MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
   int64_t rd1, rd2, rd;
-  int rate;
+  int rate = INT_MAX;
   int64_t dist;
   int64_t sse;
 
@@ -521,8 +591,8 @@ static void block_rd_txfm(int plane, int block, int blk_row, int blk_col,
                      (block >> (tx_size_1d_in_unit_log2[tx_size] * 2))] ==
         SKIP_TXFM_NONE) {
       // full forward transform and quantization
-      av1_xform_quant(x, plane, block, blk_row, blk_col, plane_bsize, tx_size);
-      dist_block(x, plane, block, tx_size, &dist, &sse);
+      inter_block_txfm_rd(args, plane, block, blk_row, blk_col, plane_bsize,
+                          tx_size, &rate, &dist, &sse);
     } else if (x->skip_txfm[(plane << 2) +
                             (block >> (tx_size_1d_in_unit_log2[tx_size] *
                                        2))] == SKIP_TXFM_AC_ONLY) {
@@ -557,8 +627,8 @@ static void block_rd_txfm(int plane, int block, int blk_row, int blk_col,
     }
   } else {
     // full forward transform and quantization
-    av1_xform_quant(x, plane, block, blk_row, blk_col, plane_bsize, tx_size);
-    dist_block(x, plane, block, tx_size, &dist, &sse);
+    inter_block_txfm_rd(args, plane, block, blk_row, blk_col, plane_bsize,
+                        tx_size, &rate, &dist, &sse);
   }
 
   rd = RDCOST(x->rdmult, x->rddiv, 0, dist);
@@ -567,7 +637,8 @@ static void block_rd_txfm(int plane, int block, int blk_row, int blk_col,
     return;
   }
 
-  rate = rate_block(plane, block, blk_row, blk_col, tx_size, args);
+  if (rate == INT_MAX)
+    rate = rate_block(plane, block, blk_row, blk_col, tx_size, args);
   rd1 = RDCOST(x->rdmult, x->rddiv, rate, dist);
   rd2 = RDCOST(x->rdmult, x->rddiv, 0, sse);
 
@@ -623,6 +694,105 @@ static void txfm_rd_in_plane(MACROBLOCK *x, int *rate, int64_t *distortion,
   }
 }
 
+// First basis functions of the 4, 8 and 16 point ADSTs, in Q8 with a unit
+// norm.
+static const int16_t adst4_basis[4] = { 58, 110, 148, 168 };
+static const int16_t adst8_basis[8] = { 13, 37, 60, 81, 99, 113, 122, 127 };
+static const int16_t adst16_basis[16] = { 4,  13, 22, 30, 39, 47, 54, 61,
+                                          67, 73, 78, 82, 85, 88, 90, 90 };
+
+// Score bonus of a transform type picked by a neighbor block or by the last
+// transform type search, in the Q8 units of the residual energy compaction.
+#define TX_TYPE_NEIGHBOR_BONUS 16
+#define TX_TYPE_LAST_BONUS 16
+
+// Gain in energy compaction of the 1-D ADST over the 1-D DCT, estimated by the
+// energy of the first basis functions over the length n segments of the
+// residual along step, each line starting stride apart. Returns a Q8 ratio to
+// the residual energy, positive when the ADST compacts better.
+static int adst_compaction_gain(const int16_t *diff, int stride, int step,
+                                int lines, int length) {
+  const int n = AOMMIN(length, 16);
+  const int n_log2 = n == 4 ? 2 : n == 8 ? 3 : 4;
+  const int16_t *const basis =
+      n == 4 ? adst4_basis : n == 8 ? adst8_basis : adst16_basis;
+  int64_t dct_energy = 0, adst_energy = 0, energy = 0;
+  int line, pos, k;
+
+  for (line = 0; line < lines; ++line) {
+    for (pos = 0; pos < length; pos += n) {
+      const int16_t *const seg = diff + line * stride + pos * step;
+      int64_t dct = 0, adst = 0;
+      for (k = 0; k < n; ++k) {
+        const int v = seg[k * step];
+        dct += v;
+        adst += v * basis[k];
+        energy += v * v;
+      }
+      dct_energy += (dct * dct) << (16 - n_log2);
+      adst_energy += adst * adst;
+    }
+  }
+  if (energy == 0) return 0;
+  return (int)((adst_energy - dct_energy) / (energy << 8));
+}
+
+// Returns the mask of the luma transform types the transform search runs the
+// full RD on: DCT_DCT and the best ranked others, sf.tx_type_candidates in
+// all. The types are ranked by the energy compaction of their 1-D transforms
+// on the residual, and by the types picked by the neighbors and by the last
+// search.
+static int get_tx_type_search_mask(const AV1_COMP *const cpi,
+                                   const MACROBLOCK *x, BLOCK_SIZE bsize) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  const int num_candidates = cpi->sf.tx_type_candidates;
+  int vert_gain, horz_gain;
+  int score[TX_TYPES];
+  int mask = 1 << DCT_DCT;
+  TX_TYPE tx_type;
+  int i;
+
+  if (num_candidates >= TX_TYPES) return (1 << TX_TYPES) - 1;
+
+  if (is_inter_block(mbmi)) {
+    const int bw = 4 * num_4x4_blocks_wide_lookup[bsize];
+    const int bh = 4 * num_4x4_blocks_high_lookup[bsize];
+    const int16_t *const diff = x->plane[0].src_diff;
+    vert_gain = adst_compaction_gain(diff, 1, bw, bw, bh);
+    horz_gain = adst_compaction_gain(diff, bw, 1, bh, bw);
+  } else {
+    // The residual of an intra block is only formed transform block by
+    // transform block, so rank by the type the prediction mode favors.
+    const TX_TYPE mode_tx_type = intra_mode_to_tx_type_context[mbmi->mode];
+    vert_gain = (mode_tx_type == ADST_DCT || mode_tx_type == ADST_ADST) * 64;
+    horz_gain = (mode_tx_type == DCT_ADST || mode_tx_type == ADST_ADST) * 64;
+  }
+
+  for (tx_type = DCT_DCT; tx_type < TX_TYPES; ++tx_type) {
+    score[tx_type] = 0;
+    if (tx_type == ADST_DCT || tx_type == ADST_ADST)
+      score[tx_type] += vert_gain;
+    if (tx_type == DCT_ADST || tx_type == ADST_ADST)
+      score[tx_type] += horz_gain;
+    if (xd->above_mi && xd->above_mi->mbmi.tx_type == tx_type)
+      score[tx_type] += TX_TYPE_NEIGHBOR_BONUS;
+    if (xd->left_mi && xd->left_mi->mbmi.tx_type == tx_type)
+      score[tx_type] += TX_TYPE_NEIGHBOR_BONUS;
+    if (x->last_tx_type == tx_type) score[tx_type] += TX_TYPE_LAST_BONUS;
+  }
+
+  for (i = 1; i < num_candidates; ++i) {
+    int best = -1;
+    for (tx_type = DCT_DCT + 1; tx_type < TX_TYPES; ++tx_type) {
+      if (mask & (1 << tx_type)) continue;
+      if (best < 0 || score[tx_type] > score[best]) best = tx_type;
+    }
+    mask |= 1 << best;
+  }
+  return mask;
+}
+
 static void choose_largest_tx_size(const AV1_COMP *const cpi, MACROBLOCK *x,
                                    int *rate, int64_t *distortion, int *skip,
                                    int64_t *sse, int64_t ref_best_rd,
@@ -648,7 +818,9 @@ static void choose_largest_tx_size(const AV1_COMP *const cpi, MACROBLOCK *x,
 
   mbmi->tx_size = AOMMIN(max_tx_size, largest_tx_size);
   if (mbmi->tx_size < TX_32X32 && !xd->lossless[mbmi->segment_id]) {
+    const int tx_type_mask = get_tx_type_search_mask(cpi, x, bs);
     for (tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+      if (!(tx_type_mask & (1 << tx_type))) continue;
       mbmi->tx_type = tx_type;
       txfm_rd_in_plane(x, &r, &d, &s, &psse, ref_best_rd, 0, bs, mbmi->tx_size,
                        cpi->sf.use_fast_coef_costing);
@@ -675,6 +847,7 @@ static void choose_largest_tx_size(const AV1_COMP *const cpi, MACROBLOCK *x,
         *sse = psse;
       }
     }
+    x->last_tx_type = best_tx_type;
   } else {
     txfm_rd_in_plane(x, rate, distortion, skip, sse, ref_best_rd, 0, bs,
                      mbmi->tx_size, cpi->sf.use_fast_coef_costing);
@@ -716,6 +889,7 @@ static void choose_tx_size_from_rd(const AV1_COMP *const cpi, MACROBLOCK *x,
   TX_TYPE tx_type, best_tx_type = DCT_DCT;
   const int is_inter = is_inter_block(mbmi);
   const aom_prob *tx_probs = get_tx_probs2(max_tx_size, xd, &cm->fc->tx_probs);
+  const int tx_type_mask = get_tx_type_search_mask(cpi, x, bs);
 
   assert(skip_prob > 0);
   s0 = av1_cost_bit(skip_prob, 0);
@@ -740,6 +914,7 @@ static void choose_tx_size_from_rd(const AV1_COMP *const cpi, MACROBLOCK *x,
 #if CONFIG_REF_MV
     if (mbmi->ref_mv_idx > 0 && tx_type != DCT_DCT) continue;
 #endif
+    if (!(tx_type_mask & (1 << tx_type))) continue;
 
     last_rd = INT64_MAX;
     for (n = start_tx; n >= end_tx; --n) {
@@ -806,6 +981,7 @@ static void choose_tx_size_from_rd(const AV1_COMP *const cpi, MACROBLOCK *x,
 
   mbmi->tx_size = best_tx;
   mbmi->tx_type = best_tx_type;
+  if (best_tx < TX_32X32) x->last_tx_type = best_tx_type;
 
   if (mbmi->tx_size >= TX_32X32) assert(mbmi->tx_type == DCT_DCT);
 }
@@ -2097,8 +2273,8 @@ static void choose_intra_uv_mode(const AV1_COMP *const cpi, MACROBLOCK *const x,
   *mode_uv = x->e_mbd.mi[0]->mbmi.uv_mode;
 }
 
-static int cost_mv_ref(const AV1_COMP *const cpi, PREDICTION_MODE mode,
-                       int16_t mode_context) {
+int av1_cost_mv_ref(const AV1_COMP *const cpi, PREDICTION_MODE mode,
+                    int16_t mode_context) {
 #if CONFIG_REF_MV
   int mode_cost = 0;
   int16_t mode_ctx = mode_context & NEWMV_CTX_MASK;
@@ -2203,7 +2379,7 @@ static int set_and_cost_bmi_mvs(const AV1_COMP *const cpi, MACROBLOCK *x,
   mode_ctx = av1_mode_context_analyzer(mbmi_ext->mode_context, mbmi->ref_frame,
                                        mbmi->sb_type, i);
 #endif
-  return cost_mv_ref(cpi, mode, mode_ctx) + thismvcost;
+  return av1_cost_mv_ref(cpi, mode, mode_ctx) + thismvcost;
 }
 
 static int64_t encode_inter_mb_segment(const AV1_COMP *const cpi, MACROBLOCK *x,
@@ -2356,6 +2532,13 @@ static INLINE void mi_buf_restore(MACROBLOCK *x, struct buf_2d orig_src,
   if (has_second_ref(mbmi)) x->e_mbd.plane[0].pre[1] = orig_pre[1];
 }
 
+// Moves the top and left edges of xd from the 8x8 block to its sub8x8 block
+// i, for the sub-pixel search with up-sampled predictions.
+static INLINE void set_sub8x8_block_edges(MACROBLOCKD *xd, int i) {
+  xd->mb_to_top_edge -= (i >> 1) * 4 * 8;
+  xd->mb_to_left_edge -= (i & 1) * 4 * 8;
+}
+
 static INLINE int mv_has_subpel(const MV *mv) {
   return (mv->row & 0x0F) || (mv->col & 0x0F);
 }
@@ -2378,9 +2561,9 @@ static int check_best_zero_mv(const AV1_COMP *const cpi,
 #else
     int16_t rfc = mode_context[ref_frames[0]];
 #endif
-    int c1 = cost_mv_ref(cpi, NEARMV, rfc);
-    int c2 = cost_mv_ref(cpi, NEARESTMV, rfc);
-    int c3 = cost_mv_ref(cpi, ZEROMV, rfc);
+    int c1 = av1_cost_mv_ref(cpi, NEARMV, rfc);
+    int c2 = av1_cost_mv_ref(cpi, NEARESTMV, rfc);
+    int c3 = av1_cost_mv_ref(cpi, ZEROMV, rfc);
 
 #if !CONFIG_REF_MV
     (void)bsize;
@@ -2409,6 +2592,52 @@ static int check_best_zero_mv(const AV1_COMP *const cpi,
   return 1;
 }
 
+// Sets up the key of a subpel refinement of the block. The key is cleared
+// first so that keys can be compared with memcmp().
+static void init_subpel_memo_key(SUBPEL_MEMO_KEY *key, const MACROBLOCK *x,
+                                 BLOCK_SIZE bsize, int block,
+                                 MV_REFERENCE_FRAME ref, const MV *start_mv,
+                                 const MV *ref_mv, int forced_stop,
+                                 const int *cost_list) {
+  int i;
+  memset(key, 0, sizeof(*key));
+  key->ref = ref;
+  key->second_ref = NONE;
+  key->bsize = bsize;
+  key->block = block;
+  key->start_mv = *start_mv;
+  key->ref_mv = *ref_mv;
+  key->forced_stop = forced_stop;
+  for (i = 0; i < 5; ++i) key->cost_list[i] = cost_list ? cost_list[i] : 0;
+  key->mvcost = x->mvcost;
+}
+
+// Returns the result of the subpel refinement of key if it has already been
+// run for the block, NULL otherwise.
+static const SUBPEL_MEMO *find_subpel_memo(const MACROBLOCK *x,
+                                           const SUBPEL_MEMO_KEY *key) {
+  const int n = AOMMIN(x->subpel_memo_count, SUBPEL_MEMO_SIZE);
+  int i;
+  for (i = 0; i < n; ++i)
+    if (!memcmp(&x->subpel_memo[i].key, key, sizeof(*key)))
+      return &x->subpel_memo[i];
+  return NULL;
+}
+
+// Records the result of a subpel refinement, replacing the oldest one when
+// the memo is full.
+static void store_subpel_memo(MACROBLOCK *x, const SUBPEL_MEMO_KEY *key,
+                              const MV *best_mv, int besterr, int distortion,
+                              unsigned int sse) {
+  SUBPEL_MEMO *const memo =
+      &x->subpel_memo[x->subpel_memo_count++ % SUBPEL_MEMO_SIZE];
+  memo->key = *key;
+  memo->best_mv = *best_mv;
+  memo->besterr = besterr;
+  memo->distortion = distortion;
+  memo->sse = sse;
+}
+
 static void joint_motion_search(const AV1_COMP *cpi, MACROBLOCK *x,
                                 BLOCK_SIZE bsize, int_mv *frame_mv, int mi_row,
                                 int mi_col, int_mv single_newmv[MAX_REF_FRAMES],
@@ -2539,24 +2768,25 @@ static void joint_motion_search(const AV1_COMP *cpi, MACROBLOCK *x,
     if (bestsme < INT_MAX) {
       int dis; /* TODO: use dis in distortion calculation later. */
       unsigned int sse;
-      if (cpi->sf.use_upsampled_references) {
-        // Use up-sampled reference frames.
-        struct macroblockd_plane *const pd = &xd->plane[0];
-        struct buf_2d backup_pred = pd->pre[0];
-        const YV12_BUFFER_CONFIG *upsampled_ref =
-            get_upsampled_ref(cpi, refs[id]);
-
-        // Set pred for Y plane
-        setup_pred_plane(&pd->pre[0], upsampled_ref->y_buffer,
-                         upsampled_ref->y_stride, (mi_row << 3), (mi_col << 3),
-                         NULL, pd->subsampling_x, pd->subsampling_y);
-
-        // If bsize < BLOCK_8X8, adjust pred pointer for this block
-        if (bsize < BLOCK_8X8)
-          pd->pre[0].buf =
-              &pd->pre[0].buf[(av1_raster_block_offset(BLOCK_8X8, block,
-                                                       pd->pre[0].stride))
-                              << 3];
+      SUBPEL_MEMO_KEY key;
+      const SUBPEL_MEMO *memo;
+      // The last iterations often repeat an earlier one when the mv of the
+      // other reference has not moved.
+      init_subpel_memo_key(&key, x, bsize, block, refs[id], &tmp_mv,
+                           &ref_mv[id].as_mv, 0, NULL);
+      key.second_ref = refs[!id];
+      key.second_mv = frame_mv[refs[!id]].as_mv;
+      key.second_filter = mbmi->interp_filter;
+      memo = find_subpel_memo(x, &key);
+      if (memo) {
+        tmp_mv = memo->best_mv;
+        bestsme = memo->besterr;
+      } else if (cpi->sf.use_upsampled_references) {
+        // The up-sampled predictions are clamped to the frame edges relative
+        // to the position of the sub8x8 block.
+        const int mb_to_top_edge = xd->mb_to_top_edge;
+        const int mb_to_left_edge = xd->mb_to_left_edge;
+        if (bsize < BLOCK_8X8) set_sub8x8_block_edges(xd, block);
 
         bestsme = cpi->find_fractional_mv_step(
             x, &tmp_mv, &ref_mv[id].as_mv, cpi->common.allow_high_precision_mv,
@@ -2564,16 +2794,16 @@ static void joint_motion_search(const AV1_COMP *cpi, MACROBLOCK *x,
             cpi->sf.mv.subpel_iters_per_step, NULL, x->nmvjointcost, x->mvcost,
             &dis, &sse, second_pred, pw, ph, 1);
 
-        // Restore the reference frames.
-        pd->pre[0] = backup_pred;
+        xd->mb_to_top_edge = mb_to_top_edge;
+        xd->mb_to_left_edge = mb_to_left_edge;
       } else {
-        (void)block;
         bestsme = cpi->find_fractional_mv_step(
             x, &tmp_mv, &ref_mv[id].as_mv, cpi->common.allow_high_precision_mv,
             x->errorperbit, &cpi->fn_ptr[bsize], 0,
             cpi->sf.mv.subpel_iters_per_step, NULL, x->nmvjointcost, x->mvcost,
             &dis, &sse, second_pred, pw, ph, 0);
       }
+      if (!memo) store_subpel_memo(x, &key, &tmp_mv, bestsme, dis, sse);
     }
 
     // Restore the pointer to the first (possibly scaled) prediction buffer.
@@ -2767,22 +2997,9 @@ static int64_t rd_pick_best_sub8x8_mode(
             if (cpi->sf.use_upsampled_references) {
               const int pw = 4 * num_4x4_blocks_wide_lookup[bsize];
               const int ph = 4 * num_4x4_blocks_high_lookup[bsize];
-              // Use up-sampled reference frames.
-              struct buf_2d backup_pred = pd->pre[0];
-              const YV12_BUFFER_CONFIG *upsampled_ref =
-                  get_upsampled_ref(cpi, mbmi->ref_frame[0]);
-
-              // Set pred for Y plane
-              setup_pred_plane(&pd->pre[0], upsampled_ref->y_buffer,
-                               upsampled_ref->y_stride, (mi_row << 3),
-                               (mi_col << 3), NULL, pd->subsampling_x,
-                               pd->subsampling_y);
-
-              // adjust pred pointer for this block
-              pd->pre[0].buf =
-                  &pd->pre[0].buf[(av1_raster_block_offset(BLOCK_8X8, index,
-                                                           pd->pre[0].stride))
-                                  << 3];
+              const int mb_to_top_edge = xd->mb_to_top_edge;
+              const int mb_to_left_edge = xd->mb_to_left_edge;
+              set_sub8x8_block_edges(xd, index);
 
               cpi->find_fractional_mv_step(
                   x, new_mv, &bsi->ref_mv[0]->as_mv,
@@ -2793,8 +3010,8 @@ static int64_t rd_pick_best_sub8x8_mode(
                   &distortion, &x->pred_sse[mbmi->ref_frame[0]], NULL, pw, ph,
                   1);
 
-              // Restore the reference frames.
-              pd->pre[0] = backup_pred;
+              xd->mb_to_top_edge = mb_to_top_edge;
+              xd->mb_to_left_edge = mb_to_left_edge;
             } else {
               cpi->find_fractional_mv_step(
                   x, new_mv, &bsi->ref_mv[0]->as_mv,
@@ -2988,11 +3205,11 @@ static int64_t rd_pick_best_sub8x8_mode(
   return bsi->segment_rd;
 }
 
-static void estimate_ref_frame_costs(const AV1_COMMON *cm,
-                                     const MACROBLOCKD *xd, int segment_id,
-                                     unsigned int *ref_costs_single,
-                                     unsigned int *ref_costs_comp,
-                                     aom_prob *comp_mode_p) {
+void av1_estimate_ref_frame_costs(const AV1_COMMON *cm, const MACROBLOCKD *xd,
+                                  int segment_id,
+                                  unsigned int *ref_costs_single,
+                                  unsigned int *ref_costs_comp,
+                                  aom_prob *comp_mode_p) {
   int seg_ref_active =
       segfeature_active(&cm->seg, segment_id, SEG_LVL_REF_FRAME);
   if (seg_ref_active) {
@@ -3188,9 +3405,108 @@ static void setup_buffer_inter(
                 block_size);
 }
 
+#define MAX_MOTION_FIELD_CANDS 6
+
+static int add_motion_field_cand(const MOTION_FIELD *mf, BLOCK_SIZE bsize,
+                                 int mi_row, int mi_col, int reverse, MV *cands,
+                                 int n) {
+  const MOTION_FIELD_BLOCK *const b =
+      av1_motion_field_block(mf, bsize, mi_row, mi_col);
+  MV mv;
+  int i;
+
+  if (!b || b->sad == UINT_MAX) return n;
+  mv.row = (reverse ? -b->mv.row : b->mv.row) >> 3;
+  mv.col = (reverse ? -b->mv.col : b->mv.col) >> 3;
+  for (i = 0; i < n; ++i)
+    if (cands[i].row == mv.row && cands[i].col == mv.col) return n;
+  cands[n] = mv;
+  return n + 1;
+}
+
+// Collects the full pixel start point candidates of a bsize block from the
+// motion fields: the 8x8 block itself, and the 16x16 blocks at the top-left
+// corner of each quadrant, from the field of ref. For the ALTREF_FRAME, also
+// the reversed vector of the temporal filter at the center of the block.
+static int get_motion_field_cands(const AV1_COMP *cpi, int ref,
+                                  BLOCK_SIZE bsize, int mi_row, int mi_col,
+                                  MV *cands) {
+  const MOTION_FIELD *const mf = cpi->motion_field[ref];
+  const int mi_w = num_8x8_blocks_wide_lookup[bsize];
+  const int mi_h = num_8x8_blocks_high_lookup[bsize];
+  int n = 0;
+  int r, c;
+
+  if (mf) {
+    if (bsize == BLOCK_8X8)
+      n = add_motion_field_cand(mf, BLOCK_8X8, mi_row, mi_col, 0, cands, n);
+    for (r = 0; r < mi_h; r += AOMMAX(mi_h >> 1, 2))
+      for (c = 0; c < mi_w; c += AOMMAX(mi_w >> 1, 2))
+        n = add_motion_field_cand(mf, BLOCK_16X16, mi_row + r, mi_col + c, 0,
+                                  cands, n);
+  }
+  if (ref == ALTREF_FRAME && cpi->arf_motion_field)
+    n = add_motion_field_cand(cpi->arf_motion_field, BLOCK_16X16,
+                              mi_row + (mi_h >> 1), mi_col + (mi_w >> 1), 1,
+                              cands, n);
+  assert(n <= MAX_MOTION_FIELD_CANDS);
+  return n;
+}
+
+// Returns 1 and the full pixel vector in mv if the 16x16 or 8x8 block has
+// already been searched on this frame pair, and the vector is within the
+// motion vector limits of x.
+static int get_motion_field_result(const AV1_COMP *cpi, const MACROBLOCK *x,
+                                   int ref, BLOCK_SIZE bsize, int mi_row,
+                                   int mi_col, MV *mv) {
+  const MOTION_FIELD_BLOCK *b;
+
+  if (!cpi->motion_field[ref]) return 0;
+  b = av1_motion_field_block(cpi->motion_field[ref], bsize, mi_row, mi_col);
+  if (!b || b->sad == UINT_MAX) return 0;
+  mv->row = b->mv.row >> 3;
+  mv->col = b->mv.col >> 3;
+  return mv->col >= x->mv_col_min && mv->col <= x->mv_col_max &&
+         mv->row >= x->mv_row_min && mv->row <= x->mv_row_max;
+}
+
+// Limits the full pixel search of the block to the range of the reference
+// frame or of its superblock, and starts it with a step matching that range.
+static void apply_search_range_map(const AV1_COMP *cpi, MACROBLOCK *x, int ref,
+                                   int mi_row, int mi_col, int *step_param) {
+  const AV1_COMMON *const cm = &cpi->common;
+  const int sb_cols = (cm->mi_cols + MAX_MIB_SIZE - 1) >> MAX_MIB_SIZE_LOG2;
+  const int sb_index = (mi_row >> MAX_MIB_SIZE_LOG2) * sb_cols +
+                       (mi_col >> MAX_MIB_SIZE_LOG2);
+  const int sb_range =
+      cpi->search_range_map[sb_index] * cpi->ref_frame_distance[ref];
+  const MV zero_mv = { 0, 0 };
+  int range = cpi->ref_search_range[ref];
+
+  if (sb_range && (!range || sb_range < range)) range = sb_range;
+  if (!range || x->mv_col_min > 0 || x->mv_col_max < 0 || x->mv_row_min > 0 ||
+      x->mv_row_max < 0)
+    return;
+  av1_limit_mv_search_range(x, &zero_mv, range);
+  *step_param = AOMMAX(*step_param, av1_init_search_range(range));
+}
+
+// Returns the motion vector for ref of the decision seeding the mode search
+// of the block, NULL if none.
+static const MV *rd_seed_mv(const MACROBLOCK *x, MV_REFERENCE_FRAME ref) {
+  const RD_DECISION *const seed = x->rd_seed;
+  int i;
+  if (seed == NULL) return NULL;
+  for (i = 0; i < 2; ++i) {
+    if (seed->ref_frame[i] == ref) return &seed->mv[i].as_mv;
+  }
+  return NULL;
+}
+
 static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
                                  BLOCK_SIZE bsize, int mi_row, int mi_col,
-                                 int_mv *tmp_mv, int *rate_mv) {
+                                 int_mv *tmp_mv, int *rate_mv,
+                                 MOTION_FIELD_BLOCK *field_result) {
   MACROBLOCKD *xd = &x->e_mbd;
   const AV1_COMMON *cm = &cpi->common;
   MB_MODE_INFO *mbmi = &xd->mi[0]->mbmi;
@@ -3207,9 +3523,11 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   int tmp_row_min = x->mv_row_min;
   int tmp_row_max = x->mv_row_max;
   int cost_list[5];
+  int reuse_mv = 0;
 
   const YV12_BUFFER_CONFIG *scaled_ref_frame =
       av1_get_scaled_ref_frame(cpi, ref);
+  const MV *const seed_mv = rd_seed_mv(x, ref);
 
   MV pred_mv[3];
   pred_mv[0] = x->mbmi_ext->ref_mvs[ref][0].as_mv;
@@ -3278,6 +3596,8 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   }
 
   av1_set_mv_search_range(x, &ref_mv);
+  if (cpi->use_search_range_map && !scaled_ref_frame)
+    apply_search_range_map(cpi, x, ref, mi_row, mi_col, &step_param);
 
 #if CONFIG_MOTION_VAR
   if (mbmi->motion_mode != SIMPLE_TRANSLATION)
@@ -3289,13 +3609,86 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   mvp_full.col >>= 3;
   mvp_full.row >>= 3;
 
+  if (cpi->sf.mv.pyramid_search && !scaled_ref_frame &&
+#if CONFIG_MOTION_VAR
+      mbmi->motion_mode == SIMPLE_TRANSLATION &&
+#endif  // CONFIG_MOTION_VAR
+      bsize >= BLOCK_16X16 && bsize <= BLOCK_64X64 &&
+      av1_me_pyramid_valid(&cpi->source_pyramid, cm->width, cm->height)) {
+    const ME_PYRAMID *const ref_pyramid = get_ref_me_pyramid(cpi, ref);
+    // The pyramid vector is within a couple of pixels of the best match, so
+    // the search can start with a step of 4.
+    if (ref_pyramid &&
+        av1_pyramid_search(cpi, x, bsize, mi_row, mi_col, &cpi->source_pyramid,
+                           ref_pyramid, sadpb, &ref_mv, &mvp_full))
+      step_param = AOMMAX(step_param, MAX_MVSEARCH_STEPS - 3);
+  }
+
+  if (cpi->sf.mv.use_motion_field_cache && !scaled_ref_frame &&
+#if CONFIG_MOTION_VAR
+      mbmi->motion_mode == SIMPLE_TRANSLATION &&
+#endif  // CONFIG_MOTION_VAR
+      bsize >= BLOCK_8X8 && bsize <= BLOCK_64X64) {
+    if (cpi->sf.mv.use_motion_field_cache > 1)
+      reuse_mv = get_motion_field_result(cpi, x, ref, bsize, mi_row, mi_col,
+                                         &tmp_mv->as_mv);
+    if (!reuse_mv) {
+      MV cands[MAX_MOTION_FIELD_CANDS];
+      const int num_cands =
+          get_motion_field_cands(cpi, ref, bsize, mi_row, mi_col, cands);
+      if (num_cands)
+        av1_pick_full_pixel_start(cpi, x, bsize, cands, num_cands, sadpb,
+                                  &ref_mv, &mvp_full);
+    }
+  }
+
+  if (cpi->oxcf.global_me && !scaled_ref_frame && !reuse_mv &&
+#if CONFIG_MOTION_VAR
+      mbmi->motion_mode == SIMPLE_TRANSLATION &&
+#endif  // CONFIG_MOTION_VAR
+      bsize >= BLOCK_8X8 && bsize <= BLOCK_64X64 &&
+      cpi->global_me[ref].type != GLOBAL_ME_NONE) {
+    const GLOBAL_ME_MODEL *const model = &cpi->global_me[ref];
+    MV gmv;
+    av1_global_me_block_mv(model, bsize, mi_row, mi_col, &gmv);
+    av1_pick_full_pixel_start(cpi, x, bsize, &gmv, 1, sadpb, &ref_mv,
+                              &mvp_full);
+    // A block starting next to the camera motion most likely follows it, so
+    // search around it only, with a step of 4.
+    if (model->search_range && abs(mvp_full.row - gmv.row) <= 1 &&
+        abs(mvp_full.col - gmv.col) <= 1) {
+      step_param = AOMMAX(step_param, MAX_MVSEARCH_STEPS - 3);
+      av1_limit_mv_search_range(x, &mvp_full, model->search_range);
+    }
+  }
+
+  if (!reuse_mv &&
+#if CONFIG_MOTION_VAR
+      mbmi->motion_mode == SIMPLE_TRANSLATION &&
+#endif  // CONFIG_MOTION_VAR
+      seed_mv != NULL) {
+    // The motion barely depends on q, so search around the vector of the
+    // previous encode of the frame only, with a step of 4.
+    mvp_full.row = seed_mv->row >> 3;
+    mvp_full.col = seed_mv->col >> 3;
+    step_param = AOMMAX(step_param, MAX_MVSEARCH_STEPS - 3);
+  }
+
 #if CONFIG_MOTION_VAR
   switch (mbmi->motion_mode) {
     case SIMPLE_TRANSLATION:
 #endif  // CONFIG_MOTION_VAR
-      bestsme = av1_full_pixel_search(cpi, x, bsize, &mvp_full, step_param,
-                                      sadpb, cond_cost_list(cpi, cost_list),
-                                      &ref_mv, &tmp_mv->as_mv, INT_MAX, 1);
+      if (reuse_mv) {
+        int i;
+        for (i = 0; i < 5; ++i) cost_list[i] = INT_MAX;
+        bestsme = av1_get_mvpred_var(x, &tmp_mv->as_mv, &ref_mv,
+                                     &cpi->fn_ptr[bsize], 1);
+      } else {
+        bestsme = av1_full_pixel_search(
+            cpi, x, bsize, &mvp_full, step_param, sadpb,
+            cond_cost_list(cpi, cost_list), &ref_mv, &tmp_mv->as_mv, INT_MAX,
+            1);
+      }
 #if CONFIG_MOTION_VAR
       break;
     case OBMC_CAUSAL:
@@ -3308,6 +3701,28 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   }
 #endif  // CONFIG_MOTION_VAR
 
+  if (cpi->motion_field[ref] && !scaled_ref_frame && bestsme < INT_MAX &&
+#if CONFIG_MOTION_VAR
+      mbmi->motion_mode == SIMPLE_TRANSLATION &&
+#endif  // CONFIG_MOTION_VAR
+      (bsize == BLOCK_16X16 || bsize == BLOCK_8X8)) {
+    const struct buf_2d *const pre = &xd->plane[0].pre[0];
+    const MV mv = { tmp_mv->as_mv.row * 8, tmp_mv->as_mv.col * 8 };
+    const unsigned int sad = cpi->fn_ptr[bsize].sdf(
+        x->plane[0].src.buf, x->plane[0].src.stride,
+        pre->buf + tmp_mv->as_mv.row * pre->stride + tmp_mv->as_mv.col,
+        pre->stride);
+    // Searches run ahead of the mode search hand the entry back instead of
+    // writing to the shared field.
+    if (field_result) {
+      field_result->mv = mv;
+      field_result->sad = sad;
+    } else {
+      av1_motion_field_store(cpi->motion_field[ref], bsize, mi_row, mi_col,
+                             &mv, sad);
+    }
+  }
+
   x->mv_col_min = tmp_col_min;
   x->mv_col_max = tmp_col_max;
   x->mv_row_min = tmp_row_min;
@@ -3315,50 +3730,47 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
 
   if (bestsme < INT_MAX) {
     int dis; /* TODO: use dis in distortion calculation later. */
+    SUBPEL_MEMO_KEY key;
+    const SUBPEL_MEMO *memo;
 #if CONFIG_MOTION_VAR
     switch (mbmi->motion_mode) {
       case SIMPLE_TRANSLATION:
 #endif  // CONFIG_MOTION_VAR
-        if (cpi->sf.use_upsampled_references) {
+        init_subpel_memo_key(&key, x, bsize, 0, ref, &tmp_mv->as_mv, &ref_mv,
+                             cpi->sf.mv.subpel_force_stop,
+                             cond_cost_list(cpi, cost_list));
+        memo = find_subpel_memo(x, &key);
+        if (memo) {
+          tmp_mv->as_mv = memo->best_mv;
+          x->pred_sse[ref] = memo->sse;
+        } else if (cpi->sf.use_upsampled_references) {
           const int pw = 4 * num_4x4_blocks_wide_lookup[bsize];
           const int ph = 4 * num_4x4_blocks_high_lookup[bsize];
-          // Use up-sampled reference frames.
-          struct macroblockd_plane *const pd = &xd->plane[0];
-          struct buf_2d backup_pred = pd->pre[0];
-          const YV12_BUFFER_CONFIG *upsampled_ref = get_upsampled_ref(cpi, ref);
-
-          // Set pred for Y plane
-          setup_pred_plane(&pd->pre[0], upsampled_ref->y_buffer,
-                           upsampled_ref->y_stride, (mi_row << 3),
-                           (mi_col << 3), NULL, pd->subsampling_x,
-                           pd->subsampling_y);
-
           bestsme = cpi->find_fractional_mv_step(
               x, &tmp_mv->as_mv, &ref_mv, cm->allow_high_precision_mv,
               x->errorperbit, &cpi->fn_ptr[bsize], cpi->sf.mv.subpel_force_stop,
               cpi->sf.mv.subpel_iters_per_step, cond_cost_list(cpi, cost_list),
               x->nmvjointcost, x->mvcost, &dis, &x->pred_sse[ref], NULL, pw, ph,
               1);
-
-          // Restore the reference frames.
-          pd->pre[0] = backup_pred;
         } else {
-          cpi->find_fractional_mv_step(
+          bestsme = cpi->find_fractional_mv_step(
               x, &tmp_mv->as_mv, &ref_mv, cm->allow_high_precision_mv,
               x->errorperbit, &cpi->fn_ptr[bsize], cpi->sf.mv.subpel_force_stop,
               cpi->sf.mv.subpel_iters_per_step, cond_cost_list(cpi, cost_list),
               x->nmvjointcost, x->mvcost, &dis, &x->pred_sse[ref], NULL, 0, 0,
               0);
         }
+        if (!memo)
+          store_subpel_memo(x, &key, &tmp_mv->as_mv, bestsme, dis,
+                            x->pred_sse[ref]);
 #if CONFIG_MOTION_VAR
         break;
       case OBMC_CAUSAL:
         av1_find_best_obmc_sub_pixel_tree_up(
-            cpi, x, mi_row, mi_col, &tmp_mv->as_mv, &ref_mv,
-            cm->allow_high_precision_mv, x->errorperbit, &cpi->fn_ptr[bsize],
-            cpi->sf.mv.subpel_force_stop, cpi->sf.mv.subpel_iters_per_step,
-            x->nmvjointcost, x->mvcost, &dis, &x->pred_sse[ref], 0,
-            cpi->sf.use_upsampled_references);
+            x, &tmp_mv->as_mv, &ref_mv, cm->allow_high_precision_mv,
+            x->errorperbit, &cpi->fn_ptr[bsize], cpi->sf.mv.subpel_force_stop,
+            cpi->sf.mv.subpel_iters_per_step, x->nmvjointcost, x->mvcost, &dis,
+            &x->pred_sse[ref], 0, cpi->sf.use_upsampled_references);
         break;
       default: assert("Invalid motion mode!\n");
     }
@@ -3380,6 +3792,187 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
   }
 }
 
+// Returns whether the mode search of the block skips the prediction from
+// ref_frame and second_ref_frame given the decision it is seeded with: all
+// but the references of the decision if it was made in the same context, the
+// references that were far from the best one otherwise.
+static int skip_seeded_refs(const MACROBLOCK *x, MV_REFERENCE_FRAME ref_frame,
+                            MV_REFERENCE_FRAME second_ref_frame) {
+  const RD_DECISION *const seed = x->rd_seed;
+  if (seed == NULL) return 0;
+  if (x->rd_seed_exact)
+    return ref_frame != seed->ref_frame[0] ||
+           second_ref_frame != seed->ref_frame[1];
+  return !(seed->ref_mask & (1 << ref_frame)) ||
+         (second_ref_frame > INTRA_FRAME &&
+          !(seed->ref_mask & (1 << second_ref_frame)));
+}
+
+// The state of a block shared by the reference frame searches run ahead of
+// its mode search.
+typedef struct {
+  const MACROBLOCK *x;
+  BLOCK_SIZE bsize;
+  int mi_row;
+  int mi_col;
+  struct buf_2d (*yv12_mb)[MAX_MB_PLANE];
+  REF_SEARCH_JOB *jobs[MAX_REF_SEARCH_WORKERS];
+  int num_jobs;
+  int num_workers;
+} REF_SEARCH_BLOCK;
+
+static void run_ref_search_job(RefSearchWorkerData *const data,
+                               const REF_SEARCH_BLOCK *const blk,
+                               REF_SEARCH_JOB *const job) {
+  const AV1_COMP *const cpi = data->cpi;
+  const MACROBLOCK *const src = blk->x;
+  MACROBLOCK *const x = &data->x;
+  MACROBLOCKD *const xd = &x->e_mbd;
+  MB_MODE_INFO *const mbmi = &data->mi.mbmi;
+  const int m_search_count = *src->m_search_count_ptr;
+  const int ex_search_count = *src->ex_search_count_ptr;
+  int i;
+
+  // The frame level state of x was copied by av1_setup_ref_search_workers(),
+  // only the block level state used by single_motion_search() is copied.
+  x->plane[0].src = src->plane[0].src;
+  x->e_mbd = src->e_mbd;
+  x->errorperbit = src->errorperbit;
+  x->sadperbit16 = src->sadperbit16;
+  x->sadperbit4 = src->sadperbit4;
+  x->rddiv = src->rddiv;
+  x->rdmult = src->rdmult;
+  x->source_variance = src->source_variance;
+  x->mv_col_min = src->mv_col_min;
+  x->mv_col_max = src->mv_col_max;
+  x->mv_row_min = src->mv_row_min;
+  x->mv_row_max = src->mv_row_max;
+  memcpy(x->mv_best_ref_index, src->mv_best_ref_index,
+         sizeof(x->mv_best_ref_index));
+  memcpy(x->max_mv_context, src->max_mv_context, sizeof(x->max_mv_context));
+  memcpy(x->pred_mv_sad, src->pred_mv_sad, sizeof(x->pred_mv_sad));
+  memcpy(x->pred_mv, src->pred_mv, sizeof(x->pred_mv));
+  memcpy(x->pred_sse, src->pred_sse, sizeof(x->pred_sse));
+  x->rd_seed = src->rd_seed;
+  x->rd_seed_exact = src->rd_seed_exact;
+  data->m_search_count = m_search_count;
+  data->ex_search_count = ex_search_count;
+  x->subpel_memo_count = 0;
+
+  data->mi = *src->e_mbd.mi[0];
+  data->mi_ptr = &data->mi;
+  xd->mi = &data->mi_ptr;
+  mbmi->mode = NEWMV;
+  mbmi->ref_frame[0] = job->ref;
+  mbmi->ref_frame[1] = NONE;
+#if CONFIG_MOTION_VAR
+  mbmi->motion_mode = SIMPLE_TRANSLATION;
+#endif  // CONFIG_MOTION_VAR
+  data->mbmi_ext = *src->mbmi_ext;
+  x->mbmi_ext = &data->mbmi_ext;
+#if CONFIG_REF_MV
+  {
+    // Same reference mv as the first NEWMV search of the mode loop.
+    const uint8_t ref_frame_type = av1_ref_frame_type(mbmi->ref_frame);
+    mbmi->ref_mv_idx = 0;
+    if (data->mbmi_ext.ref_mv_count[ref_frame_type] > 1) {
+      int_mv this_mv = data->mbmi_ext.ref_mv_stack[ref_frame_type][0].this_mv;
+      clamp_mv_ref(&this_mv.as_mv, xd->n8_w << 3, xd->n8_h << 3, xd);
+      lower_mv_precision(&this_mv.as_mv,
+                         cpi->common.allow_high_precision_mv);
+      data->mbmi_ext.ref_mvs[job->ref][0] = this_mv;
+    }
+  }
+#endif  // CONFIG_REF_MV
+  for (i = 0; i < MAX_MB_PLANE; ++i)
+    xd->plane[i].pre[0] = blk->yv12_mb[job->ref][i];
+
+  job->field_result.sad = UINT_MAX;
+  single_motion_search(cpi, x, blk->bsize, blk->mi_row, blk->mi_col, &job->mv,
+                       &job->rate_mv, &job->field_result);
+  job->pred_mv = x->pred_mv[job->ref];
+  job->pred_sse = x->pred_sse[job->ref];
+  job->m_search_count = data->m_search_count - m_search_count;
+  job->ex_search_count = data->ex_search_count - ex_search_count;
+  job->valid = 1;
+}
+
+static int ref_search_worker_hook(RefSearchWorkerData *const data,
+                                  const REF_SEARCH_BLOCK *const blk) {
+  int j;
+  for (j = data->start; j < blk->num_jobs; j += blk->num_workers)
+    run_ref_search_job(data, blk, blk->jobs[j]);
+  return 1;
+}
+
+// Runs the NEWMV searches of the single reference frames that the mode search
+// of the block will try, one reference per thread. The results do not depend
+// on the number of threads: each search starts from the state of x before
+// the mode search, and its updates of x and of the motion field are applied
+// by use_ref_search_result() when the mode search reaches it.
+static void search_refs_mt(const AV1_COMP *const cpi, const MACROBLOCK *x,
+                           BLOCK_SIZE bsize, int mi_row, int mi_col,
+                           struct buf_2d yv12_mb[][MAX_MB_PLANE],
+                           const uint8_t ref_frame_skip_mask[2],
+                           const uint16_t mode_skip_mask[MAX_REF_FRAMES],
+                           REF_SEARCH_JOB ref_search[MAX_REF_FRAMES]) {
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  REF_SEARCH_BLOCK blk;
+  MV_REFERENCE_FRAME ref;
+  int i;
+
+  blk.num_jobs = 0;
+  for (ref = LAST_FRAME; ref <= ALTREF_FRAME; ++ref) {
+    // The skip mask also covers the references missing from the frame.
+    if (!(ref_frame_skip_mask[0] & (1 << ref)) &&
+        !(mode_skip_mask[ref] & (1 << NEWMV)) &&
+        !skip_seeded_refs(x, ref, NONE)) {
+      ref_search[ref].ref = ref;
+      blk.jobs[blk.num_jobs++] = &ref_search[ref];
+    }
+  }
+  if (blk.num_jobs < 2) return;
+
+  blk.x = x;
+  blk.bsize = bsize;
+  blk.mi_row = mi_row;
+  blk.mi_col = mi_col;
+  blk.yv12_mb = yv12_mb;
+  blk.num_workers = AOMMIN(cpi->num_ref_search_workers, blk.num_jobs);
+
+  for (i = 0; i < blk.num_workers; ++i) {
+    AVxWorker *const worker = &cpi->ref_search_workers[i];
+    ((RefSearchWorkerData *)worker->data1)->start = i;
+    worker->hook = (AVxWorkerHook)ref_search_worker_hook;
+    worker->data2 = &blk;
+    // The main thread runs the last worker.
+    if (i == blk.num_workers - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+  for (i = 0; i < blk.num_workers; ++i)
+    winterface->sync(&cpi->ref_search_workers[i]);
+}
+
+// Takes the result of a search run by search_refs_mt() in place of calling
+// single_motion_search().
+static void use_ref_search_result(const AV1_COMP *const cpi, MACROBLOCK *x,
+                                  BLOCK_SIZE bsize, int mi_row, int mi_col,
+                                  REF_SEARCH_JOB *const job, int_mv *tmp_mv,
+                                  int *rate_mv) {
+  x->pred_mv[job->ref] = job->pred_mv;
+  x->pred_sse[job->ref] = job->pred_sse;
+  *x->m_search_count_ptr += job->m_search_count;
+  *x->ex_search_count_ptr += job->ex_search_count;
+  if (job->field_result.sad != UINT_MAX)
+    av1_motion_field_store(cpi->motion_field[job->ref], bsize, mi_row, mi_col,
+                           &job->field_result.mv, job->field_result.sad);
+  *tmp_mv = job->mv;
+  *rate_mv = job->rate_mv;
+  job->valid = 0;
+}
+
 static INLINE void restore_dst_buf(MACROBLOCKD *xd,
                                    uint8_t *orig_dst[MAX_MB_PLANE],
                                    int orig_dst_stride[MAX_MB_PLANE]) {
@@ -3429,10 +4022,10 @@ static int64_t handle_inter_mode(
     uint8_t *above_pred_buf[3], int above_pred_stride[3],
     uint8_t *left_pred_buf[3], int left_pred_stride[3],
 #endif  // CONFIG_MOTION_VAR
-    int_mv single_newmv[MAX_REF_FRAMES],
+    int_mv single_newmv[MAX_REF_FRAMES], REF_SEARCH_JOB *ref_search,
     InterpFilter (*single_filter)[MAX_REF_FRAMES],
     int (*single_skippable)[MAX_REF_FRAMES], int64_t *psse,
-    const int64_t ref_best_rd) {
+    int64_t *best_model_rd, const int64_t ref_best_rd) {
   const AV1_COMMON *cm = &cpi->common;
   MACROBLOCKD *xd = &x->e_mbd;
   MB_MODE_INFO *mbmi = &xd->mi[0]->mbmi;
@@ -3516,7 +4109,12 @@ static int64_t handle_inter_mode(
       }
     } else {
       int_mv tmp_mv;
-      single_motion_search(cpi, x, bsize, mi_row, mi_col, &tmp_mv, &rate_mv);
+      if (ref_search && ref_search[refs[0]].valid)
+        use_ref_search_result(cpi, x, bsize, mi_row, mi_col,
+                              &ref_search[refs[0]], &tmp_mv, &rate_mv);
+      else
+        single_motion_search(cpi, x, bsize, mi_row, mi_col, &tmp_mv, &rate_mv,
+                             NULL);
       if (tmp_mv.as_int == INVALID_MV) return INT64_MAX;
 
       frame_mv[refs[0]].as_int = xd->mi[0]->bmi[0].as_mv[0].as_int =
@@ -3605,10 +4203,10 @@ static int64_t handle_inter_mode(
   // Under some circumstances we discount the cost of new mv mode to encourage
   // initiation of a motion field.
   if (discount_newmv_test(cpi, this_mode, frame_mv[refs[0]], mode_mv, refs[0]))
-    *rate2 += AOMMIN(cost_mv_ref(cpi, this_mode, mode_ctx),
-                     cost_mv_ref(cpi, NEARESTMV, mode_ctx));
+    *rate2 += AOMMIN(av1_cost_mv_ref(cpi, this_mode, mode_ctx),
+                     av1_cost_mv_ref(cpi, NEARESTMV, mode_ctx));
   else
-    *rate2 += cost_mv_ref(cpi, this_mode, mode_ctx);
+    *rate2 += av1_cost_mv_ref(cpi, this_mode, mode_ctx);
 
   if (RDCOST(x->rdmult, x->rddiv, *rate2, 0) > ref_best_rd &&
       mbmi->mode != NEARESTMV)
@@ -3733,6 +4331,18 @@ static int64_t handle_inter_mode(
     }
   }
 
+  if (cpi->sf.model_rd_mode_gate) {
+    // Only run the transform domain RD of the modes whose modeled cost is
+    // close enough to the best modeled cost of the block so far.
+    const int64_t model_rd = rd + RDCOST(x->rdmult, x->rddiv, *rate2, 0);
+    if (*best_model_rd < INT64_MAX &&
+        model_rd > (*best_model_rd >> 4) * cpi->sf.model_rd_mode_gate) {
+      restore_dst_buf(xd, orig_dst, orig_dst_stride);
+      return INT64_MAX;
+    }
+    *best_model_rd = AOMMIN(*best_model_rd, model_rd);
+  }
+
   *rate2 += av1_get_switchable_rate(cpi, xd);
 #if CONFIG_MOTION_VAR
   rate2_nocoeff = *rate2;
@@ -3755,7 +4365,7 @@ static int64_t handle_inter_mode(
         int tmp_rate_mv = 0;
 
         single_motion_search(cpi, x, bsize, mi_row, mi_col, &tmp_mv,
-                             &tmp_rate_mv);
+                             &tmp_rate_mv, NULL);
         mbmi->mv[0].as_int = tmp_mv.as_int;
         if (discount_newmv_test(cpi, this_mode, tmp_mv, mode_mv, refs[0])) {
           tmp_rate_mv = AOMMAX((tmp_rate_mv / NEW_MV_DISCOUNT_FACTOR), 1);
@@ -4160,6 +4770,7 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
   int comp_pred, i, k;
   int_mv frame_mv[MB_MODE_COUNT][MAX_REF_FRAMES];
   struct buf_2d yv12_mb[MAX_REF_FRAMES][MAX_MB_PLANE];
+  REF_SEARCH_JOB ref_search[MAX_REF_FRAMES];
   int_mv single_newmv[MAX_REF_FRAMES] = { { 0 } };
   InterpFilter single_inter_filter[MB_MODE_COUNT][MAX_REF_FRAMES];
   int single_skippable[MB_MODE_COUNT][MAX_REF_FRAMES];
@@ -4177,6 +4788,7 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
     AOM_ALT_FLAG
   };
   int64_t best_rd = best_rd_so_far;
+  int64_t best_model_rd = INT64_MAX;
   int64_t best_pred_diff[REFERENCE_MODES];
   int64_t best_pred_rd[REFERENCE_MODES];
   MB_MODE_INFO best_mbmode;
@@ -4189,6 +4801,7 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
   unsigned int ref_costs_single[MAX_REF_FRAMES], ref_costs_comp[MAX_REF_FRAMES];
   aom_prob comp_mode_p;
   int64_t best_intra_rd = INT64_MAX;
+  int64_t ref_best_rd[MAX_REF_FRAMES];
   unsigned int best_pred_sse = UINT_MAX;
   PREDICTION_MODE best_intra_mode = DC_PRED;
   int rate_uv_intra[TX_SIZES], rate_uv_tokenonly[TX_SIZES];
@@ -4276,12 +4889,16 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
   }
 #endif  // CONFIG_PALETTE
 
-  estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single, ref_costs_comp,
-                           &comp_mode_p);
+  av1_estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single,
+                               ref_costs_comp, &comp_mode_p);
 
   for (i = 0; i < REFERENCE_MODES; ++i) best_pred_rd[i] = INT64_MAX;
   for (i = 0; i < TX_SIZES; i++) rate_uv_intra[i] = INT_MAX;
-  for (i = 0; i < MAX_REF_FRAMES; ++i) x->pred_sse[i] = INT_MAX;
+  for (i = 0; i < MAX_REF_FRAMES; ++i) {
+    x->pred_sse[i] = INT_MAX;
+    ref_best_rd[i] = INT64_MAX;
+  }
+  x->subpel_memo_count = 0;
   for (i = 0; i < MB_MODE_COUNT; ++i) {
     for (k = 0; k < MAX_REF_FRAMES; ++k) {
       single_inter_filter[i][k] = SWITCHABLE;
@@ -4440,6 +5057,13 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
     midx = end_pos;
   }
 
+  for (ref_frame = INTRA_FRAME; ref_frame < MAX_REF_FRAMES; ++ref_frame)
+    ref_search[ref_frame].valid = 0;
+  // The searches of smaller blocks are too short to be worth a thread.
+  if (cpi->use_ref_search_mt && bsize >= BLOCK_16X16)
+    search_refs_mt(cpi, x, bsize, mi_row, mi_col, yv12_mb, ref_frame_skip_mask,
+                   mode_skip_mask, ref_search);
+
   for (midx = 0; midx < MAX_MODES; ++midx) {
     int mode_index = mode_map[midx];
     int mode_excluded = 0;
@@ -4506,6 +5130,8 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
 
     if (mode_skip_mask[ref_frame] & (1 << this_mode)) continue;
 
+    if (skip_seeded_refs(x, ref_frame, second_ref_frame)) continue;
+
     // Test best rd so far against threshold for trying this mode.
     if (best_mode_skippable && sf->schedule_mode_search)
       mode_threshold[mode_index] <<= 1;
@@ -4708,8 +5334,9 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
 #if CONFIG_MOTION_VAR
                                   dst_buf1, dst_stride1, dst_buf2, dst_stride2,
 #endif  // CONFIG_MOTION_VAR
-                                  single_newmv, single_inter_filter,
-                                  single_skippable, &total_sse, best_rd);
+                                  single_newmv, ref_search, single_inter_filter,
+                                  single_skippable, &total_sse, &best_model_rd,
+                                  best_rd);
 
 #if CONFIG_REF_MV
       if ((mbmi->mode == NEARMV &&
@@ -4785,8 +5412,8 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
 #if CONFIG_MOTION_VAR
                 dst_buf1, dst_stride1, dst_buf2, dst_stride2,
 #endif  // CONFIG_MOTION_VAR
-                dummy_single_newmv, single_inter_filter, dummy_single_skippable,
-                &tmp_sse, best_rd);
+                dummy_single_newmv, NULL, single_inter_filter,
+                dummy_single_skippable, &tmp_sse, &best_model_rd, best_rd);
           }
 
           for (i = 0; i < mbmi->ref_mv_idx; ++i) {
@@ -4912,6 +5539,11 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
     rd_variance_adjustment(cpi, x, bsize, &this_rd, ref_frame,
                            x->source_variance);
 
+    ref_best_rd[ref_frame] = AOMMIN(ref_best_rd[ref_frame], this_rd);
+    if (comp_pred)
+      ref_best_rd[second_ref_frame] =
+          AOMMIN(ref_best_rd[second_ref_frame], this_rd);
+
     if (ref_frame == INTRA_FRAME) {
       // Keep record of best intra rd
       if (this_rd < best_intra_rd) {
@@ -5163,6 +5795,16 @@ PALETTE_EXIT:
     return;
   }
 
+  // The references whose best mode came within 1/4 of the best RD cost, the
+  // only ones a search of the block at a nearby q is likely to pick.
+  x->rd_ref_mask = 1 << best_mbmode.ref_frame[0];
+  if (has_second_ref(&best_mbmode))
+    x->rd_ref_mask |= 1 << best_mbmode.ref_frame[1];
+  for (ref_frame = INTRA_FRAME; ref_frame < MAX_REF_FRAMES; ++ref_frame) {
+    if (ref_best_rd[ref_frame] - best_rd <= best_rd / 4)
+      x->rd_ref_mask |= 1 << ref_frame;
+  }
+
   assert((cm->interp_filter == SWITCHABLE) ||
          (cm->interp_filter == best_mbmode.interp_filter) ||
          !is_inter_block(&best_mbmode));
@@ -5223,8 +5865,8 @@ void av1_rd_pick_inter_mode_sb_seg_skip(const AV1_COMP *cpi,
   int rate2 = 0;
   const int64_t distortion2 = 0;
 
-  estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single, ref_costs_comp,
-                           &comp_mode_p);
+  av1_estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single,
+                               ref_costs_comp, &comp_mode_p);
 #if CONFIG_PALETTE
   mbmi->palette_mode_info.palette_size[0] = 0;
   mbmi->palette_mode_info.palette_size[1] = 0;
@@ -5369,13 +6011,14 @@ void av1_rd_pick_inter_mode_sub8x8(const AV1_COMP *cpi, TileDataEnc *tile_data,
     for (j = 0; j < MAX_REF_FRAMES; j++) seg_mvs[i][j].as_int = INVALID_MV;
   }
 
-  estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single, ref_costs_comp,
-                           &comp_mode_p);
+  av1_estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single,
+                               ref_costs_comp, &comp_mode_p);
 
   for (i = 0; i < REFERENCE_MODES; ++i) best_pred_rd[i] = INT64_MAX;
   for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; i++)
     best_filter_rd[i] = INT64_MAX;
   rate_uv_intra = INT_MAX;
+  x->subpel_memo_count = 0;
 
   rd_cost->rate = INT_MAX;
 
@@ -50,6 +50,15 @@ void av1_rd_pick_inter_mode_sb_seg_skip(
     struct macroblock *x, struct RD_COST *rd_cost, BLOCK_SIZE bsize,
     PICK_MODE_CONTEXT *ctx, int64_t best_rd_so_far);
 
+int av1_cost_mv_ref(const struct AV1_COMP *const cpi, PREDICTION_MODE mode,
+                    int16_t mode_context);
+
+void av1_estimate_ref_frame_costs(const struct AV1Common *cm,
+                                  const MACROBLOCKD *xd, int segment_id,
+                                  unsigned int *ref_costs_single,
+                                  unsigned int *ref_costs_comp,
+                                  aom_prob *comp_mode_p);
+
 int av1_internal_image_edge(const struct AV1_COMP *cpi);
 int av1_active_h_edge(const struct AV1_COMP *cpi, int mi_row, int mi_step);
 int av1_active_v_edge(const struct AV1_COMP *cpi, int mi_col, int mi_step);
@@ -134,6 +134,7 @@ static void set_good_speed_feature(AV1_COMP *cpi, AV1_COMMON *cm,
   const int boosted = frame_is_boosted(cpi);
 
   sf->adaptive_rd_thresh = 1;
+  sf->use_rd_decision_cache = 1;
 
   if (speed >= 1) {
     if ((cpi->twopass.fr_content_type == FC_GRAPHICS_ANIMATION) ||
@@ -161,6 +162,12 @@ static void set_good_speed_feature(AV1_COMP *cpi, AV1_COMMON *cm,
 
     sf->tx_size_search_breakout = 1;
     sf->partition_search_breakout_rate_thr = 80;
+    sf->partition_model_prune = 1;
+    sf->mv.use_motion_field_cache = 2;
+    sf->mv.adaptive_search_range = 1;
+    sf->tx_type_candidates = 3;
+    sf->model_rd_mode_gate = 16;
+    sf->fast_trellis = 1;
   }
 
   if (speed >= 2) {
@@ -177,6 +184,9 @@ static void set_good_speed_feature(AV1_COMP *cpi, AV1_COMMON *cm,
     sf->auto_min_max_partition_size = RELAXED_NEIGHBORING_MIN_MAX;
     sf->allow_partition_search_skip = 1;
     sf->use_upsampled_references = 0;
+    sf->partition_model_prune = 2;
+    sf->mv.pyramid_search = 1;
+    sf->tx_type_candidates = 2;
   }
 
   if (speed >= 3) {
@@ -195,6 +205,7 @@ static void set_good_speed_feature(AV1_COMP *cpi, AV1_COMMON *cm,
     sf->intra_y_mode_mask[TX_32X32] = INTRA_DC;
     sf->intra_uv_mode_mask[TX_32X32] = INTRA_DC;
     sf->adaptive_interp_filter_search = 1;
+    sf->auto_min_max_partition_size = VAR_BASED_MIN_MAX;
   }
 
   if (speed >= 4) {
@@ -401,6 +412,19 @@ static void set_rt_speed_feature(AV1_COMP *cpi, SPEED_FEATURES *sf, int speed,
     sf->mv.subpel_force_stop = 2;
     sf->lpf_pick = LPF_PICK_MINIMAL_LPF;
   }
+
+  if (speed >= 9) {
+    // Pick the modes of inter frames from variance based estimates instead
+    // of the RD search.
+    sf->use_nonrd_pick_mode = 1;
+    sf->mv.search_method = FAST_DIAMOND;
+    sf->mv.fullpel_search_step_param = 10;
+    sf->inter_mode_mask[BLOCK_32X32] = INTER_NEAREST_NEW_ZERO;
+    sf->inter_mode_mask[BLOCK_32X64] = INTER_NEAREST_NEW_ZERO;
+    sf->inter_mode_mask[BLOCK_64X32] = INTER_NEAREST_NEW_ZERO;
+    sf->inter_mode_mask[BLOCK_64X64] = INTER_NEAREST_NEW_ZERO;
+    if (!is_keyframe) sf->max_intra_bsize = BLOCK_32X32;
+  }
 }
 
 void av1_set_speed_features_framesize_dependent(AV1_COMP *cpi) {
@@ -442,13 +466,18 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->mv.subpel_iters_per_step = 2;
   sf->mv.subpel_force_stop = 0;
   sf->optimize_coefficients = !is_lossless_requested(&cpi->oxcf);
+  sf->fast_trellis = 0;
   sf->mv.reduce_first_step_size = 0;
   sf->coeff_prob_appx_step = 1;
   sf->mv.auto_mv_step_size = 0;
   sf->mv.fullpel_search_step_param = 6;
+  sf->mv.pyramid_search = 0;
+  sf->mv.use_motion_field_cache = 0;
+  sf->mv.adaptive_search_range = 0;
   sf->comp_inter_joint_search_thresh = BLOCK_4X4;
   sf->adaptive_rd_thresh = 0;
   sf->tx_size_search_method = USE_FULL_RD;
+  sf->tx_type_candidates = TX_TYPES;
   sf->use_lp32x32fdct = 0;
   sf->adaptive_motion_search = 0;
   sf->adaptive_pred_interp_filter = 0;
@@ -484,8 +513,12 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->use_fast_coef_updates = TWO_LOOP;
   sf->use_fast_coef_costing = 0;
   sf->mode_skip_start = MAX_MODES;  // Mode index at which mode skip mask set
+  sf->use_rd_decision_cache = 0;
   sf->schedule_mode_search = 0;
-  for (i = 0; i < BLOCK_SIZES; ++i) sf->inter_mode_mask[i] = INTER_ALL;
+  for (i = 0; i < BLOCK_SIZES; ++i) {
+    sf->inter_mode_mask[i] = INTER_ALL;
+    sf->intra_y_mode_bsize_mask[i] = INTRA_ALL;
+  }
   sf->max_intra_bsize = BLOCK_64X64;
   sf->reuse_inter_pred_sby = 0;
   // This setting only takes effect when partition_search_type is set
@@ -498,7 +531,10 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->tx_size_search_breakout = 0;
   sf->partition_search_breakout_dist_thr = 0;
   sf->partition_search_breakout_rate_thr = 0;
+  sf->partition_model_prune = 0;
   sf->simple_model_rd_from_var = 0;
+  sf->model_rd_mode_gate = 0;
+  sf->use_nonrd_pick_mode = 0;
 
   if (oxcf->mode == REALTIME)
     set_rt_speed_feature(cpi, sf, oxcf->speed, oxcf->content);
@@ -546,6 +582,9 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
     sf->optimize_coefficients = 0;
   }
 
+  // The decisions are only kept for the recode loop.
+  if (sf->recode_loop == DISALLOW_RECODE) sf->use_rd_decision_cache = 0;
+
   if (sf->mv.subpel_search_method == SUBPEL_TREE) {
     cpi->find_fractional_mv_step = av1_find_best_sub_pixel_tree;
   } else if (sf->mv.subpel_search_method == SUBPEL_TREE_PRUNED) {
@@ -562,6 +601,7 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   // FIXME: trellis not very efficient for quantisation matrices
   x->optimize = 0;
 #endif
+  x->fast_trellis = sf->fast_trellis;
 
   x->min_partition_size = sf->default_min_partition_size;
   x->max_partition_size = sf->default_max_partition_size;
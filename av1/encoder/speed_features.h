@@ -94,7 +94,9 @@ typedef enum {
 typedef enum {
   NOT_IN_USE = 0,
   RELAXED_NEIGHBORING_MIN_MAX = 1,
-  STRICT_NEIGHBORING_MIN_MAX = 2
+  STRICT_NEIGHBORING_MIN_MAX = 2,
+  // Derive the range from the variance based partitioning of the SB64.
+  VAR_BASED_MIN_MAX = 3
 } AUTO_MIN_MAX_MODE;
 
 typedef enum {
@@ -186,6 +188,21 @@ typedef struct MV_SPEED_FEATURES {
 
   // This variable sets the step_param used in full pel motion search.
   int fullpel_search_step_param;
+
+  // Seed the full pixel search of 16x16 to 64x64 blocks with a coarse-to-fine
+  // search on 1/4 and 1/2 resolution pyramids of the source and reference
+  // frames, and start it with a smaller step when that finds a better vector.
+  int pyramid_search;
+
+  // Record the 16x16 and 8x8 motion vectors found by the motion searches of
+  // every frame pair. 1: seed later searches on the same pair, or on the
+  // reverse pair for the temporal filter, with them. 2: also skip the full
+  // pixel search of a 16x16 or 8x8 block that has already been searched.
+  int use_motion_field_cache;
+
+  // Limit the full pixel search of each superblock in the second pass to the
+  // motion found around it by the first pass.
+  int adaptive_search_range;
 } MV_SPEED_FEATURES;
 
 #define MAX_MESH_STEP 4
@@ -206,6 +223,11 @@ typedef struct SPEED_FEATURES {
   // Trellis (dynamic programming) optimization of quantized values (+1, 0).
   int optimize_coefficients;
 
+  // Use the faster trellis, which skips the blocks and coefficients with
+  // nothing to round down and does not evaluate the rounding down of large
+  // coefficients that cannot pay off.
+  int fast_trellis;
+
   // Always set to 0. If on it enables 0 cost background transmission
   // (except for the initial transmission of the segmentation). The feature is
   // disabled because the addition of very large block sizes make the
@@ -235,6 +257,11 @@ typedef struct SPEED_FEATURES {
   // for intra and model coefs for the rest.
   TX_SIZE_SEARCH_METHOD tx_size_search_method;
 
+  // Number of luma transform types, DCT_DCT included, that the transform
+  // search runs the full RD on, picked by a cheap ranking of the types.
+  // TX_TYPES searches them all.
+  int tx_type_candidates;
+
   // Low precision 32x32 fdct keeps everything in 16 bits and thus is less
   // precise but significantly faster than the non lp version.
   int use_lp32x32fdct;
@@ -244,6 +271,12 @@ typedef struct SPEED_FEATURES {
   // of the best so far.
   int mode_skip_start;
 
+  // Seed the mode search of the inter blocks of 8x8 and above with the
+  // decisions of the previous encode of the frame in the recode loop: skip
+  // the reference frames that were far from the best one then, and search
+  // for motion around the vectors chosen then.
+  int use_rd_decision_cache;
+
   PARTITION_SEARCH_TYPE partition_search_type;
 
   // Used if partition_search_type = FIXED_SIZE_PARTITION
@@ -257,7 +290,8 @@ typedef struct SPEED_FEATURES {
   int use_square_partition_only;
 
   // Sets min and max partition sizes for this 64x64 region based on the
-  // same 64x64 in last encoded frame, and the left and above neighbor.
+  // same 64x64 in last encoded frame, and the left and above neighbor, or
+  // on a variance based pre-pass over the region.
   AUTO_MIN_MAX_MODE auto_min_max_partition_size;
   // Ensures the rd based auto partition search will always
   // go down at least to the specified level.
@@ -399,14 +433,28 @@ typedef struct SPEED_FEATURES {
   int64_t partition_search_breakout_dist_thr;
   int partition_search_breakout_rate_thr;
 
+  // Skip the square and rectangular split searches of 16x16 to 64x64 blocks
+  // that the partition models predict will not win. 0: off, 1: conservative,
+  // 2: aggressive.
+  int partition_model_prune;
+
   // Allow skipping partition search for still image frame
   int allow_partition_search_skip;
 
   // Fast approximation of av1_model_rd_from_var_lapndz
   int simple_model_rd_from_var;
 
+  // Skips the transform domain RD of an inter mode whose modeled RD cost is
+  // above the best modeled cost of the block so far times this value in
+  // 1/16ths. 0 disables the gate.
+  int model_rd_mode_gate;
+
   // Do sub-pixel search in up-sampled reference frames
   int use_upsampled_references;
+
+  // Use the non-RD mode decision (av1_pick_inter_mode) for blocks of 8x8 and
+  // above in inter frames.
+  int use_nonrd_pick_mode;
 } SPEED_FEATURES;
 
 struct AV1_COMP;
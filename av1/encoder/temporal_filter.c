@@ -267,6 +267,7 @@ static int temporal_filter_find_matching_mb_c(AV1_COMP *cpi,
 
 static void temporal_filter_iterate_c(AV1_COMP *cpi,
                                       YV12_BUFFER_CONFIG **frames,
+                                      MOTION_FIELD **motion_fields,
                                       int frame_count, int alt_ref_index,
                                       int strength,
                                       struct scale_factors *scale) {
@@ -350,6 +351,18 @@ static void temporal_filter_iterate_c(AV1_COMP *cpi,
               cpi, frames[alt_ref_index]->y_buffer + mb_y_offset,
               frames[frame]->y_buffer + mb_y_offset, frames[frame]->y_stride);
 
+          if (motion_fields[frame]) {
+            const MV *const mv = &mbd->mi[0]->bmi[0].as_mv[0].as_mv;
+            const int y_stride = frames[frame]->y_stride;
+            const unsigned int sad = cpi->fn_ptr[BLOCK_16X16].sdf(
+                frames[alt_ref_index]->y_buffer + mb_y_offset, y_stride,
+                frames[frame]->y_buffer + mb_y_offset +
+                    (mv->row >> 3) * y_stride + (mv->col >> 3),
+                y_stride);
+            av1_motion_field_store(motion_fields[frame], BLOCK_16X16,
+                                   mb_row * 2, mb_col * 2, mv, sad);
+          }
+
           // Assign higher weight to matching MB if it's error
           // score is lower. If not applying MC default behavior
           // is to weight all MBs equal.
@@ -613,6 +626,8 @@ void av1_temporal_filter(AV1_COMP *cpi, int distance) {
   int frames_to_blur_forward;
   struct scale_factors sf;
   YV12_BUFFER_CONFIG *frames[MAX_LAG_BUFFERS] = { NULL };
+  int64_t time_stamps[MAX_LAG_BUFFERS];
+  MOTION_FIELD *motion_fields[MAX_LAG_BUFFERS] = { NULL };
 
   // Apply context specific adjustments to the arnr filter parameters.
   adjust_arnr_filter(cpi, distance, rc->gfu_boost, &frames_to_blur, &strength);
@@ -626,6 +641,19 @@ void av1_temporal_filter(AV1_COMP *cpi, int distance) {
     struct lookahead_entry *buf =
         av1_lookahead_peek(cpi->lookahead, which_buffer);
     frames[frames_to_blur - 1 - frame] = &buf->img;
+    time_stamps[frames_to_blur - 1 - frame] = buf->ts_start;
+  }
+
+  // Record the motion of the filtered frame relative to the others, to seed
+  // the ALTREF_FRAME searches of the frames that are coded later.
+  if (cpi->sf.mv.use_motion_field_cache) {
+    for (frame = 0; frame < frames_to_blur; ++frame) {
+      if (frame == frames_to_blur_backward) continue;
+      motion_fields[frame] = av1_motion_field_get(
+          &cpi->motion_field_cache, time_stamps[frames_to_blur_backward],
+          av1_motion_field_source_ref_id(time_stamps[frame]),
+          frames[frame]->y_crop_width, frames[frame]->y_crop_height);
+    }
   }
 
   if (frames_to_blur > 0) {
@@ -644,6 +672,6 @@ void av1_temporal_filter(AV1_COMP *cpi, int distance) {
 #endif  // CONFIG_AOM_HIGHBITDEPTH
   }
 
-  temporal_filter_iterate_c(cpi, frames, frames_to_blur,
+  temporal_filter_iterate_c(cpi, frames, motion_fields, frames_to_blur,
                             frames_to_blur_backward, strength, &sf);
 }
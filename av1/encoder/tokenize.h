@@ -69,6 +69,7 @@ extern const int16_t *av1_dct_value_cost_ptr;
  */
 extern const TOKENVALUE *av1_dct_value_tokens_ptr;
 extern const TOKENVALUE *av1_dct_cat_lt_10_value_tokens;
+extern const int16_t *av1_dct_cat_lt_10_value_cost;
 extern const int16_t av1_cat6_low_cost[256];
 extern const int av1_cat6_high_cost[64];
 extern const int av1_cat6_high10_high_cost[256];
@@ -106,6 +107,20 @@ static INLINE void av1_get_token_extra(int v, int16_t *token, EXTRABIT *extra) {
   *token = av1_dct_cat_lt_10_value_tokens[v].token;
   *extra = av1_dct_cat_lt_10_value_tokens[v].extra;
 }
+// Returns the cost of the extra bits of v, sign included, and sets *token to
+// its token. Same as av1_get_token_extra() followed by av1_get_cost(), with a
+// single table lookup for the values below CAT6_MIN_VAL.
+static INLINE int av1_get_token_cost(int v, int16_t *token,
+                                     const int *cat6_high_table) {
+  if (v >= CAT6_MIN_VAL || v <= -CAT6_MIN_VAL) {
+    EXTRABIT extra;
+    av1_get_token_extra(v, token, &extra);
+    return av1_get_cost(*token, extra, cat6_high_table);
+  }
+  *token = av1_dct_cat_lt_10_value_tokens[v].token;
+  return av1_dct_cat_lt_10_value_cost[v];
+}
+
 static INLINE int16_t av1_get_token(int v) {
   if (v >= CAT6_MIN_VAL || v <= -CAT6_MIN_VAL) return 10;
   return av1_dct_cat_lt_10_value_tokens[v].token;
@@ -0,0 +1,1180 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./av1_rtcd.h"
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/txfm_common.h"
+#include "aom_dsp/x86/txfm_common_avx2.h"
+#include "aom_ports/mem.h"
+
+// The 16x16 hybrid transforms hold a whole block in 16 registers, one row of
+// 16 coefficients each, and so do the 1-D transforms of all the columns at
+// once. They follow the 16-bit arithmetic of the SSE2 version, which works on
+// 8 columns at a time, and their output is the same.
+
+static INLINE void load_buffer_16x16_avx2(const int16_t *input, __m256i *in,
+                                          int stride, int flipud, int fliplr) {
+  int i;
+  if (flipud) {
+    input += 15 * stride;
+    stride = -stride;
+  }
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+    if (fliplr) {
+      const __m256i kReverse = _mm256_setr_epi8(
+          14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1, 14, 15, 12, 13,
+          10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+      in[i] = _mm256_shuffle_epi8(in[i], kReverse);
+      in[i] = _mm256_permute4x64_epi64(in[i], 0x4e);
+    }
+    in[i] = _mm256_slli_epi16(in[i], 2);
+  }
+}
+
+static INLINE void store_output_avx2(__m256i out, tran_low_t *dst) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  const __m128i lo = _mm256_castsi256_si128(out);
+  const __m128i hi = _mm256_extractf128_si256(out, 1);
+  _mm256_storeu_si256((__m256i *)dst, _mm256_cvtepi16_epi32(lo));
+  _mm256_storeu_si256((__m256i *)(dst + 8), _mm256_cvtepi16_epi32(hi));
+#else
+  _mm256_storeu_si256((__m256i *)dst, out);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+static INLINE void write_buffer_16x16_avx2(tran_low_t *output,
+                                           const __m256i *in) {
+  int i;
+  for (i = 0; i < 16; ++i) store_output_avx2(in[i], output + i * 16);
+}
+
+// Rounds the output of the first pass as the C code does:
+// (x + 1 + (x < 0)) >> 2.
+static INLINE void right_shift_16x16_avx2(__m256i *in) {
+  const __m256i kOne = _mm256_set1_epi16(1);
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i sign = _mm256_srai_epi16(in[i], 15);
+    in[i] = _mm256_add_epi16(in[i], kOne);
+    in[i] = _mm256_sub_epi16(in[i], sign);
+    in[i] = _mm256_srai_epi16(in[i], 2);
+  }
+}
+
+// Transposes the 8x8 blocks in each 128-bit lane of in[0] to in[7].
+static INLINE void transpose_8x8_lanes_avx2(const __m256i *in, __m256i *res) {
+  const __m256i tr0_0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i tr0_1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i tr0_2 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i tr0_3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i tr0_4 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i tr0_5 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i tr0_6 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i tr0_7 = _mm256_unpackhi_epi16(in[6], in[7]);
+  const __m256i tr1_0 = _mm256_unpacklo_epi32(tr0_0, tr0_1);
+  const __m256i tr1_1 = _mm256_unpacklo_epi32(tr0_4, tr0_5);
+  const __m256i tr1_2 = _mm256_unpackhi_epi32(tr0_0, tr0_1);
+  const __m256i tr1_3 = _mm256_unpackhi_epi32(tr0_4, tr0_5);
+  const __m256i tr1_4 = _mm256_unpacklo_epi32(tr0_2, tr0_3);
+  const __m256i tr1_5 = _mm256_unpacklo_epi32(tr0_6, tr0_7);
+  const __m256i tr1_6 = _mm256_unpackhi_epi32(tr0_2, tr0_3);
+  const __m256i tr1_7 = _mm256_unpackhi_epi32(tr0_6, tr0_7);
+  res[0] = _mm256_unpacklo_epi64(tr1_0, tr1_1);
+  res[1] = _mm256_unpackhi_epi64(tr1_0, tr1_1);
+  res[2] = _mm256_unpacklo_epi64(tr1_2, tr1_3);
+  res[3] = _mm256_unpackhi_epi64(tr1_2, tr1_3);
+  res[4] = _mm256_unpacklo_epi64(tr1_4, tr1_5);
+  res[5] = _mm256_unpackhi_epi64(tr1_4, tr1_5);
+  res[6] = _mm256_unpacklo_epi64(tr1_6, tr1_7);
+  res[7] = _mm256_unpackhi_epi64(tr1_6, tr1_7);
+}
+
+static INLINE void transpose_16x16_avx2(__m256i *in) {
+  // Lane 0 of t[i] is column i of rows 0 to 7, lane 1 column i + 8. u[i] is
+  // the same for rows 8 to 15.
+  __m256i t[8], u[8];
+  int i;
+  transpose_8x8_lanes_avx2(in, t);
+  transpose_8x8_lanes_avx2(in + 8, u);
+  for (i = 0; i < 8; ++i) {
+    in[i] = _mm256_permute2x128_si256(t[i], u[i], 0x20);
+    in[i + 8] = _mm256_permute2x128_si256(t[i], u[i], 0x31);
+  }
+}
+
+static void fdct16_avx2(__m256i *in) {
+  // perform 16x16 1-D DCT for 16 columns
+  __m256i i[8], s[8], p[8], t[8], u[16], v[16];
+  const __m256i k__cospi_p16_p16 = _mm256_set1_epi16((int16_t)cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_m16_p16 = pair256_set_epi16(-cospi_16_64, cospi_16_64);
+  const __m256i k__cospi_p24_p08 = pair256_set_epi16(cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_p08_m24 = pair256_set_epi16(cospi_8_64, -cospi_24_64);
+  const __m256i k__cospi_m08_p24 = pair256_set_epi16(-cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p28_p04 = pair256_set_epi16(cospi_28_64, cospi_4_64);
+  const __m256i k__cospi_m04_p28 = pair256_set_epi16(-cospi_4_64, cospi_28_64);
+  const __m256i k__cospi_p12_p20 = pair256_set_epi16(cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_m20_p12 = pair256_set_epi16(-cospi_20_64, cospi_12_64);
+  const __m256i k__cospi_p30_p02 = pair256_set_epi16(cospi_30_64, cospi_2_64);
+  const __m256i k__cospi_p14_p18 = pair256_set_epi16(cospi_14_64, cospi_18_64);
+  const __m256i k__cospi_m02_p30 = pair256_set_epi16(-cospi_2_64, cospi_30_64);
+  const __m256i k__cospi_m18_p14 = pair256_set_epi16(-cospi_18_64, cospi_14_64);
+  const __m256i k__cospi_p22_p10 = pair256_set_epi16(cospi_22_64, cospi_10_64);
+  const __m256i k__cospi_p06_p26 = pair256_set_epi16(cospi_6_64, cospi_26_64);
+  const __m256i k__cospi_m10_p22 = pair256_set_epi16(-cospi_10_64, cospi_22_64);
+  const __m256i k__cospi_m26_p06 = pair256_set_epi16(-cospi_26_64, cospi_6_64);
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+
+  // stage 1
+  i[0] = _mm256_add_epi16(in[0], in[15]);
+  i[1] = _mm256_add_epi16(in[1], in[14]);
+  i[2] = _mm256_add_epi16(in[2], in[13]);
+  i[3] = _mm256_add_epi16(in[3], in[12]);
+  i[4] = _mm256_add_epi16(in[4], in[11]);
+  i[5] = _mm256_add_epi16(in[5], in[10]);
+  i[6] = _mm256_add_epi16(in[6], in[9]);
+  i[7] = _mm256_add_epi16(in[7], in[8]);
+
+  s[0] = _mm256_sub_epi16(in[7], in[8]);
+  s[1] = _mm256_sub_epi16(in[6], in[9]);
+  s[2] = _mm256_sub_epi16(in[5], in[10]);
+  s[3] = _mm256_sub_epi16(in[4], in[11]);
+  s[4] = _mm256_sub_epi16(in[3], in[12]);
+  s[5] = _mm256_sub_epi16(in[2], in[13]);
+  s[6] = _mm256_sub_epi16(in[1], in[14]);
+  s[7] = _mm256_sub_epi16(in[0], in[15]);
+
+  p[0] = _mm256_add_epi16(i[0], i[7]);
+  p[1] = _mm256_add_epi16(i[1], i[6]);
+  p[2] = _mm256_add_epi16(i[2], i[5]);
+  p[3] = _mm256_add_epi16(i[3], i[4]);
+  p[4] = _mm256_sub_epi16(i[3], i[4]);
+  p[5] = _mm256_sub_epi16(i[2], i[5]);
+  p[6] = _mm256_sub_epi16(i[1], i[6]);
+  p[7] = _mm256_sub_epi16(i[0], i[7]);
+
+  u[0] = _mm256_add_epi16(p[0], p[3]);
+  u[1] = _mm256_add_epi16(p[1], p[2]);
+  u[2] = _mm256_sub_epi16(p[1], p[2]);
+  u[3] = _mm256_sub_epi16(p[0], p[3]);
+
+  v[0] = _mm256_unpacklo_epi16(u[0], u[1]);
+  v[1] = _mm256_unpackhi_epi16(u[0], u[1]);
+  v[2] = _mm256_unpacklo_epi16(u[2], u[3]);
+  v[3] = _mm256_unpackhi_epi16(u[2], u[3]);
+
+  u[0] = _mm256_madd_epi16(v[0], k__cospi_p16_p16);
+  u[1] = _mm256_madd_epi16(v[1], k__cospi_p16_p16);
+  u[2] = _mm256_madd_epi16(v[0], k__cospi_p16_m16);
+  u[3] = _mm256_madd_epi16(v[1], k__cospi_p16_m16);
+  u[4] = _mm256_madd_epi16(v[2], k__cospi_p24_p08);
+  u[5] = _mm256_madd_epi16(v[3], k__cospi_p24_p08);
+  u[6] = _mm256_madd_epi16(v[2], k__cospi_m08_p24);
+  u[7] = _mm256_madd_epi16(v[3], k__cospi_m08_p24);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+
+  in[0] = _mm256_packs_epi32(u[0], u[1]);
+  in[4] = _mm256_packs_epi32(u[4], u[5]);
+  in[8] = _mm256_packs_epi32(u[2], u[3]);
+  in[12] = _mm256_packs_epi32(u[6], u[7]);
+
+  u[0] = _mm256_unpacklo_epi16(p[5], p[6]);
+  u[1] = _mm256_unpackhi_epi16(p[5], p[6]);
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_p16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_p16);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p16_p16);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p16_p16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+
+  u[0] = _mm256_packs_epi32(v[0], v[1]);
+  u[1] = _mm256_packs_epi32(v[2], v[3]);
+
+  t[0] = _mm256_add_epi16(p[4], u[0]);
+  t[1] = _mm256_sub_epi16(p[4], u[0]);
+  t[2] = _mm256_sub_epi16(p[7], u[1]);
+  t[3] = _mm256_add_epi16(p[7], u[1]);
+
+  u[0] = _mm256_unpacklo_epi16(t[0], t[3]);
+  u[1] = _mm256_unpackhi_epi16(t[0], t[3]);
+  u[2] = _mm256_unpacklo_epi16(t[1], t[2]);
+  u[3] = _mm256_unpackhi_epi16(t[1], t[2]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p28_p04);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p28_p04);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p12_p20);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p12_p20);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_m20_p12);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_m20_p12);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_m04_p28);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_m04_p28);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  in[2] = _mm256_packs_epi32(v[0], v[1]);
+  in[6] = _mm256_packs_epi32(v[4], v[5]);
+  in[10] = _mm256_packs_epi32(v[2], v[3]);
+  in[14] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 2
+  u[0] = _mm256_unpacklo_epi16(s[2], s[5]);
+  u[1] = _mm256_unpackhi_epi16(s[2], s[5]);
+  u[2] = _mm256_unpacklo_epi16(s[3], s[4]);
+  u[3] = _mm256_unpackhi_epi16(s[3], s[4]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_p16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_p16);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_m16_p16);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_m16_p16);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p16_p16);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p16_p16);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_p16_p16);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_p16_p16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  t[2] = _mm256_packs_epi32(v[0], v[1]);
+  t[3] = _mm256_packs_epi32(v[2], v[3]);
+  t[4] = _mm256_packs_epi32(v[4], v[5]);
+  t[5] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 3
+  p[0] = _mm256_add_epi16(s[0], t[3]);
+  p[1] = _mm256_add_epi16(s[1], t[2]);
+  p[2] = _mm256_sub_epi16(s[1], t[2]);
+  p[3] = _mm256_sub_epi16(s[0], t[3]);
+  p[4] = _mm256_sub_epi16(s[7], t[4]);
+  p[5] = _mm256_sub_epi16(s[6], t[5]);
+  p[6] = _mm256_add_epi16(s[6], t[5]);
+  p[7] = _mm256_add_epi16(s[7], t[4]);
+
+  // stage 4
+  u[0] = _mm256_unpacklo_epi16(p[1], p[6]);
+  u[1] = _mm256_unpackhi_epi16(p[1], p[6]);
+  u[2] = _mm256_unpacklo_epi16(p[2], p[5]);
+  u[3] = _mm256_unpackhi_epi16(p[2], p[5]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m08_p24);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m08_p24);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p24_p08);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p24_p08);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p08_m24);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p08_m24);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_p24_p08);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_p24_p08);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  t[1] = _mm256_packs_epi32(v[0], v[1]);
+  t[2] = _mm256_packs_epi32(v[2], v[3]);
+  t[5] = _mm256_packs_epi32(v[4], v[5]);
+  t[6] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 5
+  s[0] = _mm256_add_epi16(p[0], t[1]);
+  s[1] = _mm256_sub_epi16(p[0], t[1]);
+  s[2] = _mm256_add_epi16(p[3], t[2]);
+  s[3] = _mm256_sub_epi16(p[3], t[2]);
+  s[4] = _mm256_sub_epi16(p[4], t[5]);
+  s[5] = _mm256_add_epi16(p[4], t[5]);
+  s[6] = _mm256_sub_epi16(p[7], t[6]);
+  s[7] = _mm256_add_epi16(p[7], t[6]);
+
+  // stage 6
+  u[0] = _mm256_unpacklo_epi16(s[0], s[7]);
+  u[1] = _mm256_unpackhi_epi16(s[0], s[7]);
+  u[2] = _mm256_unpacklo_epi16(s[1], s[6]);
+  u[3] = _mm256_unpackhi_epi16(s[1], s[6]);
+  u[4] = _mm256_unpacklo_epi16(s[2], s[5]);
+  u[5] = _mm256_unpackhi_epi16(s[2], s[5]);
+  u[6] = _mm256_unpacklo_epi16(s[3], s[4]);
+  u[7] = _mm256_unpackhi_epi16(s[3], s[4]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p30_p02);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p30_p02);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p14_p18);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p14_p18);
+  v[4] = _mm256_madd_epi16(u[4], k__cospi_p22_p10);
+  v[5] = _mm256_madd_epi16(u[5], k__cospi_p22_p10);
+  v[6] = _mm256_madd_epi16(u[6], k__cospi_p06_p26);
+  v[7] = _mm256_madd_epi16(u[7], k__cospi_p06_p26);
+  v[8] = _mm256_madd_epi16(u[6], k__cospi_m26_p06);
+  v[9] = _mm256_madd_epi16(u[7], k__cospi_m26_p06);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_m10_p22);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_m10_p22);
+  v[12] = _mm256_madd_epi16(u[2], k__cospi_m18_p14);
+  v[13] = _mm256_madd_epi16(u[3], k__cospi_m18_p14);
+  v[14] = _mm256_madd_epi16(u[0], k__cospi_m02_p30);
+  v[15] = _mm256_madd_epi16(u[1], k__cospi_m02_p30);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(v[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(v[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(v[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(v[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(v[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(v[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(v[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(v[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  in[1] = _mm256_packs_epi32(v[0], v[1]);
+  in[9] = _mm256_packs_epi32(v[2], v[3]);
+  in[5] = _mm256_packs_epi32(v[4], v[5]);
+  in[13] = _mm256_packs_epi32(v[6], v[7]);
+  in[3] = _mm256_packs_epi32(v[8], v[9]);
+  in[11] = _mm256_packs_epi32(v[10], v[11]);
+  in[7] = _mm256_packs_epi32(v[12], v[13]);
+  in[15] = _mm256_packs_epi32(v[14], v[15]);
+}
+
+static void fadst16_avx2(__m256i *in) {
+  // perform 16x16 1-D ADST for 16 columns
+  __m256i s[16], x[16], u[32], v[32];
+  const __m256i k__cospi_p01_p31 = pair256_set_epi16(cospi_1_64, cospi_31_64);
+  const __m256i k__cospi_p31_m01 = pair256_set_epi16(cospi_31_64, -cospi_1_64);
+  const __m256i k__cospi_p05_p27 = pair256_set_epi16(cospi_5_64, cospi_27_64);
+  const __m256i k__cospi_p27_m05 = pair256_set_epi16(cospi_27_64, -cospi_5_64);
+  const __m256i k__cospi_p09_p23 = pair256_set_epi16(cospi_9_64, cospi_23_64);
+  const __m256i k__cospi_p23_m09 = pair256_set_epi16(cospi_23_64, -cospi_9_64);
+  const __m256i k__cospi_p13_p19 = pair256_set_epi16(cospi_13_64, cospi_19_64);
+  const __m256i k__cospi_p19_m13 = pair256_set_epi16(cospi_19_64, -cospi_13_64);
+  const __m256i k__cospi_p17_p15 = pair256_set_epi16(cospi_17_64, cospi_15_64);
+  const __m256i k__cospi_p15_m17 = pair256_set_epi16(cospi_15_64, -cospi_17_64);
+  const __m256i k__cospi_p21_p11 = pair256_set_epi16(cospi_21_64, cospi_11_64);
+  const __m256i k__cospi_p11_m21 = pair256_set_epi16(cospi_11_64, -cospi_21_64);
+  const __m256i k__cospi_p25_p07 = pair256_set_epi16(cospi_25_64, cospi_7_64);
+  const __m256i k__cospi_p07_m25 = pair256_set_epi16(cospi_7_64, -cospi_25_64);
+  const __m256i k__cospi_p29_p03 = pair256_set_epi16(cospi_29_64, cospi_3_64);
+  const __m256i k__cospi_p03_m29 = pair256_set_epi16(cospi_3_64, -cospi_29_64);
+  const __m256i k__cospi_p04_p28 = pair256_set_epi16(cospi_4_64, cospi_28_64);
+  const __m256i k__cospi_p28_m04 = pair256_set_epi16(cospi_28_64, -cospi_4_64);
+  const __m256i k__cospi_p20_p12 = pair256_set_epi16(cospi_20_64, cospi_12_64);
+  const __m256i k__cospi_p12_m20 = pair256_set_epi16(cospi_12_64, -cospi_20_64);
+  const __m256i k__cospi_m28_p04 = pair256_set_epi16(-cospi_28_64, cospi_4_64);
+  const __m256i k__cospi_m12_p20 = pair256_set_epi16(-cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_p08_p24 = pair256_set_epi16(cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p24_m08 = pair256_set_epi16(cospi_24_64, -cospi_8_64);
+  const __m256i k__cospi_m24_p08 = pair256_set_epi16(-cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_m16_m16 = _mm256_set1_epi16((int16_t)-cospi_16_64);
+  const __m256i k__cospi_p16_p16 = _mm256_set1_epi16((int16_t)cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_m16_p16 = pair256_set_epi16(-cospi_16_64, cospi_16_64);
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  const __m256i kZero = _mm256_set1_epi16(0);
+
+  u[0] = _mm256_unpacklo_epi16(in[15], in[0]);
+  u[1] = _mm256_unpackhi_epi16(in[15], in[0]);
+  u[2] = _mm256_unpacklo_epi16(in[13], in[2]);
+  u[3] = _mm256_unpackhi_epi16(in[13], in[2]);
+  u[4] = _mm256_unpacklo_epi16(in[11], in[4]);
+  u[5] = _mm256_unpackhi_epi16(in[11], in[4]);
+  u[6] = _mm256_unpacklo_epi16(in[9], in[6]);
+  u[7] = _mm256_unpackhi_epi16(in[9], in[6]);
+  u[8] = _mm256_unpacklo_epi16(in[7], in[8]);
+  u[9] = _mm256_unpackhi_epi16(in[7], in[8]);
+  u[10] = _mm256_unpacklo_epi16(in[5], in[10]);
+  u[11] = _mm256_unpackhi_epi16(in[5], in[10]);
+  u[12] = _mm256_unpacklo_epi16(in[3], in[12]);
+  u[13] = _mm256_unpackhi_epi16(in[3], in[12]);
+  u[14] = _mm256_unpacklo_epi16(in[1], in[14]);
+  u[15] = _mm256_unpackhi_epi16(in[1], in[14]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p01_p31);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p01_p31);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p31_m01);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p31_m01);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p05_p27);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p05_p27);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p27_m05);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p27_m05);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p09_p23);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p09_p23);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p23_m09);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p23_m09);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_p13_p19);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_p13_p19);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p19_m13);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p19_m13);
+  v[16] = _mm256_madd_epi16(u[8], k__cospi_p17_p15);
+  v[17] = _mm256_madd_epi16(u[9], k__cospi_p17_p15);
+  v[18] = _mm256_madd_epi16(u[8], k__cospi_p15_m17);
+  v[19] = _mm256_madd_epi16(u[9], k__cospi_p15_m17);
+  v[20] = _mm256_madd_epi16(u[10], k__cospi_p21_p11);
+  v[21] = _mm256_madd_epi16(u[11], k__cospi_p21_p11);
+  v[22] = _mm256_madd_epi16(u[10], k__cospi_p11_m21);
+  v[23] = _mm256_madd_epi16(u[11], k__cospi_p11_m21);
+  v[24] = _mm256_madd_epi16(u[12], k__cospi_p25_p07);
+  v[25] = _mm256_madd_epi16(u[13], k__cospi_p25_p07);
+  v[26] = _mm256_madd_epi16(u[12], k__cospi_p07_m25);
+  v[27] = _mm256_madd_epi16(u[13], k__cospi_p07_m25);
+  v[28] = _mm256_madd_epi16(u[14], k__cospi_p29_p03);
+  v[29] = _mm256_madd_epi16(u[15], k__cospi_p29_p03);
+  v[30] = _mm256_madd_epi16(u[14], k__cospi_p03_m29);
+  v[31] = _mm256_madd_epi16(u[15], k__cospi_p03_m29);
+
+  u[0] = _mm256_add_epi32(v[0], v[16]);
+  u[1] = _mm256_add_epi32(v[1], v[17]);
+  u[2] = _mm256_add_epi32(v[2], v[18]);
+  u[3] = _mm256_add_epi32(v[3], v[19]);
+  u[4] = _mm256_add_epi32(v[4], v[20]);
+  u[5] = _mm256_add_epi32(v[5], v[21]);
+  u[6] = _mm256_add_epi32(v[6], v[22]);
+  u[7] = _mm256_add_epi32(v[7], v[23]);
+  u[8] = _mm256_add_epi32(v[8], v[24]);
+  u[9] = _mm256_add_epi32(v[9], v[25]);
+  u[10] = _mm256_add_epi32(v[10], v[26]);
+  u[11] = _mm256_add_epi32(v[11], v[27]);
+  u[12] = _mm256_add_epi32(v[12], v[28]);
+  u[13] = _mm256_add_epi32(v[13], v[29]);
+  u[14] = _mm256_add_epi32(v[14], v[30]);
+  u[15] = _mm256_add_epi32(v[15], v[31]);
+  u[16] = _mm256_sub_epi32(v[0], v[16]);
+  u[17] = _mm256_sub_epi32(v[1], v[17]);
+  u[18] = _mm256_sub_epi32(v[2], v[18]);
+  u[19] = _mm256_sub_epi32(v[3], v[19]);
+  u[20] = _mm256_sub_epi32(v[4], v[20]);
+  u[21] = _mm256_sub_epi32(v[5], v[21]);
+  u[22] = _mm256_sub_epi32(v[6], v[22]);
+  u[23] = _mm256_sub_epi32(v[7], v[23]);
+  u[24] = _mm256_sub_epi32(v[8], v[24]);
+  u[25] = _mm256_sub_epi32(v[9], v[25]);
+  u[26] = _mm256_sub_epi32(v[10], v[26]);
+  u[27] = _mm256_sub_epi32(v[11], v[27]);
+  u[28] = _mm256_sub_epi32(v[12], v[28]);
+  u[29] = _mm256_sub_epi32(v[13], v[29]);
+  u[30] = _mm256_sub_epi32(v[14], v[30]);
+  u[31] = _mm256_sub_epi32(v[15], v[31]);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  v[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  v[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  v[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  v[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  v[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  v[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  v[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  v[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+  v[16] = _mm256_add_epi32(u[16], k__DCT_CONST_ROUNDING);
+  v[17] = _mm256_add_epi32(u[17], k__DCT_CONST_ROUNDING);
+  v[18] = _mm256_add_epi32(u[18], k__DCT_CONST_ROUNDING);
+  v[19] = _mm256_add_epi32(u[19], k__DCT_CONST_ROUNDING);
+  v[20] = _mm256_add_epi32(u[20], k__DCT_CONST_ROUNDING);
+  v[21] = _mm256_add_epi32(u[21], k__DCT_CONST_ROUNDING);
+  v[22] = _mm256_add_epi32(u[22], k__DCT_CONST_ROUNDING);
+  v[23] = _mm256_add_epi32(u[23], k__DCT_CONST_ROUNDING);
+  v[24] = _mm256_add_epi32(u[24], k__DCT_CONST_ROUNDING);
+  v[25] = _mm256_add_epi32(u[25], k__DCT_CONST_ROUNDING);
+  v[26] = _mm256_add_epi32(u[26], k__DCT_CONST_ROUNDING);
+  v[27] = _mm256_add_epi32(u[27], k__DCT_CONST_ROUNDING);
+  v[28] = _mm256_add_epi32(u[28], k__DCT_CONST_ROUNDING);
+  v[29] = _mm256_add_epi32(u[29], k__DCT_CONST_ROUNDING);
+  v[30] = _mm256_add_epi32(u[30], k__DCT_CONST_ROUNDING);
+  v[31] = _mm256_add_epi32(u[31], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+  u[8] = _mm256_srai_epi32(v[8], DCT_CONST_BITS);
+  u[9] = _mm256_srai_epi32(v[9], DCT_CONST_BITS);
+  u[10] = _mm256_srai_epi32(v[10], DCT_CONST_BITS);
+  u[11] = _mm256_srai_epi32(v[11], DCT_CONST_BITS);
+  u[12] = _mm256_srai_epi32(v[12], DCT_CONST_BITS);
+  u[13] = _mm256_srai_epi32(v[13], DCT_CONST_BITS);
+  u[14] = _mm256_srai_epi32(v[14], DCT_CONST_BITS);
+  u[15] = _mm256_srai_epi32(v[15], DCT_CONST_BITS);
+  u[16] = _mm256_srai_epi32(v[16], DCT_CONST_BITS);
+  u[17] = _mm256_srai_epi32(v[17], DCT_CONST_BITS);
+  u[18] = _mm256_srai_epi32(v[18], DCT_CONST_BITS);
+  u[19] = _mm256_srai_epi32(v[19], DCT_CONST_BITS);
+  u[20] = _mm256_srai_epi32(v[20], DCT_CONST_BITS);
+  u[21] = _mm256_srai_epi32(v[21], DCT_CONST_BITS);
+  u[22] = _mm256_srai_epi32(v[22], DCT_CONST_BITS);
+  u[23] = _mm256_srai_epi32(v[23], DCT_CONST_BITS);
+  u[24] = _mm256_srai_epi32(v[24], DCT_CONST_BITS);
+  u[25] = _mm256_srai_epi32(v[25], DCT_CONST_BITS);
+  u[26] = _mm256_srai_epi32(v[26], DCT_CONST_BITS);
+  u[27] = _mm256_srai_epi32(v[27], DCT_CONST_BITS);
+  u[28] = _mm256_srai_epi32(v[28], DCT_CONST_BITS);
+  u[29] = _mm256_srai_epi32(v[29], DCT_CONST_BITS);
+  u[30] = _mm256_srai_epi32(v[30], DCT_CONST_BITS);
+  u[31] = _mm256_srai_epi32(v[31], DCT_CONST_BITS);
+
+  s[0] = _mm256_packs_epi32(u[0], u[1]);
+  s[1] = _mm256_packs_epi32(u[2], u[3]);
+  s[2] = _mm256_packs_epi32(u[4], u[5]);
+  s[3] = _mm256_packs_epi32(u[6], u[7]);
+  s[4] = _mm256_packs_epi32(u[8], u[9]);
+  s[5] = _mm256_packs_epi32(u[10], u[11]);
+  s[6] = _mm256_packs_epi32(u[12], u[13]);
+  s[7] = _mm256_packs_epi32(u[14], u[15]);
+  s[8] = _mm256_packs_epi32(u[16], u[17]);
+  s[9] = _mm256_packs_epi32(u[18], u[19]);
+  s[10] = _mm256_packs_epi32(u[20], u[21]);
+  s[11] = _mm256_packs_epi32(u[22], u[23]);
+  s[12] = _mm256_packs_epi32(u[24], u[25]);
+  s[13] = _mm256_packs_epi32(u[26], u[27]);
+  s[14] = _mm256_packs_epi32(u[28], u[29]);
+  s[15] = _mm256_packs_epi32(u[30], u[31]);
+
+  // stage 2
+  u[0] = _mm256_unpacklo_epi16(s[8], s[9]);
+  u[1] = _mm256_unpackhi_epi16(s[8], s[9]);
+  u[2] = _mm256_unpacklo_epi16(s[10], s[11]);
+  u[3] = _mm256_unpackhi_epi16(s[10], s[11]);
+  u[4] = _mm256_unpacklo_epi16(s[12], s[13]);
+  u[5] = _mm256_unpackhi_epi16(s[12], s[13]);
+  u[6] = _mm256_unpacklo_epi16(s[14], s[15]);
+  u[7] = _mm256_unpackhi_epi16(s[14], s[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p04_p28);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p04_p28);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p28_m04);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p28_m04);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p20_p12);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p20_p12);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p12_m20);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p12_m20);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_m28_p04);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_m28_p04);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p04_p28);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p04_p28);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m12_p20);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m12_p20);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p20_p12);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p20_p12);
+
+  u[0] = _mm256_add_epi32(v[0], v[8]);
+  u[1] = _mm256_add_epi32(v[1], v[9]);
+  u[2] = _mm256_add_epi32(v[2], v[10]);
+  u[3] = _mm256_add_epi32(v[3], v[11]);
+  u[4] = _mm256_add_epi32(v[4], v[12]);
+  u[5] = _mm256_add_epi32(v[5], v[13]);
+  u[6] = _mm256_add_epi32(v[6], v[14]);
+  u[7] = _mm256_add_epi32(v[7], v[15]);
+  u[8] = _mm256_sub_epi32(v[0], v[8]);
+  u[9] = _mm256_sub_epi32(v[1], v[9]);
+  u[10] = _mm256_sub_epi32(v[2], v[10]);
+  u[11] = _mm256_sub_epi32(v[3], v[11]);
+  u[12] = _mm256_sub_epi32(v[4], v[12]);
+  u[13] = _mm256_sub_epi32(v[5], v[13]);
+  u[14] = _mm256_sub_epi32(v[6], v[14]);
+  u[15] = _mm256_sub_epi32(v[7], v[15]);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  v[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  v[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  v[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  v[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  v[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  v[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  v[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  v[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+  u[8] = _mm256_srai_epi32(v[8], DCT_CONST_BITS);
+  u[9] = _mm256_srai_epi32(v[9], DCT_CONST_BITS);
+  u[10] = _mm256_srai_epi32(v[10], DCT_CONST_BITS);
+  u[11] = _mm256_srai_epi32(v[11], DCT_CONST_BITS);
+  u[12] = _mm256_srai_epi32(v[12], DCT_CONST_BITS);
+  u[13] = _mm256_srai_epi32(v[13], DCT_CONST_BITS);
+  u[14] = _mm256_srai_epi32(v[14], DCT_CONST_BITS);
+  u[15] = _mm256_srai_epi32(v[15], DCT_CONST_BITS);
+
+  x[0] = _mm256_add_epi16(s[0], s[4]);
+  x[1] = _mm256_add_epi16(s[1], s[5]);
+  x[2] = _mm256_add_epi16(s[2], s[6]);
+  x[3] = _mm256_add_epi16(s[3], s[7]);
+  x[4] = _mm256_sub_epi16(s[0], s[4]);
+  x[5] = _mm256_sub_epi16(s[1], s[5]);
+  x[6] = _mm256_sub_epi16(s[2], s[6]);
+  x[7] = _mm256_sub_epi16(s[3], s[7]);
+  x[8] = _mm256_packs_epi32(u[0], u[1]);
+  x[9] = _mm256_packs_epi32(u[2], u[3]);
+  x[10] = _mm256_packs_epi32(u[4], u[5]);
+  x[11] = _mm256_packs_epi32(u[6], u[7]);
+  x[12] = _mm256_packs_epi32(u[8], u[9]);
+  x[13] = _mm256_packs_epi32(u[10], u[11]);
+  x[14] = _mm256_packs_epi32(u[12], u[13]);
+  x[15] = _mm256_packs_epi32(u[14], u[15]);
+
+  // stage 3
+  u[0] = _mm256_unpacklo_epi16(x[4], x[5]);
+  u[1] = _mm256_unpackhi_epi16(x[4], x[5]);
+  u[2] = _mm256_unpacklo_epi16(x[6], x[7]);
+  u[3] = _mm256_unpackhi_epi16(x[6], x[7]);
+  u[4] = _mm256_unpacklo_epi16(x[12], x[13]);
+  u[5] = _mm256_unpackhi_epi16(x[12], x[13]);
+  u[6] = _mm256_unpacklo_epi16(x[14], x[15]);
+  u[7] = _mm256_unpackhi_epi16(x[14], x[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p08_p24);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p08_p24);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p24_m08);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p24_m08);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_m24_p08);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_m24_p08);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p08_p24);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p08_p24);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p08_p24);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p08_p24);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p24_m08);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p24_m08);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m24_p08);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m24_p08);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p08_p24);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p08_p24);
+
+  u[0] = _mm256_add_epi32(v[0], v[4]);
+  u[1] = _mm256_add_epi32(v[1], v[5]);
+  u[2] = _mm256_add_epi32(v[2], v[6]);
+  u[3] = _mm256_add_epi32(v[3], v[7]);
+  u[4] = _mm256_sub_epi32(v[0], v[4]);
+  u[5] = _mm256_sub_epi32(v[1], v[5]);
+  u[6] = _mm256_sub_epi32(v[2], v[6]);
+  u[7] = _mm256_sub_epi32(v[3], v[7]);
+  u[8] = _mm256_add_epi32(v[8], v[12]);
+  u[9] = _mm256_add_epi32(v[9], v[13]);
+  u[10] = _mm256_add_epi32(v[10], v[14]);
+  u[11] = _mm256_add_epi32(v[11], v[15]);
+  u[12] = _mm256_sub_epi32(v[8], v[12]);
+  u[13] = _mm256_sub_epi32(v[9], v[13]);
+  u[14] = _mm256_sub_epi32(v[10], v[14]);
+  u[15] = _mm256_sub_epi32(v[11], v[15]);
+
+  u[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  s[0] = _mm256_add_epi16(x[0], x[2]);
+  s[1] = _mm256_add_epi16(x[1], x[3]);
+  s[2] = _mm256_sub_epi16(x[0], x[2]);
+  s[3] = _mm256_sub_epi16(x[1], x[3]);
+  s[4] = _mm256_packs_epi32(v[0], v[1]);
+  s[5] = _mm256_packs_epi32(v[2], v[3]);
+  s[6] = _mm256_packs_epi32(v[4], v[5]);
+  s[7] = _mm256_packs_epi32(v[6], v[7]);
+  s[8] = _mm256_add_epi16(x[8], x[10]);
+  s[9] = _mm256_add_epi16(x[9], x[11]);
+  s[10] = _mm256_sub_epi16(x[8], x[10]);
+  s[11] = _mm256_sub_epi16(x[9], x[11]);
+  s[12] = _mm256_packs_epi32(v[8], v[9]);
+  s[13] = _mm256_packs_epi32(v[10], v[11]);
+  s[14] = _mm256_packs_epi32(v[12], v[13]);
+  s[15] = _mm256_packs_epi32(v[14], v[15]);
+
+  // stage 4
+  u[0] = _mm256_unpacklo_epi16(s[2], s[3]);
+  u[1] = _mm256_unpackhi_epi16(s[2], s[3]);
+  u[2] = _mm256_unpacklo_epi16(s[6], s[7]);
+  u[3] = _mm256_unpackhi_epi16(s[6], s[7]);
+  u[4] = _mm256_unpacklo_epi16(s[10], s[11]);
+  u[5] = _mm256_unpackhi_epi16(s[10], s[11]);
+  u[6] = _mm256_unpacklo_epi16(s[14], s[15]);
+  u[7] = _mm256_unpackhi_epi16(s[14], s[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_m16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_m16);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p16_m16);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p16_m16);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p16_p16);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p16_p16);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_m16_p16);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_m16_p16);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p16_p16);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p16_p16);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_m16_p16);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_m16_p16);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m16_m16);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m16_m16);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p16_m16);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p16_m16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(v[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(v[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(v[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(v[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(v[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(v[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(v[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(v[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  in[0] = s[0];
+  in[1] = _mm256_sub_epi16(kZero, s[8]);
+  in[2] = s[12];
+  in[3] = _mm256_sub_epi16(kZero, s[4]);
+  in[4] = _mm256_packs_epi32(v[4], v[5]);
+  in[5] = _mm256_packs_epi32(v[12], v[13]);
+  in[6] = _mm256_packs_epi32(v[8], v[9]);
+  in[7] = _mm256_packs_epi32(v[0], v[1]);
+  in[8] = _mm256_packs_epi32(v[2], v[3]);
+  in[9] = _mm256_packs_epi32(v[10], v[11]);
+  in[10] = _mm256_packs_epi32(v[14], v[15]);
+  in[11] = _mm256_packs_epi32(v[6], v[7]);
+  in[12] = s[5];
+  in[13] = _mm256_sub_epi16(kZero, s[13]);
+  in[14] = s[9];
+  in[15] = _mm256_sub_epi16(kZero, s[1]);
+}
+#if CONFIG_EXT_TX
+// Identity transform of 16 columns: round(x * 2 * sqrt(2)).
+static void fidtx16_avx2(__m256i *in) {
+  const __m256i k__sqrt2_p2 = _mm256_set1_epi16((int16_t)Sqrt2);
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  int i;
+  for (i = 0; i < 16; ++i) {
+    __m256i lo = _mm256_unpacklo_epi16(in[i], in[i]);
+    __m256i hi = _mm256_unpackhi_epi16(in[i], in[i]);
+    lo = _mm256_madd_epi16(lo, k__sqrt2_p2);
+    hi = _mm256_madd_epi16(hi, k__sqrt2_p2);
+    lo = _mm256_add_epi32(lo, k__DCT_CONST_ROUNDING);
+    hi = _mm256_add_epi32(hi, k__DCT_CONST_ROUNDING);
+    lo = _mm256_srai_epi32(lo, DCT_CONST_BITS);
+    hi = _mm256_srai_epi32(hi, DCT_CONST_BITS);
+    in[i] = _mm256_packs_epi32(lo, hi);
+  }
+}
+#endif  // CONFIG_EXT_TX
+
+static void fdct16x16_avx2(__m256i *in) {
+  fdct16_avx2(in);
+  transpose_16x16_avx2(in);
+}
+
+static void fadst16x16_avx2(__m256i *in) {
+  fadst16_avx2(in);
+  transpose_16x16_avx2(in);
+}
+
+#if CONFIG_EXT_TX
+static void fidtx16x16_avx2(__m256i *in) {
+  fidtx16_avx2(in);
+  transpose_16x16_avx2(in);
+}
+#endif  // CONFIG_EXT_TX
+
+// Computes the 16x16 hybrid transform of input into in, one row per register,
+// for any tx_type but DCT_DCT.
+static void fht16x16_avx2(const int16_t *input, __m256i *in, int stride,
+                          int tx_type) {
+  switch (tx_type) {
+    case ADST_DCT:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fdct16x16_avx2(in);
+      break;
+    case DCT_ADST:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fdct16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+    case ADST_ADST:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+#if CONFIG_EXT_TX
+    case FLIPADST_DCT:
+      load_buffer_16x16_avx2(input, in, stride, 1, 0);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fdct16x16_avx2(in);
+      break;
+    case DCT_FLIPADST:
+      load_buffer_16x16_avx2(input, in, stride, 0, 1);
+      fdct16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+    case FLIPADST_FLIPADST:
+      load_buffer_16x16_avx2(input, in, stride, 1, 1);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+    case ADST_FLIPADST:
+      load_buffer_16x16_avx2(input, in, stride, 0, 1);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+    case FLIPADST_ADST:
+      load_buffer_16x16_avx2(input, in, stride, 1, 0);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+    case IDTX:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fidtx16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fidtx16x16_avx2(in);
+      break;
+    case V_DCT:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fdct16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fidtx16x16_avx2(in);
+      break;
+    case H_DCT:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fidtx16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fdct16x16_avx2(in);
+      break;
+    case V_ADST:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fidtx16x16_avx2(in);
+      break;
+    case H_ADST:
+      load_buffer_16x16_avx2(input, in, stride, 0, 0);
+      fidtx16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+    case V_FLIPADST:
+      load_buffer_16x16_avx2(input, in, stride, 1, 0);
+      fadst16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fidtx16x16_avx2(in);
+      break;
+    case H_FLIPADST:
+      load_buffer_16x16_avx2(input, in, stride, 0, 1);
+      fidtx16x16_avx2(in);
+      right_shift_16x16_avx2(in);
+      fadst16x16_avx2(in);
+      break;
+#endif  // CONFIG_EXT_TX
+    default: assert(0); break;
+  }
+}
+
+void av1_fht16x16_avx2(const int16_t *input, tran_low_t *output, int stride,
+                       int tx_type) {
+  __m256i in[16];
+
+  if (tx_type == DCT_DCT) {
+    aom_fdct16x16(input, output, stride);
+    return;
+  }
+  fht16x16_avx2(input, in, stride, tx_type);
+  write_buffer_16x16_avx2(output, in);
+}
+
+#if !CONFIG_AOM_QM
+int64_t av1_fht16x16_quant_avx2(
+    const int16_t *input, int stride, int tx_type, tran_low_t *coeff_ptr,
+    int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr,
+    const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr,
+    uint16_t *eob_ptr, const int16_t *scan_ptr, const int16_t *iscan_ptr,
+    int64_t *ssz) {
+  const __m256i zero = _mm256_setzero_si256();
+  // Index 0 holds the DC value in its first lane, index 1 only AC values. No
+  // coefficient passes a zbin of INT16_MAX, so a skipped block quantizes to
+  // zeros.
+  const __m128i zbin_dc_ac =
+      skip_block ? _mm_set1_epi16(INT16_MAX)
+                 : _mm_sub_epi16(_mm_load_si128((const __m128i *)zbin_ptr),
+                                 _mm_set1_epi16(1));
+  const __m128i round_dc_ac = _mm_load_si128((const __m128i *)round_ptr);
+  const __m128i quant_dc_ac = _mm_load_si128((const __m128i *)quant_ptr);
+  const __m128i shift_dc_ac = _mm_load_si128((const __m128i *)quant_shift_ptr);
+  const __m128i dequant_dc_ac = _mm_load_si128((const __m128i *)dequant_ptr);
+  __m256i zbin[2], round[2], quant[2], shift[2], dequant[2];
+  __m256i eob = zero, error = zero, sse = zero;
+  __m256i in[16];
+  __m128i eob128, error128, sse128;
+  int64_t error_sum, sse_sum;
+  int i;
+  (void)scan_ptr;
+
+  zbin[1] = _mm256_broadcastsi128_si256(_mm_unpackhi_epi64(zbin_dc_ac,
+                                                           zbin_dc_ac));
+  round[1] = _mm256_broadcastsi128_si256(_mm_unpackhi_epi64(round_dc_ac,
+                                                            round_dc_ac));
+  quant[1] = _mm256_broadcastsi128_si256(_mm_unpackhi_epi64(quant_dc_ac,
+                                                            quant_dc_ac));
+  shift[1] = _mm256_broadcastsi128_si256(_mm_unpackhi_epi64(shift_dc_ac,
+                                                            shift_dc_ac));
+  dequant[1] = _mm256_broadcastsi128_si256(
+      _mm_unpackhi_epi64(dequant_dc_ac, dequant_dc_ac));
+  zbin[0] = _mm256_blend_epi32(_mm256_castsi128_si256(zbin_dc_ac), zbin[1],
+                               0xf0);
+  round[0] = _mm256_blend_epi32(_mm256_castsi128_si256(round_dc_ac), round[1],
+                                0xf0);
+  quant[0] = _mm256_blend_epi32(_mm256_castsi128_si256(quant_dc_ac), quant[1],
+                                0xf0);
+  shift[0] = _mm256_blend_epi32(_mm256_castsi128_si256(shift_dc_ac), shift[1],
+                                0xf0);
+  dequant[0] = _mm256_blend_epi32(_mm256_castsi128_si256(dequant_dc_ac),
+                                  dequant[1], 0xf0);
+
+  if (tx_type == DCT_DCT) {
+    // The DCT passes of the hybrid transforms round differently from
+    // aom_fdct16x16(), so its output is read back.
+    aom_fdct16x16(input, coeff_ptr, stride);
+    for (i = 0; i < 16; ++i) {
+#if CONFIG_AOM_HIGHBITDEPTH
+      const __m256i lo =
+          _mm256_loadu_si256((const __m256i *)(coeff_ptr + i * 16));
+      const __m256i hi =
+          _mm256_loadu_si256((const __m256i *)(coeff_ptr + i * 16 + 8));
+      in[i] = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xd8);
+#else
+      in[i] = _mm256_loadu_si256((const __m256i *)(coeff_ptr + i * 16));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+    }
+  } else {
+    fht16x16_avx2(input, in, stride, tx_type);
+  }
+
+  for (i = 0; i < 16; ++i) {
+    const int ac = i != 0;
+    const __m256i coeff = in[i];
+    const __m256i sign = _mm256_srai_epi16(coeff, 15);
+    const __m256i abs_coeff =
+        _mm256_sub_epi16(_mm256_xor_si256(coeff, sign), sign);
+    const __m256i mask = _mm256_cmpgt_epi16(abs_coeff, zbin[ac]);
+    const __m256i tmp = _mm256_adds_epi16(abs_coeff, round[ac]);
+    const __m256i tmp2 =
+        _mm256_add_epi16(_mm256_mulhi_epi16(tmp, quant[ac]), tmp);
+    __m256i qcoeff = _mm256_mulhi_epi16(tmp2, shift[ac]);
+    __m256i dqcoeff, nzero, iscan, diff, sqr;
+
+    qcoeff = _mm256_sub_epi16(_mm256_xor_si256(qcoeff, sign), sign);
+    qcoeff = _mm256_and_si256(qcoeff, mask);
+    dqcoeff = _mm256_mullo_epi16(qcoeff, dequant[ac]);
+    store_output_avx2(coeff, coeff_ptr + i * 16);
+    store_output_avx2(qcoeff, qcoeff_ptr + i * 16);
+    store_output_avx2(dqcoeff, dqcoeff_ptr + i * 16);
+
+    // Add one to convert from indices to counts
+    nzero = _mm256_cmpeq_epi16(_mm256_cmpeq_epi16(qcoeff, zero), zero);
+    iscan = _mm256_loadu_si256((const __m256i *)(iscan_ptr + i * 16));
+    iscan = _mm256_and_si256(_mm256_sub_epi16(iscan, nzero), nzero);
+    eob = _mm256_max_epi16(eob, iscan);
+
+    // The sums of two squares are below 2^31 and are accumulated unsigned.
+    diff = _mm256_sub_epi16(coeff, dqcoeff);
+    diff = _mm256_madd_epi16(diff, diff);
+    sqr = _mm256_madd_epi16(coeff, coeff);
+    error = _mm256_add_epi64(error, _mm256_unpacklo_epi32(diff, zero));
+    error = _mm256_add_epi64(error, _mm256_unpackhi_epi32(diff, zero));
+    sse = _mm256_add_epi64(sse, _mm256_unpacklo_epi32(sqr, zero));
+    sse = _mm256_add_epi64(sse, _mm256_unpackhi_epi32(sqr, zero));
+  }
+
+  eob128 = _mm_max_epi16(_mm256_castsi256_si128(eob),
+                         _mm256_extracti128_si256(eob, 1));
+  eob128 = _mm_max_epi16(eob128, _mm_shuffle_epi32(eob128, 0xe));
+  eob128 = _mm_max_epi16(eob128, _mm_shufflelo_epi16(eob128, 0xe));
+  eob128 = _mm_max_epi16(eob128, _mm_shufflelo_epi16(eob128, 0x1));
+  *eob_ptr = _mm_extract_epi16(eob128, 0);
+
+  error128 = _mm_add_epi64(_mm256_castsi256_si128(error),
+                           _mm256_extracti128_si256(error, 1));
+  error128 = _mm_add_epi64(error128, _mm_unpackhi_epi64(error128, error128));
+  sse128 = _mm_add_epi64(_mm256_castsi256_si128(sse),
+                         _mm256_extracti128_si256(sse, 1));
+  sse128 = _mm_add_epi64(sse128, _mm_unpackhi_epi64(sse128, sse128));
+  _mm_storel_epi64((__m128i *)&error_sum, error128);
+  _mm_storel_epi64((__m128i *)&sse_sum, sse128);
+  *ssz = sse_sum;
+  return error_sum;
+}
+#endif  // !CONFIG_AOM_QM
@@ -2044,3 +2044,247 @@ void av1_fht16x16_sse2(const int16_t *input, tran_low_t *output, int stride,
     default: assert(0); break;
   }
 }
+
+#if !CONFIG_AOM_QM
+// The aom_quantize_b() parameters held in registers, with the DC value in the
+// first lane of index 0 and only AC values in index 1, and the eob, error and
+// sse accumulated over the block.
+typedef struct {
+  __m128i zbin[2], round[2], quant[2], shift[2], dequant[2];
+  __m128i eob, error, sse;
+} QUANT_B_SSE2;
+
+static INLINE __m128i load_output(const tran_low_t *src) {
+#if CONFIG_AOM_HIGHBITDEPTH
+  return _mm_packs_epi32(_mm_load_si128((const __m128i *)src),
+                         _mm_load_si128((const __m128i *)(src + 4)));
+#else
+  return _mm_load_si128((const __m128i *)src);
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+}
+
+static INLINE void quant_b_init(QUANT_B_SSE2 *q, int skip_block,
+                                const int16_t *zbin_ptr,
+                                const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                const int16_t *quant_shift_ptr,
+                                const int16_t *dequant_ptr) {
+  // No coefficient passes a zbin of INT16_MAX, so a skipped block quantizes
+  // to zeros.
+  q->zbin[0] = skip_block ? _mm_set1_epi16(INT16_MAX)
+                          : _mm_sub_epi16(_mm_load_si128((const __m128i *)
+                                                             zbin_ptr),
+                                          _mm_set1_epi16(1));
+  q->round[0] = _mm_load_si128((const __m128i *)round_ptr);
+  q->quant[0] = _mm_load_si128((const __m128i *)quant_ptr);
+  q->shift[0] = _mm_load_si128((const __m128i *)quant_shift_ptr);
+  q->dequant[0] = _mm_load_si128((const __m128i *)dequant_ptr);
+  q->zbin[1] = _mm_unpackhi_epi64(q->zbin[0], q->zbin[0]);
+  q->round[1] = _mm_unpackhi_epi64(q->round[0], q->round[0]);
+  q->quant[1] = _mm_unpackhi_epi64(q->quant[0], q->quant[0]);
+  q->shift[1] = _mm_unpackhi_epi64(q->shift[0], q->shift[0]);
+  q->dequant[1] = _mm_unpackhi_epi64(q->dequant[0], q->dequant[0]);
+  q->eob = _mm_setzero_si128();
+  q->error = _mm_setzero_si128();
+  q->sse = _mm_setzero_si128();
+}
+
+// Stores the 8 coefficients of coeff at raster position pos of the block with
+// their quantized and dequantized values, and accumulates their eob, error
+// and sse.
+static INLINE void quant_b_8(QUANT_B_SSE2 *q, __m128i coeff, int pos,
+                             const int16_t *iscan_ptr, tran_low_t *coeff_ptr,
+                             tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr) {
+  const __m128i zero = _mm_setzero_si128();
+  const int ac = pos != 0;
+  const __m128i sign = _mm_srai_epi16(coeff, 15);
+  const __m128i abs_coeff = _mm_sub_epi16(_mm_xor_si128(coeff, sign), sign);
+  const __m128i mask = _mm_cmpgt_epi16(abs_coeff, q->zbin[ac]);
+  const __m128i tmp = _mm_adds_epi16(abs_coeff, q->round[ac]);
+  const __m128i tmp2 = _mm_add_epi16(_mm_mulhi_epi16(tmp, q->quant[ac]), tmp);
+  __m128i qcoeff = _mm_mulhi_epi16(tmp2, q->shift[ac]);
+  __m128i dqcoeff, nzero, iscan, diff;
+
+  qcoeff = _mm_sub_epi16(_mm_xor_si128(qcoeff, sign), sign);
+  qcoeff = _mm_and_si128(qcoeff, mask);
+  dqcoeff = _mm_mullo_epi16(qcoeff, q->dequant[ac]);
+  store_output(&coeff, coeff_ptr + pos);
+  store_output(&qcoeff, qcoeff_ptr + pos);
+  store_output(&dqcoeff, dqcoeff_ptr + pos);
+
+  // Add one to convert from indices to counts
+  nzero = _mm_cmpeq_epi16(_mm_cmpeq_epi16(qcoeff, zero), zero);
+  iscan = _mm_load_si128((const __m128i *)(iscan_ptr + pos));
+  iscan = _mm_and_si128(_mm_sub_epi16(iscan, nzero), nzero);
+  q->eob = _mm_max_epi16(q->eob, iscan);
+
+  // The sums of two squares are below 2^31 and are accumulated unsigned.
+  diff = _mm_sub_epi16(coeff, dqcoeff);
+  diff = _mm_madd_epi16(diff, diff);
+  coeff = _mm_madd_epi16(coeff, coeff);
+  q->error = _mm_add_epi64(q->error, _mm_unpacklo_epi32(diff, zero));
+  q->error = _mm_add_epi64(q->error, _mm_unpackhi_epi32(diff, zero));
+  q->sse = _mm_add_epi64(q->sse, _mm_unpacklo_epi32(coeff, zero));
+  q->sse = _mm_add_epi64(q->sse, _mm_unpackhi_epi32(coeff, zero));
+}
+
+static INLINE int64_t quant_b_finish(const QUANT_B_SSE2 *q, uint16_t *eob_ptr,
+                                     int64_t *ssz) {
+  __m128i eob = q->eob;
+  int64_t error, sse;
+  eob = _mm_max_epi16(eob, _mm_shuffle_epi32(eob, 0xe));
+  eob = _mm_max_epi16(eob, _mm_shufflelo_epi16(eob, 0xe));
+  eob = _mm_max_epi16(eob, _mm_shufflelo_epi16(eob, 0x1));
+  *eob_ptr = _mm_extract_epi16(eob, 0);
+  _mm_storel_epi64((__m128i *)&error,
+                   _mm_add_epi64(q->error, _mm_unpackhi_epi64(q->error,
+                                                              q->error)));
+  _mm_storel_epi64((__m128i *)&sse,
+                   _mm_add_epi64(q->sse, _mm_unpackhi_epi64(q->sse, q->sse)));
+  *ssz = sse;
+  return error;
+}
+
+int64_t av1_fht4x4_quant_sse2(const int16_t *input, int stride, int tx_type,
+                              tran_low_t *coeff_ptr, int skip_block,
+                              const int16_t *zbin_ptr, const int16_t *round_ptr,
+                              const int16_t *quant_ptr,
+                              const int16_t *quant_shift_ptr,
+                              tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                              const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                              const int16_t *scan_ptr, const int16_t *iscan_ptr,
+                              int64_t *ssz) {
+  const __m128i kOne = _mm_set1_epi16(1);
+  QUANT_B_SSE2 q;
+  __m128i in[4], out01, out23;
+  (void)scan_ptr;
+
+  load_buffer_4x4(input, in, stride);
+  switch (tx_type) {
+    case DCT_DCT:
+      fdct4_sse2(in);
+      fdct4_sse2(in);
+      break;
+    case ADST_DCT:
+      fadst4_sse2(in);
+      fdct4_sse2(in);
+      break;
+    case DCT_ADST:
+      fdct4_sse2(in);
+      fadst4_sse2(in);
+      break;
+    case ADST_ADST:
+      fadst4_sse2(in);
+      fadst4_sse2(in);
+      break;
+    default: assert(0); break;
+  }
+  out01 = _mm_unpacklo_epi64(in[0], in[1]);
+  out23 = _mm_unpacklo_epi64(in[2], in[3]);
+  out01 = _mm_srai_epi16(_mm_add_epi16(out01, kOne), 2);
+  out23 = _mm_srai_epi16(_mm_add_epi16(out23, kOne), 2);
+
+  quant_b_init(&q, skip_block, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+               dequant_ptr);
+  quant_b_8(&q, out01, 0, iscan_ptr, coeff_ptr, qcoeff_ptr, dqcoeff_ptr);
+  quant_b_8(&q, out23, 8, iscan_ptr, coeff_ptr, qcoeff_ptr, dqcoeff_ptr);
+  return quant_b_finish(&q, eob_ptr, ssz);
+}
+
+int64_t av1_fht8x8_quant_sse2(const int16_t *input, int stride, int tx_type,
+                              tran_low_t *coeff_ptr, int skip_block,
+                              const int16_t *zbin_ptr, const int16_t *round_ptr,
+                              const int16_t *quant_ptr,
+                              const int16_t *quant_shift_ptr,
+                              tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                              const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                              const int16_t *scan_ptr, const int16_t *iscan_ptr,
+                              int64_t *ssz) {
+  QUANT_B_SSE2 q;
+  __m128i in[8];
+  int i;
+  (void)scan_ptr;
+
+  load_buffer_8x8(input, in, stride);
+  switch (tx_type) {
+    case DCT_DCT:
+      fdct8_sse2(in);
+      fdct8_sse2(in);
+      break;
+    case ADST_DCT:
+      fadst8_sse2(in);
+      fdct8_sse2(in);
+      break;
+    case DCT_ADST:
+      fdct8_sse2(in);
+      fadst8_sse2(in);
+      break;
+    case ADST_ADST:
+      fadst8_sse2(in);
+      fadst8_sse2(in);
+      break;
+    default: assert(0); break;
+  }
+  right_shift_8x8(in, 1);
+
+  quant_b_init(&q, skip_block, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+               dequant_ptr);
+  for (i = 0; i < 8; ++i)
+    quant_b_8(&q, in[i], i * 8, iscan_ptr, coeff_ptr, qcoeff_ptr, dqcoeff_ptr);
+  return quant_b_finish(&q, eob_ptr, ssz);
+}
+
+int64_t av1_fht16x16_quant_sse2(
+    const int16_t *input, int stride, int tx_type, tran_low_t *coeff_ptr,
+    int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr,
+    const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr,
+    uint16_t *eob_ptr, const int16_t *scan_ptr, const int16_t *iscan_ptr,
+    int64_t *ssz) {
+  QUANT_B_SSE2 q;
+  __m128i in0[16], in1[16];
+  int i;
+  (void)scan_ptr;
+
+  if (tx_type == DCT_DCT) {
+    // The DCT passes of the hybrid transforms round differently from
+    // aom_fdct16x16(), so its output is read back.
+    aom_fdct16x16_sse2(input, coeff_ptr, stride);
+    for (i = 0; i < 16; ++i) {
+      in0[i] = load_output(coeff_ptr + i * 16);
+      in1[i] = load_output(coeff_ptr + i * 16 + 8);
+    }
+  } else {
+    load_buffer_16x16(input, in0, in1, stride);
+  }
+  switch (tx_type) {
+    case DCT_DCT: break;
+    case ADST_DCT:
+      fadst16_sse2(in0, in1);
+      right_shift_16x16(in0, in1);
+      fdct16_sse2(in0, in1);
+      break;
+    case DCT_ADST:
+      fdct16_sse2(in0, in1);
+      right_shift_16x16(in0, in1);
+      fadst16_sse2(in0, in1);
+      break;
+    case ADST_ADST:
+      fadst16_sse2(in0, in1);
+      right_shift_16x16(in0, in1);
+      fadst16_sse2(in0, in1);
+      break;
+    default: assert(0); break;
+  }
+
+  quant_b_init(&q, skip_block, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+               dequant_ptr);
+  for (i = 0; i < 16; ++i) {
+    quant_b_8(&q, in0[i], i * 16, iscan_ptr, coeff_ptr, qcoeff_ptr,
+              dqcoeff_ptr);
+    quant_b_8(&q, in1[i], i * 16 + 8, iscan_ptr, coeff_ptr, qcoeff_ptr,
+              dqcoeff_ptr);
+  }
+  return quant_b_finish(&q, eob_ptr, ssz);
+}
+#endif  // !CONFIG_AOM_QM
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./av1_rtcd.h"
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/txfm_common.h"
+
+#define HBD_LANES 8
+typedef __m256i hbd_vec;
+
+static INLINE __m256i hbd_add(__m256i a, __m256i b) {
+  return _mm256_add_epi32(a, b);
+}
+
+static INLINE __m256i hbd_sub(__m256i a, __m256i b) {
+  return _mm256_sub_epi32(a, b);
+}
+
+static INLINE __m256i hbd_neg(__m256i a) {
+  return _mm256_sub_epi32(_mm256_setzero_si256(), a);
+}
+
+static INLINE __m256i hbd_set1(int a) { return _mm256_set1_epi32(a); }
+
+static INLINE __m256i hbd_slli(__m256i a, int bits) {
+  return _mm256_slli_epi32(a, bits);
+}
+
+static INLINE __m256i hbd_srai(__m256i a, int bits) {
+  return _mm256_srai_epi32(a, bits);
+}
+
+static INLINE __m256i hbd_load(const int16_t *src, int reverse) {
+  const __m256i a =
+      _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)src));
+  return reverse
+             ? _mm256_permutevar8x32_epi32(
+                   a, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0))
+             : a;
+}
+
+static INLINE void hbd_store(tran_low_t *dst, __m256i a) {
+  _mm256_storeu_si256((__m256i *)dst, a);
+}
+
+static INLINE void hbd_mul_wide(__m256i a, int c, __m256i *w) {
+  const __m256i k = _mm256_set1_epi32(c);
+  w[0] = _mm256_mul_epi32(a, k);
+  w[1] = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), k);
+}
+
+static INLINE void hbd_add_wide(const __m256i *a, const __m256i *b,
+                                __m256i *w) {
+  w[0] = _mm256_add_epi64(a[0], b[0]);
+  w[1] = _mm256_add_epi64(a[1], b[1]);
+}
+
+static INLINE void hbd_sub_wide(const __m256i *a, const __m256i *b,
+                                __m256i *w) {
+  w[0] = _mm256_sub_epi64(a[0], b[0]);
+  w[1] = _mm256_sub_epi64(a[1], b[1]);
+}
+
+static INLINE __m256i hbd_round_shift_wide(const __m256i *w) {
+  // Only the low 32 bits of the shifted values are kept, so a logical shift
+  // is as good as an arithmetic one.
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi64x(DCT_CONST_ROUNDING);
+  const __m256i even =
+      _mm256_srli_epi64(_mm256_add_epi64(w[0], k__DCT_CONST_ROUNDING),
+                        DCT_CONST_BITS);
+  const __m256i odd = _mm256_slli_epi64(
+      _mm256_add_epi64(w[1], k__DCT_CONST_ROUNDING), 32 - DCT_CONST_BITS);
+  return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+static INLINE void hbd_transpose(const __m256i *in, __m256i *out) {
+  // Transposes the 4x4 blocks in each 128-bit lane, then exchanges the
+  // upper right and lower left blocks.
+  __m256i t[8], u[8];
+  int i;
+  for (i = 0; i < 8; i += 4) {
+    const __m256i t0 = _mm256_unpacklo_epi32(in[i + 0], in[i + 1]);
+    const __m256i t1 = _mm256_unpacklo_epi32(in[i + 2], in[i + 3]);
+    const __m256i t2 = _mm256_unpackhi_epi32(in[i + 0], in[i + 1]);
+    const __m256i t3 = _mm256_unpackhi_epi32(in[i + 2], in[i + 3]);
+    t[i + 0] = _mm256_unpacklo_epi64(t0, t1);
+    t[i + 1] = _mm256_unpackhi_epi64(t0, t1);
+    t[i + 2] = _mm256_unpacklo_epi64(t2, t3);
+    t[i + 3] = _mm256_unpackhi_epi64(t2, t3);
+  }
+  for (i = 0; i < 4; ++i) {
+    u[i] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x20);
+    u[i + 4] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x31);
+  }
+  for (i = 0; i < 8; ++i) out[i] = u[i];
+}
+
+#include "av1/encoder/x86/highbd_dct_intrin_impl.h"
+
+void av1_highbd_fht8x8_avx2(const int16_t *input, tran_low_t *output,
+                            int stride, int tx_type) {
+  if (tx_type == DCT_DCT)
+    aom_highbd_fdct8x8(input, output, stride);
+  else
+    hbd_fht(input, output, stride, tx_type, 8, &HBD_FHT_8[tx_type]);
+}
+
+void av1_highbd_fht16x16_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  if (tx_type == DCT_DCT)
+    aom_highbd_fdct16x16(input, output, stride);
+  else
+    hbd_fht(input, output, stride, tx_type, 16, &HBD_FHT_16[tx_type]);
+}
@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+// High bitdepth hybrid forward transforms, shared by the SSE4.1 and AVX2
+// versions. The residuals of 12 bit video need 64 bit products, so the
+// transforms follow the C code of av1/encoder/dct.c step by step on 32 bit
+// lanes, widening each product and rounding back like fdct_round_shift().
+// Their output is the same as that of the C code.
+//
+// The including file defines HBD_LANES, the number of 32 bit lanes of a
+// register, the hbd_vec type and these operations on it:
+//   hbd_vec hbd_add(hbd_vec a, hbd_vec b);
+//   hbd_vec hbd_sub(hbd_vec a, hbd_vec b);
+//   hbd_vec hbd_neg(hbd_vec a);
+//   hbd_vec hbd_set1(int a);
+//   hbd_vec hbd_slli(hbd_vec a, int bits);
+//   hbd_vec hbd_srai(hbd_vec a, int bits);
+//   // Sign extends HBD_LANES values from src, in reverse order if reverse.
+//   hbd_vec hbd_load(const int16_t *src, int reverse);
+//   void hbd_store(tran_low_t *dst, hbd_vec a);
+//   // 64 bit products of the lanes of a with c, of the even lanes in w[0]
+//   // and of the odd lanes in w[1].
+//   void hbd_mul_wide(hbd_vec a, int c, hbd_vec *w);
+//   void hbd_add_wide(const hbd_vec *a, const hbd_vec *b, hbd_vec *w);
+//   void hbd_sub_wide(const hbd_vec *a, const hbd_vec *b, hbd_vec *w);
+//   // fdct_round_shift() of a wide value, back to 32 bit lanes.
+//   hbd_vec hbd_round_shift_wide(const hbd_vec *w);
+//   // Transposes a HBD_LANES x HBD_LANES block of registers.
+//   void hbd_transpose(const hbd_vec *in, hbd_vec *out);
+// and, when HBD_LANES is 4, to add the bias of the 4x4 transform:
+//   hbd_vec hbd_set_lane0(int a);
+
+#ifndef AV1_ENCODER_X86_HIGHBD_DCT_INTRIN_IMPL_H_
+#define AV1_ENCODER_X86_HIGHBD_DCT_INTRIN_IMPL_H_
+
+#include <assert.h>
+
+#include "./aom_config.h"
+#include "aom_dsp/txfm_common.h"
+#include "av1/common/enums.h"
+
+typedef void (*hbd_transform_1d)(const hbd_vec *in, hbd_vec *out);
+
+typedef struct {
+  hbd_transform_1d cols, rows;
+} hbd_transform_2d;
+
+// a * c0 + b * c1 in 64 bits.
+static INLINE void hbd_mul2_wide(hbd_vec a, int c0, hbd_vec b, int c1,
+                                 hbd_vec *w) {
+  hbd_vec t[2];
+  hbd_mul_wide(a, c0, w);
+  hbd_mul_wide(b, c1, t);
+  hbd_add_wide(w, t, w);
+}
+
+// fdct_round_shift(a * c0 + b * c1).
+static INLINE hbd_vec hbd_butterfly(hbd_vec a, int c0, hbd_vec b, int c1) {
+  hbd_vec w[2];
+  hbd_mul2_wide(a, c0, b, c1, w);
+  return hbd_round_shift_wide(w);
+}
+
+// fdct_round_shift(a * c).
+static INLINE hbd_vec hbd_mul_round(hbd_vec a, int c) {
+  hbd_vec w[2];
+  hbd_mul_wide(a, c, w);
+  return hbd_round_shift_wide(w);
+}
+
+// fdct_round_shift(a + b) and fdct_round_shift(a - b) of wide values.
+static INLINE void hbd_round_add_sub(const hbd_vec *a, const hbd_vec *b,
+                                     hbd_vec *sum, hbd_vec *diff) {
+  hbd_vec w[2];
+  hbd_add_wide(a, b, w);
+  *sum = hbd_round_shift_wide(w);
+  hbd_sub_wide(a, b, w);
+  *diff = hbd_round_shift_wide(w);
+}
+
+#if HBD_LANES == 4
+static void hbd_fdct4(const hbd_vec *in, hbd_vec *out) {
+  const int c8 = (int)cospi_8_64;
+  const int c16 = (int)cospi_16_64;
+  const int c24 = (int)cospi_24_64;
+  const hbd_vec s0 = hbd_add(in[0], in[3]);
+  const hbd_vec s1 = hbd_add(in[1], in[2]);
+  const hbd_vec s2 = hbd_sub(in[1], in[2]);
+  const hbd_vec s3 = hbd_sub(in[0], in[3]);
+
+  out[0] = hbd_butterfly(s0, c16, s1, c16);
+  out[1] = hbd_butterfly(s2, c24, s3, c8);
+  out[2] = hbd_butterfly(s1, -c16, s0, c16);
+  out[3] = hbd_butterfly(s3, c24, s2, -c8);
+}
+
+static void hbd_fadst4(const hbd_vec *in, hbd_vec *out) {
+  hbd_vec s0[2], s1[2], s2[2], s3[2], s4[2], s5[2], s6[2];
+  hbd_vec x0[2], x1[2], x2[2], t[2];
+  const hbd_vec s7 = hbd_sub(hbd_add(in[0], in[1]), in[3]);
+
+  hbd_mul_wide(in[0], (int)sinpi_1_9, s0);
+  hbd_mul_wide(in[0], (int)sinpi_4_9, s1);
+  hbd_mul_wide(in[1], (int)sinpi_2_9, s2);
+  hbd_mul_wide(in[1], (int)sinpi_1_9, s3);
+  hbd_mul_wide(in[2], (int)sinpi_3_9, s4);
+  hbd_mul_wide(in[3], (int)sinpi_4_9, s5);
+  hbd_mul_wide(in[3], (int)sinpi_2_9, s6);
+
+  hbd_add_wide(s0, s2, x0);
+  hbd_add_wide(x0, s5, x0);
+  hbd_mul_wide(s7, (int)sinpi_3_9, x1);
+  hbd_sub_wide(s1, s3, x2);
+  hbd_add_wide(x2, s6, x2);
+
+  hbd_add_wide(x0, s4, t);
+  out[0] = hbd_round_shift_wide(t);
+  out[1] = hbd_round_shift_wide(x1);
+  hbd_sub_wide(x2, s4, t);
+  out[2] = hbd_round_shift_wide(t);
+  hbd_sub_wide(x2, x0, t);
+  hbd_add_wide(t, s4, t);
+  out[3] = hbd_round_shift_wide(t);
+}
+#endif  // HBD_LANES == 4
+
+static void hbd_fdct8(const hbd_vec *in, hbd_vec *out) {
+  const int c4 = (int)cospi_4_64;
+  const int c8 = (int)cospi_8_64;
+  const int c12 = (int)cospi_12_64;
+  const int c16 = (int)cospi_16_64;
+  const int c20 = (int)cospi_20_64;
+  const int c24 = (int)cospi_24_64;
+  const int c28 = (int)cospi_28_64;
+  hbd_vec s[8], x[8], y[8];
+
+  // stage 1
+  s[0] = hbd_add(in[0], in[7]);
+  s[1] = hbd_add(in[1], in[6]);
+  s[2] = hbd_add(in[2], in[5]);
+  s[3] = hbd_add(in[3], in[4]);
+  s[4] = hbd_sub(in[3], in[4]);
+  s[5] = hbd_sub(in[2], in[5]);
+  s[6] = hbd_sub(in[1], in[6]);
+  s[7] = hbd_sub(in[0], in[7]);
+
+  // stage 2
+  x[0] = hbd_add(s[0], s[3]);
+  x[1] = hbd_add(s[1], s[2]);
+  x[2] = hbd_sub(s[1], s[2]);
+  x[3] = hbd_sub(s[0], s[3]);
+  x[5] = hbd_butterfly(s[5], -c16, s[6], c16);
+  x[6] = hbd_butterfly(s[6], c16, s[5], c16);
+
+  // stage 3
+  out[0] = hbd_butterfly(x[0], c16, x[1], c16);
+  out[4] = hbd_butterfly(x[1], -c16, x[0], c16);
+  out[2] = hbd_butterfly(x[2], c24, x[3], c8);
+  out[6] = hbd_butterfly(x[3], c24, x[2], -c8);
+  y[4] = hbd_add(s[4], x[5]);
+  y[5] = hbd_sub(s[4], x[5]);
+  y[6] = hbd_sub(s[7], x[6]);
+  y[7] = hbd_add(s[7], x[6]);
+
+  // stage 4
+  out[1] = hbd_butterfly(y[4], c28, y[7], c4);
+  out[5] = hbd_butterfly(y[5], c12, y[6], c20);
+  out[3] = hbd_butterfly(y[6], c12, y[5], -c20);
+  out[7] = hbd_butterfly(y[7], c28, y[4], -c4);
+}
+
+static void hbd_fadst8(const hbd_vec *in, hbd_vec *out) {
+  const int c8 = (int)cospi_8_64;
+  const int c16 = (int)cospi_16_64;
+  const int c24 = (int)cospi_24_64;
+  hbd_vec s0[2], s1[2], s2[2], s3[2], s4[2], s5[2], s6[2], s7[2];
+  hbd_vec x0, x1, x2, x3, x4, x5, x6, x7;
+
+  // stage 1
+  hbd_mul2_wide(in[7], (int)cospi_2_64, in[0], (int)cospi_30_64, s0);
+  hbd_mul2_wide(in[7], (int)cospi_30_64, in[0], -(int)cospi_2_64, s1);
+  hbd_mul2_wide(in[5], (int)cospi_10_64, in[2], (int)cospi_22_64, s2);
+  hbd_mul2_wide(in[5], (int)cospi_22_64, in[2], -(int)cospi_10_64, s3);
+  hbd_mul2_wide(in[3], (int)cospi_18_64, in[4], (int)cospi_14_64, s4);
+  hbd_mul2_wide(in[3], (int)cospi_14_64, in[4], -(int)cospi_18_64, s5);
+  hbd_mul2_wide(in[1], (int)cospi_26_64, in[6], (int)cospi_6_64, s6);
+  hbd_mul2_wide(in[1], (int)cospi_6_64, in[6], -(int)cospi_26_64, s7);
+
+  hbd_round_add_sub(s0, s4, &x0, &x4);
+  hbd_round_add_sub(s1, s5, &x1, &x5);
+  hbd_round_add_sub(s2, s6, &x2, &x6);
+  hbd_round_add_sub(s3, s7, &x3, &x7);
+
+  // stage 2
+  hbd_mul2_wide(x4, c8, x5, c24, s4);
+  hbd_mul2_wide(x4, c24, x5, -c8, s5);
+  hbd_mul2_wide(x6, -c24, x7, c8, s6);
+  hbd_mul2_wide(x6, c8, x7, c24, s7);
+
+  out[0] = hbd_add(x0, x2);
+  out[7] = hbd_neg(hbd_add(x1, x3));
+  x2 = hbd_sub(x0, x2);
+  x3 = hbd_sub(x1, x3);
+  hbd_round_add_sub(s4, s6, &x4, &x6);
+  hbd_round_add_sub(s5, s7, &x5, &x7);
+
+  // stage 3
+  out[1] = hbd_neg(x4);
+  out[2] = hbd_mul_round(hbd_add(x6, x7), c16);
+  out[3] = hbd_neg(hbd_mul_round(hbd_add(x2, x3), c16));
+  out[4] = hbd_mul_round(hbd_sub(x2, x3), c16);
+  out[5] = hbd_neg(hbd_mul_round(hbd_sub(x6, x7), c16));
+  out[6] = x5;
+}
+
+static void hbd_fdct16(const hbd_vec *in, hbd_vec *out) {
+  const int c4 = (int)cospi_4_64;
+  const int c8 = (int)cospi_8_64;
+  const int c12 = (int)cospi_12_64;
+  const int c16 = (int)cospi_16_64;
+  const int c20 = (int)cospi_20_64;
+  const int c24 = (int)cospi_24_64;
+  const int c28 = (int)cospi_28_64;
+  hbd_vec input[8], step1[8], step2[8], step3[8];
+  int i;
+
+  // step 1
+  for (i = 0; i < 8; ++i) {
+    input[i] = hbd_add(in[i], in[15 - i]);
+    step1[i] = hbd_sub(in[7 - i], in[8 + i]);
+  }
+
+  // fdct8(step, step);
+  {
+    hbd_vec s0, s1, s2, s3, s4, s5, s6, s7;
+    hbd_vec t2, t3;
+    hbd_vec x0, x1, x2, x3;
+
+    // stage 1
+    s0 = hbd_add(input[0], input[7]);
+    s1 = hbd_add(input[1], input[6]);
+    s2 = hbd_add(input[2], input[5]);
+    s3 = hbd_add(input[3], input[4]);
+    s4 = hbd_sub(input[3], input[4]);
+    s5 = hbd_sub(input[2], input[5]);
+    s6 = hbd_sub(input[1], input[6]);
+    s7 = hbd_sub(input[0], input[7]);
+
+    // fdct4(step, step);
+    x0 = hbd_add(s0, s3);
+    x1 = hbd_add(s1, s2);
+    x2 = hbd_sub(s1, s2);
+    x3 = hbd_sub(s0, s3);
+    out[0] = hbd_mul_round(hbd_add(x0, x1), c16);
+    out[4] = hbd_butterfly(x3, c8, x2, c24);
+    out[8] = hbd_mul_round(hbd_sub(x0, x1), c16);
+    out[12] = hbd_butterfly(x3, c24, x2, -c8);
+
+    // Stage 2
+    t2 = hbd_mul_round(hbd_sub(s6, s5), c16);
+    t3 = hbd_mul_round(hbd_add(s6, s5), c16);
+
+    // Stage 3
+    x0 = hbd_add(s4, t2);
+    x1 = hbd_sub(s4, t2);
+    x2 = hbd_sub(s7, t3);
+    x3 = hbd_add(s7, t3);
+
+    // Stage 4
+    out[2] = hbd_butterfly(x0, c28, x3, c4);
+    out[6] = hbd_butterfly(x2, c12, x1, -c20);
+    out[10] = hbd_butterfly(x1, c12, x2, c20);
+    out[14] = hbd_butterfly(x3, c28, x0, -c4);
+  }
+
+  // step 2
+  step2[2] = hbd_mul_round(hbd_sub(step1[5], step1[2]), c16);
+  step2[3] = hbd_mul_round(hbd_sub(step1[4], step1[3]), c16);
+  step2[4] = hbd_mul_round(hbd_add(step1[4], step1[3]), c16);
+  step2[5] = hbd_mul_round(hbd_add(step1[5], step1[2]), c16);
+
+  // step 3
+  step3[0] = hbd_add(step1[0], step2[3]);
+  step3[1] = hbd_add(step1[1], step2[2]);
+  step3[2] = hbd_sub(step1[1], step2[2]);
+  step3[3] = hbd_sub(step1[0], step2[3]);
+  step3[4] = hbd_sub(step1[7], step2[4]);
+  step3[5] = hbd_sub(step1[6], step2[5]);
+  step3[6] = hbd_add(step1[6], step2[5]);
+  step3[7] = hbd_add(step1[7], step2[4]);
+
+  // step 4
+  step2[1] = hbd_butterfly(step3[1], -c8, step3[6], c24);
+  step2[2] = hbd_butterfly(step3[2], c24, step3[5], c8);
+  step2[5] = hbd_butterfly(step3[2], c8, step3[5], -c24);
+  step2[6] = hbd_butterfly(step3[1], c24, step3[6], c8);
+
+  // step 5
+  step1[0] = hbd_add(step3[0], step2[1]);
+  step1[1] = hbd_sub(step3[0], step2[1]);
+  step1[2] = hbd_add(step3[3], step2[2]);
+  step1[3] = hbd_sub(step3[3], step2[2]);
+  step1[4] = hbd_sub(step3[4], step2[5]);
+  step1[5] = hbd_add(step3[4], step2[5]);
+  step1[6] = hbd_sub(step3[7], step2[6]);
+  step1[7] = hbd_add(step3[7], step2[6]);
+
+  // step 6
+  out[1] = hbd_butterfly(step1[0], (int)cospi_30_64, step1[7], (int)cospi_2_64);
+  out[9] =
+      hbd_butterfly(step1[1], (int)cospi_14_64, step1[6], (int)cospi_18_64);
+  out[5] =
+      hbd_butterfly(step1[2], (int)cospi_22_64, step1[5], (int)cospi_10_64);
+  out[13] =
+      hbd_butterfly(step1[3], (int)cospi_6_64, step1[4], (int)cospi_26_64);
+  out[3] =
+      hbd_butterfly(step1[3], -(int)cospi_26_64, step1[4], (int)cospi_6_64);
+  out[11] =
+      hbd_butterfly(step1[2], -(int)cospi_10_64, step1[5], (int)cospi_22_64);
+  out[7] =
+      hbd_butterfly(step1[1], -(int)cospi_18_64, step1[6], (int)cospi_14_64);
+  out[15] =
+      hbd_butterfly(step1[0], -(int)cospi_2_64, step1[7], (int)cospi_30_64);
+}
+
+static void hbd_fadst16(const hbd_vec *in, hbd_vec *out) {
+  const int c4 = (int)cospi_4_64;
+  const int c8 = (int)cospi_8_64;
+  const int c12 = (int)cospi_12_64;
+  const int c16 = (int)cospi_16_64;
+  const int c20 = (int)cospi_20_64;
+  const int c24 = (int)cospi_24_64;
+  const int c28 = (int)cospi_28_64;
+  hbd_vec s[16][2];
+  hbd_vec x[16];
+  int i;
+
+  // stage 1
+  hbd_mul2_wide(in[15], (int)cospi_1_64, in[0], (int)cospi_31_64, s[0]);
+  hbd_mul2_wide(in[15], (int)cospi_31_64, in[0], -(int)cospi_1_64, s[1]);
+  hbd_mul2_wide(in[13], (int)cospi_5_64, in[2], (int)cospi_27_64, s[2]);
+  hbd_mul2_wide(in[13], (int)cospi_27_64, in[2], -(int)cospi_5_64, s[3]);
+  hbd_mul2_wide(in[11], (int)cospi_9_64, in[4], (int)cospi_23_64, s[4]);
+  hbd_mul2_wide(in[11], (int)cospi_23_64, in[4], -(int)cospi_9_64, s[5]);
+  hbd_mul2_wide(in[9], (int)cospi_13_64, in[6], (int)cospi_19_64, s[6]);
+  hbd_mul2_wide(in[9], (int)cospi_19_64, in[6], -(int)cospi_13_64, s[7]);
+  hbd_mul2_wide(in[7], (int)cospi_17_64, in[8], (int)cospi_15_64, s[8]);
+  hbd_mul2_wide(in[7], (int)cospi_15_64, in[8], -(int)cospi_17_64, s[9]);
+  hbd_mul2_wide(in[5], (int)cospi_21_64, in[10], (int)cospi_11_64, s[10]);
+  hbd_mul2_wide(in[5], (int)cospi_11_64, in[10], -(int)cospi_21_64, s[11]);
+  hbd_mul2_wide(in[3], (int)cospi_25_64, in[12], (int)cospi_7_64, s[12]);
+  hbd_mul2_wide(in[3], (int)cospi_7_64, in[12], -(int)cospi_25_64, s[13]);
+  hbd_mul2_wide(in[1], (int)cospi_29_64, in[14], (int)cospi_3_64, s[14]);
+  hbd_mul2_wide(in[1], (int)cospi_3_64, in[14], -(int)cospi_29_64, s[15]);
+
+  for (i = 0; i < 8; ++i) hbd_round_add_sub(s[i], s[i + 8], &x[i], &x[i + 8]);
+
+  // stage 2
+  hbd_mul2_wide(x[8], c4, x[9], c28, s[8]);
+  hbd_mul2_wide(x[8], c28, x[9], -c4, s[9]);
+  hbd_mul2_wide(x[10], c20, x[11], c12, s[10]);
+  hbd_mul2_wide(x[10], c12, x[11], -c20, s[11]);
+  hbd_mul2_wide(x[12], -c28, x[13], c4, s[12]);
+  hbd_mul2_wide(x[12], c4, x[13], c28, s[13]);
+  hbd_mul2_wide(x[14], -c12, x[15], c20, s[14]);
+  hbd_mul2_wide(x[14], c20, x[15], c12, s[15]);
+
+  for (i = 0; i < 4; ++i) {
+    const hbd_vec t = x[i];
+    x[i] = hbd_add(t, x[i + 4]);
+    x[i + 4] = hbd_sub(t, x[i + 4]);
+    hbd_round_add_sub(s[i + 8], s[i + 12], &x[i + 8], &x[i + 12]);
+  }
+
+  // stage 3
+  hbd_mul2_wide(x[4], c8, x[5], c24, s[4]);
+  hbd_mul2_wide(x[4], c24, x[5], -c8, s[5]);
+  hbd_mul2_wide(x[6], -c24, x[7], c8, s[6]);
+  hbd_mul2_wide(x[6], c8, x[7], c24, s[7]);
+  hbd_mul2_wide(x[12], c8, x[13], c24, s[12]);
+  hbd_mul2_wide(x[12], c24, x[13], -c8, s[13]);
+  hbd_mul2_wide(x[14], -c24, x[15], c8, s[14]);
+  hbd_mul2_wide(x[14], c8, x[15], c24, s[15]);
+
+  for (i = 0; i < 2; ++i) {
+    hbd_vec t = x[i];
+    x[i] = hbd_add(t, x[i + 2]);
+    x[i + 2] = hbd_sub(t, x[i + 2]);
+    hbd_round_add_sub(s[i + 4], s[i + 6], &x[i + 4], &x[i + 6]);
+    t = x[i + 8];
+    x[i + 8] = hbd_add(t, x[i + 10]);
+    x[i + 10] = hbd_sub(t, x[i + 10]);
+    hbd_round_add_sub(s[i + 12], s[i + 14], &x[i + 12], &x[i + 14]);
+  }
+
+  // stage 4
+  out[0] = x[0];
+  out[1] = hbd_neg(x[8]);
+  out[2] = x[12];
+  out[3] = hbd_neg(x[4]);
+  out[4] = hbd_mul_round(hbd_add(x[6], x[7]), c16);
+  out[5] = hbd_mul_round(hbd_add(x[14], x[15]), -c16);
+  out[6] = hbd_mul_round(hbd_add(x[10], x[11]), c16);
+  out[7] = hbd_mul_round(hbd_add(x[2], x[3]), -c16);
+  out[8] = hbd_mul_round(hbd_sub(x[2], x[3]), c16);
+  out[9] = hbd_mul_round(hbd_sub(x[11], x[10]), c16);
+  out[10] = hbd_mul_round(hbd_sub(x[14], x[15]), c16);
+  out[11] = hbd_mul_round(hbd_sub(x[7], x[6]), c16);
+  out[12] = x[5];
+  out[13] = hbd_neg(x[13]);
+  out[14] = x[9];
+  out[15] = hbd_neg(x[1]);
+}
+
+#if CONFIG_EXT_TX
+#if HBD_LANES == 4
+static void hbd_fidtx4(const hbd_vec *in, hbd_vec *out) {
+  int i;
+  for (i = 0; i < 4; ++i) out[i] = hbd_mul_round(in[i], (int)Sqrt2);
+}
+#endif  // HBD_LANES == 4
+
+static void hbd_fidtx8(const hbd_vec *in, hbd_vec *out) {
+  int i;
+  for (i = 0; i < 8; ++i) out[i] = hbd_add(in[i], in[i]);
+}
+
+static void hbd_fidtx16(const hbd_vec *in, hbd_vec *out) {
+  int i;
+  for (i = 0; i < 16; ++i) out[i] = hbd_mul_round(in[i], 2 * (int)Sqrt2);
+}
+#endif  // CONFIG_EXT_TX
+
+#if HBD_LANES == 4
+static const hbd_transform_2d HBD_FHT_4[] = {
+  { hbd_fdct4, hbd_fdct4 },    // DCT_DCT  = 0
+  { hbd_fadst4, hbd_fdct4 },   // ADST_DCT = 1
+  { hbd_fdct4, hbd_fadst4 },   // DCT_ADST = 2
+  { hbd_fadst4, hbd_fadst4 },  // ADST_ADST = 3
+#if CONFIG_EXT_TX
+  { hbd_fadst4, hbd_fdct4 },   // FLIPADST_DCT = 4
+  { hbd_fdct4, hbd_fadst4 },   // DCT_FLIPADST = 5
+  { hbd_fadst4, hbd_fadst4 },  // FLIPADST_FLIPADST = 6
+  { hbd_fadst4, hbd_fadst4 },  // ADST_FLIPADST = 7
+  { hbd_fadst4, hbd_fadst4 },  // FLIPADST_ADST = 8
+  { hbd_fidtx4, hbd_fidtx4 },  // IDTX = 9
+  { hbd_fdct4, hbd_fidtx4 },   // V_DCT = 10
+  { hbd_fidtx4, hbd_fdct4 },   // H_DCT = 11
+  { hbd_fadst4, hbd_fidtx4 },  // V_ADST = 12
+  { hbd_fidtx4, hbd_fadst4 },  // H_ADST = 13
+  { hbd_fadst4, hbd_fidtx4 },  // V_FLIPADST = 14
+  { hbd_fidtx4, hbd_fadst4 },  // H_FLIPADST = 15
+#endif                         // CONFIG_EXT_TX
+};
+#endif  // HBD_LANES == 4
+
+static const hbd_transform_2d HBD_FHT_8[] = {
+  { hbd_fdct8, hbd_fdct8 },    // DCT_DCT  = 0
+  { hbd_fadst8, hbd_fdct8 },   // ADST_DCT = 1
+  { hbd_fdct8, hbd_fadst8 },   // DCT_ADST = 2
+  { hbd_fadst8, hbd_fadst8 },  // ADST_ADST = 3
+#if CONFIG_EXT_TX
+  { hbd_fadst8, hbd_fdct8 },   // FLIPADST_DCT = 4
+  { hbd_fdct8, hbd_fadst8 },   // DCT_FLIPADST = 5
+  { hbd_fadst8, hbd_fadst8 },  // FLIPADST_FLIPADST = 6
+  { hbd_fadst8, hbd_fadst8 },  // ADST_FLIPADST = 7
+  { hbd_fadst8, hbd_fadst8 },  // FLIPADST_ADST = 8
+  { hbd_fidtx8, hbd_fidtx8 },  // IDTX = 9
+  { hbd_fdct8, hbd_fidtx8 },   // V_DCT = 10
+  { hbd_fidtx8, hbd_fdct8 },   // H_DCT = 11
+  { hbd_fadst8, hbd_fidtx8 },  // V_ADST = 12
+  { hbd_fidtx8, hbd_fadst8 },  // H_ADST = 13
+  { hbd_fadst8, hbd_fidtx8 },  // V_FLIPADST = 14
+  { hbd_fidtx8, hbd_fadst8 },  // H_FLIPADST = 15
+#endif                         // CONFIG_EXT_TX
+};
+
+static const hbd_transform_2d HBD_FHT_16[] = {
+  { hbd_fdct16, hbd_fdct16 },    // DCT_DCT  = 0
+  { hbd_fadst16, hbd_fdct16 },   // ADST_DCT = 1
+  { hbd_fdct16, hbd_fadst16 },   // DCT_ADST = 2
+  { hbd_fadst16, hbd_fadst16 },  // ADST_ADST = 3
+#if CONFIG_EXT_TX
+  { hbd_fadst16, hbd_fdct16 },   // FLIPADST_DCT = 4
+  { hbd_fdct16, hbd_fadst16 },   // DCT_FLIPADST = 5
+  { hbd_fadst16, hbd_fadst16 },  // FLIPADST_FLIPADST = 6
+  { hbd_fadst16, hbd_fadst16 },  // ADST_FLIPADST = 7
+  { hbd_fadst16, hbd_fadst16 },  // FLIPADST_ADST = 8
+  { hbd_fidtx16, hbd_fidtx16 },  // IDTX = 9
+  { hbd_fdct16, hbd_fidtx16 },   // V_DCT = 10
+  { hbd_fidtx16, hbd_fdct16 },   // H_DCT = 11
+  { hbd_fadst16, hbd_fidtx16 },  // V_ADST = 12
+  { hbd_fidtx16, hbd_fadst16 },  // H_ADST = 13
+  { hbd_fadst16, hbd_fidtx16 },  // V_FLIPADST = 14
+  { hbd_fidtx16, hbd_fadst16 },  // H_FLIPADST = 15
+#endif                           // CONFIG_EXT_TX
+};
+
+// A block of n x n coefficients is held in n * n / HBD_LANES registers,
+// buf[g * n + r] holding the HBD_LANES columns of group g in row r, so that
+// the 1-D transforms of the columns of a group read consecutive registers.
+static void hbd_transpose_block(const hbd_vec *in, hbd_vec *out, int n) {
+  int g, h;
+  for (g = 0; g < n; g += HBD_LANES)
+    for (h = 0; h < n; h += HBD_LANES)
+      hbd_transpose(in + g * n / HBD_LANES + h, out + h * n / HBD_LANES + g);
+}
+
+static void hbd_load_block(const int16_t *input, int stride, hbd_vec *buf,
+                           int n, int tx_type, int shift) {
+  hbd_vec *const buf0 = buf;
+  int flipud = 0, fliplr = 0;
+  int g, r;
+#if CONFIG_EXT_TX
+  switch (tx_type) {
+    case FLIPADST_DCT:
+    case FLIPADST_ADST:
+    case V_FLIPADST: flipud = 1; break;
+    case DCT_FLIPADST:
+    case ADST_FLIPADST:
+    case H_FLIPADST: fliplr = 1; break;
+    case FLIPADST_FLIPADST:
+      flipud = 1;
+      fliplr = 1;
+      break;
+    default: break;
+  }
+#else
+  (void)tx_type;
+#endif  // CONFIG_EXT_TX
+  if (flipud) {
+    input += (n - 1) * stride;
+    stride = -stride;
+  }
+  for (g = 0; g < n; g += HBD_LANES) {
+    const int16_t *src = input + (fliplr ? n - HBD_LANES - g : g);
+    for (r = 0; r < n; ++r)
+      *buf++ = hbd_slli(hbd_load(src + r * stride, fliplr), shift);
+  }
+#if HBD_LANES == 4
+  // The 4x4 transform adds 1 to its first input when it is not 0.
+  if (n == 4 && input[fliplr ? n - 1 : 0])
+    buf0[0] = hbd_add(buf0[0], hbd_set_lane0(1));
+#else
+  (void)buf0;
+#endif  // HBD_LANES == 4
+}
+
+static void hbd_store_block(const hbd_vec *buf, tran_low_t *output, int n) {
+  int g, r;
+  for (g = 0; g < n; g += HBD_LANES)
+    for (r = 0; r < n; ++r) hbd_store(output + r * n + g, *buf++);
+}
+
+// (x + 1 + (x < 0)) >> 2, as between the passes of the 16x16 transform.
+static INLINE hbd_vec hbd_round_shift_2(hbd_vec x) {
+  const hbd_vec x1 = hbd_sub(hbd_add(x, hbd_set1(1)), hbd_srai(x, 31));
+  return hbd_srai(x1, 2);
+}
+
+static void hbd_fht(const int16_t *input, tran_low_t *output, int stride,
+                    int tx_type, int n, const hbd_transform_2d *ht) {
+  hbd_vec buf0[16 * 16 / HBD_LANES], buf1[16 * 16 / HBD_LANES];
+  const int num = n * n / HBD_LANES;
+  int i;
+
+  hbd_load_block(input, stride, buf0, n, tx_type, n == 4 ? 4 : 2);
+
+  // Columns
+  for (i = 0; i < n; i += HBD_LANES)
+    ht->cols(buf0 + i * n / HBD_LANES, buf1 + i * n / HBD_LANES);
+  if (n == 16)
+    for (i = 0; i < num; ++i) buf1[i] = hbd_round_shift_2(buf1[i]);
+  hbd_transpose_block(buf1, buf0, n);
+
+  // Rows
+  for (i = 0; i < n; i += HBD_LANES)
+    ht->rows(buf0 + i * n / HBD_LANES, buf1 + i * n / HBD_LANES);
+  if (n == 4) {
+    for (i = 0; i < num; ++i)
+      buf1[i] = hbd_srai(hbd_add(buf1[i], hbd_set1(1)), 2);
+  } else if (n == 8) {
+    for (i = 0; i < num; ++i)
+      buf1[i] = hbd_srai(hbd_sub(buf1[i], hbd_srai(buf1[i], 31)), 1);
+  }
+  hbd_transpose_block(buf1, buf0, n);
+  hbd_store_block(buf0, output, n);
+}
+
+#endif  // AV1_ENCODER_X86_HIGHBD_DCT_INTRIN_IMPL_H_
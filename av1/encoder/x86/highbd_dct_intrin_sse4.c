@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <smmintrin.h>  // SSE4.1
+
+#include "./av1_rtcd.h"
+#include "./aom_dsp_rtcd.h"
+#include "aom_dsp/txfm_common.h"
+
+#define HBD_LANES 4
+typedef __m128i hbd_vec;
+
+static INLINE __m128i hbd_add(__m128i a, __m128i b) {
+  return _mm_add_epi32(a, b);
+}
+
+static INLINE __m128i hbd_sub(__m128i a, __m128i b) {
+  return _mm_sub_epi32(a, b);
+}
+
+static INLINE __m128i hbd_neg(__m128i a) {
+  return _mm_sub_epi32(_mm_setzero_si128(), a);
+}
+
+static INLINE __m128i hbd_set1(int a) { return _mm_set1_epi32(a); }
+
+static INLINE __m128i hbd_set_lane0(int a) { return _mm_cvtsi32_si128(a); }
+
+static INLINE __m128i hbd_slli(__m128i a, int bits) {
+  return _mm_slli_epi32(a, bits);
+}
+
+static INLINE __m128i hbd_srai(__m128i a, int bits) {
+  return _mm_srai_epi32(a, bits);
+}
+
+static INLINE __m128i hbd_load(const int16_t *src, int reverse) {
+  const __m128i a = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)src));
+  return reverse ? _mm_shuffle_epi32(a, 0x1b) : a;
+}
+
+static INLINE void hbd_store(tran_low_t *dst, __m128i a) {
+  _mm_storeu_si128((__m128i *)dst, a);
+}
+
+static INLINE void hbd_mul_wide(__m128i a, int c, __m128i *w) {
+  const __m128i k = _mm_set1_epi32(c);
+  w[0] = _mm_mul_epi32(a, k);
+  w[1] = _mm_mul_epi32(_mm_srli_epi64(a, 32), k);
+}
+
+static INLINE void hbd_add_wide(const __m128i *a, const __m128i *b,
+                                __m128i *w) {
+  w[0] = _mm_add_epi64(a[0], b[0]);
+  w[1] = _mm_add_epi64(a[1], b[1]);
+}
+
+static INLINE void hbd_sub_wide(const __m128i *a, const __m128i *b,
+                                __m128i *w) {
+  w[0] = _mm_sub_epi64(a[0], b[0]);
+  w[1] = _mm_sub_epi64(a[1], b[1]);
+}
+
+static INLINE __m128i hbd_round_shift_wide(const __m128i *w) {
+  // Only the low 32 bits of the shifted values are kept, so a logical shift
+  // is as good as an arithmetic one.
+  const __m128i k__DCT_CONST_ROUNDING = _mm_set1_epi64x(DCT_CONST_ROUNDING);
+  const __m128i even =
+      _mm_srli_epi64(_mm_add_epi64(w[0], k__DCT_CONST_ROUNDING),
+                     DCT_CONST_BITS);
+  const __m128i odd = _mm_slli_epi64(
+      _mm_add_epi64(w[1], k__DCT_CONST_ROUNDING), 32 - DCT_CONST_BITS);
+  return _mm_blend_epi16(even, odd, 0xcc);
+}
+
+static INLINE void hbd_transpose(const __m128i *in, __m128i *out) {
+  const __m128i t0 = _mm_unpacklo_epi32(in[0], in[1]);
+  const __m128i t1 = _mm_unpacklo_epi32(in[2], in[3]);
+  const __m128i t2 = _mm_unpackhi_epi32(in[0], in[1]);
+  const __m128i t3 = _mm_unpackhi_epi32(in[2], in[3]);
+  out[0] = _mm_unpacklo_epi64(t0, t1);
+  out[1] = _mm_unpackhi_epi64(t0, t1);
+  out[2] = _mm_unpacklo_epi64(t2, t3);
+  out[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+#include "av1/encoder/x86/highbd_dct_intrin_impl.h"
+
+void av1_highbd_fht4x4_sse4_1(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  if (tx_type == DCT_DCT)
+    aom_highbd_fdct4x4(input, output, stride);
+  else
+    hbd_fht(input, output, stride, tx_type, 4, &HBD_FHT_4[tx_type]);
+}
+
+void av1_highbd_fht8x8_sse4_1(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  if (tx_type == DCT_DCT)
+    aom_highbd_fdct8x8(input, output, stride);
+  else
+    hbd_fht(input, output, stride, tx_type, 8, &HBD_FHT_8[tx_type]);
+}
+
+void av1_highbd_fht16x16_sse4_1(const int16_t *input, tran_low_t *output,
+                                int stride, int tx_type) {
+  if (tx_type == DCT_DCT)
+    aom_highbd_fdct16x16(input, output, stride);
+  else
+    hbd_fht(input, output, stride, tx_type, 16, &HBD_FHT_16[tx_type]);
+}
@@ -116,6 +116,81 @@ class AverageTest : public AverageTestBase,
   }
 };
 
+typedef void (*AverageQuadFunction)(const uint8_t *s, int pitch, int x16_idx,
+                                    int y16_idx, int *avg);
+
+typedef std::tr1::tuple<int, int, AverageQuadFunction> AvgQuadFunc;
+
+class AverageQuadTest : public AverageTestBase,
+                        public ::testing::WithParamInterface<AvgQuadFunc> {
+ public:
+  AverageQuadTest() : AverageTestBase(64, 64) {}
+
+ protected:
+  void CheckAverages() {
+    const int x16_idx = GET_PARAM(0);
+    const int y16_idx = GET_PARAM(1);
+    int actual[4];
+    ASM_REGISTER_STATE_CHECK(
+        GET_PARAM(2)(source_data_, source_stride_, x16_idx, y16_idx, actual));
+    for (int k = 0; k < 4; ++k) {
+      const int x8_idx = x16_idx + ((k & 1) << 3);
+      const int y8_idx = y16_idx + ((k >> 1) << 3);
+      const unsigned int expected = ReferenceAverage8x8(
+          source_data_ + y8_idx * source_stride_ + x8_idx, source_stride_);
+      EXPECT_EQ(expected, static_cast<unsigned int>(actual[k])) << "k: " << k;
+    }
+  }
+};
+
+#if CONFIG_AOM_HIGHBITDEPTH
+typedef std::tr1::tuple<int, int, AverageFunction> HighbdAvgFunc;
+
+class HighbdAverageTest : public ::testing::TestWithParam<HighbdAvgFunc> {
+ protected:
+  static const int kStride = 16;
+
+  virtual void SetUp() {
+    bit_depth_ = GET_PARAM(0);
+    block_size_ = GET_PARAM(1);
+    avg_func_ = GET_PARAM(2);
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+  void FillConstant(uint16_t fill_constant) {
+    for (int i = 0; i < kStride * kStride; ++i) source_data_[i] = fill_constant;
+  }
+
+  void FillRandom() {
+    const int mask = (1 << bit_depth_) - 1;
+    for (int i = 0; i < kStride * kStride; ++i)
+      source_data_[i] = rnd_.Rand16() & mask;
+  }
+
+  void CheckAverages() {
+    const int offset = kStride + 3;
+    unsigned int sum = 0;
+    for (int h = 0; h < block_size_; ++h)
+      for (int w = 0; w < block_size_; ++w)
+        sum += source_data_[offset + h * kStride + w];
+    const int n = block_size_ * block_size_;
+    const unsigned int expected = (sum + (n >> 1)) / n;
+    unsigned int actual;
+    ASM_REGISTER_STATE_CHECK(
+        actual = avg_func_(CONVERT_TO_BYTEPTR(source_data_ + offset), kStride));
+    EXPECT_EQ(expected, actual);
+  }
+
+  int bit_depth_;
+  int block_size_;
+  AverageFunction avg_func_;
+  DECLARE_ALIGNED(16, uint16_t, source_data_[kStride * kStride]);
+  ACMRandom rnd_;
+};
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
 typedef void (*IntProRowFunc)(int16_t hbuf[16], uint8_t const *ref,
                               const int ref_stride, const int height);
 
@@ -248,6 +323,42 @@ TEST_P(AverageTest, Random) {
   }
 }
 
+TEST_P(AverageQuadTest, MinValue) {
+  FillConstant(0);
+  CheckAverages();
+}
+
+TEST_P(AverageQuadTest, MaxValue) {
+  FillConstant(255);
+  CheckAverages();
+}
+
+TEST_P(AverageQuadTest, Random) {
+  for (int i = 0; i < 1000; i++) {
+    FillRandom();
+    CheckAverages();
+  }
+}
+
+#if CONFIG_AOM_HIGHBITDEPTH
+TEST_P(HighbdAverageTest, MinValue) {
+  FillConstant(0);
+  CheckAverages();
+}
+
+TEST_P(HighbdAverageTest, MaxValue) {
+  FillConstant((1 << bit_depth_) - 1);
+  CheckAverages();
+}
+
+TEST_P(HighbdAverageTest, Random) {
+  for (int i = 0; i < 1000; i++) {
+    FillRandom();
+    CheckAverages();
+  }
+}
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
 TEST_P(IntProRowTest, MinValue) {
   FillConstant(0);
   RunComparison();
@@ -314,6 +425,20 @@ INSTANTIATE_TEST_CASE_P(
     ::testing::Values(make_tuple(16, 16, 1, 8, &aom_avg_8x8_c),
                       make_tuple(16, 16, 1, 4, &aom_avg_4x4_c)));
 
+INSTANTIATE_TEST_CASE_P(
+    C, AverageQuadTest,
+    ::testing::Values(make_tuple(0, 0, &aom_avg_8x8_quad_c),
+                      make_tuple(16, 32, &aom_avg_8x8_quad_c)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    C, HighbdAverageTest,
+    ::testing::Values(make_tuple(10, 8, &aom_highbd_avg_8x8_c),
+                      make_tuple(12, 8, &aom_highbd_avg_8x8_c),
+                      make_tuple(10, 4, &aom_highbd_avg_4x4_c),
+                      make_tuple(12, 4, &aom_highbd_avg_4x4_c)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
 INSTANTIATE_TEST_CASE_P(C, SatdTest,
                         ::testing::Values(make_tuple(16, &aom_satd_c),
                                           make_tuple(64, &aom_satd_c),
@@ -330,6 +455,21 @@ INSTANTIATE_TEST_CASE_P(
                       make_tuple(16, 16, 5, 4, &aom_avg_4x4_sse2),
                       make_tuple(32, 32, 15, 4, &aom_avg_4x4_sse2)));
 
+INSTANTIATE_TEST_CASE_P(
+    SSE2, AverageQuadTest,
+    ::testing::Values(make_tuple(0, 0, &aom_avg_8x8_quad_sse2),
+                      make_tuple(16, 32, &aom_avg_8x8_quad_sse2),
+                      make_tuple(5, 48, &aom_avg_8x8_quad_sse2)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE2, HighbdAverageTest,
+    ::testing::Values(make_tuple(10, 8, &aom_highbd_avg_8x8_sse2),
+                      make_tuple(12, 8, &aom_highbd_avg_8x8_sse2),
+                      make_tuple(10, 4, &aom_highbd_avg_4x4_sse2),
+                      make_tuple(12, 4, &aom_highbd_avg_4x4_sse2)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
 INSTANTIATE_TEST_CASE_P(
     SSE2, IntProRowTest,
     ::testing::Values(make_tuple(16, &aom_int_pro_row_sse2, &aom_int_pro_row_c),
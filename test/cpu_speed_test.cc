@@ -136,4 +136,14 @@ AV1_INSTANTIATE_TEST_CASE(CpuSpeedTest,
                           ::testing::Values(::libaom_test::kTwoPassGood,
                                             ::libaom_test::kOnePassGood),
                           ::testing::Range(0, 3));
+
+#if CONFIG_AV1
+// Real-time speed 9 selects the non-RD mode picker.
+INSTANTIATE_TEST_CASE_P(
+    AV1RealTime, CpuSpeedTest,
+    ::testing::Combine(
+        ::testing::Values(
+            static_cast<const libaom_test::CodecFactory *>(&libaom_test::kAV1)),
+        ::testing::Values(::libaom_test::kRealTime), ::testing::Values(9)));
+#endif  // CONFIG_AV1
 }  // namespace
@@ -509,4 +509,18 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(&av1_fht4x4_msa, &av1_iht4x4_16_add_msa, 2, AOM_BITS_8),
         make_tuple(&av1_fht4x4_msa, &av1_iht4x4_16_add_msa, 3, AOM_BITS_8)));
 #endif  // HAVE_MSA && !CONFIG_AOM_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+
+#if HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, Trans4x4HT,
+    ::testing::Values(
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_10, 0, AOM_BITS_10),
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_10, 1, AOM_BITS_10),
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_10, 2, AOM_BITS_10),
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_10, 3, AOM_BITS_10),
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_12, 0, AOM_BITS_12),
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_12, 1, AOM_BITS_12),
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_12, 2, AOM_BITS_12),
+        make_tuple(&av1_highbd_fht4x4_sse4_1, &iht4x4_12, 3, AOM_BITS_12)));
+#endif  // HAVE_SSE4_1 && CONFIG_AOM_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 }  // namespace
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
+#include "./av1_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "av1/common/quant_common.h"
+#include "av1/common/scan.h"
+#include "aom_ports/mem.h"
+
+using libaom_test::ACMRandom;
+
+namespace {
+#if !CONFIG_AOM_QM
+typedef int64_t (*FhtQuantFunc)(
+    const int16_t *input, int stride, int tx_type, tran_low_t *coeff,
+    int skip_block, const int16_t *zbin, const int16_t *round,
+    const int16_t *quant, const int16_t *quant_shift, tran_low_t *qcoeff,
+    tran_low_t *dqcoeff, const int16_t *dequant, uint16_t *eob,
+    const int16_t *scan, const int16_t *iscan, int64_t *ssz);
+typedef void (*FhtFunc)(const int16_t *input, tran_low_t *output, int stride,
+                        int tx_type);
+typedef std::tr1::tuple<FhtQuantFunc, TX_SIZE> FhtQuantParam;
+
+// Sets up the quantizer of q as av1_init_quantizer() does for 8-bit luma.
+void InitQuantizer(int q, int16_t *zbin, int16_t *round, int16_t *quant,
+                   int16_t *quant_shift, int16_t *dequant) {
+  for (int i = 0; i < 8; ++i) {
+    const int d = i == 0 ? av1_dc_quant(q, 0, AOM_BITS_8)
+                         : av1_ac_quant(q, 0, AOM_BITS_8);
+    const int zbin_factor = q == 0 ? 64 : (d < 148 ? 84 : 80);
+    int l = 0;
+    while ((d >> (l + 1)) > 0) ++l;
+    quant[i] = (int16_t)(1 + (1 << (16 + l)) / d - (1 << 16));
+    quant_shift[i] = 1 << (16 - l);
+    zbin[i] = ROUND_POWER_OF_TWO(zbin_factor * d, 7);
+    round[i] = ((q == 0 ? 64 : 48) * d) >> 7;
+    dequant[i] = d;
+  }
+}
+
+class FhtQuantTest : public ::testing::TestWithParam<FhtQuantParam> {
+ public:
+  virtual ~FhtQuantTest() {}
+  virtual void SetUp() {
+    fht_quant_ = GET_PARAM(0);
+    tx_size_ = GET_PARAM(1);
+    fht_ = tx_size_ == TX_4X4 ? av1_fht4x4_c : tx_size_ == TX_8X8
+                                                   ? av1_fht8x8_c
+                                                   : av1_fht16x16_c;
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  FhtQuantFunc fht_quant_;
+  FhtFunc fht_;
+  TX_SIZE tx_size_;
+};
+
+// The fused kernels must code the block exactly as the transform, quantizer
+// and error kernels do in turn.
+TEST_P(FhtQuantTest, MatchesSeparateKernels) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int stride = 32;
+  const int count = (4 << tx_size_) * (4 << tx_size_);
+  DECLARE_ALIGNED(16, int16_t, input[16 * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, coeff[256]);
+  DECLARE_ALIGNED(32, tran_low_t, qcoeff[256]);
+  DECLARE_ALIGNED(32, tran_low_t, dqcoeff[256]);
+  DECLARE_ALIGNED(32, tran_low_t, ref_coeff[256]);
+  DECLARE_ALIGNED(32, tran_low_t, ref_qcoeff[256]);
+  DECLARE_ALIGNED(32, tran_low_t, ref_dqcoeff[256]);
+  DECLARE_ALIGNED(16, int16_t, zbin[8]);
+  DECLARE_ALIGNED(16, int16_t, round[8]);
+  DECLARE_ALIGNED(16, int16_t, quant[8]);
+  DECLARE_ALIGNED(16, int16_t, quant_shift[8]);
+  DECLARE_ALIGNED(16, int16_t, dequant[8]);
+
+  for (int i = 0; i < 2000; ++i) {
+    const int tx_type = i % TX_TYPES;
+    const int skip_block = i % 101 == 0;
+    // Extreme residuals first, then full range and small ones.
+    const int max = i < 400 ? 255 : i < 1200 ? rnd(256) : rnd(16);
+    const SCAN_ORDER *const scan_order = &av1_scan_orders[tx_size_][tx_type];
+    uint16_t eob, ref_eob;
+    int64_t sse, ref_sse, error, ref_error;
+
+    InitQuantizer(rnd(QINDEX_RANGE), zbin, round, quant, quant_shift,
+                  dequant);
+    for (int j = 0; j < 16 * 32; ++j) {
+      input[j] = i < 100 ? (rnd(2) ? max : -max) : rnd(2 * max + 1) - max;
+    }
+
+    fht_(input, ref_coeff, stride, tx_type);
+    aom_quantize_b_c(ref_coeff, count, skip_block, zbin, round, quant,
+                     quant_shift, ref_qcoeff, ref_dqcoeff, dequant, &ref_eob,
+                     scan_order->scan, scan_order->iscan);
+    ref_error = av1_block_error_c(ref_coeff, ref_dqcoeff, count, &ref_sse);
+    ASM_REGISTER_STATE_CHECK(
+        error = fht_quant_(input, stride, tx_type, coeff, skip_block, zbin,
+                           round, quant, quant_shift, qcoeff, dqcoeff, dequant,
+                           &eob, scan_order->scan, scan_order->iscan, &sse));
+
+    ASSERT_EQ(ref_eob, eob) << "iteration " << i;
+    ASSERT_EQ(ref_error, error) << "iteration " << i;
+    ASSERT_EQ(ref_sse, sse) << "iteration " << i;
+    ASSERT_EQ(0, memcmp(ref_coeff, coeff, count * sizeof(*coeff)))
+        << "iteration " << i;
+    ASSERT_EQ(0, memcmp(ref_qcoeff, qcoeff, count * sizeof(*qcoeff)))
+        << "iteration " << i;
+    ASSERT_EQ(0, memcmp(ref_dqcoeff, dqcoeff, count * sizeof(*dqcoeff)))
+        << "iteration " << i;
+  }
+}
+
+using std::tr1::make_tuple;
+
+INSTANTIATE_TEST_CASE_P(C, FhtQuantTest,
+                        ::testing::Values(make_tuple(&av1_fht4x4_quant_c,
+                                                     TX_4X4),
+                                          make_tuple(&av1_fht8x8_quant_c,
+                                                     TX_8X8),
+                                          make_tuple(&av1_fht16x16_quant_c,
+                                                     TX_16X16)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, FhtQuantTest,
+                        ::testing::Values(make_tuple(&av1_fht4x4_quant_sse2,
+                                                     TX_4X4),
+                                          make_tuple(&av1_fht8x8_quant_sse2,
+                                                     TX_8X8),
+                                          make_tuple(&av1_fht16x16_quant_sse2,
+                                                     TX_16X16)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, FhtQuantTest,
+                        ::testing::Values(make_tuple(&av1_fht16x16_quant_avx2,
+                                                     TX_16X16)));
+#endif  // HAVE_AVX2
+#endif  // !CONFIG_AOM_QM
+}  // namespace
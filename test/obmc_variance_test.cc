@@ -33,6 +33,12 @@ typedef unsigned int (*ObmcVarF)(const uint8_t *pre, int pre_stride,
                                  const int32_t *wsrc, const int32_t *mask,
                                  unsigned int *sse);
 typedef libaom_test::FuncParam<ObmcVarF> TestFuncs;
+typedef unsigned int (*ObmcSubpelVarF)(const uint8_t *pre, int pre_stride,
+                                       int xoffset, int yoffset,
+                                       const int32_t *wsrc,
+                                       const int32_t *mask,
+                                       unsigned int *sse);
+typedef libaom_test::FuncParam<ObmcSubpelVarF> SubpelTestFuncs;
 
 ////////////////////////////////////////////////////////////////////////////////
 // 8 bit
@@ -113,6 +119,125 @@ INSTANTIATE_TEST_CASE_P(SSE4_1_C_COMPARE, ObmcVarianceTest,
                         ::testing::ValuesIn(sse4_functions));
 #endif  // HAVE_SSE4_1
 
+class ObmcSubpelVarianceTest
+    : public FunctionEquivalenceTest<ObmcSubpelVarF> {};
+
+// The C bilinear filters need a stride of at least the block width, and read
+// one row and one column beyond the block.
+#define SUBPEL_MAX_STRIDE (2 * MAX_SB_SIZE)
+#define SUBPEL_PRE_SIZE ((MAX_SB_SIZE + 1) * SUBPEL_MAX_STRIDE)
+
+TEST_P(ObmcSubpelVarianceTest, RandomValues) {
+  DECLARE_ALIGNED(32, uint8_t, pre[SUBPEL_PRE_SIZE]);
+  DECLARE_ALIGNED(32, int32_t, wsrc[MAX_SB_SQUARE]);
+  DECLARE_ALIGNED(32, int32_t, mask[MAX_SB_SQUARE]);
+
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    const int pre_stride = MAX_SB_SIZE + this->rng_(MAX_SB_SIZE);
+    const int xoffset = this->rng_(8);
+    const int yoffset = this->rng_(8);
+
+    for (int i = 0; i < SUBPEL_PRE_SIZE; ++i) pre[i] = this->rng_.Rand8();
+    for (int i = 0; i < MAX_SB_SQUARE; ++i) {
+      wsrc[i] = this->rng_.Rand8() * this->rng_(kMaskMax * kMaskMax + 1);
+      mask[i] = this->rng_(kMaskMax * kMaskMax + 1);
+    }
+
+    unsigned int ref_sse, tst_sse;
+    const unsigned int ref_res = params_.ref_func(
+        pre, pre_stride, xoffset, yoffset, wsrc, mask, &ref_sse);
+    unsigned int tst_res;
+    ASM_REGISTER_STATE_CHECK(tst_res = params_.tst_func(pre, pre_stride,
+                                                        xoffset, yoffset,
+                                                        wsrc, mask, &tst_sse));
+
+    ASSERT_EQ(ref_res, tst_res);
+    ASSERT_EQ(ref_sse, tst_sse);
+  }
+}
+
+TEST_P(ObmcSubpelVarianceTest, ExtremeValues) {
+  DECLARE_ALIGNED(32, uint8_t, pre[SUBPEL_PRE_SIZE]);
+  DECLARE_ALIGNED(32, int32_t, wsrc[MAX_SB_SQUARE]);
+  DECLARE_ALIGNED(32, int32_t, mask[MAX_SB_SQUARE]);
+
+  for (int iter = 0; iter < MAX_SB_SIZE && !HasFatalFailure(); ++iter) {
+    const int pre_stride = MAX_SB_SIZE + iter;
+    const int xoffset = iter & 7;
+    const int yoffset = (iter >> 3) & 7;
+
+    for (int i = 0; i < SUBPEL_PRE_SIZE; ++i) pre[i] = UINT8_MAX;
+    for (int i = 0; i < MAX_SB_SQUARE; ++i) {
+      wsrc[i] = 0;
+      mask[i] = kMaskMax * kMaskMax;
+    }
+
+    unsigned int ref_sse, tst_sse;
+    const unsigned int ref_res = params_.ref_func(
+        pre, pre_stride, xoffset, yoffset, wsrc, mask, &ref_sse);
+    unsigned int tst_res;
+    ASM_REGISTER_STATE_CHECK(tst_res = params_.tst_func(pre, pre_stride,
+                                                        xoffset, yoffset,
+                                                        wsrc, mask, &tst_sse));
+
+    ASSERT_EQ(ref_res, tst_res);
+    ASSERT_EQ(ref_sse, tst_sse);
+  }
+}
+
+#if HAVE_AVX2
+const ObmcVarianceTest::ParamType avx2_functions[] = {
+  TestFuncs(aom_obmc_variance64x64_c, aom_obmc_variance64x64_avx2),
+  TestFuncs(aom_obmc_variance64x32_c, aom_obmc_variance64x32_avx2),
+  TestFuncs(aom_obmc_variance32x64_c, aom_obmc_variance32x64_avx2),
+  TestFuncs(aom_obmc_variance32x32_c, aom_obmc_variance32x32_avx2),
+  TestFuncs(aom_obmc_variance32x16_c, aom_obmc_variance32x16_avx2),
+  TestFuncs(aom_obmc_variance16x32_c, aom_obmc_variance16x32_avx2),
+  TestFuncs(aom_obmc_variance16x16_c, aom_obmc_variance16x16_avx2),
+  TestFuncs(aom_obmc_variance16x8_c, aom_obmc_variance16x8_avx2),
+  TestFuncs(aom_obmc_variance8x16_c, aom_obmc_variance8x16_avx2),
+  TestFuncs(aom_obmc_variance8x8_c, aom_obmc_variance8x8_avx2),
+  TestFuncs(aom_obmc_variance8x4_c, aom_obmc_variance8x4_avx2),
+  TestFuncs(aom_obmc_variance4x8_c, aom_obmc_variance4x8_avx2),
+  TestFuncs(aom_obmc_variance4x4_c, aom_obmc_variance4x4_avx2)
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2_C_COMPARE, ObmcVarianceTest,
+                        ::testing::ValuesIn(avx2_functions));
+
+const ObmcSubpelVarianceTest::ParamType avx2_subpel_functions[] = {
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance64x64_c,
+                  aom_obmc_sub_pixel_variance64x64_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance64x32_c,
+                  aom_obmc_sub_pixel_variance64x32_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance32x64_c,
+                  aom_obmc_sub_pixel_variance32x64_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance32x32_c,
+                  aom_obmc_sub_pixel_variance32x32_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance32x16_c,
+                  aom_obmc_sub_pixel_variance32x16_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance16x32_c,
+                  aom_obmc_sub_pixel_variance16x32_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance16x16_c,
+                  aom_obmc_sub_pixel_variance16x16_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance16x8_c,
+                  aom_obmc_sub_pixel_variance16x8_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance8x16_c,
+                  aom_obmc_sub_pixel_variance8x16_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance8x8_c,
+                  aom_obmc_sub_pixel_variance8x8_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance8x4_c,
+                  aom_obmc_sub_pixel_variance8x4_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance4x8_c,
+                  aom_obmc_sub_pixel_variance4x8_avx2),
+  SubpelTestFuncs(aom_obmc_sub_pixel_variance4x4_c,
+                  aom_obmc_sub_pixel_variance4x4_avx2)
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2_C_COMPARE, ObmcSubpelVarianceTest,
+                        ::testing::ValuesIn(avx2_subpel_functions));
+#endif  // HAVE_AVX2
+
 ////////////////////////////////////////////////////////////////////////////////
 // High bit-depth
 ////////////////////////////////////////////////////////////////////////////////
@@ -260,5 +385,237 @@ ObmcVarianceHBDTest::ParamType sse4_functions_hbd[] = {
 INSTANTIATE_TEST_CASE_P(SSE4_1_C_COMPARE, ObmcVarianceHBDTest,
                         ::testing::ValuesIn(sse4_functions_hbd));
 #endif  // HAVE_SSE4_1
+
+class ObmcSubpelVarianceHBDTest
+    : public FunctionEquivalenceTest<ObmcSubpelVarF> {};
+
+TEST_P(ObmcSubpelVarianceHBDTest, RandomValues) {
+  DECLARE_ALIGNED(32, uint16_t, pre[SUBPEL_PRE_SIZE]);
+  DECLARE_ALIGNED(32, int32_t, wsrc[MAX_SB_SQUARE]);
+  DECLARE_ALIGNED(32, int32_t, mask[MAX_SB_SQUARE]);
+
+  for (int iter = 0; iter < kIterations && !HasFatalFailure(); ++iter) {
+    const int pre_stride = MAX_SB_SIZE + this->rng_(MAX_SB_SIZE);
+    const int xoffset = this->rng_(8);
+    const int yoffset = this->rng_(8);
+
+    for (int i = 0; i < SUBPEL_PRE_SIZE; ++i)
+      pre[i] = this->rng_(1 << params_.bit_depth);
+    for (int i = 0; i < MAX_SB_SQUARE; ++i) {
+      wsrc[i] = this->rng_(1 << params_.bit_depth) *
+                this->rng_(kMaskMax * kMaskMax + 1);
+      mask[i] = this->rng_(kMaskMax * kMaskMax + 1);
+    }
+
+    unsigned int ref_sse, tst_sse;
+    const unsigned int ref_res =
+        params_.ref_func(CONVERT_TO_BYTEPTR(pre), pre_stride, xoffset,
+                         yoffset, wsrc, mask, &ref_sse);
+    unsigned int tst_res;
+    ASM_REGISTER_STATE_CHECK(
+        tst_res = params_.tst_func(CONVERT_TO_BYTEPTR(pre), pre_stride,
+                                   xoffset, yoffset, wsrc, mask, &tst_sse));
+
+    ASSERT_EQ(ref_res, tst_res);
+    ASSERT_EQ(ref_sse, tst_sse);
+  }
+}
+
+TEST_P(ObmcSubpelVarianceHBDTest, ExtremeValues) {
+  DECLARE_ALIGNED(32, uint16_t, pre[SUBPEL_PRE_SIZE]);
+  DECLARE_ALIGNED(32, int32_t, wsrc[MAX_SB_SQUARE]);
+  DECLARE_ALIGNED(32, int32_t, mask[MAX_SB_SQUARE]);
+
+  for (int iter = 0; iter < MAX_SB_SIZE && !HasFatalFailure(); ++iter) {
+    const int pre_stride = MAX_SB_SIZE + iter;
+    const int xoffset = iter & 7;
+    const int yoffset = (iter >> 3) & 7;
+
+    for (int i = 0; i < SUBPEL_PRE_SIZE; ++i)
+      pre[i] = (1 << params_.bit_depth) - 1;
+    for (int i = 0; i < MAX_SB_SQUARE; ++i) {
+      wsrc[i] = 0;
+      mask[i] = kMaskMax * kMaskMax;
+    }
+
+    unsigned int ref_sse, tst_sse;
+    const unsigned int ref_res =
+        params_.ref_func(CONVERT_TO_BYTEPTR(pre), pre_stride, xoffset,
+                         yoffset, wsrc, mask, &ref_sse);
+    unsigned int tst_res;
+    ASM_REGISTER_STATE_CHECK(
+        tst_res = params_.tst_func(CONVERT_TO_BYTEPTR(pre), pre_stride,
+                                   xoffset, yoffset, wsrc, mask, &tst_sse));
+
+    ASSERT_EQ(ref_res, tst_res);
+    ASSERT_EQ(ref_sse, tst_sse);
+  }
+}
+
+#if HAVE_AVX2
+ObmcVarianceHBDTest::ParamType avx2_functions_hbd[] = {
+  TestFuncs(aom_highbd_obmc_variance64x64_c, aom_highbd_obmc_variance64x64_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance64x32_c, aom_highbd_obmc_variance64x32_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance32x64_c, aom_highbd_obmc_variance32x64_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance32x32_c, aom_highbd_obmc_variance32x32_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance32x16_c, aom_highbd_obmc_variance32x16_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance16x32_c, aom_highbd_obmc_variance16x32_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance16x16_c, aom_highbd_obmc_variance16x16_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance16x8_c, aom_highbd_obmc_variance16x8_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance8x16_c, aom_highbd_obmc_variance8x16_avx2,
+            8),
+  TestFuncs(aom_highbd_obmc_variance8x8_c, aom_highbd_obmc_variance8x8_avx2, 8),
+  TestFuncs(aom_highbd_obmc_variance8x4_c, aom_highbd_obmc_variance8x4_avx2, 8),
+  TestFuncs(aom_highbd_obmc_variance4x8_c, aom_highbd_obmc_variance4x8_avx2, 8),
+  TestFuncs(aom_highbd_obmc_variance4x4_c, aom_highbd_obmc_variance4x4_avx2, 8),
+  TestFuncs(aom_highbd_10_obmc_variance64x64_c,
+            aom_highbd_10_obmc_variance64x64_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance64x32_c,
+            aom_highbd_10_obmc_variance64x32_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance32x64_c,
+            aom_highbd_10_obmc_variance32x64_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance32x32_c,
+            aom_highbd_10_obmc_variance32x32_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance32x16_c,
+            aom_highbd_10_obmc_variance32x16_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance16x32_c,
+            aom_highbd_10_obmc_variance16x32_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance16x16_c,
+            aom_highbd_10_obmc_variance16x16_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance16x8_c,
+            aom_highbd_10_obmc_variance16x8_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance8x16_c,
+            aom_highbd_10_obmc_variance8x16_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance8x8_c,
+            aom_highbd_10_obmc_variance8x8_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance8x4_c,
+            aom_highbd_10_obmc_variance8x4_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance4x8_c,
+            aom_highbd_10_obmc_variance4x8_avx2, 10),
+  TestFuncs(aom_highbd_10_obmc_variance4x4_c,
+            aom_highbd_10_obmc_variance4x4_avx2, 10),
+  TestFuncs(aom_highbd_12_obmc_variance64x64_c,
+            aom_highbd_12_obmc_variance64x64_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance64x32_c,
+            aom_highbd_12_obmc_variance64x32_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance32x64_c,
+            aom_highbd_12_obmc_variance32x64_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance32x32_c,
+            aom_highbd_12_obmc_variance32x32_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance32x16_c,
+            aom_highbd_12_obmc_variance32x16_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance16x32_c,
+            aom_highbd_12_obmc_variance16x32_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance16x16_c,
+            aom_highbd_12_obmc_variance16x16_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance16x8_c,
+            aom_highbd_12_obmc_variance16x8_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance8x16_c,
+            aom_highbd_12_obmc_variance8x16_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance8x8_c,
+            aom_highbd_12_obmc_variance8x8_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance8x4_c,
+            aom_highbd_12_obmc_variance8x4_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance4x8_c,
+            aom_highbd_12_obmc_variance4x8_avx2, 12),
+  TestFuncs(aom_highbd_12_obmc_variance4x4_c,
+            aom_highbd_12_obmc_variance4x4_avx2, 12)
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2_C_COMPARE, ObmcVarianceHBDTest,
+                        ::testing::ValuesIn(avx2_functions_hbd));
+
+ObmcSubpelVarianceHBDTest::ParamType avx2_subpel_functions_hbd[] = {
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance64x64_c,
+                  aom_highbd_obmc_sub_pixel_variance64x64_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance64x32_c,
+                  aom_highbd_obmc_sub_pixel_variance64x32_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance32x64_c,
+                  aom_highbd_obmc_sub_pixel_variance32x64_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance32x32_c,
+                  aom_highbd_obmc_sub_pixel_variance32x32_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance32x16_c,
+                  aom_highbd_obmc_sub_pixel_variance32x16_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance16x32_c,
+                  aom_highbd_obmc_sub_pixel_variance16x32_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance16x16_c,
+                  aom_highbd_obmc_sub_pixel_variance16x16_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance16x8_c,
+                  aom_highbd_obmc_sub_pixel_variance16x8_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance8x16_c,
+                  aom_highbd_obmc_sub_pixel_variance8x16_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance8x8_c,
+                  aom_highbd_obmc_sub_pixel_variance8x8_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance8x4_c,
+                  aom_highbd_obmc_sub_pixel_variance8x4_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance4x8_c,
+                  aom_highbd_obmc_sub_pixel_variance4x8_avx2, 8),
+  SubpelTestFuncs(aom_highbd_obmc_sub_pixel_variance4x4_c,
+                  aom_highbd_obmc_sub_pixel_variance4x4_avx2, 8),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance64x64_c,
+                  aom_highbd_10_obmc_sub_pixel_variance64x64_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance64x32_c,
+                  aom_highbd_10_obmc_sub_pixel_variance64x32_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance32x64_c,
+                  aom_highbd_10_obmc_sub_pixel_variance32x64_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance32x32_c,
+                  aom_highbd_10_obmc_sub_pixel_variance32x32_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance32x16_c,
+                  aom_highbd_10_obmc_sub_pixel_variance32x16_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance16x32_c,
+                  aom_highbd_10_obmc_sub_pixel_variance16x32_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance16x16_c,
+                  aom_highbd_10_obmc_sub_pixel_variance16x16_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance16x8_c,
+                  aom_highbd_10_obmc_sub_pixel_variance16x8_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance8x16_c,
+                  aom_highbd_10_obmc_sub_pixel_variance8x16_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance8x8_c,
+                  aom_highbd_10_obmc_sub_pixel_variance8x8_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance8x4_c,
+                  aom_highbd_10_obmc_sub_pixel_variance8x4_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance4x8_c,
+                  aom_highbd_10_obmc_sub_pixel_variance4x8_avx2, 10),
+  SubpelTestFuncs(aom_highbd_10_obmc_sub_pixel_variance4x4_c,
+                  aom_highbd_10_obmc_sub_pixel_variance4x4_avx2, 10),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance64x64_c,
+                  aom_highbd_12_obmc_sub_pixel_variance64x64_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance64x32_c,
+                  aom_highbd_12_obmc_sub_pixel_variance64x32_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance32x64_c,
+                  aom_highbd_12_obmc_sub_pixel_variance32x64_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance32x32_c,
+                  aom_highbd_12_obmc_sub_pixel_variance32x32_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance32x16_c,
+                  aom_highbd_12_obmc_sub_pixel_variance32x16_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance16x32_c,
+                  aom_highbd_12_obmc_sub_pixel_variance16x32_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance16x16_c,
+                  aom_highbd_12_obmc_sub_pixel_variance16x16_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance16x8_c,
+                  aom_highbd_12_obmc_sub_pixel_variance16x8_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance8x16_c,
+                  aom_highbd_12_obmc_sub_pixel_variance8x16_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance8x8_c,
+                  aom_highbd_12_obmc_sub_pixel_variance8x8_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance8x4_c,
+                  aom_highbd_12_obmc_sub_pixel_variance8x4_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance4x8_c,
+                  aom_highbd_12_obmc_sub_pixel_variance4x8_avx2, 12),
+  SubpelTestFuncs(aom_highbd_12_obmc_sub_pixel_variance4x4_c,
+                  aom_highbd_12_obmc_sub_pixel_variance4x4_avx2, 12)
+};
+
+INSTANTIATE_TEST_CASE_P(AVX2_C_COMPARE, ObmcSubpelVarianceHBDTest,
+                        ::testing::ValuesIn(avx2_subpel_functions_hbd));
+#endif  // HAVE_AVX2
 #endif  // CONFIG_AOM_HIGHBITDEPTH
 }  // namespace
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "./aom_dsp_rtcd.h"
+#include "./av1_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "av1/common/quant_common.h"
+#include "av1/common/scan.h"
+#include "aom_ports/mem.h"
+
+using libaom_test::ACMRandom;
+
+namespace {
+#if CONFIG_AOM_QM
+const int number_of_iterations = 1000;
+
+typedef void (*QuantizeFunc)(const tran_low_t *coeff, intptr_t count,
+                             int skip_block, const int16_t *zbin,
+                             const int16_t *round, const int16_t *quant,
+                             const int16_t *quant_shift, tran_low_t *qcoeff,
+                             tran_low_t *dqcoeff, const int16_t *dequant,
+                             uint16_t *eob, const int16_t *scan,
+                             const int16_t *iscan, const qm_val_t *qm,
+                             const qm_val_t *iqm);
+// The last parameter selects the 32x32 quantizers.
+typedef std::tr1::tuple<QuantizeFunc, QuantizeFunc, aom_bit_depth_t, bool>
+    QuantizeParam;
+
+// Sets up the quantizer of q as av1_init_quantizer() does for luma.
+void InitQuantizer(int q, aom_bit_depth_t bit_depth, int16_t *zbin,
+                   int16_t *round, int16_t *quant, int16_t *quant_shift,
+                   int16_t *dequant) {
+  for (int i = 0; i < 2; ++i) {
+    const int d = i == 0 ? av1_dc_quant(q, 0, bit_depth)
+                         : av1_ac_quant(q, 0, bit_depth);
+    const int zbin_factor = q == 0 ? 64 : (d < 148 ? 84 : 80);
+    int l = 0;
+    while ((d >> (l + 1)) > 0) ++l;
+    quant[i] = (int16_t)(1 + (1 << (16 + l)) / d - (1 << 16));
+    quant_shift[i] = 1 << (16 - l);
+    zbin[i] = ROUND_POWER_OF_TWO(zbin_factor * d, 7);
+    round[i] = ((q == 0 ? 64 : 48) * d) >> 7;
+    dequant[i] = d;
+  }
+}
+
+class QuantizeQmTest : public ::testing::TestWithParam<QuantizeParam> {
+ public:
+  virtual ~QuantizeQmTest() {}
+  virtual void SetUp() {
+    quantize_op_ = GET_PARAM(0);
+    ref_quantize_op_ = GET_PARAM(1);
+    bit_depth_ = GET_PARAM(2);
+    tx_size_max_ = GET_PARAM(3) ? TX_32X32 : TX_16X16;
+  }
+
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  QuantizeFunc quantize_op_;
+  QuantizeFunc ref_quantize_op_;
+  aom_bit_depth_t bit_depth_;
+  TX_SIZE tx_size_max_;
+};
+
+TEST_P(QuantizeQmTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  // The transforms of 12-bit input stay within 20 bits.
+  const int coeff_max = bit_depth_ == AOM_BITS_8 ? INT16_MAX
+                                                 : (1 << (bit_depth_ + 8)) - 1;
+  DECLARE_ALIGNED(16, tran_low_t, coeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, qcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, dqcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_qcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_dqcoeff[1024]);
+  DECLARE_ALIGNED(16, int16_t, zbin[2]);
+  DECLARE_ALIGNED(16, int16_t, round[2]);
+  DECLARE_ALIGNED(16, int16_t, quant[2]);
+  DECLARE_ALIGNED(16, int16_t, quant_shift[2]);
+  DECLARE_ALIGNED(16, int16_t, dequant[2]);
+
+  for (int i = 0; i < number_of_iterations; ++i) {
+    const int skip_block = i % 97 == 0;
+    const TX_SIZE tx_size =
+        tx_size_max_ == TX_32X32 ? TX_32X32 : (TX_SIZE)(i % 3);
+    const TX_TYPE tx_type = (TX_TYPE)((i >> 2) % TX_TYPES);
+    const SCAN_ORDER *const scan_order = &av1_scan_orders[tx_size][tx_type];
+    const int count = (4 << tx_size) * (4 << tx_size);
+    const int qmlevel = rnd(NUM_QM_LEVELS);
+    const int is_chroma = rnd(2);
+    const int is_intra = rnd(2);
+    const qm_val_t *const qm =
+        aom_qmatrix(qmlevel, is_chroma, tx_size, is_intra);
+    const qm_val_t *const iqm =
+        aom_iqmatrix(qmlevel, is_chroma, tx_size, is_intra);
+    // Full range coefficients first, then mostly small ones.
+    const int max = i < number_of_iterations / 2 ? coeff_max : rnd(256);
+    uint16_t eob, ref_eob;
+
+    for (int j = 0; j < count; ++j) {
+      coeff[j] = (tran_low_t)(rnd(2 * max + 1) - max);
+    }
+    InitQuantizer(rnd(QINDEX_RANGE), bit_depth_, zbin, round, quant,
+                  quant_shift, dequant);
+    if (i & 1) {
+      // Moves the dead zone and the rounding around.
+      for (int j = 0; j < 2; ++j) {
+        zbin[j] = rnd.Rand16() & ((1 << bit_depth_) - 1);
+        round[j] = rnd.Rand16() & ((1 << bit_depth_) - 1);
+      }
+    }
+
+    ref_quantize_op_(coeff, count, skip_block, zbin, round, quant, quant_shift,
+                     ref_qcoeff, ref_dqcoeff, dequant, &ref_eob,
+                     scan_order->scan, scan_order->iscan, qm, iqm);
+    ASM_REGISTER_STATE_CHECK(quantize_op_(
+        coeff, count, skip_block, zbin, round, quant, quant_shift, qcoeff,
+        dqcoeff, dequant, &eob, scan_order->scan, scan_order->iscan, qm, iqm));
+
+    ASSERT_EQ(ref_eob, eob) << "iteration " << i;
+    ASSERT_EQ(0, memcmp(ref_qcoeff, qcoeff, count * sizeof(*qcoeff)))
+        << "iteration " << i;
+    ASSERT_EQ(0, memcmp(ref_dqcoeff, dqcoeff, count * sizeof(*dqcoeff)))
+        << "iteration " << i;
+  }
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, QuantizeQmTest,
+    ::testing::Values(
+        make_tuple(&aom_quantize_b_sse4_1, &aom_quantize_b_c, AOM_BITS_8,
+                   false),
+        make_tuple(&aom_quantize_b_32x32_sse4_1, &aom_quantize_b_32x32_c,
+                   AOM_BITS_8, true),
+        make_tuple(&av1_quantize_fp_sse4_1, &av1_quantize_fp_c, AOM_BITS_8,
+                   false),
+        make_tuple(&av1_quantize_fp_32x32_sse4_1, &av1_quantize_fp_32x32_c,
+                   AOM_BITS_8, true)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1_HBD, QuantizeQmTest,
+    ::testing::Values(
+        make_tuple(&aom_highbd_quantize_b_sse4_1, &aom_highbd_quantize_b_c,
+                   AOM_BITS_10, false),
+        make_tuple(&aom_highbd_quantize_b_sse4_1, &aom_highbd_quantize_b_c,
+                   AOM_BITS_12, false),
+        make_tuple(&aom_highbd_quantize_b_32x32_sse4_1,
+                   &aom_highbd_quantize_b_32x32_c, AOM_BITS_12, true),
+        make_tuple(&av1_highbd_quantize_fp_sse4_1, &av1_highbd_quantize_fp_c,
+                   AOM_BITS_12, false),
+        make_tuple(&av1_highbd_quantize_fp_32x32_sse4_1,
+                   &av1_highbd_quantize_fp_32x32_c, AOM_BITS_12, true)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, QuantizeQmTest,
+    ::testing::Values(
+        make_tuple(&aom_quantize_b_avx2, &aom_quantize_b_c, AOM_BITS_8, false),
+        make_tuple(&aom_quantize_b_32x32_avx2, &aom_quantize_b_32x32_c,
+                   AOM_BITS_8, true),
+        make_tuple(&av1_quantize_fp_avx2, &av1_quantize_fp_c, AOM_BITS_8,
+                   false),
+        make_tuple(&av1_quantize_fp_32x32_avx2, &av1_quantize_fp_32x32_c,
+                   AOM_BITS_8, true)));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2_HBD, QuantizeQmTest,
+    ::testing::Values(
+        make_tuple(&aom_highbd_quantize_b_avx2, &aom_highbd_quantize_b_c,
+                   AOM_BITS_10, false),
+        make_tuple(&aom_highbd_quantize_b_avx2, &aom_highbd_quantize_b_c,
+                   AOM_BITS_12, false),
+        make_tuple(&aom_highbd_quantize_b_32x32_avx2,
+                   &aom_highbd_quantize_b_32x32_c, AOM_BITS_12, true),
+        make_tuple(&av1_highbd_quantize_fp_avx2, &av1_highbd_quantize_fp_c,
+                   AOM_BITS_12, false),
+        make_tuple(&av1_highbd_quantize_fp_32x32_avx2,
+                   &av1_highbd_quantize_fp_32x32_c, AOM_BITS_12, true)));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+#endif  // HAVE_AVX2
+#endif  // CONFIG_AOM_QM
+}  // namespace
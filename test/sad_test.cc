@@ -39,6 +39,11 @@ typedef void (*SadMxNx4Func)(const uint8_t *src_ptr, int src_stride,
                              uint32_t *sad_array);
 typedef std::tr1::tuple<int, int, SadMxNx4Func, int> SadMxNx4Param;
 
+typedef void (*SadMxNx8Func)(const uint8_t *src_ptr, int src_stride,
+                             const uint8_t *ref_ptr, int ref_stride,
+                             uint32_t *sad_array);
+typedef std::tr1::tuple<int, int, SadMxNx8Func, int> SadMxNx8Param;
+
 using libaom_test::ACMRandom;
 
 namespace {
@@ -118,7 +123,8 @@ class SADTestBase : public ::testing::Test {
 
   // Sum of Absolute Differences. Given two blocks, calculate the absolute
   // difference between two pixels in the same relative location; accumulate.
-  unsigned int ReferenceSAD(int block_idx) {
+  // The reference block starts offset pixels to the right of block_idx.
+  unsigned int ReferenceSAD(int block_idx, int offset = 0) {
     unsigned int sad = 0;
     const uint8_t *const reference8 = GetReference(block_idx);
     const uint8_t *const source8 = source_data_;
@@ -131,11 +137,11 @@ class SADTestBase : public ::testing::Test {
       for (int w = 0; w < width_; ++w) {
         if (!use_high_bit_depth_) {
           sad += abs(source8[h * source_stride_ + w] -
-                     reference8[h * reference_stride_ + w]);
+                     reference8[h * reference_stride_ + w + offset]);
 #if CONFIG_AOM_HIGHBITDEPTH
         } else {
           sad += abs(source16[h * source_stride_ + w] -
-                     reference16[h * reference_stride_ + w]);
+                     reference16[h * reference_stride_ + w + offset]);
 #endif  // CONFIG_AOM_HIGHBITDEPTH
         }
       }
@@ -257,6 +263,29 @@ class SADx4Test : public SADTestBase,
   }
 };
 
+class SADx8Test : public SADTestBase,
+                  public ::testing::WithParamInterface<SadMxNx8Param> {
+ public:
+  SADx8Test() : SADTestBase(GET_PARAM(0), GET_PARAM(1), GET_PARAM(3)) {}
+
+ protected:
+  void SADs(unsigned int *results) {
+    ASM_REGISTER_STATE_CHECK(GET_PARAM(2)(source_data_, source_stride_,
+                                          GetReference(0), reference_stride_,
+                                          results));
+  }
+
+  void CheckSADs() {
+    unsigned int exp_sad[8];
+
+    SADs(exp_sad);
+    for (int offset = 0; offset < 8; ++offset) {
+      EXPECT_EQ(ReferenceSAD(0, offset), exp_sad[offset])
+          << "offset " << offset;
+    }
+  }
+};
+
 class SADTest : public SADTestBase,
                 public ::testing::WithParamInterface<SadMxNParam> {
  public:
@@ -468,6 +497,45 @@ TEST_P(SADx4Test, SrcAlignedByWidth) {
   source_data_ = tmp_source_data;
 }
 
+TEST_P(SADx8Test, MaxRef) {
+  FillConstant(source_data_, source_stride_, 0);
+  FillConstant(GetReference(0), reference_stride_, mask_);
+  CheckSADs();
+}
+
+TEST_P(SADx8Test, MaxSrc) {
+  FillConstant(source_data_, source_stride_, mask_);
+  FillConstant(GetReference(0), reference_stride_, 0);
+  CheckSADs();
+}
+
+TEST_P(SADx8Test, ShortRef) {
+  int tmp_stride = reference_stride_;
+  reference_stride_ >>= 1;
+  FillRandom(source_data_, source_stride_);
+  FillRandom(GetReference(0), reference_stride_);
+  CheckSADs();
+  reference_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8Test, UnalignedRef) {
+  int tmp_stride = reference_stride_;
+  reference_stride_ -= 1;
+  FillRandom(source_data_, source_stride_);
+  FillRandom(GetReference(0), reference_stride_);
+  CheckSADs();
+  reference_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8Test, ShortSrc) {
+  int tmp_stride = source_stride_;
+  source_stride_ >>= 1;
+  FillRandom(source_data_, source_stride_);
+  FillRandom(GetReference(0), reference_stride_);
+  CheckSADs();
+  source_stride_ = tmp_stride;
+}
+
 using std::tr1::make_tuple;
 
 //------------------------------------------------------------------------------
@@ -646,6 +714,64 @@ const SadMxNx4Param x4d_c_tests[] = {
 };
 INSTANTIATE_TEST_CASE_P(C, SADx4Test, ::testing::ValuesIn(x4d_c_tests));
 
+const SadMxNx8Param x8_c_tests[] = {
+  make_tuple(64, 64, &aom_sad64x64x8_c, -1),
+  make_tuple(64, 32, &aom_sad64x32x8_c, -1),
+  make_tuple(32, 64, &aom_sad32x64x8_c, -1),
+  make_tuple(32, 32, &aom_sad32x32x8_c, -1),
+  make_tuple(32, 16, &aom_sad32x16x8_c, -1),
+  make_tuple(16, 32, &aom_sad16x32x8_c, -1),
+  make_tuple(16, 16, &aom_sad16x16x8_c, -1),
+  make_tuple(16, 8, &aom_sad16x8x8_c, -1),
+  make_tuple(8, 16, &aom_sad8x16x8_c, -1),
+  make_tuple(8, 8, &aom_sad8x8x8_c, -1),
+  make_tuple(8, 4, &aom_sad8x4x8_c, -1),
+  make_tuple(4, 8, &aom_sad4x8x8_c, -1),
+  make_tuple(4, 4, &aom_sad4x4x8_c, -1),
+#if CONFIG_AOM_HIGHBITDEPTH
+  make_tuple(64, 64, &aom_highbd_sad64x64x8_c, 8),
+  make_tuple(64, 32, &aom_highbd_sad64x32x8_c, 8),
+  make_tuple(32, 64, &aom_highbd_sad32x64x8_c, 8),
+  make_tuple(32, 32, &aom_highbd_sad32x32x8_c, 8),
+  make_tuple(32, 16, &aom_highbd_sad32x16x8_c, 8),
+  make_tuple(16, 32, &aom_highbd_sad16x32x8_c, 8),
+  make_tuple(16, 16, &aom_highbd_sad16x16x8_c, 8),
+  make_tuple(16, 8, &aom_highbd_sad16x8x8_c, 8),
+  make_tuple(8, 16, &aom_highbd_sad8x16x8_c, 8),
+  make_tuple(8, 8, &aom_highbd_sad8x8x8_c, 8),
+  make_tuple(8, 4, &aom_highbd_sad8x4x8_c, 8),
+  make_tuple(4, 8, &aom_highbd_sad4x8x8_c, 8),
+  make_tuple(4, 4, &aom_highbd_sad4x4x8_c, 8),
+  make_tuple(64, 64, &aom_highbd_sad64x64x8_c, 10),
+  make_tuple(64, 32, &aom_highbd_sad64x32x8_c, 10),
+  make_tuple(32, 64, &aom_highbd_sad32x64x8_c, 10),
+  make_tuple(32, 32, &aom_highbd_sad32x32x8_c, 10),
+  make_tuple(32, 16, &aom_highbd_sad32x16x8_c, 10),
+  make_tuple(16, 32, &aom_highbd_sad16x32x8_c, 10),
+  make_tuple(16, 16, &aom_highbd_sad16x16x8_c, 10),
+  make_tuple(16, 8, &aom_highbd_sad16x8x8_c, 10),
+  make_tuple(8, 16, &aom_highbd_sad8x16x8_c, 10),
+  make_tuple(8, 8, &aom_highbd_sad8x8x8_c, 10),
+  make_tuple(8, 4, &aom_highbd_sad8x4x8_c, 10),
+  make_tuple(4, 8, &aom_highbd_sad4x8x8_c, 10),
+  make_tuple(4, 4, &aom_highbd_sad4x4x8_c, 10),
+  make_tuple(64, 64, &aom_highbd_sad64x64x8_c, 12),
+  make_tuple(64, 32, &aom_highbd_sad64x32x8_c, 12),
+  make_tuple(32, 64, &aom_highbd_sad32x64x8_c, 12),
+  make_tuple(32, 32, &aom_highbd_sad32x32x8_c, 12),
+  make_tuple(32, 16, &aom_highbd_sad32x16x8_c, 12),
+  make_tuple(16, 32, &aom_highbd_sad16x32x8_c, 12),
+  make_tuple(16, 16, &aom_highbd_sad16x16x8_c, 12),
+  make_tuple(16, 8, &aom_highbd_sad16x8x8_c, 12),
+  make_tuple(8, 16, &aom_highbd_sad8x16x8_c, 12),
+  make_tuple(8, 8, &aom_highbd_sad8x8x8_c, 12),
+  make_tuple(8, 4, &aom_highbd_sad8x4x8_c, 12),
+  make_tuple(4, 8, &aom_highbd_sad4x8x8_c, 12),
+  make_tuple(4, 4, &aom_highbd_sad4x4x8_c, 12),
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+};
+INSTANTIATE_TEST_CASE_P(C, SADx8Test, ::testing::ValuesIn(x8_c_tests));
+
 //------------------------------------------------------------------------------
 // ARM functions
 #if HAVE_MEDIA
@@ -860,7 +986,145 @@ INSTANTIATE_TEST_CASE_P(SSE2, SADx4Test, ::testing::ValuesIn(x4d_sse2_tests));
 #endif  // HAVE_SSSE3
 
 #if HAVE_SSE4_1
-// Only functions are x8, which do not have tests.
+const SadMxNx8Param x8_sse4_1_tests[] = {
+  make_tuple(16, 16, &aom_sad16x16x8_sse4_1, -1),
+  make_tuple(16, 8, &aom_sad16x8x8_sse4_1, -1),
+  make_tuple(8, 16, &aom_sad8x16x8_sse4_1, -1),
+  make_tuple(8, 8, &aom_sad8x8x8_sse4_1, -1),
+  make_tuple(4, 4, &aom_sad4x4x8_sse4_1, -1),
+#if CONFIG_AOM_HIGHBITDEPTH
+  make_tuple(64, 64, &aom_highbd_sad64x64x8_sse4_1, 8),
+  make_tuple(64, 32, &aom_highbd_sad64x32x8_sse4_1, 8),
+  make_tuple(32, 64, &aom_highbd_sad32x64x8_sse4_1, 8),
+  make_tuple(32, 32, &aom_highbd_sad32x32x8_sse4_1, 8),
+  make_tuple(32, 16, &aom_highbd_sad32x16x8_sse4_1, 8),
+  make_tuple(16, 32, &aom_highbd_sad16x32x8_sse4_1, 8),
+  make_tuple(16, 16, &aom_highbd_sad16x16x8_sse4_1, 8),
+  make_tuple(16, 8, &aom_highbd_sad16x8x8_sse4_1, 8),
+  make_tuple(8, 16, &aom_highbd_sad8x16x8_sse4_1, 8),
+  make_tuple(8, 8, &aom_highbd_sad8x8x8_sse4_1, 8),
+  make_tuple(8, 4, &aom_highbd_sad8x4x8_sse4_1, 8),
+  make_tuple(4, 8, &aom_highbd_sad4x8x8_sse4_1, 8),
+  make_tuple(4, 4, &aom_highbd_sad4x4x8_sse4_1, 8),
+  make_tuple(64, 64, &aom_highbd_sad64x64x8_sse4_1, 10),
+  make_tuple(64, 32, &aom_highbd_sad64x32x8_sse4_1, 10),
+  make_tuple(32, 64, &aom_highbd_sad32x64x8_sse4_1, 10),
+  make_tuple(32, 32, &aom_highbd_sad32x32x8_sse4_1, 10),
+  make_tuple(32, 16, &aom_highbd_sad32x16x8_sse4_1, 10),
+  make_tuple(16, 32, &aom_highbd_sad16x32x8_sse4_1, 10),
+  make_tuple(16, 16, &aom_highbd_sad16x16x8_sse4_1, 10),
+  make_tuple(16, 8, &aom_highbd_sad16x8x8_sse4_1, 10),
+  make_tuple(8, 16, &aom_highbd_sad8x16x8_sse4_1, 10),
+  make_tuple(8, 8, &aom_highbd_sad8x8x8_sse4_1, 10),
+  make_tuple(8, 4, &aom_highbd_sad8x4x8_sse4_1, 10),
+  make_tuple(4, 8, &aom_highbd_sad4x8x8_sse4_1, 10),
+  make_tuple(4, 4, &aom_highbd_sad4x4x8_sse4_1, 10),
+  make_tuple(64, 64, &aom_highbd_sad64x64x8_sse4_1, 12),
+  make_tuple(64, 32, &aom_highbd_sad64x32x8_sse4_1, 12),
+  make_tuple(32, 64, &aom_highbd_sad32x64x8_sse4_1, 12),
+  make_tuple(32, 32, &aom_highbd_sad32x32x8_sse4_1, 12),
+  make_tuple(32, 16, &aom_highbd_sad32x16x8_sse4_1, 12),
+  make_tuple(16, 32, &aom_highbd_sad16x32x8_sse4_1, 12),
+  make_tuple(16, 16, &aom_highbd_sad16x16x8_sse4_1, 12),
+  make_tuple(16, 8, &aom_highbd_sad16x8x8_sse4_1, 12),
+  make_tuple(8, 16, &aom_highbd_sad8x16x8_sse4_1, 12),
+  make_tuple(8, 8, &aom_highbd_sad8x8x8_sse4_1, 12),
+  make_tuple(8, 4, &aom_highbd_sad8x4x8_sse4_1, 12),
+  make_tuple(4, 8, &aom_highbd_sad4x8x8_sse4_1, 12),
+  make_tuple(4, 4, &aom_highbd_sad4x4x8_sse4_1, 12),
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+};
+INSTANTIATE_TEST_CASE_P(SSE4_1, SADx8Test,
+                        ::testing::ValuesIn(x8_sse4_1_tests));
+
+#if CONFIG_AOM_HIGHBITDEPTH
+const SadMxNParam sse4_1_tests[] = {
+  make_tuple(64, 64, &aom_highbd_sad64x64_sse4_1, 8),
+  make_tuple(64, 32, &aom_highbd_sad64x32_sse4_1, 8),
+  make_tuple(32, 64, &aom_highbd_sad32x64_sse4_1, 8),
+  make_tuple(32, 32, &aom_highbd_sad32x32_sse4_1, 8),
+  make_tuple(32, 16, &aom_highbd_sad32x16_sse4_1, 8),
+  make_tuple(16, 32, &aom_highbd_sad16x32_sse4_1, 8),
+  make_tuple(16, 16, &aom_highbd_sad16x16_sse4_1, 8),
+  make_tuple(16, 8, &aom_highbd_sad16x8_sse4_1, 8),
+  make_tuple(8, 16, &aom_highbd_sad8x16_sse4_1, 8),
+  make_tuple(8, 8, &aom_highbd_sad8x8_sse4_1, 8),
+  make_tuple(8, 4, &aom_highbd_sad8x4_sse4_1, 8),
+  make_tuple(4, 8, &aom_highbd_sad4x8_sse4_1, 8),
+  make_tuple(4, 4, &aom_highbd_sad4x4_sse4_1, 8),
+  make_tuple(64, 64, &aom_highbd_sad64x64_sse4_1, 10),
+  make_tuple(64, 32, &aom_highbd_sad64x32_sse4_1, 10),
+  make_tuple(32, 64, &aom_highbd_sad32x64_sse4_1, 10),
+  make_tuple(32, 32, &aom_highbd_sad32x32_sse4_1, 10),
+  make_tuple(32, 16, &aom_highbd_sad32x16_sse4_1, 10),
+  make_tuple(16, 32, &aom_highbd_sad16x32_sse4_1, 10),
+  make_tuple(16, 16, &aom_highbd_sad16x16_sse4_1, 10),
+  make_tuple(16, 8, &aom_highbd_sad16x8_sse4_1, 10),
+  make_tuple(8, 16, &aom_highbd_sad8x16_sse4_1, 10),
+  make_tuple(8, 8, &aom_highbd_sad8x8_sse4_1, 10),
+  make_tuple(8, 4, &aom_highbd_sad8x4_sse4_1, 10),
+  make_tuple(4, 8, &aom_highbd_sad4x8_sse4_1, 10),
+  make_tuple(4, 4, &aom_highbd_sad4x4_sse4_1, 10),
+  make_tuple(64, 64, &aom_highbd_sad64x64_sse4_1, 12),
+  make_tuple(64, 32, &aom_highbd_sad64x32_sse4_1, 12),
+  make_tuple(32, 64, &aom_highbd_sad32x64_sse4_1, 12),
+  make_tuple(32, 32, &aom_highbd_sad32x32_sse4_1, 12),
+  make_tuple(32, 16, &aom_highbd_sad32x16_sse4_1, 12),
+  make_tuple(16, 32, &aom_highbd_sad16x32_sse4_1, 12),
+  make_tuple(16, 16, &aom_highbd_sad16x16_sse4_1, 12),
+  make_tuple(16, 8, &aom_highbd_sad16x8_sse4_1, 12),
+  make_tuple(8, 16, &aom_highbd_sad8x16_sse4_1, 12),
+  make_tuple(8, 8, &aom_highbd_sad8x8_sse4_1, 12),
+  make_tuple(8, 4, &aom_highbd_sad8x4_sse4_1, 12),
+  make_tuple(4, 8, &aom_highbd_sad4x8_sse4_1, 12),
+  make_tuple(4, 4, &aom_highbd_sad4x4_sse4_1, 12),
+};
+INSTANTIATE_TEST_CASE_P(SSE4_1, SADTest, ::testing::ValuesIn(sse4_1_tests));
+
+const SadMxNx4Param x4d_sse4_1_tests[] = {
+  make_tuple(64, 64, &aom_highbd_sad64x64x4d_sse4_1, 8),
+  make_tuple(64, 32, &aom_highbd_sad64x32x4d_sse4_1, 8),
+  make_tuple(32, 64, &aom_highbd_sad32x64x4d_sse4_1, 8),
+  make_tuple(32, 32, &aom_highbd_sad32x32x4d_sse4_1, 8),
+  make_tuple(32, 16, &aom_highbd_sad32x16x4d_sse4_1, 8),
+  make_tuple(16, 32, &aom_highbd_sad16x32x4d_sse4_1, 8),
+  make_tuple(16, 16, &aom_highbd_sad16x16x4d_sse4_1, 8),
+  make_tuple(16, 8, &aom_highbd_sad16x8x4d_sse4_1, 8),
+  make_tuple(8, 16, &aom_highbd_sad8x16x4d_sse4_1, 8),
+  make_tuple(8, 8, &aom_highbd_sad8x8x4d_sse4_1, 8),
+  make_tuple(8, 4, &aom_highbd_sad8x4x4d_sse4_1, 8),
+  make_tuple(4, 8, &aom_highbd_sad4x8x4d_sse4_1, 8),
+  make_tuple(4, 4, &aom_highbd_sad4x4x4d_sse4_1, 8),
+  make_tuple(64, 64, &aom_highbd_sad64x64x4d_sse4_1, 10),
+  make_tuple(64, 32, &aom_highbd_sad64x32x4d_sse4_1, 10),
+  make_tuple(32, 64, &aom_highbd_sad32x64x4d_sse4_1, 10),
+  make_tuple(32, 32, &aom_highbd_sad32x32x4d_sse4_1, 10),
+  make_tuple(32, 16, &aom_highbd_sad32x16x4d_sse4_1, 10),
+  make_tuple(16, 32, &aom_highbd_sad16x32x4d_sse4_1, 10),
+  make_tuple(16, 16, &aom_highbd_sad16x16x4d_sse4_1, 10),
+  make_tuple(16, 8, &aom_highbd_sad16x8x4d_sse4_1, 10),
+  make_tuple(8, 16, &aom_highbd_sad8x16x4d_sse4_1, 10),
+  make_tuple(8, 8, &aom_highbd_sad8x8x4d_sse4_1, 10),
+  make_tuple(8, 4, &aom_highbd_sad8x4x4d_sse4_1, 10),
+  make_tuple(4, 8, &aom_highbd_sad4x8x4d_sse4_1, 10),
+  make_tuple(4, 4, &aom_highbd_sad4x4x4d_sse4_1, 10),
+  make_tuple(64, 64, &aom_highbd_sad64x64x4d_sse4_1, 12),
+  make_tuple(64, 32, &aom_highbd_sad64x32x4d_sse4_1, 12),
+  make_tuple(32, 64, &aom_highbd_sad32x64x4d_sse4_1, 12),
+  make_tuple(32, 32, &aom_highbd_sad32x32x4d_sse4_1, 12),
+  make_tuple(32, 16, &aom_highbd_sad32x16x4d_sse4_1, 12),
+  make_tuple(16, 32, &aom_highbd_sad16x32x4d_sse4_1, 12),
+  make_tuple(16, 16, &aom_highbd_sad16x16x4d_sse4_1, 12),
+  make_tuple(16, 8, &aom_highbd_sad16x8x4d_sse4_1, 12),
+  make_tuple(8, 16, &aom_highbd_sad8x16x4d_sse4_1, 12),
+  make_tuple(8, 8, &aom_highbd_sad8x8x4d_sse4_1, 12),
+  make_tuple(8, 4, &aom_highbd_sad8x4x4d_sse4_1, 12),
+  make_tuple(4, 8, &aom_highbd_sad4x8x4d_sse4_1, 12),
+  make_tuple(4, 4, &aom_highbd_sad4x4x4d_sse4_1, 12),
+};
+INSTANTIATE_TEST_CASE_P(SSE4_1, SADx4Test,
+                        ::testing::ValuesIn(x4d_sse4_1_tests));
+#endif  // CONFIG_AOM_HIGHBITDEPTH
 #endif  // HAVE_SSE4_1
 
 #if HAVE_AVX2
@@ -870,6 +1134,9 @@ const SadMxNParam avx2_tests[] = {
   make_tuple(32, 64, &aom_sad32x64_avx2, -1),
   make_tuple(32, 32, &aom_sad32x32_avx2, -1),
   make_tuple(32, 16, &aom_sad32x16_avx2, -1),
+  make_tuple(16, 32, &aom_sad16x32_avx2, -1),
+  make_tuple(16, 16, &aom_sad16x16_avx2, -1),
+  make_tuple(16, 8, &aom_sad16x8_avx2, -1),
 };
 INSTANTIATE_TEST_CASE_P(AVX2, SADTest, ::testing::ValuesIn(avx2_tests));
 
@@ -884,9 +1151,32 @@ INSTANTIATE_TEST_CASE_P(AVX2, SADavgTest, ::testing::ValuesIn(avg_avx2_tests));
 
 const SadMxNx4Param x4d_avx2_tests[] = {
   make_tuple(64, 64, &aom_sad64x64x4d_avx2, -1),
+  make_tuple(64, 32, &aom_sad64x32x4d_avx2, -1),
+  make_tuple(32, 64, &aom_sad32x64x4d_avx2, -1),
   make_tuple(32, 32, &aom_sad32x32x4d_avx2, -1),
+  make_tuple(32, 16, &aom_sad32x16x4d_avx2, -1),
+  make_tuple(16, 32, &aom_sad16x32x4d_avx2, -1),
+  make_tuple(16, 16, &aom_sad16x16x4d_avx2, -1),
+  make_tuple(16, 8, &aom_sad16x8x4d_avx2, -1),
 };
 INSTANTIATE_TEST_CASE_P(AVX2, SADx4Test, ::testing::ValuesIn(x4d_avx2_tests));
+
+const SadMxNx8Param x8_avx2_tests[] = {
+  make_tuple(64, 64, &aom_sad64x64x8_avx2, -1),
+  make_tuple(64, 32, &aom_sad64x32x8_avx2, -1),
+  make_tuple(32, 64, &aom_sad32x64x8_avx2, -1),
+  make_tuple(32, 32, &aom_sad32x32x8_avx2, -1),
+  make_tuple(32, 16, &aom_sad32x16x8_avx2, -1),
+  make_tuple(16, 32, &aom_sad16x32x8_avx2, -1),
+  make_tuple(16, 16, &aom_sad16x16x8_avx2, -1),
+  make_tuple(16, 8, &aom_sad16x8x8_avx2, -1),
+  make_tuple(8, 16, &aom_sad8x16x8_avx2, -1),
+  make_tuple(8, 8, &aom_sad8x8x8_avx2, -1),
+  make_tuple(8, 4, &aom_sad8x4x8_avx2, -1),
+  make_tuple(4, 8, &aom_sad4x8x8_avx2, -1),
+  make_tuple(4, 4, &aom_sad4x4x8_avx2, -1),
+};
+INSTANTIATE_TEST_CASE_P(AVX2, SADx8Test, ::testing::ValuesIn(x8_avx2_tests));
 #endif  // HAVE_AVX2
 
 //------------------------------------------------------------------------------
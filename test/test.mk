@@ -117,10 +117,13 @@ LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += fdct4x4_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += fdct8x8_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += variance_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += quantize_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += quantize_qm_test.cc
+LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += fht_quant_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += subtract_test.cc
 LIBAOM_TEST_SRCS-yes += function_equivalence_test.h
 LIBAOM_TEST_SRCS-yes += blend_a64_mask_test.cc
 LIBAOM_TEST_SRCS-yes += blend_a64_mask_1d_test.cc
+LIBAOM_TEST_SRCS-yes += yv12extend_test.cc
 ifeq ($(CONFIG_MOTION_VAR),yes)
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += obmc_sad_test.cc
 LIBAOM_TEST_SRCS-$(CONFIG_AV1_ENCODER) += obmc_variance_test.cc
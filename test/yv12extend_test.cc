@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "test/function_equivalence_test.h"
+#include "test/register_state_check.h"
+
+#include "./aom_config.h"
+#include "./aom_scale_rtcd.h"
+#include "aom/aom_integer.h"
+#include "aom_scale/yv12config.h"
+
+using libaom_test::ACMRandom;
+using libaom_test::FunctionEquivalenceTest;
+
+namespace {
+
+static const int kMaxWidth = 128;
+static const int kMaxHeight = 16;
+static const int kMaxExtend = 160 + 7;
+static const int kStride = kMaxExtend + kMaxWidth + kMaxExtend;
+static const int kBufSize = kStride * kMaxHeight;
+
+//////////////////////////////////////////////////////////////////////////////
+// Left and right border extension kernels
+//////////////////////////////////////////////////////////////////////////////
+
+typedef void (*ExtendPlaneLRFunc)(uint8_t *src, int src_stride, int width,
+                                  int height, int extend_left,
+                                  int extend_right);
+typedef libaom_test::FuncParam<ExtendPlaneLRFunc> TestFuncs;
+
+class ExtendPlaneLRTest : public FunctionEquivalenceTest<ExtendPlaneLRFunc> {
+ protected:
+  void Run() {
+    const int width = 1 + rng_(kMaxWidth);
+    const int height = 1 + rng_(kMaxHeight);
+    const int extend_left = rng_(kMaxExtend + 1);
+    const int extend_right = rng_(kMaxExtend + 1);
+    int i;
+
+    for (i = 0; i < kBufSize; ++i) buf_ref_[i] = buf_tst_[i] = rng_.Rand8();
+
+    params_.ref_func(buf_ref_ + kMaxExtend, kStride, width, height, extend_left,
+                     extend_right);
+    ASM_REGISTER_STATE_CHECK(params_.tst_func(buf_tst_ + kMaxExtend, kStride,
+                                              width, height, extend_left,
+                                              extend_right));
+
+    ASSERT_EQ(0, memcmp(buf_ref_, buf_tst_, sizeof(buf_ref_)))
+        << "width " << width << " height " << height << " extend_left "
+        << extend_left << " extend_right " << extend_right;
+  }
+
+  uint8_t buf_ref_[kBufSize];
+  uint8_t buf_tst_[kBufSize];
+};
+
+TEST_P(ExtendPlaneLRTest, RandomValues) {
+  for (int i = 0; i < 1000; ++i) Run();
+}
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, ExtendPlaneLRTest,
+                        ::testing::Values(TestFuncs(aom_extend_plane_lr_c,
+                                                    aom_extend_plane_lr_avx2)));
+#endif  // HAVE_AVX2
+
+#if CONFIG_AOM_HIGHBITDEPTH
+typedef void (*HighbdExtendPlaneLRFunc)(uint16_t *src, int src_stride,
+                                        int width, int height, int extend_left,
+                                        int extend_right);
+typedef libaom_test::FuncParam<HighbdExtendPlaneLRFunc> TestFuncsHBD;
+
+class HighbdExtendPlaneLRTest
+    : public FunctionEquivalenceTest<HighbdExtendPlaneLRFunc> {
+ protected:
+  void Run() {
+    const int width = 1 + rng_(kMaxWidth);
+    const int height = 1 + rng_(kMaxHeight);
+    const int extend_left = rng_(kMaxExtend + 1);
+    const int extend_right = rng_(kMaxExtend + 1);
+    int i;
+
+    for (i = 0; i < kBufSize; ++i)
+      buf_ref_[i] = buf_tst_[i] = rng_(1 << params_.bit_depth);
+
+    params_.ref_func(buf_ref_ + kMaxExtend, kStride, width, height, extend_left,
+                     extend_right);
+    ASM_REGISTER_STATE_CHECK(params_.tst_func(buf_tst_ + kMaxExtend, kStride,
+                                              width, height, extend_left,
+                                              extend_right));
+
+    ASSERT_EQ(0, memcmp(buf_ref_, buf_tst_, sizeof(buf_ref_)))
+        << "width " << width << " height " << height << " extend_left "
+        << extend_left << " extend_right " << extend_right;
+  }
+
+  uint16_t buf_ref_[kBufSize];
+  uint16_t buf_tst_[kBufSize];
+};
+
+TEST_P(HighbdExtendPlaneLRTest, RandomValues) {
+  for (int i = 0; i < 1000; ++i) Run();
+}
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, HighbdExtendPlaneLRTest,
+    ::testing::Values(TestFuncsHBD(aom_highbd_extend_plane_lr_c,
+                                   aom_highbd_extend_plane_lr_avx2, 10),
+                      TestFuncsHBD(aom_highbd_extend_plane_lr_c,
+                                   aom_highbd_extend_plane_lr_avx2, 12)));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_AOM_HIGHBITDEPTH
+
+//////////////////////////////////////////////////////////////////////////////
+// Row by row extension
+//////////////////////////////////////////////////////////////////////////////
+
+class ExtendPlaneRowsTest : public ::testing::TestWithParam<int> {
+ public:
+  ExtendPlaneRowsTest() : rng_(ACMRandom::DeterministicSeed()) {}
+
+  virtual void SetUp() {
+    memset(&ref_, 0, sizeof(ref_));
+    memset(&tst_, 0, sizeof(tst_));
+  }
+
+  virtual void TearDown() {
+    aom_free_frame_buffer(&ref_);
+    aom_free_frame_buffer(&tst_);
+  }
+
+ protected:
+  void Alloc(int width, int height, int use_highbitdepth) {
+    ASSERT_EQ(0, aom_alloc_frame_buffer(&ref_, width, height, 1, 1,
+#if CONFIG_AOM_HIGHBITDEPTH
+                                        use_highbitdepth,
+#endif
+                                        AOM_BORDER_IN_PIXELS, 0));
+    ASSERT_EQ(0, aom_alloc_frame_buffer(&tst_, width, height, 1, 1,
+#if CONFIG_AOM_HIGHBITDEPTH
+                                        use_highbitdepth,
+#endif
+                                        AOM_BORDER_IN_PIXELS, 0));
+#if !CONFIG_AOM_HIGHBITDEPTH
+    (void)use_highbitdepth;
+#endif
+    ASSERT_EQ(ref_.frame_size, tst_.frame_size);
+    for (int i = 0; i < ref_.frame_size; ++i)
+      ref_.buffer_alloc[i] = tst_.buffer_alloc[i] = rng_.Rand8();
+  }
+
+  ACMRandom rng_;
+  YV12_BUFFER_CONFIG ref_;
+  YV12_BUFFER_CONFIG tst_;
+};
+
+TEST_P(ExtendPlaneRowsTest, MatchesFrameExtension) {
+  const int rows_per_call = GetParam();
+  const int sizes[][2] = { { 64, 64 }, { 208, 144 }, { 99, 37 }, { 8, 8 } };
+
+  for (int hbd = 0; hbd <= CONFIG_AOM_HIGHBITDEPTH; ++hbd) {
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+      Alloc(sizes[s][0], sizes[s][1], hbd);
+
+      aom_extend_frame_inner_borders(&ref_);
+      for (int plane = 0; plane < 3; ++plane) {
+        const int height = plane ? tst_.uv_crop_height : tst_.y_crop_height;
+        // Extend the rows bottom up so that the top and bottom borders are
+        // not produced by the first call.
+        for (int row = (height - 1) / rows_per_call * rows_per_call; row >= 0;
+             row -= rows_per_call)
+          aom_extend_frame_borders_plane_rows(&tst_, plane,
+                                              AOMINNERBORDERINPIXELS, row,
+                                              row + rows_per_call);
+      }
+
+      ASSERT_EQ(0,
+                memcmp(ref_.buffer_alloc, tst_.buffer_alloc, ref_.frame_size))
+          << "size " << sizes[s][0] << "x" << sizes[s][1] << " hbd " << hbd;
+
+      aom_free_frame_buffer(&ref_);
+      aom_free_frame_buffer(&tst_);
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(C, ExtendPlaneRowsTest, ::testing::Values(1, 7, 56));
+
+}  // namespace